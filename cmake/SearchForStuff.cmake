@@ -581,6 +581,31 @@ if (PKG_CONFIG_FOUND)
     add_definitions( -DLIBBULLET_VERSION_GT_282 )
   endif()
 
+  # The multithreaded dynamics world needs bullet >= 2.88 built with
+  # BULLET2_MULTITHREADING, in which case the default task scheduler exists.
+  # BT_THREADSAFE must then be defined when including bullet headers.
+  set (BULLET_THREADSAFE FALSE)
+  if (BULLET_FOUND AND NOT BULLET_VERSION VERSION_LESS 2.88)
+    include (CheckCXXSourceRuns)
+    set (CMAKE_REQUIRED_INCLUDES ${BULLET_INCLUDE_DIRS})
+    set (CMAKE_REQUIRED_LIBRARIES ${BULLET_LDFLAGS})
+    set (CMAKE_REQUIRED_DEFINITIONS -DBT_THREADSAFE=1)
+    check_cxx_source_runs("
+      #include <LinearMath/btThreads.h>
+      int main() { return btCreateDefaultTaskScheduler() ? 0 : 1; }"
+      BULLET_HAS_TASK_SCHEDULER)
+    unset (CMAKE_REQUIRED_INCLUDES)
+    unset (CMAKE_REQUIRED_LIBRARIES)
+    unset (CMAKE_REQUIRED_DEFINITIONS)
+
+    if (BULLET_HAS_TASK_SCHEDULER)
+      set (BULLET_THREADSAFE TRUE)
+      add_definitions( -DLIBBULLET_MULTITHREADING -DBT_THREADSAFE=1 )
+    else()
+      BUILD_WARNING ("Bullet was built without multithreading support, the bullet physics engine will step on one thread.")
+    endif()
+  endif()
+
   ########################################
   # Find libusb
   pkg_check_modules(libusb-1.0 libusb-1.0)
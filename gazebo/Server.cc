@@ -189,7 +189,7 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|txt|binary).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
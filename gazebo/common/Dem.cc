@@ -16,6 +16,9 @@
 */
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
 #include <boost/filesystem.hpp>
 #include <gazebo/gazebo_config.h>
 
@@ -38,6 +41,12 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+/// \brief Number of points along each side of a DEM tile.
+static const unsigned int kDemTileSize = 256;
+
+/// \brief Number of points along each side of the coarsest level of detail.
+static const unsigned int kDemMinLevelSize = 32;
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
@@ -49,7 +58,8 @@ Dem::Dem()
 //////////////////////////////////////////////////
 Dem::~Dem()
 {
-  this->dataPtr->demData.clear();
+  this->dataPtr->tiles.clear();
+  this->dataPtr->lru.clear();
 
   if (this->dataPtr->dataSet)
     GDALClose(reinterpret_cast<GDALDataset *>(this->dataPtr->dataSet));
@@ -88,6 +98,13 @@ int Dem::Load(const std::string &_filename)
     return -1;
   }
 
+  // Drop a previously loaded DEM
+  if (this->dataPtr->dataSet)
+    GDALClose(reinterpret_cast<GDALDataset *>(this->dataPtr->dataSet));
+  this->dataPtr->tiles.clear();
+  this->dataPtr->lru.clear();
+  this->dataPtr->tilesSize = 0;
+
   this->dataPtr->dataSet = reinterpret_cast<GDALDataset *>(GDALOpen(
     fullName.c_str(), GA_ReadOnly));
 
@@ -156,7 +173,7 @@ int Dem::Load(const std::string &_filename)
 
   this->dataPtr->side = std::max(width, height);
 
-  // Preload the DEM's data
+  // Compute the size of the DEM's data
   if (this->LoadData() != 0)
     return -1;
 
@@ -173,12 +190,35 @@ int Dem::Load(const std::string &_filename)
 
   double min = ignition::math::MAX_D;
   double max = -ignition::math::MAX_D;
-  for (auto d : this->dataPtr->demData)
+  auto update = [&](const double d)
   {
     if (d < min && d > noDataValue)
       min = d;
     if (d > max && d > noDataValue)
       max = d;
+  };
+
+  // Padding points are 0
+  if (this->dataPtr->dataWidth < this->dataPtr->side ||
+      this->dataPtr->dataHeight < this->dataPtr->side)
+  {
+    update(0);
+  }
+
+  // Decode the DEM in strips of rows, which aren't kept
+  std::vector<float> strip(this->dataPtr->dataWidth * kDemTileSize);
+  for (unsigned int y = 0; y < this->dataPtr->dataHeight; y += kDemTileSize)
+  {
+    const unsigned int rows =
+      std::min(kDemTileSize, this->dataPtr->dataHeight - y);
+    if (!this->ReadPoints(0, 0, y, this->dataPtr->dataWidth, rows,
+          strip.data()))
+    {
+      gzerr << "Failure calling RasterIO while loading a DEM file\n";
+      return -1;
+    }
+    for (unsigned int i = 0; i < this->dataPtr->dataWidth * rows; ++i)
+      update(strip[i]);
   }
   if (ignition::math::equal(min, ignition::math::MAX_D) ||
       ignition::math::equal(max, -ignition::math::MAX_D))
@@ -202,7 +242,16 @@ double Dem::GetElevation(double _x, double _y)
            " x " << this->GetHeight() << "]\n");
   }
 
-  return this->dataPtr->demData.at(_y * this->GetWidth() + _x);
+  const unsigned int x = static_cast<unsigned int>(_x);
+  const unsigned int y = static_cast<unsigned int>(_y);
+  DemTilePtr tile = this->Tile(0, x / kDemTileSize, y / kDemTileSize);
+  if (!tile)
+    gzthrow("Unable to read the elevation in (" << _x << "," << _y << ")\n");
+
+  const unsigned int tileWidth =
+    std::min(kDemTileSize, this->dataPtr->side - x / kDemTileSize *
+        kDemTileSize);
+  return tile->at((y % kDemTileSize) * tileWidth + x % kDemTileSize);
 }
 
 //////////////////////////////////////////////////
@@ -329,31 +378,94 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
   // Resize the vector to match the size of the vertices.
   _heights.resize(_vertSize * _vertSize);
 
+  // The last tiles used, since neighbouring vertices use the same tiles
+  struct CachedTile
+  {
+    uint64_t key = UINT64_MAX;
+    DemTilePtr tile;
+    unsigned int width = 0;
+  };
+  CachedTile cached[4];
+  unsigned int nextCached = 0;
+  auto point = [&](const unsigned int _level, const unsigned int _x,
+      const unsigned int _y) -> double
+  {
+    const unsigned int tileX = _x / kDemTileSize;
+    const unsigned int tileY = _y / kDemTileSize;
+    const uint64_t key = (static_cast<uint64_t>(_level) << 48) |
+      (static_cast<uint64_t>(tileY) << 24) | tileX;
+    CachedTile *entry = nullptr;
+    for (auto &c : cached)
+    {
+      if (c.key == key)
+        entry = &c;
+    }
+    if (!entry)
+    {
+      entry = &cached[nextCached];
+      nextCached = (nextCached + 1) % 4;
+      entry->key = key;
+      entry->tile = this->Tile(_level, tileX, tileY);
+      const unsigned int levelSide = ((this->dataPtr->side - 1) >> _level) + 1;
+      entry->width = std::min(kDemTileSize, levelSide - tileX * kDemTileSize);
+    }
+    if (!entry->tile)
+      return this->dataPtr->minElevation;
+    return (*entry->tile)[(_y % kDemTileSize) * entry->width +
+      _x % kDemTileSize];
+  };
+
+  const unsigned int maxLevel = this->dataPtr->levels - 1;
+  const double lastVertex = std::max(1u, _vertSize - 1);
+
   // Iterate over all the vertices
   for (unsigned int y = 0; y < _vertSize; ++y)
   {
-    double yf = y / static_cast<double>(_subSampling);
-    unsigned int y1 = floor(yf);
-    unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
-    double dy = yf - y1;
-
     for (unsigned int x = 0; x < _vertSize; ++x)
     {
-      double xf = x / static_cast<double>(_subSampling);
-      unsigned int x1 = floor(xf);
+      // Halve the resolution each time the distance to the full resolution
+      // region doubles
+      unsigned int level = 0;
+      if (this->dataPtr->hasRegion && maxLevel > 0)
+      {
+        ignition::math::Vector2d pos((x / lastVertex - 0.5) * _size.X(),
+            (0.5 - y / lastVertex) * _size.Y());
+        const double dist = pos.Distance(this->dataPtr->regionCenter);
+        if (dist > this->dataPtr->regionRadius)
+        {
+          level = maxLevel;
+          if (this->dataPtr->regionRadius > 0)
+          {
+            level = std::min(maxLevel, 1u + static_cast<unsigned int>(
+                std::log2(dist / this->dataPtr->regionRadius)));
+          }
+        }
+      }
+      const unsigned int levelSide = ((this->dataPtr->side - 1) >> level) + 1;
+      const double levelStep = static_cast<double>(1u << level);
+
+      double yf = y / static_cast<double>(_subSampling) / levelStep;
+      unsigned int y1 = std::min(static_cast<unsigned int>(floor(yf)),
+          levelSide - 1);
+      unsigned int y2 = ceil(yf);
+      if (y2 >= levelSide)
+        y2 = levelSide - 1;
+      double dy = yf - y1;
+
+      double xf = x / static_cast<double>(_subSampling) / levelStep;
+      unsigned int x1 = std::min(static_cast<unsigned int>(floor(xf)),
+          levelSide - 1);
       unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
+      if (x2 >= levelSide)
+        x2 = levelSide - 1;
       double dx = xf - x1;
 
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
+      double px1 = point(level, x1, y1);
+      double px2 = point(level, x2, y1);
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
+      double px3 = point(level, x1, y2);
+      double px4 = point(level, x2, y2);
       float h2 = (px3 - ((px3 - px4) * dx));
 
       float h = this->dataPtr->minElevation +
@@ -378,6 +490,161 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
   }
 }
 
+//////////////////////////////////////////////////
+void Dem::SetFullResolutionRegion(const ignition::math::Vector2d &_center,
+    const double _radius)
+{
+  this->dataPtr->hasRegion = _radius >= 0;
+  this->dataPtr->regionCenter = _center;
+  this->dataPtr->regionRadius = _radius;
+}
+
+//////////////////////////////////////////////////
+bool Dem::FullResolutionRegion(ignition::math::Vector2d &_center,
+    double &_radius) const
+{
+  _center = this->dataPtr->regionCenter;
+  _radius = this->dataPtr->regionRadius;
+  return this->dataPtr->hasRegion;
+}
+
+//////////////////////////////////////////////////
+void Dem::SetCacheSize(const size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  this->dataPtr->cacheSize = _bytes;
+}
+
+//////////////////////////////////////////////////
+unsigned int Dem::LevelCount() const
+{
+  return this->dataPtr->levels;
+}
+
+//////////////////////////////////////////////////
+size_t Dem::DecodedSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  return this->dataPtr->tilesSize;
+}
+
+//////////////////////////////////////////////////
+DemTilePtr Dem::Tile(const unsigned int _level, const unsigned int _tileX,
+    const unsigned int _tileY) const
+{
+  const uint64_t key = (static_cast<uint64_t>(_level) << 48) |
+    (static_cast<uint64_t>(_tileY) << 24) | _tileX;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  auto iter = this->dataPtr->tiles.find(key);
+  if (iter != this->dataPtr->tiles.end())
+  {
+    this->dataPtr->lru.splice(this->dataPtr->lru.begin(), this->dataPtr->lru,
+        iter->second.second);
+    return iter->second.first;
+  }
+
+  const unsigned int levelSide = ((this->dataPtr->side - 1) >> _level) + 1;
+  const unsigned int x = _tileX * kDemTileSize;
+  const unsigned int y = _tileY * kDemTileSize;
+  if (x >= levelSide || y >= levelSide)
+    return nullptr;
+
+  const unsigned int width = std::min(kDemTileSize, levelSide - x);
+  const unsigned int height = std::min(kDemTileSize, levelSide - y);
+  std::shared_ptr<std::vector<float>> tile =
+    std::make_shared<std::vector<float>>(width * height);
+  if (!this->ReadPoints(_level, x, y, width, height, tile->data()))
+  {
+    gzerr << "Failure calling RasterIO while loading a DEM tile\n";
+    return nullptr;
+  }
+
+  this->dataPtr->lru.push_front(key);
+  this->dataPtr->tiles[key] = std::make_pair(tile, this->dataPtr->lru.begin());
+  this->dataPtr->tilesSize += tile->size() * sizeof(float);
+
+  // Keep at least two rows of full resolution tiles, so that filling the
+  // heights row by row doesn't decode tiles again
+  const size_t tilesPerRow = (this->dataPtr->side - 1) / kDemTileSize + 1;
+  const size_t limit = std::max(this->dataPtr->cacheSize,
+      2 * tilesPerRow * kDemTileSize * kDemTileSize * sizeof(float));
+  while (this->dataPtr->tilesSize > limit && this->dataPtr->lru.size() > 1)
+  {
+    auto oldest = this->dataPtr->tiles.find(this->dataPtr->lru.back());
+    this->dataPtr->tilesSize -= oldest->second.first->size() * sizeof(float);
+    this->dataPtr->tiles.erase(oldest);
+    this->dataPtr->lru.pop_back();
+  }
+
+  return tile;
+}
+
+//////////////////////////////////////////////////
+bool Dem::ReadPoints(const unsigned int _level, const unsigned int _x,
+    const unsigned int _y, const unsigned int _width,
+    const unsigned int _height, float *_data) const
+{
+  // Points beyond the scaled raster are padding
+  std::fill(_data, _data + _width * _height, 0.0f);
+  if (this->dataPtr->dataWidth == 0 || this->dataPtr->dataHeight == 0)
+    return false;
+
+  const unsigned int levelWidth =
+    ((this->dataPtr->dataWidth - 1) >> _level) + 1;
+  const unsigned int levelHeight =
+    ((this->dataPtr->dataHeight - 1) >> _level) + 1;
+  if (_x >= levelWidth || _y >= levelHeight)
+    return true;
+  const unsigned int width = std::min(_width, levelWidth - _x);
+  const unsigned int height = std::min(_height, levelHeight - _y);
+
+  // Window of the raster covered by the points, which are scaled the same
+  // way as when reading the whole raster at once
+  const unsigned int rasterWidth = this->dataPtr->dataSet->GetRasterXSize();
+  const unsigned int rasterHeight = this->dataPtr->dataSet->GetRasterYSize();
+  const double step = static_cast<double>(1u << _level);
+  const double ratioX = rasterWidth / static_cast<double>(
+      this->dataPtr->dataWidth);
+  const double ratioY = rasterHeight / static_cast<double>(
+      this->dataPtr->dataHeight);
+  const double xOff = _x * step * ratioX;
+  const double yOff = _y * step * ratioY;
+  const double xSize = std::min(width * step * ratioX, rasterWidth - xOff);
+  const double ySize = std::min(height * step * ratioY, rasterHeight - yOff);
+
+  const int rasterX = static_cast<int>(std::floor(xOff));
+  const int rasterY = static_cast<int>(std::floor(yOff));
+  const int rasterXSize = std::max(1, std::min(
+      static_cast<int>(std::ceil(xOff + xSize)) - rasterX,
+      static_cast<int>(rasterWidth) - rasterX));
+  const int rasterYSize = std::max(1, std::min(
+      static_cast<int>(std::ceil(yOff + ySize)) - rasterY,
+      static_cast<int>(rasterHeight) - rasterY));
+
+#if GDAL_VERSION_NUM >= 2000000
+  GDALRasterIOExtraArg extraArg;
+  INIT_RASTERIO_EXTRA_ARG(extraArg);
+  extraArg.bFloatingPointWindowValidity = TRUE;
+  extraArg.dfXOff = xOff;
+  extraArg.dfYOff = yOff;
+  extraArg.dfXSize = xSize;
+  extraArg.dfYSize = ySize;
+  // Coarser levels average the points they cover, and may be read from the
+  // overviews of the raster
+  if (_level > 0)
+    extraArg.eResampleAlg = GRIORA_Average;
+
+  return this->dataPtr->band->RasterIO(GF_Read, rasterX, rasterY,
+      rasterXSize, rasterYSize, _data, width, height, GDT_Float32,
+      sizeof(float), _width * sizeof(float), &extraArg) == CE_None;
+#else
+  return this->dataPtr->band->RasterIO(GF_Read, rasterX, rasterY,
+      rasterXSize, rasterYSize, _data, width, height, GDT_Float32,
+      sizeof(float), _width * sizeof(float)) == CE_None;
+#endif
+}
+
 //////////////////////////////////////////////////
 int Dem::LoadData()
 {
@@ -386,7 +653,6 @@ int Dem::LoadData()
     unsigned int nXSize = this->dataPtr->dataSet->GetRasterXSize();
     unsigned int nYSize = this->dataPtr->dataSet->GetRasterYSize();
     float ratio;
-    std::vector<float> buffer;
 
     if (nXSize == 0 || nYSize == 0)
     {
@@ -411,26 +677,17 @@ int Dem::LoadData()
       destWidth = static_cast<float>(destHeight) / static_cast<float>(ratio);
     }
 
-    // Read the whole raster data and convert it to a GDT_Float32 array.
-    // In this step the DEM is scaled to destWidth x destHeight
-    buffer.resize(destWidth * destHeight);
-    if (this->dataPtr->band->RasterIO(GF_Read, 0, 0, nXSize, nYSize, &buffer[0],
-                         destWidth, destHeight, GDT_Float32, 0, 0) != CE_None)
-    {
-      gzerr << "Failure calling RasterIO while loading a DEM file\n";
-      return -1;
-    }
+    // The DEM is scaled to destWidth x destHeight, and decoded in tiles
+    this->dataPtr->dataWidth = std::max(1u, destWidth);
+    this->dataPtr->dataHeight = std::max(1u, destHeight);
 
-    // Copy and align 'buffer' into the target vector. The destination vector is
-    // initialized to 0, so all the points not contained in 'buffer' will be
-    // extra padding
-    this->dataPtr->demData.resize(this->GetWidth() * this->GetHeight());
-    for (unsigned int y = 0; y < destHeight; ++y)
+    // Levels of detail, down to a few tens of points per side
+    this->dataPtr->levels = 1;
+    while (((this->dataPtr->side - 1) >> this->dataPtr->levels) >=
+        kDemMinLevelSize && this->dataPtr->levels < 16)
     {
-        std::copy(&buffer[destWidth * y], &buffer[destWidth * y] + destWidth,
-                  this->dataPtr->demData.begin() + this->GetWidth() * y);
+      ++this->dataPtr->levels;
     }
-    buffer.clear();
 
     return 0;
 }
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_DEM_HH_
 #define _GAZEBO_DEM_HH_
 
+#include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Angle.hh>
 
@@ -25,6 +26,7 @@
 #include <gazebo/util/system.hh>
 
 #ifdef HAVE_GDAL
+# include <memory>
 # include <string>
 # include <vector>
 
@@ -36,6 +38,10 @@ namespace gazebo
   {
     class DemPrivate;
 
+    /// \def DemTilePtr
+    /// \brief Shared pointer to the heights of a decoded DEM tile.
+    typedef std::shared_ptr<const std::vector<float>> DemTilePtr;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
@@ -125,6 +131,41 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      /// \brief Set the region of the terrain that FillHeightMap samples at
+      /// full resolution. Outside of it, the resolution is halved each time
+      /// the distance to the region doubles.
+      /// \param[in] _center Center of the region in meters, from the center
+      /// of the terrain, with X along the columns and Y along the rows from
+      /// the last row to the first one.
+      /// \param[in] _radius Radius of the region in meters. A negative radius
+      /// samples the whole terrain at full resolution, which is the default.
+      public: void SetFullResolutionRegion(
+                  const ignition::math::Vector2d &_center,
+                  const double _radius);
+
+      /// \brief Get the region of the terrain sampled at full resolution.
+      /// \param[out] _center Center of the region in meters.
+      /// \param[out] _radius Radius of the region in meters.
+      /// \return False if the whole terrain is sampled at full resolution.
+      /// \sa SetFullResolutionRegion
+      public: bool FullResolutionRegion(
+                  ignition::math::Vector2d &_center, double &_radius) const;
+
+      /// \brief Set the maximum size of the DEM data kept decoded in memory.
+      /// The DEM is decoded in tiles, which are dropped when the size is
+      /// reached. At least two rows of tiles are kept. Default is 64MB.
+      /// \param[in] _bytes Maximum size in bytes.
+      public: void SetCacheSize(const size_t _bytes);
+
+      /// \brief Get the number of levels of detail. Level L has one point
+      /// every 2^L points of the terrain.
+      /// \return Number of levels, including the full resolution.
+      public: unsigned int LevelCount() const;
+
+      /// \brief Get the size of the DEM data decoded in memory.
+      /// \return Size in bytes.
+      public: size_t DecodedSize() const;
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -135,12 +176,32 @@ namespace gazebo
                                     ignition::math::Angle &_latitude,
                                     ignition::math::Angle &_longitude) const;
 
-      /// \brief Get the terrain file as a data array. Due to the Ogre
-      /// constrains, the data might be stored in a bigger vector representing
-      /// a squared terrain with padding.
+      /// \brief Compute the size of the terrain data and its elevation range.
+      /// Due to the Ogre constrains, the data is padded to a squared terrain.
+      /// The data is decoded in strips, which aren't kept.
       /// \return 0 when the operation succeeds to open a file.
       private: int LoadData();
 
+      /// \brief Read points of a level of detail from the raster.
+      /// \param[in] _level Level of detail.
+      /// \param[in] _x First column, in points of the level.
+      /// \param[in] _y First row, in points of the level.
+      /// \param[in] _width Number of columns.
+      /// \param[in] _height Number of rows.
+      /// \param[out] _data _width * _height points, padding included.
+      /// \return False if the raster can't be read.
+      private: bool ReadPoints(const unsigned int _level, const unsigned int _x,
+                   const unsigned int _y, const unsigned int _width,
+                   const unsigned int _height, float *_data) const;
+
+      /// \brief Get a decoded tile, decoding it if needed.
+      /// \param[in] _level Level of detail.
+      /// \param[in] _tileX Column of the tile.
+      /// \param[in] _tileY Row of the tile.
+      /// \return The tile, null if the raster can't be read.
+      private: DemTilePtr Tile(const unsigned int _level,
+                   const unsigned int _tileX, const unsigned int _tileY) const;
+
       /// internal
       /// \brief Pointer to the private data.
       private: DemPrivate *dataPtr;
@@ -18,13 +18,21 @@
 #ifndef _GAZEBO_DEM_PRIVATE_HH_
 #define _GAZEBO_DEM_PRIVATE_HH_
 
+#include "gazebo/common/Dem.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 #include <gazebo/gazebo_config.h>
 #include <gazebo/util/system.hh>
 
 #ifdef HAVE_GDAL
 # include <gdal_priv.h>
+# include <cstdint>
+# include <list>
+# include <memory>
+# include <mutex>
+# include <unordered_map>
+# include <utility>
 # include <vector>
+# include <ignition/math/Vector2.hh>
 
 namespace gazebo
 {
@@ -58,8 +66,43 @@ namespace gazebo
       /// \brief Maximum elevation in meters.
       public: double maxElevation;
 
-      /// \brief DEM data converted to be OGRE-compatible.
-      public: std::vector<float> demData;
+      /// \brief Width of the raster once scaled to the terrain's side. The
+      /// points beyond it are padding.
+      public: unsigned int dataWidth = 0;
+
+      /// \brief Height of the raster once scaled to the terrain's side. The
+      /// points beyond it are padding.
+      public: unsigned int dataHeight = 0;
+
+      /// \brief Number of levels of detail. Level L has one point every 2^L
+      /// points of the terrain.
+      public: unsigned int levels = 1;
+
+      /// \brief Decoded tiles, by level and tile coordinates, with their
+      /// position in the lru list.
+      public: std::unordered_map<uint64_t,
+              std::pair<DemTilePtr, std::list<uint64_t>::iterator>> tiles;
+
+      /// \brief Keys of the decoded tiles, most recently used first.
+      public: std::list<uint64_t> lru;
+
+      /// \brief Size of the decoded tiles in bytes.
+      public: size_t tilesSize = 0;
+
+      /// \brief Maximum size of the decoded tiles in bytes.
+      public: size_t cacheSize = 64u * 1024u * 1024u;
+
+      /// \brief Protects the decoded tiles and the dataset.
+      public: std::mutex tilesMutex;
+
+      /// \brief True if only a region is sampled at full resolution.
+      public: bool hasRegion = false;
+
+      /// \brief Center of the region sampled at full resolution, in meters.
+      public: ignition::math::Vector2d regionCenter;
+
+      /// \brief Radius of the region sampled at full resolution, in meters.
+      public: double regionRadius = -1;
 
       /// \brief Holds the spherical coordinates object from the world.
       public: common::SphericalCoordinatesPtr sphericalCoordinates =
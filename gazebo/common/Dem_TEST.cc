@@ -15,10 +15,12 @@
  *
 */
 
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -168,6 +170,72 @@ TEST_F(DemTest, FillHeightmap)
   EXPECT_FLOAT_EQ(213.42966, elevations.at(elevations.size() / 2));
 }
 
+/////////////////////////////////////////////////
+TEST_F(DemTest, FullResolutionRegion)
+{
+  common::Dem dem;
+  boost::filesystem::path path = TEST_PATH;
+
+  path /= "data/dem_squared.tif";
+  EXPECT_EQ(dem.Load(path.string()), 0);
+  EXPECT_EQ(3u, dem.LevelCount());
+
+  ignition::math::Vector2d center;
+  double radius;
+  EXPECT_FALSE(dem.FullResolutionRegion(center, radius));
+
+  const int subsampling = 2;
+  const unsigned int vertSize = (dem.GetWidth() * subsampling) - 1;
+  ignition::math::Vector3d size(dem.GetWorldWidth(), dem.GetWorldHeight(),
+      dem.GetMaxElevation() - dem.GetMinElevation());
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      fabs(size.Z()) / dem.GetMaxElevation());
+
+  std::vector<float> full;
+  dem.FillHeightMap(subsampling, vertSize, size, scale, false, full);
+  EXPECT_GT(dem.DecodedSize(), 0u);
+
+  // Only the center of the terrain is sampled at full resolution
+  dem.SetFullResolutionRegion(ignition::math::Vector2d::Zero,
+      size.X() / 8);
+  EXPECT_TRUE(dem.FullResolutionRegion(center, radius));
+  EXPECT_EQ(ignition::math::Vector2d::Zero, center);
+  EXPECT_DOUBLE_EQ(size.X() / 8, radius);
+
+  std::vector<float> region;
+  dem.FillHeightMap(subsampling, vertSize, size, scale, false, region);
+  ASSERT_EQ(full.size(), region.size());
+
+  const unsigned int middle = vertSize / 2;
+  EXPECT_FLOAT_EQ(full[middle * vertSize + middle],
+      region[middle * vertSize + middle]);
+  EXPECT_FLOAT_EQ(full[(middle + 4) * vertSize + middle - 4],
+      region[(middle + 4) * vertSize + middle - 4]);
+
+  // The corners come from the coarsest level, which averages the points
+  unsigned int differences = 0;
+  for (unsigned int i = 0; i < full.size(); ++i)
+  {
+    EXPECT_GE(region[i], dem.GetMinElevation());
+    if (!ignition::math::equal(full[i], region[i], 1e-3f))
+      ++differences;
+  }
+  EXPECT_GT(differences, 0u);
+
+  // A negative radius samples the whole terrain at full resolution again
+  dem.SetFullResolutionRegion(ignition::math::Vector2d::Zero, -1);
+  EXPECT_FALSE(dem.FullResolutionRegion(center, radius));
+  dem.FillHeightMap(subsampling, vertSize, size, scale, false, region);
+  for (unsigned int i = 0; i < full.size(); ++i)
+    EXPECT_FLOAT_EQ(full[i], region[i]);
+
+  // The elevations don't depend on the tiles kept decoded
+  dem.SetCacheSize(0);
+  EXPECT_FLOAT_EQ(215.82324, dem.GetElevation(0, 0));
+  EXPECT_FLOAT_EQ(209.14784,
+      dem.GetElevation(dem.GetWidth() - 1, dem.GetHeight() - 1));
+}
+
 /////////////////////////////////////////////////
 TEST_F(DemTest, NegDem)
 {
@@ -0,0 +1,511 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Dem.hh"
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/HeightmapBuffer.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Magic number at the start of cache files.
+static const char kHeightmapCacheMagic[8] =
+    {'G', 'Z', 'H', 'E', 'I', 'G', 'H', 'T'};
+
+/// \brief Version of the cache file format.
+static const uint32_t kHeightmapCacheVersion = 1;
+
+/// \brief Written in native byte order, to detect cache files copied from
+/// a host with a different one.
+static const uint32_t kHeightmapCacheByteOrder = 0x01020304;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Header of a cache file. The heights follow the header, and the
+    /// key of the heights follows them.
+    struct HeightmapCacheHeader
+    {
+      /// \brief Magic number.
+      char magic[sizeof(kHeightmapCacheMagic)];
+
+      /// \brief Version of the file format.
+      uint32_t version;
+
+      /// \brief Byte order marker.
+      uint32_t byteOrder;
+
+      /// \brief Number of heights.
+      uint64_t count;
+
+      /// \brief Lowest height.
+      float min;
+
+      /// \brief Highest height.
+      float max;
+
+      /// \brief Length of the key.
+      uint32_t keySize;
+
+      /// \brief Padding, so that the heights are 8-byte aligned.
+      uint32_t padding;
+    };
+
+    /// \internal
+    /// \brief HeightmapBuffer private data.
+    class HeightmapBufferPrivate
+    {
+      /// \brief Heights of a buffer that is not mapped.
+      public: std::vector<float> heights;
+
+      /// \brief Mapped cache file, if any.
+      public: boost::interprocess::mapped_region region;
+
+      /// \brief Pointer to the first height.
+      public: const float *data = nullptr;
+
+      /// \brief Number of heights.
+      public: size_t count = 0;
+
+      /// \brief Lowest height.
+      public: float min = 0;
+
+      /// \brief Highest height.
+      public: float max = 0;
+
+      /// \brief Update data, count, min and max from heights.
+      public: void Update()
+      {
+        this->data = this->heights.data();
+        this->count = this->heights.size();
+        if (this->heights.empty())
+        {
+          this->min = this->max = 0;
+          return;
+        }
+        auto minMax = std::minmax_element(this->heights.begin(),
+            this->heights.end());
+        this->min = *minMax.first;
+        this->max = *minMax.second;
+      }
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the default cache directory.
+/// \return Path to the directory.
+static std::string defaultCachePath()
+{
+  const char *path = common::getEnv("GAZEBO_HEIGHTMAP_CACHE_PATH");
+  if (path)
+    return path;
+
+#ifndef _WIN32
+  const char *homePath = common::getEnv("HOME");
+#else
+  const char *homePath = common::getEnv("HOMEPATH");
+#endif
+  boost::filesystem::path cachePath;
+  if (homePath)
+    cachePath = boost::filesystem::path(homePath) / ".gazebo";
+  else
+    cachePath = boost::filesystem::path(SystemPaths::Instance()->TmpPath()) /
+      "gazebo";
+  return (cachePath / "heightmap_cache").string();
+}
+
+/// \brief Protects the cache directory, the shared buffers and the load
+/// mutexes.
+static std::mutex g_heightmapMutex;
+
+/// \brief Cache directory, empty if disabled.
+static std::string &cachePath()
+{
+  static std::string path = defaultCachePath();
+  return path;
+}
+
+/// \brief Buffers returned by Load that are still in use, by key.
+static std::map<std::string, std::weak_ptr<HeightmapBuffer>> g_heightmaps;
+
+/// \brief One mutex per key being sampled by Load.
+static std::map<std::string, std::shared_ptr<std::mutex>>
+    g_heightmapLoadMutexes;
+
+/////////////////////////////////////////////////
+HeightmapBuffer::HeightmapBuffer()
+  : dataPtr(new HeightmapBufferPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+HeightmapBuffer::HeightmapBuffer(std::vector<float> &&_heights)
+  : dataPtr(new HeightmapBufferPrivate)
+{
+  this->dataPtr->heights = std::move(_heights);
+  this->dataPtr->Update();
+}
+
+/////////////////////////////////////////////////
+HeightmapBuffer::~HeightmapBuffer()
+{
+}
+
+/////////////////////////////////////////////////
+const float *HeightmapBuffer::Data() const
+{
+  return this->dataPtr->data;
+}
+
+/////////////////////////////////////////////////
+size_t HeightmapBuffer::Count() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+float HeightmapBuffer::Min() const
+{
+  return this->dataPtr->min;
+}
+
+/////////////////////////////////////////////////
+float HeightmapBuffer::Max() const
+{
+  return this->dataPtr->max;
+}
+
+/////////////////////////////////////////////////
+bool HeightmapBuffer::Mapped() const
+{
+  return this->dataPtr->region.get_address() != nullptr;
+}
+
+/////////////////////////////////////////////////
+bool HeightmapBuffer::Set(const size_t _index, const float _height)
+{
+  if (this->Mapped() || _index >= this->dataPtr->heights.size())
+    return false;
+
+  const float old = this->dataPtr->heights[_index];
+  this->dataPtr->heights[_index] = _height;
+
+  // Only scan the heights again if the old value was an extreme
+  if (old == this->dataPtr->min || old == this->dataPtr->max)
+  {
+    this->dataPtr->Update();
+  }
+  else
+  {
+    this->dataPtr->min = std::min(this->dataPtr->min, _height);
+    this->dataPtr->max = std::max(this->dataPtr->max, _height);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void HeightmapBuffer::SetCachePath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(g_heightmapMutex);
+  cachePath() = _path;
+}
+
+/////////////////////////////////////////////////
+std::string HeightmapBuffer::CachePath()
+{
+  std::lock_guard<std::mutex> lock(g_heightmapMutex);
+  return cachePath();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the name of sampled heights, which changes with the terrain
+/// file and with any of the sampling parameters.
+/// \return The name.
+static std::string heightmapName(const HeightmapData &_data,
+    const std::string &_filename, const int _subSampling,
+    const unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY)
+{
+  std::ostringstream name;
+  name << std::setprecision(17) << _filename << '\n' << _subSampling << ' '
+       << _vertSize << ' ' << _size.X() << ' ' << _size.Y() << ' '
+       << _size.Z() << ' ' << _scale.X() << ' ' << _scale.Y() << ' '
+       << _scale.Z() << ' ' << _flipY;
+
+#ifdef HAVE_GDAL
+  // The full resolution region of a DEM changes the sampled heights
+  auto dem = dynamic_cast<const Dem *>(&_data);
+  ignition::math::Vector2d center;
+  double radius;
+  if (dem && dem->FullResolutionRegion(center, radius))
+    name << ' ' << center.X() << ' ' << center.Y() << ' ' << radius;
+#endif
+  return name.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the key of sampled heights, which also changes when the
+/// terrain file is modified.
+/// \param[in] _name Name of the heights.
+/// \param[in] _filename Path to the terrain file.
+/// \return The key, empty if the terrain file can't be read.
+static std::string heightmapKey(const std::string &_name,
+    const std::string &_filename)
+{
+  boost::system::error_code ec;
+  const uint64_t size = boost::filesystem::file_size(_filename, ec);
+  if (ec)
+    return std::string();
+  const int64_t time = boost::filesystem::last_write_time(_filename, ec);
+  if (ec)
+    return std::string();
+
+  return _name + '\n' + std::to_string(size) + ' ' + std::to_string(time);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the cache file of sampled heights. A modified terrain file
+/// keeps the same cache file, which is then replaced.
+/// \param[in] _dir Cache directory.
+/// \param[in] _name Name of the heights.
+/// \return Path to the cache file.
+static std::string cacheFilename(const std::string &_dir,
+    const std::string &_name)
+{
+  return (boost::filesystem::path(_dir) /
+      (common::get_sha1(_name) + ".gzheights")).string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write sampled heights to a cache file.
+/// \param[in] _buffer The heights.
+/// \param[in] _dir Cache directory.
+/// \param[in] _cacheFile Path to the cache file.
+/// \param[in] _key Key of the heights.
+/// \return True if the cache file was written.
+static bool saveCacheFile(const HeightmapBuffer &_buffer,
+    const std::string &_dir, const std::string &_cacheFile,
+    const std::string &_key)
+{
+  HeightmapCacheHeader header;
+  std::memcpy(header.magic, kHeightmapCacheMagic, sizeof(header.magic));
+  header.version = kHeightmapCacheVersion;
+  header.byteOrder = kHeightmapCacheByteOrder;
+  header.count = _buffer.Count();
+  header.min = _buffer.Min();
+  header.max = _buffer.Max();
+  header.keySize = static_cast<uint32_t>(_key.size());
+  header.padding = 0;
+
+  // Write to a temporary file first, so that other processes never map a
+  // partial cache file.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_dir, ec);
+  boost::filesystem::path tmpFile = _cacheFile +
+    boost::filesystem::unique_path(".%%%%%%%%.tmp").string();
+  {
+    std::ofstream out(tmpFile.string(), std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(_buffer.Data()),
+        _buffer.Count() * sizeof(float));
+    out.write(_key.data(), _key.size());
+    if (!out)
+    {
+      gzwarn << "Unable to write heightmap cache file[" << tmpFile.string()
+             << "]\n";
+      boost::filesystem::remove(tmpFile, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpFile, _cacheFile, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpFile, ec);
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+HeightmapBufferPtr HeightmapBuffer::Map(const std::string &_cacheFile,
+    const std::string &_key)
+{
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(_cacheFile, ec) ||
+      boost::filesystem::file_size(_cacheFile, ec) == 0 || ec)
+  {
+    return nullptr;
+  }
+
+  try
+  {
+    boost::interprocess::file_mapping file(_cacheFile.c_str(),
+        boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file,
+        boost::interprocess::read_only);
+
+    const char *address = static_cast<const char *>(region.get_address());
+    const size_t size = region.get_size();
+    HeightmapCacheHeader header;
+    if (size < sizeof(header))
+      return nullptr;
+    std::memcpy(&header, address, sizeof(header));
+
+    if (std::memcmp(header.magic, kHeightmapCacheMagic,
+          sizeof(header.magic)) != 0 ||
+        header.version != kHeightmapCacheVersion ||
+        header.byteOrder != kHeightmapCacheByteOrder ||
+        header.keySize != _key.size() ||
+        header.count > (size - sizeof(header)) / sizeof(float))
+    {
+      return nullptr;
+    }
+
+    const size_t heightsSize = header.count * sizeof(float);
+    if (size != sizeof(header) + heightsSize + header.keySize ||
+        _key.compare(0, _key.size(), address + sizeof(header) + heightsSize,
+          header.keySize) != 0)
+    {
+      return nullptr;
+    }
+
+    HeightmapBufferPtr buffer(new HeightmapBuffer);
+    buffer->dataPtr->data =
+      reinterpret_cast<const float *>(address + sizeof(header));
+    buffer->dataPtr->count = header.count;
+    buffer->dataPtr->min = header.min;
+    buffer->dataPtr->max = header.max;
+    buffer->dataPtr->region = std::move(region);
+    return buffer;
+  }
+  catch(boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to map heightmap cache file[" << _cacheFile << "]: "
+           << _e.what() << "\n";
+    return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+HeightmapBufferPtr HeightmapBuffer::Load(HeightmapData &_data,
+    const std::string &_filename, const int _subSampling,
+    const unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY)
+{
+  const std::string name = heightmapName(_data, _filename, _subSampling,
+      _vertSize, _size, _scale, _flipY);
+  const std::string key = heightmapKey(name, _filename);
+
+  // Share the heights with the other users of the same terrain. The
+  // caller holds g_heightmapMutex.
+  auto shared = [&key]() -> HeightmapBufferPtr
+  {
+    auto iter = g_heightmaps.find(key);
+    if (iter == g_heightmaps.end())
+      return nullptr;
+    HeightmapBufferPtr buffer = iter->second.lock();
+    if (!buffer)
+      g_heightmaps.erase(iter);
+    return buffer;
+  };
+
+  std::string dir;
+  std::shared_ptr<std::mutex> loadMutex;
+  {
+    std::lock_guard<std::mutex> lock(g_heightmapMutex);
+    dir = cachePath();
+    if (!key.empty())
+    {
+      HeightmapBufferPtr buffer = shared();
+      if (buffer)
+        return buffer;
+
+      auto &keyMutex = g_heightmapLoadMutexes[key];
+      if (!keyMutex)
+        keyMutex = std::make_shared<std::mutex>();
+      loadMutex = keyMutex;
+    }
+  }
+
+  // Sampling happens without g_heightmapMutex, so that different terrains
+  // load in parallel while each one is sampled once.
+  std::unique_lock<std::mutex> loadLock;
+  if (loadMutex)
+  {
+    loadLock = std::unique_lock<std::mutex>(*loadMutex);
+    std::lock_guard<std::mutex> lock(g_heightmapMutex);
+    HeightmapBufferPtr buffer = shared();
+    if (buffer)
+      return buffer;
+  }
+
+  std::string cacheFile;
+  HeightmapBufferPtr buffer;
+  if (!key.empty() && !dir.empty())
+  {
+    cacheFile = cacheFilename(dir, name);
+    buffer = Map(cacheFile, key);
+  }
+
+  if (!buffer)
+  {
+    std::vector<float> heights;
+    _data.FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+        heights);
+    buffer.reset(new HeightmapBuffer(std::move(heights)));
+
+    // Map the saved heights, so that other processes share the same pages
+    if (!cacheFile.empty() && saveCacheFile(*buffer, dir, cacheFile, key))
+    {
+      HeightmapBufferPtr mapped = Map(cacheFile, key);
+      if (mapped)
+        buffer = mapped;
+    }
+  }
+
+  if (!key.empty())
+  {
+    std::lock_guard<std::mutex> lock(g_heightmapMutex);
+    g_heightmaps[key] = buffer;
+    g_heightmapLoadMutexes.erase(key);
+  }
+  return buffer;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_HEIGHTMAPBUFFER_HH_
+#define GAZEBO_COMMON_HEIGHTMAPBUFFER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations
+    class HeightmapBuffer;
+    class HeightmapBufferPrivate;
+    class HeightmapData;
+
+    /// \def HeightmapBufferPtr
+    /// \brief Shared pointer to a HeightmapBuffer
+    typedef std::shared_ptr<HeightmapBuffer> HeightmapBufferPtr;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class HeightmapBuffer HeightmapBuffer.hh common/common.hh
+    /// \brief The sampled heights of a terrain, as filled by
+    /// HeightmapData::FillHeightMap.
+    ///
+    /// Buffers returned by Load are shared by every user of the same terrain
+    /// with the same sampling parameters and full resolution region in the
+    /// process, and must not be modified. They are stored in an on-disk
+    /// cache, and memory mapped from it, so that other processes share the same pages and don't sample the
+    /// terrain again. The cache directory is the
+    /// GAZEBO_HEIGHTMAP_CACHE_PATH environment variable if set, otherwise
+    /// ~/.gazebo/heightmap_cache.
+    class GZ_COMMON_VISIBLE HeightmapBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _heights The heights, moved into the buffer.
+      public: explicit HeightmapBuffer(std::vector<float> &&_heights);
+
+      /// \brief Destructor.
+      public: virtual ~HeightmapBuffer();
+
+      /// \brief Get the heights.
+      /// \return Pointer to the first height.
+      public: const float *Data() const;
+
+      /// \brief Get the number of heights.
+      /// \return Number of heights.
+      public: size_t Count() const;
+
+      /// \brief Get the lowest height.
+      /// \return The lowest height, or 0 if there are no heights.
+      public: float Min() const;
+
+      /// \brief Get the highest height.
+      /// \return The highest height, or 0 if there are no heights.
+      public: float Max() const;
+
+      /// \brief Get whether the heights are memory mapped from a cache file.
+      /// \return True if the heights are mapped.
+      public: bool Mapped() const;
+
+      /// \brief Set a height. Only buffers created with the constructor can
+      /// be modified.
+      /// \param[in] _index Index of the height.
+      /// \param[in] _height New height.
+      /// \return False if the buffer is mapped or _index is out of range.
+      public: bool Set(const size_t _index, const float _height);
+
+      /// \brief Get the sampled heights of a terrain. The heights are shared
+      /// with the other callers using the same terrain file and parameters,
+      /// read from the cache, or sampled with _data and then cached.
+      /// \param[in] _data The decoded terrain.
+      /// \param[in] _filename Full path to the terrain file.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row.
+      /// \param[in] _size Real dimensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order of the rows.
+      /// \return The heights, which must not be modified.
+      public: static HeightmapBufferPtr Load(HeightmapData &_data,
+                  const std::string &_filename, const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, const bool _flipY);
+
+      /// \brief Set the cache directory.
+      /// \param[in] _path Path to the directory, created if needed. An empty
+      /// path disables the cache.
+      public: static void SetCachePath(const std::string &_path);
+
+      /// \brief Get the cache directory.
+      /// \return Path to the directory, empty if the cache is disabled.
+      public: static std::string CachePath();
+
+      /// \brief Constructor for buffers mapped from a cache file.
+      private: HeightmapBuffer();
+
+      /// \brief Map a cache file.
+      /// \param[in] _cacheFile Path to the cache file.
+      /// \param[in] _key Key of the heights, stored in the cache file.
+      /// \return The mapped heights, null if the cache file is missing or
+      /// stale.
+      private: static HeightmapBufferPtr Map(const std::string &_cacheFile,
+                   const std::string &_key);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapBufferPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
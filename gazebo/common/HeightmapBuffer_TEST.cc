@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/HeightmapBuffer.hh"
+#include "gazebo/common/HeightmapData.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+/// \brief Terrain whose heights are the index of each point.
+class CountingHeightmap : public common::HeightmapData
+{
+  // Documentation inherited
+  public: virtual void FillHeightMap(int /*_subSampling*/,
+              unsigned int _vertSize,
+              const ignition::math::Vector3d &/*_size*/,
+              const ignition::math::Vector3d &_scale, bool /*_flipY*/,
+              std::vector<float> &_heights)
+          {
+            ++this->fillCount;
+            _heights.resize(_vertSize * _vertSize);
+            for (unsigned int i = 0; i < _heights.size(); ++i)
+              _heights[i] = i * _scale.Z();
+          }
+
+  // Documentation inherited
+  public: virtual unsigned int GetHeight() const {return 3;}
+
+  // Documentation inherited
+  public: virtual unsigned int GetWidth() const {return 3;}
+
+  // Documentation inherited
+  public: virtual float GetMaxElevation() const {return 8;}
+
+  /// \brief Number of calls to FillHeightMap.
+  public: int fillCount = 0;
+};
+
+class HeightmapBuffer : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary directory with a terrain file, and use it as
+  /// the cache directory.
+  public: void SetUp()
+          {
+            gazebo::testing::AutoLogFixture::SetUp();
+            this->dir = boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("heightmap_cache_%%%%%%%%");
+            boost::filesystem::create_directories(this->dir);
+            this->filename = (this->dir / "terrain.png").string();
+            std::ofstream out(this->filename);
+            out << "terrain";
+            this->cachePath = common::HeightmapBuffer::CachePath();
+            common::HeightmapBuffer::SetCachePath(
+                (this->dir / "cache").string());
+          }
+
+  /// \brief Remove the temporary directory.
+  public: void TearDown()
+          {
+            common::HeightmapBuffer::SetCachePath(this->cachePath);
+            boost::filesystem::remove_all(this->dir);
+            gazebo::testing::AutoLogFixture::TearDown();
+          }
+
+  /// \brief Load the heights of the terrain file.
+  /// \param[in] _data The terrain.
+  /// \param[in] _vertSize Number of points per row.
+  /// \return The heights.
+  public: common::HeightmapBufferPtr Load(common::HeightmapData &_data,
+              const unsigned int _vertSize = 3)
+          {
+            return common::HeightmapBuffer::Load(_data, this->filename, 1,
+                _vertSize, ignition::math::Vector3d(10, 10, 2),
+                ignition::math::Vector3d(1, 1, 0.5), false);
+          }
+
+  /// \brief Temporary directory.
+  public: boost::filesystem::path dir;
+
+  /// \brief Path to the terrain file.
+  public: std::string filename;
+
+  /// \brief Cache directory before the test.
+  public: std::string cachePath;
+};
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapBuffer, Heights)
+{
+  common::HeightmapBuffer buffer(std::vector<float>{3, -1, 2, 5});
+  EXPECT_FALSE(buffer.Mapped());
+  ASSERT_EQ(4u, buffer.Count());
+  EXPECT_FLOAT_EQ(-1, buffer.Min());
+  EXPECT_FLOAT_EQ(5, buffer.Max());
+
+  EXPECT_TRUE(buffer.Set(1, 0));
+  EXPECT_FLOAT_EQ(0, buffer.Data()[1]);
+  EXPECT_FLOAT_EQ(0, buffer.Min());
+  EXPECT_TRUE(buffer.Set(2, 7));
+  EXPECT_FLOAT_EQ(7, buffer.Max());
+  EXPECT_FALSE(buffer.Set(4, 1));
+
+  common::HeightmapBuffer empty(std::vector<float>{});
+  EXPECT_EQ(0u, empty.Count());
+  EXPECT_FLOAT_EQ(0, empty.Min());
+  EXPECT_FLOAT_EQ(0, empty.Max());
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapBuffer, Shared)
+{
+  CountingHeightmap data;
+  common::HeightmapBufferPtr first = this->Load(data);
+  ASSERT_TRUE(first != nullptr);
+  EXPECT_EQ(1, data.fillCount);
+  EXPECT_TRUE(first->Mapped());
+  ASSERT_EQ(9u, first->Count());
+  EXPECT_FLOAT_EQ(0, first->Min());
+  EXPECT_FLOAT_EQ(4, first->Max());
+  EXPECT_FALSE(first->Set(0, 1));
+
+  // The same terrain is shared while in use
+  common::HeightmapBufferPtr second = this->Load(data);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(1, data.fillCount);
+
+  // Other parameters sample the terrain again
+  common::HeightmapBufferPtr larger = this->Load(data, 5);
+  ASSERT_TRUE(larger != nullptr);
+  EXPECT_EQ(2, data.fillCount);
+  EXPECT_EQ(25u, larger->Count());
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapBuffer, Cached)
+{
+  CountingHeightmap data;
+  std::vector<float> heights;
+  {
+    common::HeightmapBufferPtr buffer = this->Load(data);
+    ASSERT_TRUE(buffer != nullptr);
+    heights.assign(buffer->Data(), buffer->Data() + buffer->Count());
+  }
+  EXPECT_EQ(1, data.fillCount);
+
+  // Once released, the heights are mapped from the cache file
+  common::HeightmapBufferPtr buffer = this->Load(data);
+  ASSERT_TRUE(buffer != nullptr);
+  EXPECT_EQ(1, data.fillCount);
+  EXPECT_TRUE(buffer->Mapped());
+  ASSERT_EQ(heights.size(), buffer->Count());
+  for (unsigned int i = 0; i < heights.size(); ++i)
+    EXPECT_FLOAT_EQ(heights[i], buffer->Data()[i]);
+  buffer.reset();
+
+  // Modifying the terrain file replaces the cache file
+  boost::filesystem::last_write_time(this->filename,
+      boost::filesystem::last_write_time(this->filename) + 10);
+  buffer = this->Load(data);
+  ASSERT_TRUE(buffer != nullptr);
+  EXPECT_EQ(2, data.fillCount);
+  buffer.reset();
+
+  // A corrupt cache file is ignored
+  for (auto &entry : boost::filesystem::directory_iterator(this->dir / "cache"))
+  {
+    std::ofstream out(entry.path().string(),
+        std::ios::binary | std::ios::trunc);
+    out << "corrupt";
+  }
+  buffer = this->Load(data);
+  ASSERT_TRUE(buffer != nullptr);
+  EXPECT_EQ(3, data.fillCount);
+  EXPECT_EQ(9u, buffer->Count());
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapBuffer, Disabled)
+{
+  common::HeightmapBuffer::SetCachePath("");
+  EXPECT_TRUE(common::HeightmapBuffer::CachePath().empty());
+
+  CountingHeightmap data;
+  common::HeightmapBufferPtr buffer = this->Load(data);
+  ASSERT_TRUE(buffer != nullptr);
+  EXPECT_FALSE(buffer->Mapped());
+  EXPECT_EQ(9u, buffer->Count());
+  EXPECT_FALSE(boost::filesystem::exists(this->dir / "cache"));
+
+  // A missing terrain file still has heights, which aren't shared
+  common::HeightmapBufferPtr missing = common::HeightmapBuffer::Load(data,
+      (this->dir / "missing.png").string(), 1, 3,
+      ignition::math::Vector3d(10, 10, 2),
+      ignition::math::Vector3d(1, 1, 0.5), false);
+  ASSERT_TRUE(missing != nullptr);
+  EXPECT_EQ(9u, missing->Count());
+  EXPECT_EQ(2, data.fillCount);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 
 #include <boost/filesystem.hpp>
 #include <algorithm>
+#include <atomic>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/SystemPaths.hh"
@@ -26,6 +27,10 @@
 using namespace gazebo;
 using namespace common;
 
+/// \brief Number of materials created, used to name them. Materials are
+/// created by meshes loaded in parallel, so Material::counter isn't used.
+/// TODO: Replace Material::counter when porting forward
+static std::atomic<unsigned int> g_materialCounter{0};
 
 unsigned int Material::counter = 0;
 
@@ -37,7 +42,8 @@ std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
 //////////////////////////////////////////////////
 Material::Material()
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(
+      g_materialCounter++);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient.Set(0.4, 0.4, 0.4, 1);
@@ -49,7 +55,8 @@ Material::Material()
 //////////////////////////////////////////////////
 Material::Material(const ignition::math::Color &_clr)
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(
+      g_materialCounter++);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient = _clr;
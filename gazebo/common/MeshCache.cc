@@ -0,0 +1,682 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Magic number at the start of cache files.
+static const char kMeshCacheMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', 'C', 0};
+
+/// \brief Version of the cache file format.
+static const uint32_t kMeshCacheVersion = 2;
+
+/// \brief Written in native byte order, to detect cache files copied from
+/// a host with a different one.
+static const uint32_t kMeshCacheByteOrder = 0x01020304;
+
+/// \brief Offset of the modification time of the mesh file in a cache
+/// file, which is updated in place.
+static const size_t kMeshCacheTimeOffset = 16;
+
+/// \brief Length of a SHA1 hash string.
+static const size_t kMeshCacheHashSize = 40;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief MeshCache private data.
+    class MeshCachePrivate
+    {
+      /// \brief Cache directory, empty if disabled.
+      public: std::string path;
+    };
+
+    /// \internal
+    /// \brief Appends values to a cache file buffer.
+    class MeshCacheWriter
+    {
+      /// \brief Append a value.
+      /// \param[in] _value The value.
+      public: template<typename T>
+              void Write(const T &_value)
+              {
+                this->data.append(reinterpret_cast<const char *>(&_value),
+                    sizeof(T));
+              }
+
+      /// \brief Append a length prefixed string.
+      /// \param[in] _value The string.
+      public: void WriteString(const std::string &_value)
+              {
+                this->Write(static_cast<uint32_t>(_value.size()));
+                this->data.append(_value);
+              }
+
+      /// \brief The buffer.
+      public: std::string data;
+    };
+
+    /// \internal
+    /// \brief Reads values from a cache file, checking bounds.
+    class MeshCacheReader
+    {
+      /// \brief Constructor.
+      /// \param[in] _data Start of the data.
+      /// \param[in] _size Size of the data.
+      public: MeshCacheReader(const char *_data, const size_t _size)
+              : data(_data), size(_size)
+              {
+              }
+
+      /// \brief Read a value.
+      /// \param[out] _value The value.
+      /// \return False if the data is too short.
+      public: template<typename T>
+              bool Read(T &_value)
+              {
+                if (this->size - this->pos < sizeof(T))
+                  return false;
+                std::memcpy(&_value, this->data + this->pos, sizeof(T));
+                this->pos += sizeof(T);
+                return true;
+              }
+
+      /// \brief Read a length prefixed string.
+      /// \param[out] _value The string.
+      /// \return False if the data is too short.
+      public: bool ReadString(std::string &_value)
+              {
+                uint32_t len;
+                if (!this->Read(len) || this->size - this->pos < len)
+                  return false;
+                _value.assign(this->data + this->pos, len);
+                this->pos += len;
+                return true;
+              }
+
+      /// \brief Check that an array of values fits in the data.
+      /// \param[in] _count Number of values.
+      /// \param[in] _valueSize Size of a value.
+      /// \return False if the data is too short.
+      public: bool Fits(const uint64_t _count, const size_t _valueSize) const
+              {
+                return _count <= (this->size - this->pos) / _valueSize;
+              }
+
+      /// \brief Start of the data.
+      private: const char *data;
+
+      /// \brief Size of the data.
+      private: size_t size;
+
+      /// \brief Read position.
+      private: size_t pos = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the size and modification time of a file.
+/// \param[in] _filename Path to the file.
+/// \param[out] _size Size of the file.
+/// \param[out] _time Modification time of the file.
+/// \return False if the file can't be read.
+static bool fileStamp(const std::string &_filename, uint64_t &_size,
+    int64_t &_time)
+{
+  boost::system::error_code ec;
+  _size = boost::filesystem::file_size(_filename, ec);
+  if (ec)
+    return false;
+  _time = boost::filesystem::last_write_time(_filename, ec);
+  return !ec;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the hash of the content of a file.
+/// \param[in] _filename Path to the file.
+/// \return The SHA1 hash, empty if the file can't be read.
+static std::string fileHash(const std::string &_filename)
+{
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return std::string();
+
+  std::string content((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  return common::get_sha1(content);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the material files referenced by an OBJ file with "mtllib".
+/// \param[in] _filename Full path to the mesh file.
+/// \return Full paths to the material files, empty for other formats.
+static std::vector<std::string> materialFiles(const std::string &_filename)
+{
+  std::vector<std::string> files;
+
+  std::string extension = boost::filesystem::path(_filename).extension()
+      .string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      ::tolower);
+  if (extension != ".obj")
+    return files;
+
+  std::ifstream in(_filename);
+  boost::filesystem::path dir = boost::filesystem::path(_filename)
+      .parent_path();
+  std::string line;
+  while (std::getline(in, line))
+  {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line.compare(start, 6, "mtllib") != 0 ||
+        start + 6 >= line.size() || !std::isspace(line[start + 6]))
+    {
+      continue;
+    }
+
+    // Several files may be listed, with spaces in names escaped as in
+    // the OBJ loader.
+    std::string name;
+    for (size_t i = start + 6; i <= line.size(); ++i)
+    {
+      char c = i < line.size() ? line[i] : ' ';
+      if (c == '\\' && i + 1 < line.size() && line[i + 1] == ' ')
+      {
+        name += ' ';
+        ++i;
+      }
+      else if (std::isspace(c))
+      {
+        if (!name.empty())
+          files.push_back((dir / name).string());
+        name.clear();
+      }
+      else
+      {
+        name += c;
+      }
+    }
+  }
+
+  return files;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a color.
+/// \param[in] _writer The writer.
+/// \param[in] _color The color.
+static void writeColor(MeshCacheWriter &_writer,
+    const ignition::math::Color &_color)
+{
+  _writer.Write(_color.R());
+  _writer.Write(_color.G());
+  _writer.Write(_color.B());
+  _writer.Write(_color.A());
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a color.
+/// \param[in] _reader The reader.
+/// \param[out] _color The color.
+/// \return False if the data is too short.
+static bool readColor(MeshCacheReader &_reader, ignition::math::Color &_color)
+{
+  float r, g, b, a;
+  if (!_reader.Read(r) || !_reader.Read(g) || !_reader.Read(b) ||
+      !_reader.Read(a))
+  {
+    return false;
+  }
+  _color.Set(r, g, b, a);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Decode a mesh.
+/// \param[in] _reader Reader positioned after the cache file header.
+/// \return The mesh, nullptr if the data is invalid.
+static Mesh *readMesh(MeshCacheReader &_reader)
+{
+  std::unique_ptr<Mesh> mesh(new Mesh());
+
+  std::string path;
+  uint32_t materialCount;
+  if (!_reader.ReadString(path) || !_reader.Read(materialCount))
+    return nullptr;
+  mesh->SetPath(path);
+
+  for (uint32_t i = 0; i < materialCount; ++i)
+  {
+    std::string texture;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, srcFactor, dstFactor, pointSize;
+    uint32_t blendMode, shadeMode;
+    uint8_t depthWrite, lighting;
+    if (!_reader.ReadString(texture) ||
+        !readColor(_reader, ambient) || !readColor(_reader, diffuse) ||
+        !readColor(_reader, specular) || !readColor(_reader, emissive) ||
+        !_reader.Read(transparency) || !_reader.Read(shininess) ||
+        !_reader.Read(srcFactor) || !_reader.Read(dstFactor) ||
+        !_reader.Read(blendMode) || !_reader.Read(shadeMode) ||
+        !_reader.Read(pointSize) || !_reader.Read(depthWrite) ||
+        !_reader.Read(lighting) ||
+        blendMode >= Material::BLEND_COUNT ||
+        shadeMode >= Material::SHADE_COUNT)
+    {
+      return nullptr;
+    }
+
+    Material *material = new Material();
+    mesh->AddMaterial(material);
+    if (!texture.empty())
+      material->SetTextureImage(texture);
+    material->SetAmbient(ambient);
+    material->SetDiffuse(diffuse);
+    material->SetSpecular(specular);
+    material->SetEmissive(emissive);
+    material->SetTransparency(transparency);
+    material->SetShininess(shininess);
+    material->SetBlendFactors(srcFactor, dstFactor);
+    material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    material->SetPointSize(pointSize);
+    material->SetDepthWrite(depthWrite != 0);
+    material->SetLighting(lighting != 0);
+  }
+
+  uint32_t subMeshCount;
+  if (!_reader.Read(subMeshCount))
+    return nullptr;
+
+  for (uint32_t i = 0; i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType, vertexCount, normalCount, texCoordCount,
+             indexCount;
+    int32_t materialIndex;
+    if (!_reader.ReadString(name) || !_reader.Read(primitiveType) ||
+        !_reader.Read(materialIndex) || !_reader.Read(vertexCount) ||
+        !_reader.Read(normalCount) || !_reader.Read(texCoordCount) ||
+        !_reader.Read(indexCount) ||
+        primitiveType > SubMesh::TRISTRIPS ||
+        !_reader.Fits(uint64_t(vertexCount) * 3 + uint64_t(normalCount) * 3 +
+          uint64_t(texCoordCount) * 2, sizeof(double)))
+    {
+      return nullptr;
+    }
+
+    SubMesh *subMesh = new SubMesh();
+    mesh->AddSubMesh(subMesh);
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(primitiveType));
+    subMesh->SetMaterialIndex(materialIndex);
+
+    double x, y, z;
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+      _reader.Read(x);
+      _reader.Read(y);
+      _reader.Read(z);
+      subMesh->SetVertex(v, ignition::math::Vector3d(x, y, z));
+    }
+
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t n = 0; n < normalCount; ++n)
+    {
+      _reader.Read(x);
+      _reader.Read(y);
+      _reader.Read(z);
+      subMesh->SetNormal(n, ignition::math::Vector3d(x, y, z));
+    }
+
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t t = 0; t < texCoordCount; ++t)
+    {
+      _reader.Read(x);
+      _reader.Read(y);
+      subMesh->SetTexCoord(t, ignition::math::Vector2d(x, y));
+    }
+
+    if (!_reader.Fits(indexCount, sizeof(uint32_t)))
+      return nullptr;
+
+    uint32_t index;
+    for (uint32_t n = 0; n < indexCount; ++n)
+    {
+      _reader.Read(index);
+      subMesh->AddIndex(index);
+    }
+  }
+
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache()
+  : dataPtr(new MeshCachePrivate)
+{
+  const char *path = common::getEnv("GAZEBO_MESH_CACHE_PATH");
+  if (path)
+  {
+    this->dataPtr->path = path;
+    return;
+  }
+
+#ifndef _WIN32
+  const char *homePath = common::getEnv("HOME");
+#else
+  const char *homePath = common::getEnv("HOMEPATH");
+#endif
+  boost::filesystem::path cachePath;
+  if (homePath)
+    cachePath = boost::filesystem::path(homePath) / ".gazebo";
+  else
+    cachePath = boost::filesystem::path(SystemPaths::Instance()->TmpPath()) /
+      "gazebo";
+  this->dataPtr->path = (cachePath / "mesh_cache").string();
+}
+
+/////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+/////////////////////////////////////////////////
+void MeshCache::SetPath(const std::string &_path)
+{
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Cacheable(const Mesh *_mesh)
+{
+  return _mesh && !_mesh->HasSkeleton();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the cache file of a mesh file.
+/// \param[in] _dir Cache directory.
+/// \param[in] _filename Full path to the mesh file.
+/// \return Path to the cache file.
+static std::string cacheFilename(const std::string &_dir,
+    const std::string &_filename)
+{
+  return (boost::filesystem::path(_dir) /
+      (common::get_sha1(_filename) + ".gzmesh")).string();
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename) const
+{
+  if (this->dataPtr->path.empty())
+    return nullptr;
+
+  uint64_t size;
+  int64_t time;
+  if (!fileStamp(_filename, size, time))
+    return nullptr;
+
+  std::string cacheFile = cacheFilename(this->dataPtr->path, _filename);
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(cacheFile, ec) ||
+      boost::filesystem::file_size(cacheFile, ec) == 0 || ec)
+  {
+    return nullptr;
+  }
+
+  Mesh *mesh = nullptr;
+  bool touch = false;
+  try
+  {
+    boost::interprocess::file_mapping file(cacheFile.c_str(),
+        boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file,
+        boost::interprocess::read_only);
+    MeshCacheReader reader(static_cast<const char *>(region.get_address()),
+        region.get_size());
+
+    char magic[sizeof(kMeshCacheMagic)];
+    uint32_t version, byteOrder;
+    int64_t cachedTime;
+    uint64_t cachedSize;
+    char hash[kMeshCacheHashSize];
+    std::string cachedFilename;
+    if (!reader.Read(magic) ||
+        std::memcmp(magic, kMeshCacheMagic, sizeof(magic)) != 0 ||
+        !reader.Read(version) || version != kMeshCacheVersion ||
+        !reader.Read(byteOrder) || byteOrder != kMeshCacheByteOrder ||
+        !reader.Read(cachedTime) || !reader.Read(cachedSize) ||
+        !reader.Read(hash) || !reader.ReadString(cachedFilename) ||
+        cachedFilename != _filename || cachedSize != size)
+    {
+      return nullptr;
+    }
+
+    // Material files are only compared by size and modification time
+    uint32_t materialCount;
+    if (!reader.Read(materialCount))
+      return nullptr;
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+      std::string materialFile;
+      uint64_t materialSize, cachedMaterialSize;
+      int64_t materialTime, cachedMaterialTime;
+      if (!reader.ReadString(materialFile) ||
+          !reader.Read(cachedMaterialSize) || !reader.Read(cachedMaterialTime))
+      {
+        return nullptr;
+      }
+      if (!fileStamp(materialFile, materialSize, materialTime))
+        materialSize = materialTime = 0;
+      if (materialSize != cachedMaterialSize ||
+          materialTime != cachedMaterialTime)
+      {
+        return nullptr;
+      }
+    }
+
+    // The file may have been touched or copied without being modified
+    if (cachedTime != time)
+    {
+      if (fileHash(_filename) != std::string(hash, kMeshCacheHashSize))
+        return nullptr;
+      touch = true;
+    }
+
+    mesh = readMesh(reader);
+  }
+  catch(const boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to read mesh cache file[" << cacheFile << "]: "
+           << _e.what() << "\n";
+    return nullptr;
+  }
+
+  if (!mesh)
+  {
+    gzwarn << "Invalid mesh cache file[" << cacheFile << "]\n";
+    return nullptr;
+  }
+
+  if (touch)
+  {
+    std::fstream out(cacheFile,
+        std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(kMeshCacheTimeOffset);
+    out.write(reinterpret_cast<const char *>(&time), sizeof(time));
+  }
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const Mesh *_mesh, const std::string &_filename) const
+{
+  if (this->dataPtr->path.empty() || !Cacheable(_mesh))
+    return false;
+
+  uint64_t size;
+  int64_t time;
+  if (!fileStamp(_filename, size, time))
+    return false;
+
+  std::string hash = fileHash(_filename);
+  if (hash.size() != kMeshCacheHashSize)
+    return false;
+
+  MeshCacheWriter writer;
+  writer.data.append(kMeshCacheMagic, sizeof(kMeshCacheMagic));
+  writer.Write(kMeshCacheVersion);
+  writer.Write(kMeshCacheByteOrder);
+  writer.Write(time);
+  writer.Write(size);
+  writer.data.append(hash);
+  writer.WriteString(_filename);
+
+  std::vector<std::string> materials = materialFiles(_filename);
+  writer.Write(static_cast<uint32_t>(materials.size()));
+  for (auto const &materialFile : materials)
+  {
+    uint64_t materialSize;
+    int64_t materialTime;
+    if (!fileStamp(materialFile, materialSize, materialTime))
+      materialSize = materialTime = 0;
+    writer.WriteString(materialFile);
+    writer.Write(materialSize);
+    writer.Write(materialTime);
+  }
+
+  writer.WriteString(_mesh->GetPath());
+  writer.Write(static_cast<uint32_t>(_mesh->GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *material = _mesh->GetMaterial(i);
+    double srcFactor, dstFactor;
+    material->GetBlendFactors(srcFactor, dstFactor);
+
+    writer.WriteString(material->GetTextureImage());
+    writeColor(writer, material->Ambient());
+    writeColor(writer, material->Diffuse());
+    writeColor(writer, material->Specular());
+    writeColor(writer, material->Emissive());
+    writer.Write(material->GetTransparency());
+    writer.Write(material->GetShininess());
+    writer.Write(srcFactor);
+    writer.Write(dstFactor);
+    writer.Write(static_cast<uint32_t>(material->GetBlendMode()));
+    writer.Write(static_cast<uint32_t>(material->GetShadeMode()));
+    writer.Write(material->GetPointSize());
+    writer.Write(static_cast<uint8_t>(material->GetDepthWrite()));
+    writer.Write(static_cast<uint8_t>(material->GetLighting()));
+  }
+
+  writer.Write(static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    writer.WriteString(subMesh->GetName());
+    writer.Write(static_cast<uint32_t>(subMesh->GetPrimitiveType()));
+    writer.Write(static_cast<int32_t>(subMesh->GetMaterialIndex()));
+    writer.Write(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    writer.Write(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    writer.Write(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    writer.Write(static_cast<uint32_t>(subMesh->GetIndexCount()));
+
+    for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+    {
+      ignition::math::Vector3d vertex = subMesh->Vertex(v);
+      writer.Write(vertex.X());
+      writer.Write(vertex.Y());
+      writer.Write(vertex.Z());
+    }
+    for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+    {
+      ignition::math::Vector3d normal = subMesh->Normal(n);
+      writer.Write(normal.X());
+      writer.Write(normal.Y());
+      writer.Write(normal.Z());
+    }
+    for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+    {
+      ignition::math::Vector2d texCoord = subMesh->TexCoord(t);
+      writer.Write(texCoord.X());
+      writer.Write(texCoord.Y());
+    }
+    for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+      writer.Write(static_cast<uint32_t>(subMesh->GetIndex(n)));
+  }
+
+  // Write to a temporary file first, so that other processes never read a
+  // partial cache file.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dataPtr->path, ec);
+  std::string cacheFile = cacheFilename(this->dataPtr->path, _filename);
+  boost::filesystem::path tmpFile = cacheFile +
+    boost::filesystem::unique_path(".%%%%%%%%.tmp").string();
+  {
+    std::ofstream out(tmpFile.string(), std::ios::binary);
+    out.write(writer.data.data(), writer.data.size());
+    if (!out)
+    {
+      gzwarn << "Unable to write mesh cache file[" << tmpFile.string()
+             << "]\n";
+      boost::filesystem::remove(tmpFile, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpFile, cacheFile, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpFile, ec);
+    return false;
+  }
+
+  return true;
+}
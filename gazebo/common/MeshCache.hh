@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations
+    class Mesh;
+    class MeshCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief An on-disk cache of meshes in a compact binary format, so
+    /// that mesh files don't have to be parsed again.
+    ///
+    /// Each mesh file has one cache file, named after the hash of its path.
+    /// A cache file is valid as long as the size and modification time of
+    /// the mesh file don't change. When only the modification time
+    /// changes, the hash of the mesh file content is compared to the one
+    /// stored in the cache file. The cache file of an OBJ file is also out
+    /// of date when the size or modification time of one of its material
+    /// files changes. Cache files are memory mapped to be read.
+    /// Meshes with a skeleton are not cached.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor. The cache directory is the
+      /// GAZEBO_MESH_CACHE_PATH environment variable if set, otherwise
+      /// ~/.gazebo/mesh_cache.
+      public: MeshCache();
+
+      /// \brief Destructor.
+      public: virtual ~MeshCache();
+
+      /// \brief Set the cache directory.
+      /// \param[in] _path Path to the directory, created if needed. An empty
+      /// path disables the cache.
+      public: void SetPath(const std::string &_path);
+
+      /// \brief Get the cache directory.
+      /// \return Path to the directory, empty if the cache is disabled.
+      public: std::string Path() const;
+
+      /// \brief Load a mesh from the cache.
+      /// \param[in] _filename Full path to the mesh file.
+      /// \return The mesh, or nullptr if it is not cached or the cache
+      /// file is out of date. The caller owns the mesh.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Store a mesh in the cache.
+      /// \param[in] _mesh The mesh, as loaded from _filename.
+      /// \param[in] _filename Full path to the mesh file.
+      /// \return True if the mesh was stored.
+      public: bool Save(const Mesh *_mesh, const std::string &_filename) const;
+
+      /// \brief Get whether a mesh can be stored in the cache.
+      /// \param[in] _mesh The mesh.
+      /// \return False if the mesh has a skeleton.
+      public: static bool Cacheable(const Mesh *_mesh);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/Skeleton.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary directory with a mesh file.
+  public: void SetUp()
+          {
+            gazebo::testing::AutoLogFixture::SetUp();
+            this->dir = boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("mesh_cache_%%%%%%%%");
+            boost::filesystem::create_directories(this->dir);
+            this->filename = (this->dir / "box.dae").string();
+            this->WriteMeshFile("<COLLADA/>");
+          }
+
+  /// \brief Remove the temporary directory.
+  public: void TearDown()
+          {
+            boost::filesystem::remove_all(this->dir);
+            gazebo::testing::AutoLogFixture::TearDown();
+          }
+
+  /// \brief Write the mesh file. The content doesn't matter to the cache.
+  /// \param[in] _content Content of the file.
+  public: void WriteMeshFile(const std::string &_content)
+          {
+            std::ofstream out(this->filename);
+            out << _content;
+          }
+
+  /// \brief Temporary directory.
+  public: boost::filesystem::path dir;
+
+  /// \brief Path to the mesh file.
+  public: std::string filename;
+};
+
+/////////////////////////////////////////////////
+/// \brief Create a mesh with two submeshes and a material.
+common::Mesh *createMesh()
+{
+  common::Mesh *mesh = new common::Mesh();
+  mesh->SetPath("/tmp/meshes");
+
+  common::Material *material = new common::Material();
+  material->SetTextureImage("/tmp/meshes/texture.png");
+  material->SetDiffuse(ignition::math::Color(0.1f, 0.2f, 0.3f, 0.4f));
+  material->SetTransparency(0.5);
+  material->SetBlendMode(common::Material::MODULATE);
+  material->SetLighting(false);
+  mesh->AddMaterial(material);
+
+  common::SubMesh *triangles = new common::SubMesh();
+  triangles->SetName("triangles");
+  triangles->SetMaterialIndex(0);
+  triangles->AddVertex(0, 0, 0);
+  triangles->AddVertex(1, 0, 0);
+  triangles->AddVertex(0, 1, 0.25);
+  triangles->AddNormal(0, 0, 1);
+  triangles->AddNormal(0, 0, 1);
+  triangles->AddNormal(0, 0.2, 0.9);
+  triangles->AddTexCoord(0, 0);
+  triangles->AddTexCoord(1, 0);
+  triangles->AddTexCoord(0, 1);
+  triangles->AddIndex(0);
+  triangles->AddIndex(1);
+  triangles->AddIndex(2);
+  mesh->AddSubMesh(triangles);
+
+  common::SubMesh *lines = new common::SubMesh();
+  lines->SetName("lines");
+  lines->SetPrimitiveType(common::SubMesh::LINES);
+  lines->AddVertex(-1, -2, -3);
+  lines->AddVertex(4, 5, 6);
+  lines->AddIndex(1);
+  lines->AddIndex(0);
+  mesh->AddSubMesh(lines);
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  common::MeshCache cache;
+  cache.SetPath((this->dir / "cache").string());
+  EXPECT_EQ((this->dir / "cache").string(), cache.Path());
+
+  // Nothing cached yet
+  EXPECT_TRUE(cache.Load(this->filename) == nullptr);
+
+  std::unique_ptr<common::Mesh> mesh(createMesh());
+  EXPECT_TRUE(cache.Save(mesh.get(), this->filename));
+  EXPECT_TRUE(boost::filesystem::is_directory(this->dir / "cache"));
+
+  std::unique_ptr<common::Mesh> loaded(cache.Load(this->filename));
+  ASSERT_TRUE(loaded != nullptr);
+  EXPECT_EQ(mesh->GetPath(), loaded->GetPath());
+
+  ASSERT_EQ(1u, loaded->GetMaterialCount());
+  const common::Material *material = loaded->GetMaterial(0);
+  EXPECT_EQ("/tmp/meshes/texture.png", material->GetTextureImage());
+  EXPECT_EQ(ignition::math::Color(0.1f, 0.2f, 0.3f, 0.4f),
+      material->Diffuse());
+  EXPECT_DOUBLE_EQ(0.5, material->GetTransparency());
+  EXPECT_EQ(common::Material::MODULATE, material->GetBlendMode());
+  EXPECT_FALSE(material->GetLighting());
+
+  ASSERT_EQ(mesh->GetSubMeshCount(), loaded->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *expected = mesh->GetSubMesh(i);
+    const common::SubMesh *subMesh = loaded->GetSubMesh(i);
+    EXPECT_EQ(expected->GetName(), subMesh->GetName());
+    EXPECT_EQ(expected->GetPrimitiveType(), subMesh->GetPrimitiveType());
+    EXPECT_EQ(expected->GetMaterialIndex(), subMesh->GetMaterialIndex());
+
+    ASSERT_EQ(expected->GetVertexCount(), subMesh->GetVertexCount());
+    for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+      EXPECT_EQ(expected->Vertex(v), subMesh->Vertex(v));
+
+    ASSERT_EQ(expected->GetNormalCount(), subMesh->GetNormalCount());
+    for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+      EXPECT_EQ(expected->Normal(n), subMesh->Normal(n));
+
+    ASSERT_EQ(expected->GetTexCoordCount(), subMesh->GetTexCoordCount());
+    for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+      EXPECT_EQ(expected->TexCoord(t), subMesh->TexCoord(t));
+
+    ASSERT_EQ(expected->GetIndexCount(), subMesh->GetIndexCount());
+    for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+      EXPECT_EQ(expected->GetIndex(n), subMesh->GetIndex(n));
+  }
+
+  // Other files are not cached
+  EXPECT_TRUE(cache.Load((this->dir / "other.dae").string()) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Stale)
+{
+  common::MeshCache cache;
+  cache.SetPath((this->dir / "cache").string());
+
+  std::unique_ptr<common::Mesh> mesh(createMesh());
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+
+  // Touching the file without modifying it keeps the cache valid
+  boost::filesystem::last_write_time(this->filename, std::time(nullptr) - 60);
+  std::unique_ptr<common::Mesh> loaded(cache.Load(this->filename));
+  EXPECT_TRUE(loaded != nullptr);
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded != nullptr);
+
+  // Same size, different content
+  this->WriteMeshFile("<COLLADa/>");
+  boost::filesystem::last_write_time(this->filename, std::time(nullptr) - 30);
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+
+  // Different size
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+  this->WriteMeshFile("<COLLADA></COLLADA>");
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+
+  // Corrupt cache files are ignored
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+  for (auto const &entry :
+      boost::filesystem::directory_iterator(this->dir / "cache"))
+  {
+    boost::filesystem::resize_file(entry.path(),
+        boost::filesystem::file_size(entry.path()) / 2);
+  }
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+
+  // Deleted files are not loaded
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+  boost::filesystem::remove(this->filename);
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, StaleMaterial)
+{
+  common::MeshCache cache;
+  cache.SetPath((this->dir / "cache").string());
+
+  this->filename = (this->dir / "box.obj").string();
+  this->WriteMeshFile("mtllib box.mtl other\\ box.mtl\n");
+  std::string mtlFilename = (this->dir / "other box.mtl").string();
+  {
+    std::ofstream out(mtlFilename);
+    out << "newmtl box\n";
+  }
+
+  std::unique_ptr<common::Mesh> mesh(createMesh());
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+  std::unique_ptr<common::Mesh> loaded(cache.Load(this->filename));
+  EXPECT_TRUE(loaded != nullptr);
+
+  // Changing a material file invalidates the cache
+  {
+    std::ofstream out(mtlFilename, std::ios::app);
+    out << "Kd 1 0 0\n";
+  }
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+
+  // So does creating a missing one
+  ASSERT_TRUE(cache.Save(mesh.get(), this->filename));
+  {
+    std::ofstream out((this->dir / "box.mtl").string());
+    out << "newmtl box\n";
+  }
+  loaded.reset(cache.Load(this->filename));
+  EXPECT_TRUE(loaded == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Disabled)
+{
+  common::MeshCache cache;
+  cache.SetPath("");
+  EXPECT_TRUE(cache.Path().empty());
+
+  std::unique_ptr<common::Mesh> mesh(createMesh());
+  EXPECT_FALSE(cache.Save(mesh.get(), this->filename));
+  EXPECT_TRUE(cache.Load(this->filename) == nullptr);
+
+  // Meshes with a skeleton are not cached
+  cache.SetPath((this->dir / "cache").string());
+  EXPECT_TRUE(common::MeshCache::Cacheable(mesh.get()));
+  mesh->SetSkeleton(new common::Skeleton());
+  EXPECT_FALSE(common::MeshCache::Cacheable(mesh.get()));
+  EXPECT_FALSE(cache.Save(mesh.get(), this->filename));
+  EXPECT_FALSE(common::MeshCache::Cacheable(nullptr));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
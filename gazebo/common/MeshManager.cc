@@ -16,6 +16,8 @@
  */
 
 #include <sys/stat.h>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <map>
 
@@ -31,6 +33,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -51,15 +54,9 @@ namespace common
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
-
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
@@ -70,22 +67,36 @@ class MeshManagerPrivate
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
+  /// \brief On-disk cache of loaded mesh files.
+  public: MeshCache cache;
+
+  /// \brief One mutex per mesh file being loaded, so that different files
+  /// are loaded in parallel while a file is loaded only once.
+  public: std::map<std::string, std::shared_ptr<boost::mutex>> loadMutexes;
+
+  /// \brief Mutex to protect meshes and loadMutexes.
   public: boost::mutex mutex;
-};
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+  /// \brief Add a mesh once it is complete, unless another thread added
+  /// one with the same name first.
+  /// \param[in] _mesh The mesh, deleted if it is not added.
+  /// \return The mesh with the name of _mesh in the map.
+  public: Mesh *AddMesh(Mesh *_mesh)
+          {
+            boost::mutex::scoped_lock lock(this->mutex);
+            auto result = this->meshes.insert(
+                std::make_pair(_mesh->GetName(), _mesh));
+            if (!result.second)
+              delete _mesh;
+            return result.first->second;
+          }
+};
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -124,9 +135,7 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -146,67 +155,66 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  const Mesh *loaded = this->GetMesh(_filename);
+  if (loaded)
+    return loaded;
 
-  std::string extension;
+  // This breaks trimesh geom. Each new trimesh should have a unique name.
+  // Erasing the mesh from this->dataPtr->meshes here would allow a mesh
+  // to be modified and inserted into gazebo again without closing gazebo.
 
-  if (this->HasMesh(_filename))
+  std::string fullname = common::find_file(_filename);
+  if (fullname.empty())
   {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
+    gzerr << "Unable to find file[" << _filename << "]\n";
+    return nullptr;
   }
 
-  std::string fullname = common::find_file(_filename);
+  std::string extension = fullname.substr(fullname.rfind(".")+1,
+      fullname.size());
+  std::transform(extension.begin(), extension.end(),
+      extension.begin(), ::tolower);
+
+  // Loaders keep state while loading, so each call uses its own loader
+  std::unique_ptr<MeshLoader> loader;
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+    loader.reset(new STLLoader());
+  else if (extension == "dae")
+    loader.reset(new ColladaLoader());
+  else if (extension == "obj")
+    loader.reset(new OBJLoader());
+  else
+  {
+    gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+    return nullptr;
+  }
 
-  if (!fullname.empty())
+  // This mutex prevents two threads from loading the same mesh at the
+  // same time, without blocking threads loading other meshes.
+  std::shared_ptr<boost::mutex> loadMutex;
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
-    else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
-    else if (extension == "obj")
-      loader = &objLoader;
-    else
-    {
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
-    }
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto &fileMutex = this->dataPtr->loadMutexes[_filename];
+    if (!fileMutex)
+      fileMutex.reset(new boost::mutex);
+    loadMutex = fileMutex;
+  }
+  boost::mutex::scoped_lock loadLock(*loadMutex);
+
+  // Another thread may have loaded the mesh while we were waiting
+  loaded = this->GetMesh(_filename);
+  if (loaded)
+    return loaded;
 
+  auto startTime = std::chrono::steady_clock::now();
+  bool cached = true;
+  Mesh *mesh = this->dataPtr->cache.Load(fullname);
+  if (!mesh)
+  {
+    cached = false;
     try
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
-      {
-        if ((mesh = loader->Load(fullname)) != nullptr)
-        {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
+      mesh = loader->Load(fullname);
     }
     catch(gazebo::common::Exception &e)
     {
@@ -214,11 +222,23 @@ const Mesh *MeshManager::Load(const std::string &_filename)
       gzerr << e << "\n";
       gzthrow(e);
     }
+
+    if (!mesh)
+    {
+      gzerr << "Unable to load mesh[" << fullname << "]\n";
+      return nullptr;
+    }
+
+    this->dataPtr->cache.Save(mesh, fullname);
   }
-  else
-    gzerr << "Unable to find file[" << _filename << "]\n";
 
-  return mesh;
+  gzlog << "Loaded mesh[" << fullname << "] from "
+        << (cached ? "cache" : "file") << " in "
+        << std::chrono::duration<double>(
+             std::chrono::steady_clock::now() - startTime).count() << " s\n";
+
+  mesh->SetName(_filename);
+  return this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -257,28 +277,33 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->meshes.insert(std::make_pair(_mesh->GetName(), _mesh));
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -295,6 +320,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -318,7 +344,6 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -359,6 +384,8 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
       }
     }
   }
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -386,7 +413,6 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -410,6 +436,7 @@ void MeshManager::CreatePlane(const std::string &_name,
   if (!xform.IsAffine())
   {
     gzerr << "Matrix is not affine, plane creation failed\n";
+    delete mesh;
     return;
   }
 
@@ -450,6 +477,8 @@ void MeshManager::CreatePlane(const std::string &_name,
   }
 
   this->Tesselate2DMesh(subMesh, _segments.X() + 1, _segments.Y() + 1, false);
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -466,7 +495,6 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -552,6 +580,8 @@ void MeshManager::CreateBox(const std::string &_name,
   // Set the indices
   for (i = 0; i < 36; ++i)
     subMesh->AddIndex(ind[i]);
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -767,7 +797,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(mesh);
   return;
 }
 
@@ -783,7 +813,6 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -866,6 +895,8 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
     subMesh->AddIndex(ind[i]);
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -884,7 +915,6 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -983,6 +1013,8 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
       subMesh->AddIndex(verticeIndex - segments + seg);
     }
   }
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1001,7 +1033,6 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1093,6 +1124,8 @@ void MeshManager::CreateCone(const std::string &name, float radius,
   }
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1118,7 +1151,6 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1260,6 +1292,8 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
   }
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->AddMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1339,7 +1373,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(mesh);
 }
 #endif
 
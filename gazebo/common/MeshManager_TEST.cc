@@ -17,7 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+
 #include "test_config.h"
+#include "gazebo/common/Material.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/MeshManager.hh"
 #include "gazebo/gazebo_config.h"
@@ -266,6 +273,54 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ParallelLoadMaterialNames)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("mesh_manager_%%%%%%%%");
+  boost::filesystem::create_directories(dir);
+  boost::filesystem::path data = boost::filesystem::path(TEST_PATH) / "data";
+  boost::filesystem::copy_file(data / "box.mtl", dir / "box.mtl");
+
+  const unsigned int count = 32;
+  std::vector<std::string> filenames;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    filenames.push_back(
+        (dir / ("box_" + std::to_string(i) + ".obj")).string());
+    boost::filesystem::copy_file(data / "box.obj", filenames.back());
+  }
+
+  // Each load creates materials, from the file or from the mesh cache
+  std::vector<const common::Mesh *> meshes(count, nullptr);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      meshes[i] = common::MeshManager::Instance()->Load(filenames[i]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  std::set<std::string> names;
+  unsigned int materialCount = 0;
+  for (auto const *mesh : meshes)
+  {
+    ASSERT_TRUE(mesh != nullptr);
+    for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+    {
+      names.insert(mesh->GetMaterial(i)->GetName());
+      ++materialCount;
+    }
+  }
+  EXPECT_GE(materialCount, count);
+  EXPECT_EQ(materialCount, names.size());
+
+  boost::filesystem::remove_all(dir);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
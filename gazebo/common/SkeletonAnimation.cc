@@ -15,6 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
@@ -25,9 +31,225 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Assert.hh"
 
+/// \brief Private data for SkeletonAnimation, kept out of the class to
+/// keep its layout. The key frames of all the nodes, copied into contiguous
+/// arrays so that a pose is computed in one pass over them.
+class gazebo::common::SkeletonAnimationPrivate
+{
+  /// \brief Copy the key frames into the arrays, unless they are up to
+  /// date.
+  /// \param[in] _animations The node animations, by name.
+  public: void Bake(
+              const std::map<std::string, NodeAnimation *> &_animations);
+
+  /// \brief True if the arrays match the key frames.
+  public: std::atomic<bool> baked{false};
+
+  /// \brief Mutex to protect the arrays while they are filled.
+  public: std::mutex mutex;
+
+  /// \brief Index of the first key frame of each node in the arrays below,
+  /// with nodes in the order of their names.
+  public: std::vector<size_t> first;
+
+  /// \brief Number of key frames of each node.
+  public: std::vector<size_t> count;
+
+  /// \brief Duration of the animation of each node.
+  public: std::vector<double> lengths;
+
+  /// \brief Time of each key frame.
+  public: std::vector<double> times;
+
+  /// \brief Transformation of each key frame.
+  public: std::vector<ignition::math::Matrix4d> frames;
+
+  /// \brief Translation of each key frame.
+  public: std::vector<ignition::math::Vector3d> positions;
+
+  /// \brief Rotation of each key frame.
+  public: std::vector<ignition::math::Quaterniond> rotations;
+
+  /// \brief True if all the nodes have key frames at the same times.
+  public: bool sharedTimes = false;
+};
+
+namespace
+{
+  /// \brief Key frames used for a time, as chosen by
+  /// NodeAnimation::FrameAt.
+  struct KeyFrameSample
+  {
+    /// \brief Index of the key frame to use as is, or of the next key
+    /// frame when interpolating.
+    size_t index;
+
+    /// \brief Interpolation factor between the previous and next key
+    /// frames, negative to use the key frame at index as is.
+    double t;
+
+    /// \brief False if the time is outside the key frames.
+    bool valid;
+  };
+
+  /// \brief Find the key frames to use for a time, the same way as
+  /// NodeAnimation::FrameAt.
+  /// \param[in] _times Times of the key frames, sorted.
+  /// \param[in] _count Number of key frames, at least one.
+  /// \param[in] _length Duration of the animation.
+  /// \param[in] _time The time.
+  /// \param[in] _loop True to loop the animation.
+  /// \return The key frames to use.
+  KeyFrameSample FindKeyFrames(const double *_times, const size_t _count,
+      const double _length, const double _time, const bool _loop)
+  {
+    KeyFrameSample sample = {_count - 1, -1.0, true};
+
+    double time = _time;
+    if (time > _length)
+    {
+      if (_loop && _length > 0.0)
+      {
+        while (time > _length)
+          time = time - _length;
+      }
+      else
+        time = _length;
+    }
+
+    if (ignition::math::equal(time, _length))
+      return sample;
+
+    size_t next = std::upper_bound(_times, _times + _count, time) - _times;
+    if (next == _count)
+      return sample;
+
+    sample.index = next;
+    if (next == 0 || ignition::math::equal(_times[next], time))
+      return sample;
+
+    sample.t = (time - _times[next - 1]) / (_times[next] - _times[next - 1]);
+    if (sample.t < 0.0 || sample.t > 1.0)
+    {
+      gzerr << "Invalid time range for node animation: previous ["
+            << _times[next - 1] << "], next [" << _times[next] << "]"
+            << std::endl;
+      sample.valid = false;
+    }
+
+    return sample;
+  }
+
+  /// \brief Compute the transformation of a node from its key frames.
+  /// \param[in] _data Key frames of all the nodes.
+  /// \param[in] _first Index of the first key frame of the node.
+  /// \param[in] _sample Key frames to use, relative to _first.
+  /// \param[out] _trans The transformation.
+  void Interpolate(const gazebo::common::SkeletonAnimationPrivate &_data,
+      const size_t _first, const KeyFrameSample &_sample,
+      ignition::math::Matrix4d &_trans)
+  {
+    if (!_sample.valid)
+    {
+      _trans = ignition::math::Matrix4d();
+      return;
+    }
+
+    const size_t next = _first + _sample.index;
+    if (_sample.t < 0.0)
+    {
+      _trans = _data.frames[next];
+      return;
+    }
+
+    const double t = _sample.t;
+    const ignition::math::Vector3d &nextPos = _data.positions[next];
+    const ignition::math::Vector3d &prevPos = _data.positions[next - 1];
+    ignition::math::Vector3d pos(
+        prevPos.X() + ((nextPos.X() - prevPos.X()) * t),
+        prevPos.Y() + ((nextPos.Y() - prevPos.Y()) * t),
+        prevPos.Z() + ((nextPos.Z() - prevPos.Z()) * t));
+
+    _trans = ignition::math::Matrix4d(ignition::math::Quaterniond::Slerp(t,
+        _data.rotations[next - 1], _data.rotations[next], true));
+    _trans.SetTranslation(pos);
+  }
+}
+
 using namespace gazebo;
 using namespace common;
 
+/// \brief Protects g_skeletonAnimations.
+static std::mutex g_skeletonAnimationsMutex;
+
+/// \brief Private data of every skeleton animation.
+/// TODO: Move to a data pointer member when porting forward
+static std::unordered_map<const SkeletonAnimation *,
+    std::unique_ptr<SkeletonAnimationPrivate>> g_skeletonAnimations;
+
+//////////////////////////////////////////////////
+/// \brief Get the private data of a skeleton animation, creating it if
+/// needed.
+/// \param[in] _anim The skeleton animation.
+/// \return The private data.
+static SkeletonAnimationPrivate &animationData(
+    const SkeletonAnimation *_anim)
+{
+  std::lock_guard<std::mutex> lock(g_skeletonAnimationsMutex);
+  auto &data = g_skeletonAnimations[_anim];
+  if (!data)
+    data.reset(new SkeletonAnimationPrivate);
+  return *data;
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationPrivate::Bake(
+    const std::map<std::string, NodeAnimation *> &_animations)
+{
+  if (this->baked)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->baked)
+    return;
+
+  this->first.clear();
+  this->count.clear();
+  this->lengths.clear();
+  this->times.clear();
+  this->frames.clear();
+  this->positions.clear();
+  this->rotations.clear();
+
+  for (auto const &anim : _animations)
+  {
+    this->first.push_back(this->times.size());
+    this->count.push_back(anim.second->keyFrames.size());
+    this->lengths.push_back(anim.second->length);
+
+    for (auto const &keyFrame : anim.second->keyFrames)
+    {
+      this->times.push_back(keyFrame.first);
+      this->frames.push_back(keyFrame.second);
+      this->positions.push_back(keyFrame.second.Translation());
+      this->rotations.push_back(keyFrame.second.Rotation());
+    }
+  }
+
+  // The key frames around a time are the same for every node if they all
+  // have key frames at the same times.
+  this->sharedTimes = !this->first.empty() && this->count[0] > 0;
+  for (size_t i = 1; i < this->first.size() && this->sharedTimes; ++i)
+  {
+    this->sharedTimes = this->count[i] == this->count[0] &&
+        ignition::math::equal(this->lengths[i], this->lengths[0], 0.0) &&
+        std::equal(this->times.begin(), this->times.begin() + this->count[0],
+            this->times.begin() + this->first[i]);
+  }
+
+  this->baked = true;
+}
+
 //////////////////////////////////////////////////
 NodeAnimation::NodeAnimation(const std::string& _name)
 {
@@ -214,12 +436,16 @@ double NodeAnimation::GetTimeAtX(const double _x) const
 SkeletonAnimation::SkeletonAnimation(const std::string& _name)
 {
   this->name = _name;
+  this->length = 0.0;
 }
 
 //////////////////////////////////////////////////
 SkeletonAnimation::~SkeletonAnimation()
 {
   this->animations.clear();
+
+  std::lock_guard<std::mutex> lock(g_skeletonAnimationsMutex);
+  g_skeletonAnimations.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -257,6 +483,7 @@ void SkeletonAnimation::AddKeyFrame(const std::string& _node,
     this->length = _time;
 
   this->animations[_node]->AddKeyFrame(_time, _mat);
+  animationData(this).baked = false;
 }
 
 //////////////////////////////////////////////////
@@ -270,6 +497,7 @@ void SkeletonAnimation::AddKeyFrame(const std::string &_node,
     this->length = _time;
 
   this->animations[_node]->AddKeyFrame(_time, _pose);
+  animationData(this).baked = false;
 }
 
 //////////////////////////////////////////////////
@@ -288,15 +516,13 @@ ignition::math::Matrix4d SkeletonAnimation::NodePoseAt(
 std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAt(
     const double _time, const bool _loop) const
 {
-  ///  TODO need to make sure that all nodes have keyframes at the same
-  ///  points in time and create the missing keyframes. if the animation
-  ///  comes from bvh this is guaranteed, but if it's coming from collada
-  ///  it's not guaranteed. fixing this will help not having to find the
-  ///  prev and next keyframe for each node at each time step, but rather
-  ///  doing it only once per time step.
+  std::vector<ignition::math::Matrix4d> poses;
+  this->PoseAt(_time, poses, _loop);
+
   std::map<std::string, ignition::math::Matrix4d> pose;
+  auto iter = poses.begin();
   for (auto const &anim : this->animations)
-    pose[anim.first] = anim.second->FrameAt(_time, _loop);
+    pose[anim.first] = *iter++;
 
   return pose;
 }
@@ -305,27 +531,95 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAt(
 std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
     const double _x, const std::string &_node, const bool _loop) const
 {
-  std::map<std::string, NodeAnimation*>::const_iterator nodeAnim =
-      this->animations.find(_node);
+  int node = this->NodeIndex(_node);
+  if (node < 0)
+  {
+    gzerr << "Unknown animation node [" << _node << "]" << std::endl;
+    return this->PoseAt(0.0, _loop);
+  }
 
-  ignition::math::Matrix4d lastPos = nodeAnim->second->KeyFrame(
-      nodeAnim->second->GetFrameCount() - 1).second;
+  return this->PoseAt(this->TimeAtX(_x, node, _loop), _loop);
+}
+
+//////////////////////////////////////////////////
+int SkeletonAnimation::NodeIndex(const std::string &_node) const
+{
+  auto iter = this->animations.find(_node);
+  if (iter == this->animations.end())
+    return -1;
 
-  ignition::math::Matrix4d firstPos = nodeAnim->second->KeyFrame(0).second;
+  return std::distance(this->animations.begin(), iter);
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimation::PoseAt(const double _time,
+    std::vector<ignition::math::Matrix4d> &_poses, const bool _loop) const
+{
+  SkeletonAnimationPrivate &data = animationData(this);
+  data.Bake(this->animations);
+
+  _poses.resize(data.first.size());
+
+  if (data.sharedTimes)
+  {
+    KeyFrameSample sample = FindKeyFrames(data.times.data(), data.count[0],
+        data.lengths[0], _time, _loop);
+    for (size_t i = 0; i < _poses.size(); ++i)
+      Interpolate(data, data.first[i], sample, _poses[i]);
+    return;
+  }
+
+  for (size_t i = 0; i < _poses.size(); ++i)
+  {
+    if (data.count[i] == 0)
+    {
+      _poses[i] = ignition::math::Matrix4d::Identity;
+      continue;
+    }
+
+    KeyFrameSample sample = FindKeyFrames(data.times.data() + data.first[i],
+        data.count[i], data.lengths[i], _time, _loop);
+    Interpolate(data, data.first[i], sample, _poses[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimation::TimeAtX(const double _x, const unsigned int _node,
+    const bool _loop) const
+{
+  SkeletonAnimationPrivate &data = animationData(this);
+  data.Bake(this->animations);
+
+  if (_node >= data.first.size() || data.count[_node] == 0)
+    return 0.0;
+
+  const size_t first = data.first[_node];
+  const size_t last = first + data.count[_node] - 1;
 
   double x = _x;
-  if (x < firstPos.Translation().X())
-    x = firstPos.Translation().X();
+  if (x < data.positions[first].X())
+    x = data.positions[first].X();
 
-  double lastX = lastPos.Translation().X();
-  if (x > lastX && !_loop)
+  double lastX = data.positions[last].X();
+  if (x > lastX && (!_loop || lastX <= 0.0))
     x = lastX;
   while (x > lastX)
     x -= lastX;
 
-  double time = nodeAnim->second->GetTimeAtX(x);
+  // Same as NodeAnimation::GetTimeAtX
+  size_t i = first;
+  while (i < last && data.positions[i].X() < x)
+    ++i;
+
+  if (i == first || ignition::math::equal(data.positions[i].X(), x))
+    return data.times[i];
 
-  return this->PoseAt(time, _loop);
+  double x1 = data.positions[i - 1].X();
+  double x2 = data.positions[i].X();
+  double t1 = data.times[i - 1];
+  double t2 = data.times[i];
+
+  return t1 + ((t2 - t1) * (x - x1) / (x2 - x1));
 }
 
 //////////////////////////////////////////////////
@@ -334,6 +628,8 @@ void SkeletonAnimation::Scale(const double _scale)
   for (std::map<std::string, NodeAnimation*>::iterator iter =
         this->animations.begin(); iter != this->animations.end(); ++iter)
     iter->second->Scale(_scale);
+
+  animationData(this).baked = false;
 }
 
 //////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include <map>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
@@ -31,6 +32,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class.
+    class SkeletonAnimationPrivate;
+
     /// \addtogroup gazebo_common Common Animation
     /// \{
 
@@ -120,6 +124,10 @@ namespace gazebo
 
       /// \brief the duration of the animations (time of last key frame)
       protected: double length;
+
+      /// \brief The skeleton animation copies the key frames into
+      /// contiguous arrays.
+      friend class SkeletonAnimationPrivate;
     };
 
     /// \brief Skeleton animation
@@ -200,6 +208,39 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Returns the index of a node in the transformations filled
+      /// by the indexed PoseAt. Nodes are indexed in the order of their
+      /// names, so indices change as nodes are added.
+      /// \param[in] _node the name of the animation node
+      /// \return the index, or -1 if the node doesn't exist
+      public: int NodeIndex(const std::string &_node) const;
+
+      /// \brief Fills the transformations of every node at a specific
+      /// time, indexed by NodeIndex. The transformations are the same as
+      /// those returned by the other PoseAt, without looking up names, and
+      /// without allocating once _poses has room for every node. When all
+      /// the nodes have key frames at the same times, which is the case
+      /// for BVH animations, the key frames around _time are found once
+      /// for all the nodes.
+      /// \param[in] _time the time
+      /// \param[out] _poses the transformation for every node
+      /// \param[in] _loop when true, the time is divided by the duration
+      /// (see GetLength)
+      public: void PoseAt(const double _time,
+                  std::vector<ignition::math::Matrix4d> &_poses,
+                  const bool _loop = true) const;
+
+      /// \brief Returns the time to pass to PoseAt so that the
+      /// transformation of a node has a translational value along the X
+      /// axis equal to _x, as used by PoseAtX.
+      /// \param[in] _x the value along x
+      /// \param[in] _node the index of the animation node, see NodeIndex
+      /// \param[in] _loop when true, _x is divided by the largest value
+      /// along x of the node
+      /// \return the time, or 0 if _node is out of range
+      public: double TimeAtX(const double _x, const unsigned int _node,
+                  const bool _loop = true) const;
+
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
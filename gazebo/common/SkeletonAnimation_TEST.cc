@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/SkeletonAnimation.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SkeletonAnimationTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Check that the indexed PoseAt returns the same transformations
+  /// as NodePoseAt for every node.
+  /// \param[in] _anim The animation.
+  /// \param[in] _time The time.
+  /// \param[in] _loop True to loop the animation.
+  public: void ExpectSamePoses(common::SkeletonAnimation &_anim,
+              const double _time, const bool _loop)
+          {
+            std::vector<ignition::math::Matrix4d> poses;
+            _anim.PoseAt(_time, poses, _loop);
+            ASSERT_EQ(_anim.GetNodeCount(), poses.size());
+
+            std::map<std::string, ignition::math::Matrix4d> named =
+              _anim.PoseAt(_time, _loop);
+            for (auto const &pose : named)
+            {
+              int index = _anim.NodeIndex(pose.first);
+              ASSERT_GE(index, 0);
+              EXPECT_EQ(_anim.NodePoseAt(pose.first, _time, _loop),
+                  poses[index]) << pose.first << " at " << _time;
+              EXPECT_EQ(pose.second, poses[index]);
+            }
+          }
+};
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, SharedKeyFrameTimes)
+{
+  // Every node has key frames at the same times, like BVH animations
+  common::SkeletonAnimation anim("shared");
+  for (int i = 0; i <= 4; ++i)
+  {
+    anim.AddKeyFrame("root", i * 0.5,
+        ignition::math::Pose3d(i, 0, 1, 0, 0, i * 0.3));
+    anim.AddKeyFrame("arm", i * 0.5,
+        ignition::math::Pose3d(0, 0.2, 0, i * 0.2, 0, 0));
+    anim.AddKeyFrame("leg", i * 0.5,
+        ignition::math::Pose3d(0, -0.2, -i * 0.1, 0, -i * 0.1, 0));
+  }
+  EXPECT_DOUBLE_EQ(2.0, anim.GetLength());
+
+  EXPECT_EQ(0, anim.NodeIndex("arm"));
+  EXPECT_EQ(1, anim.NodeIndex("leg"));
+  EXPECT_EQ(2, anim.NodeIndex("root"));
+  EXPECT_EQ(-1, anim.NodeIndex("head"));
+
+  for (double time : {0.0, 0.25, 0.5, 0.7, 1.5, 1.99, 2.0, 2.3, 5.1})
+  {
+    this->ExpectSamePoses(anim, time, true);
+    this->ExpectSamePoses(anim, time, false);
+  }
+
+  // Interpolated half way between the first two key frames
+  std::vector<ignition::math::Matrix4d> poses;
+  anim.PoseAt(0.25, poses);
+  EXPECT_EQ(ignition::math::Vector3d(0.5, 0, 1), poses[2].Translation());
+
+  // The poses are recomputed after the key frames are scaled
+  anim.Scale(2.0);
+  anim.PoseAt(0.25, poses);
+  EXPECT_EQ(ignition::math::Vector3d(1, 0, 2), poses[2].Translation());
+  this->ExpectSamePoses(anim, 0.25, true);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, DifferentKeyFrameTimes)
+{
+  // Nodes with key frames at different times, as COLLADA allows
+  common::SkeletonAnimation anim("different");
+  for (int i = 0; i <= 4; ++i)
+  {
+    anim.AddKeyFrame("a", i * 0.5,
+        ignition::math::Pose3d(i, 0, 0, 0, 0, i * 0.3));
+  }
+  for (int i = 0; i <= 3; ++i)
+  {
+    anim.AddKeyFrame("b", i * 0.3,
+        ignition::math::Pose3d(0, i, 0, i * 0.2, 0, 0));
+  }
+
+  for (double time : {0.0, 0.3, 0.45, 0.5, 0.9, 1.2, 1.7, 2.0, 3.3})
+  {
+    this->ExpectSamePoses(anim, time, true);
+    this->ExpectSamePoses(anim, time, false);
+  }
+
+  // Key frames added after a pose was computed are used
+  anim.AddKeyFrame("b", 2.0, ignition::math::Pose3d(0, 5, 0, 0, 0, 0));
+  this->ExpectSamePoses(anim, 1.6, true);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, TimeAtX)
+{
+  common::SkeletonAnimation anim("walk");
+  anim.AddKeyFrame("root", 0.0, ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+  anim.AddKeyFrame("root", 1.0, ignition::math::Pose3d(2, 0, 1, 0, 0, 0));
+  anim.AddKeyFrame("root", 2.0, ignition::math::Pose3d(3, 0, 1, 0, 0, 0));
+  anim.AddKeyFrame("foot", 0.0, ignition::math::Pose3d(0, 0, 0, 0, 0, 0));
+  anim.AddKeyFrame("foot", 2.0, ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+
+  int root = anim.NodeIndex("root");
+  ASSERT_GE(root, 0);
+  EXPECT_DOUBLE_EQ(0.0, anim.TimeAtX(0.0, root));
+  EXPECT_DOUBLE_EQ(0.5, anim.TimeAtX(1.0, root));
+  EXPECT_DOUBLE_EQ(1.0, anim.TimeAtX(2.0, root));
+  EXPECT_DOUBLE_EQ(1.5, anim.TimeAtX(2.5, root));
+
+  // Values before the first key frame are clamped, and values after the
+  // last one loop, unless looping is disabled
+  EXPECT_DOUBLE_EQ(0.0, anim.TimeAtX(-1.0, root));
+  EXPECT_DOUBLE_EQ(0.5, anim.TimeAtX(4.0, root));
+  EXPECT_DOUBLE_EQ(2.0, anim.TimeAtX(4.0, root, false));
+
+  // Out of range node
+  EXPECT_DOUBLE_EQ(0.0, anim.TimeAtX(1.0, 10));
+
+  // Same as PoseAtX
+  std::vector<ignition::math::Matrix4d> poses;
+  anim.PoseAt(anim.TimeAtX(2.5, root), poses);
+  std::map<std::string, ignition::math::Matrix4d> named =
+    anim.PoseAtX(2.5, "root");
+  EXPECT_EQ(named["root"], poses[root]);
+  EXPECT_EQ(named["foot"], poses[anim.NodeIndex("foot")]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, SingleKeyFrame)
+{
+  // Animations lasting no time at all always return their key frame
+  common::SkeletonAnimation anim("still");
+  ignition::math::Pose3d pose(1, 2, 3, 0, 0, 0.5);
+  anim.AddKeyFrame("root", 0.0, pose);
+
+  std::vector<ignition::math::Matrix4d> poses;
+  for (double time : {0.0, 0.5, 10.0})
+  {
+    anim.PoseAt(time, poses);
+    ASSERT_EQ(1u, poses.size());
+    EXPECT_EQ(pose, poses[0].Pose());
+  }
+
+  common::SkeletonAnimation empty("empty");
+  empty.PoseAt(1.0, poses);
+  EXPECT_TRUE(poses.empty());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,9 +15,12 @@
  *
  */
 
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #include <boost/filesystem.hpp>
 #include <ignition/common/StringUtils.hh>
@@ -56,6 +59,57 @@ char pathDelimiter()
 /// TODO(chapulina): Move to member variable when porting forward
 std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 
+/// \brief Serializes file lookups, which update the path lists from the
+/// environment, so that files can be looked up from any thread.
+/// TODO: Move to member variable when porting forward
+static std::recursive_mutex g_findFileMutex;
+
+/// \brief Result of a file lookup.
+class FindFileCacheEntry
+{
+  /// \brief Full path to the file, empty if it wasn't found.
+  public: std::string path;
+
+  /// \brief When the file wasn't found.
+  public: std::chrono::steady_clock::time_point time;
+};
+
+/// \brief How long a file that wasn't found is remembered as missing, so
+/// that files created afterwards are found eventually.
+static const std::chrono::seconds kFindFileMissingLifetime(5);
+
+/// \brief True to remember the results of file lookups.
+/// TODO: Move to member variable when porting forward
+static bool g_findFileCacheEnabled = true;
+
+/// \brief Results of file lookups, indexed by whether the local path was
+/// searched and by file name.
+/// TODO: Move to member variable when porting forward
+static std::unordered_map<std::string, FindFileCacheEntry>
+    g_findFileCache[2];
+
+/// \brief True to look models up in g_modelIndex.
+/// TODO: Move to member variable when porting forward
+static bool g_modelIndexEnabled = false;
+
+/// \brief True if model paths changed since g_modelIndex was built.
+static bool g_modelIndexDirty = true;
+
+/// \brief Model path of each model directory name, from
+/// SystemPaths::ScanModelPaths.
+/// TODO: Move to member variable when porting forward
+static std::unordered_map<std::string, std::string> g_modelIndex;
+
+//////////////////////////////////////////////////
+/// \brief Forget the results of file lookups, because search paths changed.
+static void invalidateFindFileCache()
+{
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
+  g_findFileCache[0].clear();
+  g_findFileCache[1].clear();
+  g_modelIndexDirty = true;
+}
+
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
 {
@@ -123,6 +177,14 @@ SystemPaths::SystemPaths()
   this->UpdatePluginPaths();
   this->UpdateOgrePaths();
 
+  const char *cacheEnv = getenv("GAZEBO_FIND_FILE_CACHE");
+  if (cacheEnv && std::string(cacheEnv) == "0")
+    g_findFileCacheEnabled = false;
+
+  const char *scanEnv = getenv("GAZEBO_SCAN_MODEL_PATHS");
+  if (scanEnv && std::string(scanEnv) == "1")
+    this->ScanModelPaths();
+
   // Add some search paths
   // this->suffixPaths.push_back(std::string("/sdf/") + SDF_VERSION + "/");
   this->suffixPaths.push_back("/models/");
@@ -306,6 +368,8 @@ std::string SystemPaths::GetWorldPathExtension()
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFileURI(const std::string &_uri)
 {
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
+
   int index = _uri.find("://");
   std::string prefix = _uri.substr(0, index);
   std::string suffix = _uri.substr(index + 3, _uri.size() - index - 3);
@@ -316,8 +380,25 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
   if (prefix == "model")
   {
     boost::filesystem::path path;
+
+    // The index gives the model path of the model directory, which saves
+    // checking every model path.
+    if (g_modelIndexEnabled)
+    {
+      if (g_modelIndexDirty)
+        this->ScanModelPaths();
+
+      auto iter = g_modelIndex.find(suffix.substr(0, suffix.find('/')));
+      if (iter != g_modelIndex.end())
+      {
+        path = boost::filesystem::path(iter->second) / suffix;
+        if (boost::filesystem::exists(path))
+          filename = path.string();
+      }
+    }
+
     for (std::list<std::string>::iterator iter = this->modelPaths.begin();
-         iter != this->modelPaths.end(); ++iter)
+         filename.empty() && iter != this->modelPaths.end(); ++iter)
     {
       path = boost::filesystem::path(*iter) / suffix;
       if (boost::filesystem::exists(path))
@@ -350,11 +431,35 @@ static bool isAbsolute(const std::string &_filename)
 std::string SystemPaths::FindFile(const std::string &_filename,
                                   bool _searchLocalPath)
 {
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
+
   boost::filesystem::path path;
 
   if (_filename.empty())
     return path.string();
 
+  // Each lookup may check many paths, which is slow on network file
+  // systems. Found files are only checked to still exist.
+  auto &cache = g_findFileCache[_searchLocalPath];
+  if (g_findFileCacheEnabled)
+  {
+    auto iter = cache.find(_filename);
+    if (iter != cache.end())
+    {
+      if (!iter->second.path.empty())
+      {
+        if (boost::filesystem::exists(iter->second.path))
+          return iter->second.path;
+      }
+      else if (std::chrono::steady_clock::now() - iter->second.time <
+          kFindFileMissingLifetime)
+      {
+        return std::string();
+      }
+      cache.erase(iter);
+    }
+  }
+
   // Handle as URI
   if (_filename.find("://") != std::string::npos)
   {
@@ -458,41 +563,95 @@ std::string SystemPaths::FindFile(const std::string &_filename,
   {
     gzwarn << "File or path does not exist [" << path << "] ["
            << _filename << "]" << std::endl;
+
+    // Absolute paths are cheap to check again, and are often checked
+    // before the file is created.
+    if (g_findFileCacheEnabled && !isAbsolute(_filename))
+      cache[_filename].time = std::chrono::steady_clock::now();
     return std::string();
   }
 
+  if (g_findFileCacheEnabled)
+    cache[_filename].path = path.string();
+
   return path.string();
 }
 
+/////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  invalidateFindFileCache();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ScanModelPaths()
+{
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
+
+  g_modelIndex.clear();
+  for (auto const &modelPath : this->modelPaths)
+  {
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator iter(modelPath, ec), end;
+         !ec && iter != end; iter.increment(ec))
+    {
+      // Earlier model paths take precedence, as when searching them
+      if (boost::filesystem::is_directory(iter->path(), ec))
+      {
+        g_modelIndex.emplace(iter->path().filename().string(), modelPath);
+      }
+    }
+  }
+
+  g_modelIndexEnabled = true;
+  g_modelIndexDirty = false;
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ClearModelIndex()
+{
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
+
+  g_modelIndex.clear();
+  g_modelIndexEnabled = false;
+  g_modelIndexDirty = true;
+}
+
 /////////////////////////////////////////////////
 void SystemPaths::AddFindFileCallback(
     std::function<std::string (const std::string &)> _cb)
 {
+  std::lock_guard<std::recursive_mutex> lock(g_findFileMutex);
   g_findFileCbs.push_back(_cb);
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearGazeboPaths()
 {
   this->gazeboPaths.clear();
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearOgrePaths()
 {
   this->ogrePaths.clear();
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearPluginPaths()
 {
   this->pluginPaths.clear();
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearModelPaths()
 {
   this->modelPaths.clear();
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -559,7 +718,10 @@ void SystemPaths::InsertUnique(const std::string &_path,
                                std::list<std::string> &_list)
 {
   if (std::find(_list.begin(), _list.end(), _path) == _list.end())
+  {
     _list.push_back(_path);
+    invalidateFindFileCache();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -576,6 +738,7 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  invalidateFindFileCache();
 }
 
 //////////////////////////////////////////////////
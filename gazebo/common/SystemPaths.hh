@@ -116,6 +116,24 @@ namespace gazebo
       public: std::string FindFile(const std::string &_filename,
                                    bool _searchLocalPath = true);
 
+      /// \brief Forget the results of previous calls to FindFile. Found files
+      /// are remembered until they are deleted, and files not found are
+      /// remembered for a few seconds. The results are also forgotten when
+      /// search paths or callbacks are added. Set the
+      /// GAZEBO_FIND_FILE_CACHE environment variable to 0 to disable this.
+      public: void ClearFindFileCache();
+
+      /// \brief Index the model directories found in the model paths, so
+      /// that FindFileURI finds models without checking every model path.
+      /// The index is rebuilt when model paths change. Set the
+      /// GAZEBO_SCAN_MODEL_PATHS environment variable to 1 to build the
+      /// index at startup.
+      public: void ScanModelPaths();
+
+      /// \brief Stop using the index built by ScanModelPaths, FindFileURI
+      /// checks every model path again.
+      public: void ClearModelIndex();
+
       /// \brief Add a callback to use when Gazebo can't find a file.
       /// The callback should return a full local path to the requested file, or
       /// and empty string if the file was not found in the callback.
@@ -16,9 +16,14 @@
 */
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <fstream>
+#include <list>
 #include <string>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "test/util.hh"
@@ -27,6 +32,58 @@ using namespace gazebo;
 
 class SystemPathsTest : public gazebo::testing::AutoLogFixture { };
 
+/// \brief Restores the search paths and the model index of the SystemPaths
+/// singleton changed by a test.
+class SystemPathsRestoreTest : public SystemPathsTest
+{
+  /// \brief Save the search paths.
+  public: void SetUp()
+          {
+            SystemPathsTest::SetUp();
+            auto sysPaths = common::SystemPaths::Instance();
+            this->gazeboPathsFromEnv = sysPaths->gazeboPathsFromEnv;
+            this->modelPathsFromEnv = sysPaths->modelPathsFromEnv;
+            this->gazeboPaths = sysPaths->GetGazeboPaths();
+            this->modelPaths = sysPaths->GetModelPaths();
+          }
+
+  /// \brief Restore the search paths and the model index, and forget the
+  /// files found by the test.
+  public: void TearDown()
+          {
+            auto sysPaths = common::SystemPaths::Instance();
+            sysPaths->ClearGazeboPaths();
+            for (auto const &path : this->gazeboPaths)
+              sysPaths->AddGazeboPaths(path);
+            sysPaths->ClearModelPaths();
+            for (auto const &path : this->modelPaths)
+              sysPaths->AddModelPaths(path);
+            sysPaths->gazeboPathsFromEnv = this->gazeboPathsFromEnv;
+            sysPaths->modelPathsFromEnv = this->modelPathsFromEnv;
+
+            // The index is only built at startup when asked for.
+            sysPaths->ClearModelIndex();
+            const char *scanEnv = getenv("GAZEBO_SCAN_MODEL_PATHS");
+            if (scanEnv && std::string(scanEnv) == "1")
+              sysPaths->ScanModelPaths();
+            sysPaths->ClearFindFileCache();
+
+            SystemPathsTest::TearDown();
+          }
+
+  /// \brief Gazebo paths before the test.
+  private: std::list<std::string> gazeboPaths;
+
+  /// \brief Model paths before the test.
+  private: std::list<std::string> modelPaths;
+
+  /// \brief Value of SystemPaths::gazeboPathsFromEnv before the test.
+  private: bool gazeboPathsFromEnv = true;
+
+  /// \brief Value of SystemPaths::modelPathsFromEnv before the test.
+  private: bool modelPathsFromEnv = true;
+};
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, FindFileURI)
 {
@@ -90,6 +147,62 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsRestoreTest, FindFileCache)
+{
+  auto sysPaths = common::SystemPaths::Instance();
+
+  boost::filesystem::path dir = boost::filesystem::path(sysPaths->TmpPath()) /
+    boost::filesystem::unique_path("find_file_cache_%%%%%%");
+  boost::filesystem::path resourceDir = dir / "resources";
+  boost::filesystem::path modelDir = dir / "models";
+  boost::filesystem::create_directories(resourceDir);
+  boost::filesystem::create_directories(modelDir / "cache_model");
+  std::ofstream((modelDir / "cache_model" / "model.sdf").string());
+
+  // Missing files are remembered as missing
+  std::string resource = "find_file_cache_resource.txt";
+  sysPaths->AddGazeboPaths(resourceDir.string());
+  EXPECT_EQ("", sysPaths->FindFile(resource, false));
+  std::ofstream((resourceDir / resource).string());
+  EXPECT_EQ("", sysPaths->FindFile(resource, false));
+
+  // Until the cache is cleared
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ((resourceDir / resource).string(),
+      sysPaths->FindFile(resource, false));
+  EXPECT_EQ((resourceDir / resource).string(),
+      sysPaths->FindFile(resource, false));
+
+  // Deleted files are not found anymore
+  boost::filesystem::remove(resourceDir / resource);
+  EXPECT_EQ("", sysPaths->FindFile(resource, false));
+
+  // Adding search paths clears the cache
+  boost::filesystem::path otherResourceDir = dir / "other_resources";
+  boost::filesystem::create_directories(otherResourceDir);
+  std::ofstream((otherResourceDir / resource).string());
+  EXPECT_EQ("", sysPaths->FindFile(resource, false));
+  sysPaths->AddGazeboPaths(otherResourceDir.string());
+  EXPECT_EQ((otherResourceDir / resource).string(),
+      sysPaths->FindFile(resource, false));
+
+  // Models are found through the model index, including models of model
+  // paths added afterwards
+  std::string modelUri = "model://cache_model/model.sdf";
+  sysPaths->AddModelPaths(modelDir.string());
+  sysPaths->ScanModelPaths();
+  EXPECT_EQ((modelDir / "cache_model" / "model.sdf").string(),
+      sysPaths->FindFileURI(modelUri));
+  boost::filesystem::path otherModelDir = dir / "other_models";
+  boost::filesystem::create_directories(otherModelDir / "other_model");
+  sysPaths->AddModelPaths(otherModelDir.string());
+  EXPECT_EQ((otherModelDir / "other_model").string(),
+      sysPaths->FindFileURI("model://other_model"));
+
+  boost::filesystem::remove_all(dir);
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
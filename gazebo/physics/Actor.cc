@@ -17,6 +17,7 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
@@ -42,6 +43,63 @@
 
 #include "gazebo/transport/Node.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief A bone of the skin, with what is needed to pose its link.
+    class ActorBone
+    {
+      /// \brief Link of the bone, null if it wasn't found.
+      public: LinkPtr link;
+
+      /// \brief Index of the parent bone, -1 for bones without parent.
+      public: int parent = -1;
+
+      /// \brief Transform of the bone when it isn't animated.
+      public: ignition::math::Matrix4d transform;
+
+      /// \brief Length of the bone, to which BVH offsets are scaled.
+      public: double length = 0.0;
+
+      /// \brief Name of the bone.
+      public: std::string name;
+
+      /// \brief Scoped name of the link.
+      public: std::string linkName;
+
+      /// \brief Id of the link.
+      public: uint32_t linkId = 0;
+    };
+
+    /// \brief The animation nodes driving the bones in a skeleton
+    /// animation.
+    class ActorAnimation
+    {
+      /// \brief The skeleton animation.
+      public: common::SkeletonAnimation *animation = nullptr;
+
+      /// \brief True if the animation is interpolated along X.
+      public: bool interpolateX = false;
+
+      /// \brief Index of the animation node of each bone, as returned by
+      /// SkeletonAnimation::NodeIndex, or -1 for bones without node.
+      public: std::vector<int> nodes;
+
+      /// \brief Index of the animation node of the root bone, or -1.
+      public: int rootNode = -1;
+
+      /// \brief Translations to align the BVH skeleton to the DAE skin,
+      /// for each bone.
+      public: std::vector<ignition::math::Matrix4d> translationAligners;
+
+      /// \brief Rotations to align the BVH skeleton to the DAE skin, for
+      /// each bone.
+      public: std::vector<ignition::math::Matrix4d> rotationAligners;
+    };
+  }
+}
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
@@ -56,11 +114,27 @@ class gazebo::physics::ActorPrivate
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
 
-  /// \brief Last animated frame
-  public: std::map<std::string, ignition::math::Matrix4d> lastFrame;
+  /// \brief Bones of the skin, by handle.
+  public: std::vector<ActorBone> bones;
+
+  /// \brief Handle of the root bone.
+  public: unsigned int rootBone = 0;
+
+  /// \brief Animation nodes of the bones, by skeleton animation name.
+  public: std::map<std::string, ActorAnimation> animations;
+
+  /// \brief Animation of the last animated frame. Null until the first
+  /// frame, in which case the bones are not animated.
+  public: ActorAnimation *frameAnimation = nullptr;
+
+  /// \brief Last animated frame, by animation node.
+  public: std::vector<ignition::math::Matrix4d> frame;
 
-  /// \brief Last map associating skeleton nodes from skin and animation
-  public: std::map<std::string, std::string> lastSkelMap;
+  /// \brief Transform of the root bone in the last animated frame.
+  public: ignition::math::Matrix4d rootTransform;
+
+  /// \brief Skeleton pose message, reused from frame to frame.
+  public: msgs::PoseAnimation poseMsg;
 };
 
 using namespace gazebo;
@@ -646,6 +720,10 @@ void Actor::AlignBvh(Skeleton *_skel,
         * this->dataPtr->translationAligner[animNode->GetName()].Inverse()
         * ignition::math::Matrix4d(skinNode->Transform().Rotation());
   }
+
+  // Aligners changed after the skeleton was resolved
+  if (!this->dataPtr->bones.empty())
+    this->ResolveSkeleton();
 }
 
 //////////////////////////////////////////////////
@@ -656,6 +734,77 @@ void Actor::Init()
   if (this->autoStart)
     this->Play();
   this->mainLink = this->GetChildLink(this->GetName() + "_pose");
+  this->ResolveSkeleton();
+}
+
+//////////////////////////////////////////////////
+void Actor::ResolveSkeleton()
+{
+  if (!this->skeleton)
+    return;
+
+  SkeletonNode *root = this->skeleton->GetRootNode();
+  this->dataPtr->rootBone = root ? root->GetHandle() : 0;
+
+  unsigned int count = this->skeleton->GetNumNodes();
+  this->dataPtr->bones.resize(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    SkeletonNode *node = this->skeleton->GetNodeByHandle(i);
+    ActorBone &bone = this->dataPtr->bones[i];
+
+    bone.name = node->GetName();
+    bone.parent = node->GetParent() ?
+        static_cast<int>(node->GetParent()->GetHandle()) : -1;
+    bone.transform = node->Transform();
+    bone.length = node->Transform().Translation().Length();
+    bone.link = this->GetChildLink(bone.name);
+    if (bone.link)
+    {
+      bone.linkName = bone.link->GetScopedName();
+      bone.linkId = bone.link->GetId();
+    }
+    else
+    {
+      gzerr << "Link for bone [" << bone.name << "] of actor ["
+            << this->GetName() << "] not found." << std::endl;
+    }
+  }
+
+  // Entries are updated in place, since the last frame points to one
+  for (auto const &skelAnim : this->skelAnimation)
+  {
+    ActorAnimation &anim = this->dataPtr->animations[skelAnim.first];
+    anim.animation = skelAnim.second;
+    anim.interpolateX = this->interpolateX[skelAnim.first];
+    anim.nodes.assign(count, -1);
+    anim.rootNode = -1;
+    anim.translationAligners.assign(count, ignition::math::Matrix4d());
+    anim.rotationAligners.assign(count, ignition::math::Matrix4d());
+
+    if (!anim.animation)
+      continue;
+
+    const auto &skelMap = this->skelNodesMap[skelAnim.first];
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      auto nodeName = skelMap.find(this->dataPtr->bones[i].name);
+      if (nodeName == skelMap.end())
+        continue;
+
+      anim.nodes[i] = anim.animation->NodeIndex(nodeName->second);
+      if (i == this->dataPtr->rootBone)
+        anim.rootNode = anim.nodes[i];
+
+      auto aligner = this->dataPtr->translationAligner.find(nodeName->second);
+      if (aligner != this->dataPtr->translationAligner.end())
+        anim.translationAligners[i] = aligner->second;
+
+      aligner = this->dataPtr->rotationAligner.find(nodeName->second);
+      if (aligner != this->dataPtr->rotationAligner.end())
+        anim.rotationAligners[i] = aligner->second;
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -683,8 +832,7 @@ void Actor::Update()
   common::Time currentTime = this->world->SimTime();
   if (!this->active)
   {
-    this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                  currentTime.Double());
+    this->SetPose(currentTime.Double());
     return;
   }
 
@@ -705,8 +853,7 @@ void Actor::Update()
     // waiting for delayed start
     if (this->scriptTime < 0)
     {
-      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                    currentTime.Double());
+      this->SetPose(currentTime.Double());
       return;
     }
 
@@ -790,35 +937,35 @@ void Actor::Update()
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
-
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
+  auto animIter = this->dataPtr->animations.find(tinfo->type);
+  if (animIter == this->dataPtr->animations.end() ||
+      animIter->second.animation != skelAnim)
   {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
+    // The animations changed since the skeleton was resolved
+    this->ResolveSkeleton();
+    animIter = this->dataPtr->animations.find(tinfo->type);
+    if (animIter == this->dataPtr->animations.end())
+      return;
   }
-  else
+  ActorAnimation &anim = animIter->second;
+
+  double animTime = this->scriptTime;
+  if (!this->customTrajectoryInfo && anim.interpolateX &&
+      anim.rootNode >= 0 &&
+      this->trajectories.find(tinfo->id) != this->trajectories.end())
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    animTime = skelAnim->TimeAtX(this->pathLength, anim.rootNode);
   }
 
+  // The frame is interpolated in place, and kept to pose the skeleton
+  // while the actor isn't active
+  skelAnim->PoseAt(animTime, this->dataPtr->frame);
+
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  if (anim.rootNode >= 0)
+    rootTrans = this->dataPtr->frame[anim.rootNode];
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -859,23 +1006,30 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  this->dataPtr->rootTransform = rootM;
+  this->dataPtr->frameAnimation = &anim;
 
-  this->dataPtr->lastFrame = frame;
-  this->dataPtr->lastSkelMap = skelMap;
-
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->SetPose(currentTime.Double());
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::SetPose(const double _time)
 {
-  msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  const ActorAnimation *anim = this->dataPtr->frameAnimation;
+  const std::vector<ignition::math::Matrix4d> &frame = this->dataPtr->frame;
+
+  // Only build the skeleton pose message if it has subscribers. Clearing
+  // keeps the poses allocated by the previous frames.
+  bool publishActor = this->bonePosePub && this->bonePosePub->HasConnections();
+  bool publishWorld = this->world->HasSkeletonPoseConnections();
+  msgs::PoseAnimation &msg = this->dataPtr->poseMsg;
+  if (publishActor || publishWorld)
+  {
+    msg.Clear();
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
 
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
 
   if (this->customTrajectoryInfo)
@@ -884,102 +1038,101 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     mainLinkPose.Rot() = this->worldPose.Rot();
   }
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  for (unsigned int i = 0; i < this->dataPtr->bones.size(); ++i)
   {
-    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
-    ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
+    const ActorBone &bone = this->dataPtr->bones[i];
+    if (!bone.link)
+      continue;
+
+    ignition::math::Matrix4d transform = bone.transform;
 
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
+    int node = anim ? anim->nodes[i] : -1;
+    bool animated = anim && (i == this->dataPtr->rootBone ||
+        (node >= 0 && static_cast<size_t>(node) < frame.size()));
+    if (animated)
     {
+      if (i == this->dataPtr->rootBone)
+        transform = this->dataPtr->rootTransform;
+      else
+        transform = frame[node];
+
       if (this->dataPtr->bvhFile)
       {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
-
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
+        if (i != this->dataPtr->rootBone)
         {
           ignition::math::Vector3d bvhOffset = transform.Translation();
-          ignition::math::Vector3d daeOffset = bone->Transform().Translation();
           // scale bvh offset to dae link length
-          transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
+          transform.SetTranslation(bone.length * bvhOffset.Normalize());
         }
 
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
+        transform = anim->translationAligners[i] * transform *
+            anim->rotationAligners[i];
       }
     }
-    else
-    {
-      transform = bone->Transform();
-    }
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
-      gzerr << "ACTOR: " << _time << " " << bone->GetName()
+      gzerr << "ACTOR: " << _time << " " << bone.name
                 << " " << bonePose << "\n";
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
+    msgs::Pose *bone_pose = nullptr;
+    if (publishActor || publishWorld)
+    {
+      bone_pose = msg.add_pose();
+      bone_pose->set_name(bone.name);
+    }
 
-    if (!parentBone)
+    if (bone.parent < 0)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
+      if (bone_pose)
+        msgs::Set(bone_pose, ignition::math::Pose3d::Zero);
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
-      transform = parentTrans * transform;
+      if (bone_pose)
+        msgs::Set(bone_pose, bonePose);
+      const LinkPtr &parentLink = this->dataPtr->bones[bone.parent].link;
+      if (parentLink)
+      {
+        ignition::math::Matrix4d parentTrans(parentLink->WorldPose());
+        transform = parentTrans * transform;
+      }
     }
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
-    currentLink->SetWorldPose(transform.Pose(), true, false);
+    if (publishActor || publishWorld)
+    {
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(bone.linkName);
+      link_pose->set_id(bone.linkId);
+      msgs::Set(link_pose, transform.Pose() - mainLinkPose);
+    }
+    bone.link->SetWorldPose(transform.Pose(), true, false);
   }
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
-
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
+  if (publishActor || publishWorld)
   {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
-  }
-  else
-  {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
+    msgs::Set(msg.add_time(), common::Time(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    if (!this->customTrajectoryInfo)
+      msgs::Set(model_pose, mainLinkPose);
+    else
+      msgs::Set(model_pose, this->worldPose);
+
+    if (publishActor)
+      this->bonePosePub->Publish(msg);
+    // Swaps msg with a cleared message, so it must be last
+    if (publishWorld)
+      this->world->PublishSkeletonPose(msg);
   }
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
-    this->bonePosePub->Publish(msg);
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
@@ -988,6 +1141,9 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
 void Actor::Fini()
 {
   this->ResetCustomTrajectory();
+  this->dataPtr->frameAnimation = nullptr;
+  this->dataPtr->animations.clear();
+  this->dataPtr->bones.clear();
   Model::Fini();
 }
 
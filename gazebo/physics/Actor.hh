@@ -281,14 +281,15 @@ namespace gazebo
       private: void LoadScript(sdf::ElementPtr _sdf);
 
       /// \brief Set the actor's pose. This sets the pose for each bone in the
-      /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
+      /// skeleton from the last animated frame, and also the actor's pose in
+      /// the world.
       /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      private: void SetPose(const double _time);
+
+      /// \brief Find the link of each bone, and the animation node driving
+      /// each bone in every skeleton animation, so that frames are applied
+      /// without looking up names.
+      private: void ResolveSkeleton();
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
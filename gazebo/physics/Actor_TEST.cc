@@ -15,6 +15,10 @@
  *
 */
 
+#include <mutex>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/Skeleton.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Actor.hh"
 
@@ -24,6 +28,18 @@ using namespace gazebo;
 
 class ActorTest : public ServerFixture { };
 
+std::mutex g_skeletonPosesMutex;
+msgs::PoseAnimation_V g_skeletonPoses;
+unsigned int g_skeletonPosesCount = 0;
+
+// Callback for the skeleton poses published by the world
+void ReceiveSkeletonPoses(ConstPoseAnimation_VPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_skeletonPosesMutex);
+  g_skeletonPoses.CopyFrom(*_msg);
+  ++g_skeletonPosesCount;
+}
+
 //////////////////////////////////////////////////
 TEST_F(ActorTest, Load)
 {
@@ -133,6 +149,55 @@ TEST_F(ActorTest, ActorCollision)
   EXPECT_LT((poseTarget - actor->WorldPose().Pos()).Length(), 0.1);
 }
 
+//////////////////////////////////////////////////
+TEST_F(ActorTest, SkeletonPoses)
+{
+  // Load a world with an actor
+  this->Load("worlds/actor.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+      world->ModelByName("actor"));
+  ASSERT_TRUE(actor != nullptr);
+  ASSERT_TRUE(actor->Mesh() != nullptr);
+  unsigned int boneCount = actor->Mesh()->GetSkeleton()->GetNumNodes();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("~/skeleton_pose/info_v",
+      &ReceiveSkeletonPoses);
+  for (int i = 0; i < 50 && !world->HasSkeletonPoseConnections(); ++i)
+    common::Time::MSleep(100);
+  ASSERT_TRUE(world->HasSkeletonPoseConnections());
+
+  world->Step(100);
+  for (int i = 0; i < 50; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_skeletonPosesMutex);
+      if (g_skeletonPosesCount > 0)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_skeletonPosesMutex);
+  ASSERT_GT(g_skeletonPosesCount, 0u);
+
+  // The poses of every actor updated in a step are in one message
+  ASSERT_EQ(1, g_skeletonPoses.pose_animation_size());
+  const msgs::PoseAnimation &poseAnim = g_skeletonPoses.pose_animation(0);
+  EXPECT_EQ("actor::actor_pose::actor_visual", poseAnim.model_name());
+  EXPECT_EQ(1, poseAnim.time_size());
+
+  // The pose of each bone and of its link, followed by the model pose
+  ASSERT_EQ(static_cast<int>(boneCount * 2 + 1), poseAnim.pose_size());
+  const msgs::Pose &modelPose = poseAnim.pose(poseAnim.pose_size() - 1);
+  EXPECT_EQ(actor->GetScopedName(), modelPose.name());
+  EXPECT_EQ(actor->GetId(), modelPose.id());
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
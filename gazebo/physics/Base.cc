@@ -90,6 +90,9 @@ void Base::Fini()
 {
   this->UnregisterIntrospectionItems();
 
+  if (this->world)
+    this->world->_RemoveFromEntityIndex(this);
+
   // Remove self as a child of the parent
   if (this->parent)
   {
@@ -193,6 +196,9 @@ void Base::AddChild(BasePtr _child)
       == this->children.end())
   {
     this->children.push_back(_child);
+
+    if (this->world)
+      this->world->_AddToEntityIndex(_child);
   }
 }
 
@@ -272,6 +278,18 @@ void Base::RemoveChild(physics::BasePtr _child)
 //////////////////////////////////////////////////
 void Base::RemoveChildren()
 {
+  // The children are no longer part of the entity tree
+  if (this->world)
+  {
+    Base_V removed = this->children;
+    for (size_t i = 0; i < removed.size(); ++i)
+    {
+      this->world->_RemoveFromEntityIndex(removed[i].get());
+      for (unsigned int c = 0; c < removed[i]->GetChildCount(); ++c)
+        removed.push_back(removed[i]->GetChild(c));
+    }
+  }
+
   this->children.clear();
 }
 
@@ -302,6 +320,8 @@ BasePtr Base::GetByIdRecursive(unsigned int _id)
   }
 
   BasePtr result;
+  if (this->world && this->world->_EntityIndexById(_id, this, result))
+    return result;
   Base_V::const_iterator biter;
 
   for (biter = this->children.begin();
@@ -320,6 +340,8 @@ BasePtr Base::GetByName(const std::string &_name)
     return shared_from_this();
 
   BasePtr result;
+  if (this->world && this->world->_EntityIndexByName(_name, this, result))
+    return result;
   Base_V::const_iterator iter;
 
   for (iter = this->children.begin();
@@ -432,6 +454,9 @@ void Base::ComputeScopedName()
       this->scopedName.insert(0, p->GetName()+"::");
     p = p->GetParent();
   }
+
+  if (this->world)
+    this->world->_UpdateEntityIndex(this);
 }
 
 //////////////////////////////////////////////////
@@ -491,6 +516,10 @@ void Base::SetWorld(const WorldPtr &_newWorld)
 {
   this->world = _newWorld;
 
+  // The root of the entity tree of a world
+  if (!this->parent && this->world)
+    this->world->_AddToEntityIndex(shared_from_this());
+
   Base_V::iterator iter;
   for (iter = this->children.begin(); iter != this->children.end(); ++iter)
   {
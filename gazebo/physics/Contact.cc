@@ -19,6 +19,8 @@
  * Date: 10 Nov 2009
  */
 
+#include <algorithm>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Contact.hh"
@@ -30,6 +32,8 @@ using namespace physics;
 //////////////////////////////////////////////////
 Contact::Contact()
 {
+  this->collision1 = nullptr;
+  this->collision2 = nullptr;
   this->count = 0;
 }
 
@@ -51,14 +55,12 @@ Contact &Contact::operator =(const Contact &_contact)
   this->collision1 = _contact.collision1;
   this->collision2 = _contact.collision2;
 
-  this->count = _contact.count;
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-  {
-    this->wrench[i] = _contact.wrench[i];
-    this->positions[i] = _contact.positions[i];
-    this->normals[i] = _contact.normals[i];
-    this->depths[i] = _contact.depths[i];
-  }
+  this->Resize(_contact.count);
+  std::copy_n(_contact.wrench.begin(), this->count, this->wrench.begin());
+  std::copy_n(_contact.positions.begin(), this->count,
+      this->positions.begin());
+  std::copy_n(_contact.normals.begin(), this->count, this->normals.begin());
+  std::copy_n(_contact.depths.begin(), this->count, this->depths.begin());
 
   this->time = _contact.time;
 
@@ -68,7 +70,7 @@ Contact &Contact::operator =(const Contact &_contact)
 //////////////////////////////////////////////////
 Contact &Contact::operator =(const msgs::Contact &_contact)
 {
-  this->count = 0;
+  this->Resize(_contact.position_size());
 
   this->world = physics::get_world(_contact.world());
 
@@ -104,8 +106,6 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
 
     this->wrench[j].body2Torque =
       msgs::ConvertIgn(_contact.wrench(j).body_2_wrench().torque());
-
-    this->count++;
   }
 
   this->time = msgs::Convert(_contact.time());
@@ -116,7 +116,29 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
 //////////////////////////////////////////////////
 void Contact::Reset()
 {
-  this->count = 0;
+  this->Resize(0);
+}
+
+//////////////////////////////////////////////////
+void Contact::Resize(const int _count)
+{
+  this->count = std::max(_count, 0);
+
+  // Shrinking keeps the capacity, and growing zero initializes the new
+  // points.
+  this->wrench.resize(this->count);
+  this->positions.resize(this->count);
+  this->normals.resize(this->count);
+  this->depths.resize(this->count);
+}
+
+//////////////////////////////////////////////////
+size_t Contact::AllocatedBytes() const
+{
+  return this->wrench.capacity() * sizeof(JointWrench) +
+    this->positions.capacity() * sizeof(ignition::math::Vector3d) +
+    this->normals.capacity() * sizeof(ignition::math::Vector3d) +
+    this->depths.capacity() * sizeof(double);
 }
 
 //////////////////////////////////////////////////
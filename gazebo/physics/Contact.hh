@@ -27,7 +27,6 @@
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/util/system.hh"
 
-// For the sake of efficiency, use fixed size arrays for collision
 // MAX_COLLIDE_RETURNS limits contact detection, needs to be large
 //                      for proper contact dynamics.
 // MAX_CONTACT_JOINTS truncates <max_contacts> specified in SDF
@@ -75,9 +74,20 @@ namespace gazebo
       /// \return A string that contains the values of the contact.
       public: std::string DebugString() const;
 
-      /// \brief Reset to default values.
+      /// \brief Reset to default values. Memory used by the contact points
+      /// is kept, so that pooled contacts don't reallocate every step.
       public: void Reset();
 
+      /// \brief Set the number of contact points and size the wrench,
+      /// positions, normals and depths arrays to match. Existing points keep
+      /// their values and new points are zero.
+      /// \param[in] _count Number of contact points.
+      public: void Resize(const int _count);
+
+      /// \brief Get the number of bytes allocated for the contact points.
+      /// \return Allocated size in bytes.
+      public: size_t AllocatedBytes() const;
+
       /// \brief Pointer to the first collision object
       public: Collision *collision1;
 
@@ -88,16 +98,17 @@ namespace gazebo
       /// All forces and torques are in the world frame.
       /// All forces and torques are relative to the center of mass of the
       /// respective links that the collision elments are attached to.
-      public: JointWrench wrench[MAX_CONTACT_JOINTS];
+      /// Use Resize before writing new contact points.
+      public: std::vector<JointWrench> wrench;
 
       /// \brief Array of force positions.
-      public: ignition::math::Vector3d positions[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> positions;
 
       /// \brief Array of force normals.
-      public: ignition::math::Vector3d normals[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> normals;
 
       /// \brief Array of contact depths
-      public: double depths[MAX_CONTACT_JOINTS];
+      public: std::vector<double> depths;
 
       /// \brief Length of all the arrays.
       public: int count;
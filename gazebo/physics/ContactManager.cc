@@ -228,7 +228,7 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   if (!result)
     return result;
 
-  result->count = 0;
+  result->Reset();
   result->collision1 = _collision1;
   result->collision2 = _collision2;
   result->time = _time;
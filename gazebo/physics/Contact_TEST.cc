@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "test/util.hh"
+#include "gazebo/physics/Contact.hh"
+
+using namespace gazebo;
+
+class ContactTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ContactTest, Resize)
+{
+  physics::Contact contact;
+  EXPECT_EQ(0, contact.count);
+  EXPECT_EQ(0u, contact.AllocatedBytes());
+
+  contact.Resize(3);
+  EXPECT_EQ(3, contact.count);
+  ASSERT_EQ(3u, contact.positions.size());
+  ASSERT_EQ(3u, contact.normals.size());
+  ASSERT_EQ(3u, contact.depths.size());
+  ASSERT_EQ(3u, contact.wrench.size());
+  EXPECT_GT(contact.AllocatedBytes(), 0u);
+
+  contact.positions[2].Set(1, 2, 3);
+  contact.depths[2] = 0.1;
+  contact.wrench[2].body1Force.Set(0, 0, 10);
+
+  // Growing keeps existing points and zeroes new ones
+  contact.Resize(4);
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3), contact.positions[2]);
+  EXPECT_DOUBLE_EQ(0.1, contact.depths[2]);
+  EXPECT_EQ(ignition::math::Vector3d::Zero, contact.wrench[3].body1Force);
+  EXPECT_DOUBLE_EQ(0.0, contact.depths[3]);
+
+  // Reset keeps the memory for the next step, and reused points start
+  // from zero
+  size_t bytes = contact.AllocatedBytes();
+  contact.Reset();
+  EXPECT_EQ(0, contact.count);
+  EXPECT_EQ(bytes, contact.AllocatedBytes());
+  contact.Resize(3);
+  EXPECT_EQ(ignition::math::Vector3d::Zero, contact.positions[2]);
+  EXPECT_EQ(ignition::math::Vector3d::Zero, contact.wrench[2].body1Force);
+  EXPECT_EQ(bytes, contact.AllocatedBytes());
+
+  // Negative counts are clamped
+  contact.Resize(-1);
+  EXPECT_EQ(0, contact.count);
+  EXPECT_TRUE(contact.positions.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactTest, Copy)
+{
+  physics::Contact contact;
+  contact.Resize(2);
+  contact.positions[1].Set(1, 2, 3);
+  contact.normals[1].Set(0, 0, 1);
+  contact.depths[1] = 0.5;
+  contact.wrench[1].body2Torque.Set(4, 5, 6);
+  contact.time.Set(2, 0);
+
+  physics::Contact copy(contact);
+  EXPECT_EQ(2, copy.count);
+  ASSERT_EQ(2u, copy.positions.size());
+  EXPECT_EQ(contact.positions[1], copy.positions[1]);
+  EXPECT_EQ(contact.normals[1], copy.normals[1]);
+  EXPECT_DOUBLE_EQ(contact.depths[1], copy.depths[1]);
+  EXPECT_EQ(contact.wrench[1].body2Torque, copy.wrench[1].body2Torque);
+  EXPECT_EQ(contact.time, copy.time);
+
+  // Assigning a smaller contact shrinks the arrays
+  physics::Contact empty;
+  copy = empty;
+  EXPECT_EQ(0, copy.count);
+  EXPECT_TRUE(copy.depths.empty());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -488,6 +488,16 @@ void Entity::SetWorldPose(const ignition::math::Pose3d &_pose,
     std::lock_guard<std::mutex> lock(this->GetWorld()->WorldPoseMutex());
     (*this.*setWorldPoseFunc)(_pose, _notify, _publish);
   }
+
+  // Record the models containing the entity, the spatial index collects
+  // them when it refits.
+  physics::SpatialIndex &index = this->GetWorld()->SpatialIndex();
+  for (Entity *entity = this; entity; entity = entity->parentEntity.get())
+  {
+    if (entity->HasType(MODEL))
+      index.MarkMoved(static_cast<Model *>(entity));
+  }
+
   if (_publish)
     this->PublishPose();
 }
@@ -16,7 +16,13 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -24,6 +30,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/HeightmapBuffer.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 #include "gazebo/physics/HeightmapShape.hh"
 #include "gazebo/physics/World.hh"
@@ -32,15 +39,89 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace gazebo
+{
+  namespace physics
+  {
+/// \internal
+/// \brief Private data for the HeightmapShape class, kept out of the class
+/// to keep its layout.
+class HeightmapShapePrivate
+{
+  /// \brief Heights loaded by Init, shared with the other users of the
+  /// same terrain. Kept after SetHeight copies the heights, since physics
+  /// engines without a copy callback may still point to them.
+  public: common::HeightmapBufferPtr sharedHeights;
+
+  /// \brief Heights in use, either sharedHeights or HeightmapShape::heights.
+  public: const HeightmapShape::HeightType *data = nullptr;
+
+  /// \brief Number of heights.
+  public: size_t count = 0;
+
+  /// \brief Called when SetHeight copies the shared heights.
+  public: std::function<void (const HeightmapShape::HeightType *)>
+          heightsCopied;
+
+  /// \brief Lowest height of HeightmapShape::heights.
+  public: HeightmapShape::HeightType minHeight = 0;
+
+  /// \brief Highest height of HeightmapShape::heights.
+  public: HeightmapShape::HeightType maxHeight = 0;
+
+  /// \brief False if minHeight and maxHeight must be computed again.
+  public: bool rangeValid = false;
+};
+  }
+}
+
+/// \brief Protects g_heightmapShapes.
+static std::mutex g_heightmapShapesMutex;
+
+/// \brief Private data of every heightmap shape.
+/// TODO: Move to a data pointer member when porting forward
+static std::unordered_map<const HeightmapShape *,
+    std::unique_ptr<HeightmapShapePrivate>> g_heightmapShapes;
+
+//////////////////////////////////////////////////
+/// \brief Get the private data of a heightmap shape.
+/// \param[in] _shape The shape.
+/// \return The private data, created by the constructor of the shape.
+static HeightmapShapePrivate &shapeData(const HeightmapShape *_shape)
+{
+  std::lock_guard<std::mutex> lock(g_heightmapShapesMutex);
+  return *g_heightmapShapes.at(_shape);
+}
+
+//////////////////////////////////////////////////
+/// \brief Scan the copied heights of a shape if SetHeight changed its
+/// lowest or highest height.
+/// \param[in] _heights The copied heights.
+/// \param[in,out] _shapePriv The private data holding the height range.
+static void updateHeightRange(
+    const std::vector<HeightmapShape::HeightType> &_heights,
+    HeightmapShapePrivate &_shapePriv)
+{
+  if (_shapePriv.rangeValid || _heights.empty())
+    return;
+
+  auto range = std::minmax_element(_heights.begin(), _heights.end());
+  _shapePriv.minHeight = *range.first;
+  _shapePriv.maxHeight = *range.second;
+  _shapePriv.rangeValid = true;
+}
 
 //////////////////////////////////////////////////
 HeightmapShape::HeightmapShape(CollisionPtr _parent)
     : Shape(_parent)
 {
-  static_assert(
-      std::is_same<HeightType, float>::value ||
-      std::is_same<HeightType, double>::value,
-      "Height field needs to be double or float");
+  {
+    std::lock_guard<std::mutex> lock(g_heightmapShapesMutex);
+    g_heightmapShapes[this].reset(new HeightmapShapePrivate);
+  }
+
+  static_assert(std::is_same<HeightType, float>::value,
+      "Height field needs to be float, like common::HeightmapBuffer");
   this->vertSize = 0;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
@@ -53,6 +134,12 @@ HeightmapShape::~HeightmapShape()
   if (this->node)
     this->node->Fini();
   this->node.reset();
+
+  delete this->heightmapData;
+  this->heightmapData = nullptr;
+
+  std::lock_guard<std::mutex> lock(g_heightmapShapesMutex);
+  g_heightmapShapes.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -68,7 +155,27 @@ void HeightmapShape::OnRequest(ConstRequestPtr &_msg)
     response.set_response("success");
 
     this->FillMsg(msg);
-    this->FillHeights(msg);
+
+    // The data of the request may select a tile of rows, as
+    // "<first row> <row count>". Without it, all the heights are sent.
+    unsigned int firstRow = 0;
+    unsigned int rowCount = this->vertSize;
+    if (_msg->has_data() && !_msg->data().empty())
+    {
+      std::istringstream tile(_msg->data());
+      if (!(tile >> firstRow >> rowCount))
+      {
+        gzerr << "Invalid heightmap tile[" << _msg->data() << "]\n";
+        response.set_response("invalid tile");
+        firstRow = rowCount = 0;
+      }
+      else if (rowCount == 0)
+      {
+        // Let the server choose tiles of a few million heights
+        rowCount = std::max(1u, (1u << 22) / std::max(1u, this->vertSize));
+      }
+    }
+    this->FillHeights(msg, firstRow, rowCount);
 
     response.set_type(msg.GetTypeName());
     std::string *serializedData = response.mutable_serialized_data();
@@ -97,17 +204,16 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
   auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
   if (demData)
   {
-    this->dem = *demData;
     if (this->sdf->HasElement("size"))
     {
       this->heightmapSize = this->sdf->Get<ignition::math::Vector3d>("size");
     }
     else
     {
-      this->heightmapSize.X() = this->dem.GetWorldWidth();
-      this->heightmapSize.Y() = this->dem.GetWorldHeight();
-      this->heightmapSize.Z() = this->dem.GetMaxElevation() -
-          this->dem.GetMinElevation();
+      this->heightmapSize.X() = demData->GetWorldWidth();
+      this->heightmapSize.Y() = demData->GetWorldHeight();
+      this->heightmapSize.Z() = demData->GetMaxElevation() -
+          demData->GetMinElevation();
     }
 
     // Modify the reference geotedic latitude/longitude.
@@ -120,7 +226,7 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
 
       try
       {
-        this->dem.GetGeoReferenceOrigin(latitude, longitude);
+        demData->GetGeoReferenceOrigin(latitude, longitude);
       }
       catch(const common::Exception &)
       {
@@ -128,7 +234,7 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
                << "SphericalCoordiantes and GpsSensor may not function properly."
                << std::endl;
       }
-      elevation = this->dem.GetElevation(0.0, 0.0);
+      elevation = demData->GetElevation(0.0, 0.0);
 
       sphericalCoordinates->SetLatitudeReference(latitude);
       sphericalCoordinates->SetLongitudeReference(longitude);
@@ -201,6 +307,21 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     gzerr << "Heightmap data size must be square, with a size of 2^n+1\n";
     return;
   }
+
+#ifdef HAVE_GDAL
+  // Bound the memory used to decode DEMs. This element is not part of the
+  // SDFormat spec. Collisions are always sampled at full resolution, like
+  // the rendering heightmap, so that both share the same heights.
+  const std::string kCacheSize = "gz:terrain_cache_size";
+  auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
+  if (demData && this->sdf->HasElement(kCacheSize))
+  {
+    // In MB
+    demData->SetCacheSize(
+        static_cast<size_t>(this->sdf->Get<unsigned int>(kCacheSize)) *
+        1024u * 1024u);
+  }
+#endif
 }
 
 //////////////////////////////////////////////////
@@ -258,8 +379,16 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
-  // Construct the heightmap lookup table
-  this->FillHeightfield(this->heights);
+  // Construct the heightmap lookup table, or share it with the other users
+  // of the same terrain
+  std::string filename = common::find_file(this->GetURI());
+  HeightmapShapePrivate &shapePriv = shapeData(this);
+  shapePriv.sharedHeights = common::HeightmapBuffer::Load(
+      *this->heightmapData, filename, this->subSampling, this->vertSize,
+      this->Size(), this->scale, this->flipY);
+  this->heights.clear();
+  shapePriv.data = shapePriv.sharedHeights->Data();
+  shapePriv.count = shapePriv.sharedHeights->Count();
 }
 
 //////////////////////////////////////////////////
@@ -307,13 +436,36 @@ void HeightmapShape::FillMsg(msgs::Geometry &_msg)
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
 {
-  for (unsigned int y = 0; y < this->vertSize; ++y)
+  this->FillHeights(_msg, 0, this->vertSize);
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::FillHeights(msgs::Geometry &_msg,
+    const unsigned int _firstRow, const unsigned int _rowCount) const
+{
+  msgs::HeightmapGeom *heightmapMsg = _msg.mutable_heightmap();
+  const unsigned int firstRow = std::min(_firstRow, this->vertSize);
+  const unsigned int rowCount =
+    std::min(_rowCount, this->vertSize - firstRow);
+  heightmapMsg->set_tile_row(firstRow);
+  heightmapMsg->set_tile_rows(rowCount);
+  const HeightmapShapePrivate &shapePriv = shapeData(this);
+  if (!shapePriv.data || rowCount == 0 ||
+      shapePriv.count < this->vertSize * this->vertSize)
   {
-    for (unsigned int x = 0; x < this->vertSize; ++x)
-    {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
-    }
+    return;
+  }
+
+  // Rows are sent in the reverse order of the lookup table, and copied whole
+  auto *msgHeights = heightmapMsg->mutable_heights();
+  const int offset = msgHeights->size();
+  msgHeights->Resize(offset + rowCount * this->vertSize, 0);
+  for (unsigned int y = 0; y < rowCount; ++y)
+  {
+    const unsigned int row = this->vertSize - (firstRow + y) - 1;
+    std::memcpy(msgHeights->mutable_data() + offset + y * this->vertSize,
+        shapePriv.data + row * this->vertSize,
+        this->vertSize * sizeof(float));
   }
 }
 
@@ -333,50 +485,104 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
   int index =  _y * this->vertSize + _x;
-  if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
+  const HeightmapShapePrivate &shapePriv = shapeData(this);
+  if (!shapePriv.data || _x < 0 || _y < 0 ||
+      index >= static_cast<int>(shapePriv.count))
+  {
     return 0.0;
+  }
 
-  return this->heights[index];
+  return shapePriv.data[index];
 }
 
 /////////////////////////////////////////////////
 void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 {
   int index =  _y * this->vertSize + _x;
-  if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
+  HeightmapShapePrivate &shapePriv = shapeData(this);
+  if (!shapePriv.data || _x < 0 || _y < 0 ||
+      index >= static_cast<int>(shapePriv.count))
   {
     gzerr << "SetHeight position (" << _x << ", " << _y << ")"
           << " is out of bounds" << std::endl;
     return;
   }
 
+  // Copy the shared heights before the first change. Later changes are
+  // made in place, and seen by the physics engine pointing to the copy.
+  bool copied = false;
+  if (this->heights.empty())
+  {
+    this->heights.assign(shapePriv.data,
+        shapePriv.data + shapePriv.count);
+    shapePriv.data = this->heights.data();
+    shapePriv.minHeight = shapePriv.sharedHeights->Min();
+    shapePriv.maxHeight = shapePriv.sharedHeights->Max();
+    shapePriv.rangeValid = true;
+    copied = true;
+  }
+
+  // Only scan the heights again if the old value was an extreme
+  const HeightType old = this->heights[index];
   this->heights[index] = _h;
+  if ((old == shapePriv.minHeight && _h > old) ||
+      (old == shapePriv.maxHeight && _h < old))
+  {
+    shapePriv.rangeValid = false;
+  }
+  else
+  {
+    shapePriv.minHeight = std::min(shapePriv.minHeight, _h);
+    shapePriv.maxHeight = std::max(shapePriv.maxHeight, _h);
+  }
+
+  if (copied && shapePriv.heightsCopied)
+    shapePriv.heightsCopied(shapePriv.data);
+}
+
+/////////////////////////////////////////////////
+const HeightmapShape::HeightType *HeightmapShape::HeightData() const
+{
+  return shapeData(this).data;
+}
+
+/////////////////////////////////////////////////
+void HeightmapShape::SetHeightsCopiedCallback(
+    std::function<void (const HeightType *)> _callback)
+{
+  shapeData(this).heightsCopied = _callback;
 }
 
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
-  HeightType max = -std::numeric_limits<HeightType>::max();
-  for (unsigned int i = 0; i < this->heights.size(); ++i)
+  HeightmapShapePrivate &shapePriv = shapeData(this);
+  if (!this->heights.empty())
   {
-    if (this->heights[i] > max)
-      max = this->heights[i];
+    updateHeightRange(this->heights, shapePriv);
+    return shapePriv.maxHeight;
   }
 
-  return max;
+  if (!shapePriv.sharedHeights || shapePriv.count == 0)
+    return -std::numeric_limits<HeightType>::max();
+
+  return shapePriv.sharedHeights->Max();
 }
 
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
-  HeightType min = std::numeric_limits<HeightType>::max();
-  for (unsigned int i = 0; i < this->heights.size(); ++i)
+  HeightmapShapePrivate &shapePriv = shapeData(this);
+  if (!this->heights.empty())
   {
-    if (this->heights[i] < min)
-      min = this->heights[i];
+    updateHeightRange(this->heights, shapePriv);
+    return shapePriv.minHeight;
   }
 
-  return min;
+  if (!shapePriv.sharedHeights || shapePriv.count == 0)
+    return std::numeric_limits<HeightType>::max();
+
+  return shapePriv.sharedHeights->Min();
 }
 
 //////////////////////////////////////////////////
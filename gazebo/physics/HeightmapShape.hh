@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
@@ -89,7 +90,10 @@ namespace gazebo
       /// \return The height at a the specified location.
       public: HeightType GetHeight(int _x, int _y) const;
 
-      /// \brief Sets a height value at a position.
+      /// \brief Sets a height value at a position. The first call copies
+      /// the heights, which are otherwise shared with the other users of the
+      /// same terrain, into the heights member, and points the physics
+      /// engine to the copy.
       /// \param[in] _x X position.
       /// \param[in] _y Y position.
       /// \param[in] _h Height to set.
@@ -105,6 +109,15 @@ namespace gazebo
       /// \param[in] _msg Message to fill.
       public: void FillHeights(msgs::Geometry &_msg) const;
 
+      /// \brief Fill a geometry message with a tile of this shape's height
+      /// data, made of whole rows, in the order of FillHeights.
+      /// \param[in] _msg Message to fill.
+      /// \param[in] _firstRow Index of the first row of the tile.
+      /// \param[in] _rowCount Maximum number of rows of the tile.
+      public: void FillHeights(msgs::Geometry &_msg,
+                  const unsigned int _firstRow,
+                  const unsigned int _rowCount) const;
+
       /// \brief Update the heightmap from a message.
       /// \param[in] _msg Message to update from.
       public: virtual void ProcessMsg(const msgs::Geometry &_msg);
@@ -112,11 +125,13 @@ namespace gazebo
       /// Documentation inherited
       public: virtual double ComputeVolume() const;
 
-      /// \brief Get the maximum height.
+      /// \brief Get the maximum height. The heights are only scanned again
+      /// after SetHeight lowered the highest height.
       /// \return The maximum height.
       public: HeightType GetMaxHeight() const;
 
-      /// \brief Get the minimum height.
+      /// \brief Get the minimum height. The heights are only scanned again
+      /// after SetHeight raised the lowest height.
       /// \return The minimum height.
       public: HeightType GetMinHeight() const;
 
@@ -149,14 +164,27 @@ namespace gazebo
       /// \brief Version of FillHeightfield() for double vectors.
       public: void FillHeightfield(std::vector<double>& heights);
 
-      /// \brief Lookup table of heights.
+      /// \brief Get the heights of the lookup table. They are shared with
+      /// the other users of the same terrain until SetHeight copies them
+      /// into heights.
+      /// \return Pointer to the first height, null before Init.
+      protected: const HeightType *HeightData() const;
+
+      /// \brief Set a function called when SetHeight copies the shared
+      /// heights, so that a physics engine pointing to them uses the copy.
+      /// \param[in] _callback Function given the copied heights.
+      protected: void SetHeightsCopiedCallback(
+                     std::function<void (const HeightType *)> _callback);
+
+      /// \brief Lookup table of heights, once modified by SetHeight. Empty
+      /// while the heights are shared, see HeightData.
       protected: std::vector<HeightType> heights;
 
       /// \brief Image used to generate the heights.
       protected: common::ImageHeightmap img;
 
       /// \brief HeightmapData used to generate the heights.
-      protected: common::HeightmapData *heightmapData;
+      protected: common::HeightmapData *heightmapData = nullptr;
 
       /// \brief Size of the height lookup table.
       protected: unsigned int vertSize;
@@ -183,7 +211,7 @@ namespace gazebo
       private: ignition::math::Vector3d heightmapSize;
 
       #ifdef HAVE_GDAL
-      /// \brief DEM used to generate the heights.
+      /// \brief Unused, heightmapData holds the DEM.
       private: common::Dem dem;
       #endif
 
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -70,11 +71,32 @@ JointController::~JointController()
 void JointController::AddJoint(JointPtr _joint)
 {
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  this->dataPtr->joints[_joint->GetScopedName()] = _joint;
-  this->dataPtr->posPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
-  this->dataPtr->velPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
+  const std::string name = _joint->GetScopedName();
+
+  unsigned int handle;
+  auto iter = this->dataPtr->handles.find(name);
+  if (iter != this->dataPtr->handles.end())
+  {
+    handle = iter->second;
+  }
+  else
+  {
+    handle = this->dataPtr->joints.size();
+    this->dataPtr->handles[name] = handle;
+    this->dataPtr->joints.push_back(JointPtr());
+    this->dataPtr->posPids.push_back(common::PID());
+    this->dataPtr->velPids.push_back(common::PID());
+    this->dataPtr->forces.push_back(0);
+    this->dataPtr->positions.push_back(0);
+    this->dataPtr->velocities.push_back(0);
+    this->dataPtr->hasForce.push_back(0);
+    this->dataPtr->hasPosition.push_back(0);
+    this->dataPtr->hasVelocity.push_back(0);
+  }
+
+  this->dataPtr->joints[handle] = _joint;
+  this->dataPtr->posPids[handle].Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
+  this->dataPtr->velPids[handle].Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
 }
 
 /////////////////////////////////////////////////
@@ -83,33 +105,34 @@ void JointController::RemoveJoint(Joint *_joint)
   if (_joint)
   {
     std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-    this->dataPtr->joints.erase(_joint->GetScopedName());
-    this->dataPtr->posPids.erase(_joint->GetScopedName());
-    this->dataPtr->velPids.erase(_joint->GetScopedName());
+    int handle = this->dataPtr->Handle(_joint->GetScopedName());
+    if (handle >= 0)
+    {
+      this->dataPtr->joints[handle].reset();
+      this->dataPtr->hasForce[handle] = 0;
+      this->dataPtr->hasPosition[handle] = 0;
+      this->dataPtr->hasVelocity[handle] = 0;
+    }
   }
 }
 
 /////////////////////////////////////////////////
 void JointController::Reset()
 {
-  // Reset setpoints and feed-forward.
-  this->dataPtr->positions.clear();
-  this->dataPtr->velocities.clear();
-  this->dataPtr->forces.clear();
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
 
-  std::map<std::string, common::PID>::iterator iter;
+  // Reset setpoints and feed-forward.
+  std::fill(this->dataPtr->hasForce.begin(), this->dataPtr->hasForce.end(), 0);
+  std::fill(this->dataPtr->hasPosition.begin(),
+      this->dataPtr->hasPosition.end(), 0);
+  std::fill(this->dataPtr->hasVelocity.begin(),
+      this->dataPtr->hasVelocity.end(), 0);
 
-  for (iter = this->dataPtr->posPids.begin();
-    iter != this->dataPtr->posPids.end(); ++iter)
-  {
-    iter->second.Reset();
-  }
+  for (auto &pid : this->dataPtr->posPids)
+    pid.Reset();
 
-  for (iter = this->dataPtr->velPids.begin();
-    iter != this->dataPtr->velPids.end(); ++iter)
-  {
-    iter->second.Reset();
-  }
+  for (auto &pid : this->dataPtr->velPids)
+    pid.Reset();
 }
 
 /////////////////////////////////////////////////
@@ -120,53 +143,65 @@ void JointController::Update()
   common::Time stepTime = currTime - this->dataPtr->prevUpdateTime;
   this->dataPtr->prevUpdateTime = currTime;
 
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+
+  // Apply the queued commands, oldest first so that the last one wins.
+  IGN_PROFILE_BEGIN("commands");
+  this->dataPtr->commands.Pop([this](const JointCommand &_queued)
+  {
+    switch (_queued.type)
+    {
+      case JointCommand::FORCE:
+        this->dataPtr->SetForce(_queued.handle, _queued.value);
+        break;
+      case JointCommand::POSITION:
+        this->dataPtr->SetPositionTarget(_queued.handle, _queued.value);
+        break;
+      case JointCommand::VELOCITY:
+        this->dataPtr->SetVelocityTarget(_queued.handle, _queued.value);
+        break;
+    }
+  });
+  IGN_PROFILE_END();
+
   // Skip the update step if SimTime appears to have gone backward.
   // Negative update time wreaks havok on the integrators.
   // This happens when World::ResetTime is called.
   // TODO: fix this when World::ResetTime is improved
   if (stepTime > 0)
   {
-    std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+    const size_t count = this->dataPtr->joints.size();
+
     IGN_PROFILE_BEGIN("forces");
-    if (!this->dataPtr->forces.empty())
+    for (size_t i = 0; i < count; ++i)
     {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
+      if (this->dataPtr->hasForce[i])
+        this->dataPtr->joints[i]->SetForce(0, this->dataPtr->forces[i]);
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("positions");
-    if (!this->dataPtr->positions.empty())
+    for (size_t i = 0; i < count; ++i)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
+      if (this->dataPtr->hasPosition[i])
       {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
+        double cmd = this->dataPtr->posPids[i].Update(
+            this->dataPtr->joints[i]->Position(0) -
+            this->dataPtr->positions[i], stepTime);
+        this->dataPtr->joints[i]->SetForce(0, cmd);
       }
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("velocities");
-    if (!this->dataPtr->velocities.empty())
+    for (size_t i = 0; i < count; ++i)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
+      if (this->dataPtr->hasVelocity[i])
       {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
+        double cmd = this->dataPtr->velPids[i].Update(
+            this->dataPtr->joints[i]->GetVelocity(0) -
+            this->dataPtr->velocities[i], stepTime);
+        this->dataPtr->joints[i]->SetForce(0, cmd);
       }
     }
     IGN_PROFILE_END();
@@ -199,47 +234,43 @@ bool JointController::OnJointCmdReq(const ignition::msgs::StringMsg &_req,
   const std::string &jointName = _req.data();
   _rep.set_name(jointName);
 
-  if (this->dataPtr->forces.find(jointName) !=
-      this->dataPtr->forces.end())
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  int handle = this->dataPtr->Handle(jointName);
+  if (handle < 0)
+    return true;
+
+  if (this->dataPtr->hasForce[handle])
   {
-    _rep.mutable_force_optional()->set_data(this->dataPtr->forces[jointName]);
+    _rep.mutable_force_optional()->set_data(this->dataPtr->forces[handle]);
   }
 
-  if (this->dataPtr->positions.find(jointName) !=
-      this->dataPtr->positions.end())
+  if (this->dataPtr->hasPosition[handle])
   {
     _rep.mutable_position()->mutable_target_optional()->set_data(
-        this->dataPtr->positions[jointName]);
+        this->dataPtr->positions[handle]);
   }
 
-  if (this->dataPtr->velocities.find(jointName) !=
-      this->dataPtr->velocities.end())
+  if (this->dataPtr->hasVelocity[handle])
   {
     _rep.mutable_velocity()->mutable_target_optional()->set_data(
-        this->dataPtr->velocities[jointName]);
+        this->dataPtr->velocities[handle]);
   }
 
-  if (this->dataPtr->posPids.find(jointName) !=
-      this->dataPtr->posPids.end())
-  {
-    _rep.mutable_position()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetPGain());
-    _rep.mutable_position()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetDGain());
-    _rep.mutable_position()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetIGain());
-  }
-
-  if (this->dataPtr->velPids.find(jointName) !=
-      this->dataPtr->velPids.end())
-  {
-    _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetPGain());
-    _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetDGain());
-    _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetIGain());
-  }
+  const common::PID &posPid = this->dataPtr->posPids[handle];
+  _rep.mutable_position()->mutable_p_gain_optional()->set_data(
+      posPid.GetPGain());
+  _rep.mutable_position()->mutable_d_gain_optional()->set_data(
+      posPid.GetDGain());
+  _rep.mutable_position()->mutable_i_gain_optional()->set_data(
+      posPid.GetIGain());
+
+  const common::PID &velPid = this->dataPtr->velPids[handle];
+  _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
+      velPid.GetPGain());
+  _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
+      velPid.GetDGain());
+  _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
+      velPid.GetIGain());
 
   return true;
 }
@@ -247,136 +278,81 @@ bool JointController::OnJointCmdReq(const ignition::msgs::StringMsg &_req,
 /////////////////////////////////////////////////
 void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
 {
-  std::map<std::string, JointPtr>::iterator iter;
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  iter = this->dataPtr->joints.find(_msg.name());
-  if (iter != this->dataPtr->joints.end())
+  int handle = this->dataPtr->Handle(_msg.name());
+  if (handle >= 0)
   {
     if (_msg.reset())
     {
-      if (this->dataPtr->forces.find(_msg.name()) !=
-          this->dataPtr->forces.end())
-      {
-        this->dataPtr->forces.erase(this->dataPtr->forces.find(_msg.name()));
-      }
-
-      if (this->dataPtr->positions.find(_msg.name()) !=
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions.erase(
-            this->dataPtr->positions.find(_msg.name()));
-      }
-
-      if (this->dataPtr->velocities.find(_msg.name()) !=
-          this->dataPtr->velocities.end())
-      {
-        this->dataPtr->velocities.erase(
-            this->dataPtr->velocities.find(_msg.name()));
-      }
+      this->dataPtr->hasForce[handle] = 0;
+      this->dataPtr->hasPosition[handle] = 0;
+      this->dataPtr->hasVelocity[handle] = 0;
     }
 
     if (_msg.has_force_optional())
-      this->dataPtr->forces[_msg.name()] = _msg.force_optional().data();
+      this->dataPtr->SetForce(handle, _msg.force_optional().data());
 
     if (_msg.has_position())
     {
+      common::PID &pid = this->dataPtr->posPids[handle];
+
       if (_msg.position().has_target_optional())
       {
-        if (!this->SetPositionTarget(_msg.name(),
-            _msg.position().target_optional().data()))
-        {
-          gzerr << "Unable to set position target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
+        this->dataPtr->SetPositionTarget(handle,
+            _msg.position().target_optional().data());
       }
 
       if (_msg.position().has_p_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetPGain(
-            _msg.position().p_gain_optional().data());
-      }
+        pid.SetPGain(_msg.position().p_gain_optional().data());
 
       if (_msg.position().has_i_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIGain(
-            _msg.position().i_gain_optional().data());
-      }
+        pid.SetIGain(_msg.position().i_gain_optional().data());
 
       if (_msg.position().has_d_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetDGain(
-            _msg.position().d_gain_optional().data());
-      }
+        pid.SetDGain(_msg.position().d_gain_optional().data());
 
       if (_msg.position().has_i_max_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMax(
-            _msg.position().i_max_optional().data());
-      }
+        pid.SetIMax(_msg.position().i_max_optional().data());
 
       if (_msg.position().has_i_min_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMin(
-            _msg.position().i_min_optional().data());
-      }
+        pid.SetIMin(_msg.position().i_min_optional().data());
 
       if (_msg.position().has_limit_optional())
       {
-        this->dataPtr->posPids[_msg.name()].SetCmdMax(
-            _msg.position().limit_optional().data());
-        this->dataPtr->posPids[_msg.name()].SetCmdMin(
-            -_msg.position().limit_optional().data());
+        pid.SetCmdMax(_msg.position().limit_optional().data());
+        pid.SetCmdMin(-_msg.position().limit_optional().data());
       }
     }
 
     if (_msg.has_velocity())
     {
+      common::PID &pid = this->dataPtr->velPids[handle];
+
       if (_msg.velocity().has_target_optional())
       {
-        if (!this->SetVelocityTarget(_msg.name(),
-            _msg.velocity().target_optional().data()))
-        {
-          gzerr << "Unable to set velocity target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
+        this->dataPtr->SetVelocityTarget(handle,
+            _msg.velocity().target_optional().data());
       }
 
       if (_msg.velocity().has_p_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetPGain(
-            _msg.velocity().p_gain_optional().data());
-      }
+        pid.SetPGain(_msg.velocity().p_gain_optional().data());
 
       if (_msg.velocity().has_i_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIGain(
-            _msg.velocity().i_gain_optional().data());
-      }
+        pid.SetIGain(_msg.velocity().i_gain_optional().data());
 
       if (_msg.velocity().has_d_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetDGain(
-            _msg.velocity().d_gain_optional().data());
-      }
+        pid.SetDGain(_msg.velocity().d_gain_optional().data());
 
       if (_msg.velocity().has_i_max_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIMax(
-            _msg.velocity().i_max_optional().data());
-      }
+        pid.SetIMax(_msg.velocity().i_max_optional().data());
 
       if (_msg.velocity().has_i_min_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIMin(
-            _msg.velocity().i_min_optional().data());
-      }
+        pid.SetIMin(_msg.velocity().i_min_optional().data());
 
       if (_msg.velocity().has_limit_optional())
       {
-        this->dataPtr->velPids[_msg.name()].SetCmdMax(
-            _msg.velocity().limit_optional().data());
-        this->dataPtr->velPids[_msg.name()].SetCmdMin(
-            -_msg.velocity().limit_optional().data());
+        pid.SetCmdMax(_msg.velocity().limit_optional().data());
+        pid.SetCmdMin(-_msg.velocity().limit_optional().data());
       }
     }
   }
@@ -389,11 +365,10 @@ void JointController::SetJointPosition(const std::string & _name,
                                        double _position, int _index)
 {
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  std::map<std::string, JointPtr>::iterator jiter =
-    this->dataPtr->joints.find(_name);
+  int handle = this->dataPtr->Handle(_name);
 
-  if (jiter != this->dataPtr->joints.end())
-    this->SetJointPosition(jiter->second, _position, _index);
+  if (handle >= 0)
+    this->SetJointPosition(this->dataPtr->joints[handle], _position, _index);
   else
     gzwarn << "SetJointPosition [" << _name << "] not found\n";
 }
@@ -404,25 +379,27 @@ void JointController::SetJointPositions(
 {
   // go through all joints in this model and update each one
   //   for each joint update, recursively update all children
-  std::map<std::string, JointPtr>::iterator iter;
   std::map<std::string, double>::const_iterator jiter;
 
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  for (iter = this->dataPtr->joints.begin();
-      iter != this->dataPtr->joints.end(); ++iter)
+  for (auto const &handle : this->dataPtr->handles)
   {
+    const JointPtr &joint = this->dataPtr->joints[handle.second];
+    if (!joint)
+      continue;
+
     // First try name without scope, i.e. joint_name
-    jiter = _jointPositions.find(iter->second->GetName());
+    jiter = _jointPositions.find(joint->GetName());
 
     if (jiter == _jointPositions.end())
     {
       // Second try name with scope, i.e. model_name::joint_name
-      jiter = _jointPositions.find(iter->second->GetScopedName());
+      jiter = _jointPositions.find(joint->GetScopedName());
       if (jiter == _jointPositions.end())
         continue;
     }
 
-    this->SetJointPosition(iter->second, jiter->second);
+    this->SetJointPosition(joint, jiter->second);
   }
 }
 
@@ -442,50 +419,90 @@ common::Time JointController::GetLastUpdateTime() const
 /////////////////////////////////////////////////
 std::map<std::string, JointPtr> JointController::GetJoints() const
 {
+  std::map<std::string, JointPtr> result;
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  return this->dataPtr->joints;
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->joints[handle.second])
+      result[handle.first] = this->dataPtr->joints[handle.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetPositionPIDs() const
 {
-  return this->dataPtr->posPids;
+  std::map<std::string, common::PID> result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->joints[handle.second])
+      result[handle.first] = this->dataPtr->posPids[handle.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetVelocityPIDs() const
 {
-  return this->dataPtr->velPids;
+  std::map<std::string, common::PID> result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->joints[handle.second])
+      result[handle.first] = this->dataPtr->velPids[handle.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetForces() const
 {
-  return this->dataPtr->forces;
+  std::map<std::string, double> result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->hasForce[handle.second])
+      result[handle.first] = this->dataPtr->forces[handle.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetPositions() const
 {
-  return this->dataPtr->positions;
+  std::map<std::string, double> result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->hasPosition[handle.second])
+      result[handle.first] = this->dataPtr->positions[handle.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetVelocities() const
 {
-  return this->dataPtr->velocities;
+  std::map<std::string, double> result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  for (auto const &handle : this->dataPtr->handles)
+  {
+    if (this->dataPtr->hasVelocity[handle.second])
+      result[handle.first] = this->dataPtr->velocities[handle.second];
+  }
+  return result;
 }
 
 //////////////////////////////////////////////////
 void JointController::SetPositionPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  iter = this->dataPtr->joints.find(_jointName);
+  int handle = this->dataPtr->Handle(_jointName);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->posPids[_jointName] = _pid;
+  if (handle >= 0)
+    this->dataPtr->posPids[handle] = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -494,28 +511,20 @@ void JointController::SetPositionPID(const std::string &_jointName,
 bool JointController::SetPositionTarget(const std::string &_jointName,
     const double _target)
 {
-  bool result = false;
-
-  if (this->dataPtr->posPids.find(_jointName) !=
-      this->dataPtr->posPids.end())
-  {
-    this->dataPtr->positions[_jointName] = _target;
-    result = true;
-  }
-
-  return result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  int handle = this->dataPtr->Handle(_jointName);
+  return handle >= 0 && this->dataPtr->SetPositionTarget(handle, _target);
 }
 
 //////////////////////////////////////////////////
 void JointController::SetVelocityPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  iter = this->dataPtr->joints.find(_jointName);
+  int handle = this->dataPtr->Handle(_jointName);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->velPids[_jointName] = _pid;
+  if (handle >= 0)
+    this->dataPtr->velPids[handle] = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -524,31 +533,83 @@ void JointController::SetVelocityPID(const std::string &_jointName,
 bool JointController::SetVelocityTarget(const std::string &_jointName,
     const double _target)
 {
-  bool result = false;
-
-  if (this->dataPtr->velPids.find(_jointName) !=
-      this->dataPtr->velPids.end())
-  {
-    this->dataPtr->velocities[_jointName] = _target;
-    result = true;
-  }
-
-  return result;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  int handle = this->dataPtr->Handle(_jointName);
+  return handle >= 0 && this->dataPtr->SetVelocityTarget(handle, _target);
 }
 
 /////////////////////////////////////////////////
 bool JointController::SetForce(const std::string &_jointName,
     const double _force)
 {
-  bool result = false;
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  int handle = this->dataPtr->Handle(_jointName);
+  return handle >= 0 && this->dataPtr->SetForce(handle, _force);
+}
 
+/////////////////////////////////////////////////
+int JointController::JointHandle(const std::string &_jointName) const
+{
   std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
-  if (this->dataPtr->joints.find(_jointName) !=
-      this->dataPtr->joints.end())
-  {
-    this->dataPtr->forces[_jointName] = _force;
-    result = true;
-  }
+  return this->dataPtr->Handle(_jointName);
+}
 
-  return result;
+/////////////////////////////////////////////////
+bool JointController::SetPositionTarget(const unsigned int _handle,
+    const double _target)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  return this->dataPtr->SetPositionTarget(_handle, _target);
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetVelocityTarget(const unsigned int _handle,
+    const double _target)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  return this->dataPtr->SetVelocityTarget(_handle, _target);
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetForce(const unsigned int _handle,
+    const double _force)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->jointsMutex);
+  return this->dataPtr->SetForce(_handle, _force);
+}
+
+/////////////////////////////////////////////////
+bool JointController::QueuePositionTarget(const unsigned int _handle,
+    const double _target)
+{
+  JointCommand cmd;
+  cmd.handle = _handle;
+  cmd.type = JointCommand::POSITION;
+  cmd.value = _target;
+  this->dataPtr->commands.Push(cmd);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::QueueVelocityTarget(const unsigned int _handle,
+    const double _target)
+{
+  JointCommand cmd;
+  cmd.handle = _handle;
+  cmd.type = JointCommand::VELOCITY;
+  cmd.value = _target;
+  this->dataPtr->commands.Push(cmd);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::QueueForce(const unsigned int _handle,
+    const double _force)
+{
+  JointCommand cmd;
+  cmd.handle = _handle;
+  cmd.type = JointCommand::FORCE;
+  cmd.value = _force;
+  this->dataPtr->commands.Push(cmd);
+  return true;
 }
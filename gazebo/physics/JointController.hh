@@ -41,6 +41,12 @@ namespace gazebo
 
     /// \class JointController JointController.hh physics/physics.hh
     /// \brief A class for manipulating physics::Joint
+    ///
+    /// Joints can be commanded by name, or by the handle returned by
+    /// JointHandle, which avoids looking up the name. Controllers running in
+    /// another thread than the world can queue commands with the Queue
+    /// functions, which usually don't lock, and the next Update applies
+    /// them.
     class GZ_PHYSICS_VISIBLE JointController
     {
       /// \brief Constructor
@@ -116,6 +122,67 @@ namespace gazebo
       /// \return False if the joint was not found.
       public: bool SetForce(const std::string &_jointName, const double _force);
 
+      /// \brief Get the handle of a joint, used instead of its name by the
+      /// functions taking a handle. A joint keeps its handle when it is
+      /// removed and added again.
+      /// \param[in] _jointName Scoped name of the joint.
+      /// \return The handle, or -1 if the joint isn't controlled.
+      public: int JointHandle(const std::string &_jointName) const;
+
+      /// \brief Set the target position for the position PID controller.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Position target.
+      /// \return False if the handle isn't valid.
+      /// \sa JointHandle
+      public: bool SetPositionTarget(const unsigned int _handle,
+                  const double _target);
+
+      /// \brief Set the target velocity for the velocity PID controller.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Velocity target.
+      /// \return False if the handle isn't valid.
+      /// \sa JointHandle
+      public: bool SetVelocityTarget(const unsigned int _handle,
+                  const double _target);
+
+      /// \brief Set the applied effort for the specified joint.
+      /// This force will persist across time steps.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _force Force to apply.
+      /// \return False if the handle isn't valid.
+      /// \sa JointHandle
+      public: bool SetForce(const unsigned int _handle, const double _force);
+
+      /// \brief Queue a target position for the position PID controller,
+      /// set by the next Update. Only one thread at a time may queue
+      /// commands. The first 1024 commands queued between two updates are
+      /// queued without locking. Past that, a lock is taken and only the
+      /// latest command of each kind for each joint is kept, so the newest
+      /// command is never lost. Commands for handles that aren't valid when
+      /// they are applied are ignored.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Position target.
+      /// \return Always true.
+      /// \sa JointHandle
+      public: bool QueuePositionTarget(const unsigned int _handle,
+                  const double _target);
+
+      /// \brief Queue a target velocity for the velocity PID controller,
+      /// set by the next Update.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Velocity target.
+      /// \return Always true.
+      /// \sa QueuePositionTarget
+      public: bool QueueVelocityTarget(const unsigned int _handle,
+                  const double _target);
+
+      /// \brief Queue an applied effort, set by the next Update.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _force Force to apply.
+      /// \return Always true.
+      /// \sa QueuePositionTarget
+      public: bool QueueForce(const unsigned int _handle, const double _force);
+
       /// \brief Get all the position PID controllers.
       /// \return A map<joint_name, PID> for all the position PID
       /// controllers.
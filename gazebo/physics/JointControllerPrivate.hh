@@ -17,9 +17,14 @@
 #ifndef _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 #define _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <map>
 #include <mutex>
+#include <utility>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -31,34 +36,229 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A command queued with the JointController::Queue functions.
+    class JointCommand
+    {
+      /// \brief Kinds of commands.
+      public: enum Type
+      {
+        /// \brief Set the force.
+        FORCE,
+
+        /// \brief Set the target of the position PID.
+        POSITION,
+
+        /// \brief Set the target of the velocity PID.
+        VELOCITY
+      };
+
+      /// \brief Handle of the joint.
+      public: unsigned int handle = 0;
+
+      /// \brief Kind of command.
+      public: Type type = FORCE;
+
+      /// \brief Force or target.
+      public: double value = 0;
+    };
+
+    /// \brief Fixed size ring buffer of commands, written by one thread and
+    /// read by another one without locks.
+    ///
+    /// When the ring is full, commands go to an overflow buffer that keeps
+    /// the latest value of each kind of command per joint, under a lock.
+    /// The producer doesn't use the ring again until the consumer empties
+    /// the overflow, so overflow commands are always newer than the ring.
+    class JointCommandBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Number of commands queued without locking.
+      public: explicit JointCommandBuffer(const size_t _capacity)
+              : commands(_capacity + 1)
+              {
+              }
+
+      /// \brief Queue a command. Called by the producer only.
+      /// \param[in] _cmd The command.
+      public: void Push(const JointCommand &_cmd)
+              {
+                if (!this->overflowed.load(std::memory_order_acquire))
+                {
+                  const size_t last =
+                    this->tail.load(std::memory_order_relaxed);
+                  const size_t next = (last + 1) % this->commands.size();
+                  if (next != this->head.load(std::memory_order_acquire))
+                  {
+                    this->commands[last] = _cmd;
+                    this->tail.store(next, std::memory_order_release);
+                    return;
+                  }
+                }
+
+                std::lock_guard<std::mutex> lock(this->overflowMutex);
+                this->overflow[std::make_pair(_cmd.handle, _cmd.type)] =
+                  _cmd.value;
+                this->overflowed.store(true, std::memory_order_release);
+              }
+
+      /// \brief Remove the queued commands, oldest first. Called by the
+      /// consumer only.
+      /// \param[in] _apply Function called with each command.
+      public: void Pop(const std::function<void (const JointCommand &)>
+                  &_apply)
+              {
+                // Read the flag first, the ring only holds older commands
+                // once it is set.
+                const bool hasOverflow =
+                  this->overflowed.load(std::memory_order_acquire);
+
+                size_t first = this->head.load(std::memory_order_relaxed);
+                while (first != this->tail.load(std::memory_order_acquire))
+                {
+                  _apply(this->commands[first]);
+                  first = (first + 1) % this->commands.size();
+                  this->head.store(first, std::memory_order_release);
+                }
+
+                if (!hasOverflow)
+                  return;
+
+                std::map<std::pair<unsigned int, JointCommand::Type>, double>
+                  latest;
+                {
+                  std::lock_guard<std::mutex> lock(this->overflowMutex);
+                  latest.swap(this->overflow);
+                  this->overflowed.store(false, std::memory_order_release);
+                }
+
+                JointCommand cmd;
+                for (auto const &entry : latest)
+                {
+                  cmd.handle = entry.first.first;
+                  cmd.type = entry.first.second;
+                  cmd.value = entry.second;
+                  _apply(cmd);
+                }
+              }
+
+      /// \brief The commands. One slot is always empty, to tell a full
+      /// buffer from an empty one.
+      private: std::vector<JointCommand> commands;
+
+      /// \brief Index of the oldest command, written by the consumer.
+      private: std::atomic<size_t> head{0};
+
+      /// \brief Index of the next free slot, written by the producer.
+      private: std::atomic<size_t> tail{0};
+
+      /// \brief Latest value of each kind of command per joint, queued
+      /// while the ring was full.
+      private: std::map<std::pair<unsigned int, JointCommand::Type>, double>
+               overflow;
+
+      /// \brief True if the overflow holds commands.
+      private: std::atomic<bool> overflowed{false};
+
+      /// \brief Mutex to protect the overflow.
+      private: std::mutex overflowMutex;
+    };
+
     class JointControllerPrivate
     {
+      /// \brief Set a force, the caller holds jointsMutex.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _force Force to apply.
+      /// \return False if the handle isn't valid.
+      public: bool SetForce(const unsigned int _handle, const double _force)
+              {
+                if (_handle >= this->joints.size() || !this->joints[_handle])
+                  return false;
+                this->forces[_handle] = _force;
+                this->hasForce[_handle] = 1;
+                return true;
+              }
+
+      /// \brief Set a position target, the caller holds jointsMutex.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Position target.
+      /// \return False if the handle isn't valid.
+      public: bool SetPositionTarget(const unsigned int _handle,
+                  const double _target)
+              {
+                if (_handle >= this->joints.size() || !this->joints[_handle])
+                  return false;
+                this->positions[_handle] = _target;
+                this->hasPosition[_handle] = 1;
+                return true;
+              }
+
+      /// \brief Set a velocity target, the caller holds jointsMutex.
+      /// \param[in] _handle Handle of the joint.
+      /// \param[in] _target Velocity target.
+      /// \return False if the handle isn't valid.
+      public: bool SetVelocityTarget(const unsigned int _handle,
+                  const double _target)
+              {
+                if (_handle >= this->joints.size() || !this->joints[_handle])
+                  return false;
+                this->velocities[_handle] = _target;
+                this->hasVelocity[_handle] = 1;
+                return true;
+              }
+
+      /// \brief Get the handle of a joint, the caller holds jointsMutex.
+      /// \param[in] _jointName Scoped name of the joint.
+      /// \return The handle, or -1 if the joint isn't controlled.
+      public: int Handle(const std::string &_jointName) const
+              {
+                auto iter = this->handles.find(_jointName);
+                if (iter == this->handles.end() || !this->joints[iter->second])
+                  return -1;
+                return static_cast<int>(iter->second);
+              }
+
       /// \brief Model to control.
       public: ModelPtr model;
 
-      /// \brief Mutex to protect joints map.
+      /// \brief Mutex to protect the joints and their commands.
       public: std::mutex jointsMutex;
 
       /// \brief List of links that have been updated.
       public: Link_V updatedLinks;
 
-      /// \brief Map of joint names to the joint pointer.
-      public: std::map<std::string, JointPtr> joints;
+      /// \brief Map of joint names to their handle. Names of removed joints
+      /// are kept, so that the joint gets the same handle if added again.
+      public: std::map<std::string, unsigned int> handles;
+
+      /// \brief The joints, indexed by handle. Null for removed joints.
+      public: std::vector<JointPtr> joints;
+
+      /// \brief Position PID controllers, indexed by handle.
+      public: std::vector<common::PID> posPids;
+
+      /// \brief Velocity PID controllers, indexed by handle.
+      public: std::vector<common::PID> velPids;
+
+      /// \brief Forces applied to joints, indexed by handle.
+      public: std::vector<double> forces;
+
+      /// \brief Joint position targets, indexed by handle.
+      public: std::vector<double> positions;
 
-      /// \brief Position PID controllers.
-      public: std::map<std::string, common::PID> posPids;
+      /// \brief Joint velocity targets, indexed by handle.
+      public: std::vector<double> velocities;
 
-      /// \brief Velocity PID controllers.
-      public: std::map<std::string, common::PID> velPids;
+      /// \brief Whether a force is set, indexed by handle.
+      public: std::vector<uint8_t> hasForce;
 
-      /// \brief Forces applied to joints.
-      public: std::map<std::string, double> forces;
+      /// \brief Whether a position target is set, indexed by handle.
+      public: std::vector<uint8_t> hasPosition;
 
-      /// \brief Joint positions.
-      public: std::map<std::string, double> positions;
+      /// \brief Whether a velocity target is set, indexed by handle.
+      public: std::vector<uint8_t> hasVelocity;
 
-      /// \brief Joint velocities.
-      public: std::map<std::string, double> velocities;
+      /// \brief Commands queued by another thread, applied by Update.
+      public: JointCommandBuffer commands{1024};
 
       /// \brief Node for communication.
       /// \deprecated See JointControllerPrivate::node.
@@ -280,6 +280,75 @@ TEST_F(JointControllerTest, SetJointPositions)
   EXPECT_NO_THROW(jointController->SetJointPositions(positions));
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, Handles)
+{
+  // Create a dummy model
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  EXPECT_TRUE(model != NULL);
+
+  // Create the joint controller
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+  EXPECT_TRUE(jointController != NULL);
+
+  physics::JointPtr joint1(new FakeJoint(model));
+  joint1->SetName("joint1");
+
+  physics::JointPtr joint2(new FakeJoint(model));
+  joint2->SetName("joint2");
+
+  jointController->AddJoint(joint1);
+  jointController->AddJoint(joint2);
+
+  int handle1 = jointController->JointHandle(joint1->GetScopedName());
+  int handle2 = jointController->JointHandle(joint2->GetScopedName());
+  EXPECT_EQ(0, handle1);
+  EXPECT_EQ(1, handle2);
+  EXPECT_EQ(-1, jointController->JointHandle("my_bad_name"));
+
+  // Set commands by handle
+  EXPECT_TRUE(jointController->SetPositionTarget(handle1, 1.5));
+  EXPECT_TRUE(jointController->SetVelocityTarget(handle2, 2.5));
+  EXPECT_TRUE(jointController->SetForce(handle2, 3.5));
+
+  std::map<std::string, double> positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 1u);
+  EXPECT_DOUBLE_EQ(positions[joint1->GetScopedName()], 1.5);
+  std::map<std::string, double> velocities = jointController->GetVelocities();
+  EXPECT_EQ(velocities.size(), 1u);
+  EXPECT_DOUBLE_EQ(velocities[joint2->GetScopedName()], 2.5);
+  std::map<std::string, double> forces = jointController->GetForces();
+  EXPECT_EQ(forces.size(), 1u);
+  EXPECT_DOUBLE_EQ(forces[joint2->GetScopedName()], 3.5);
+
+  // Handles that don't exist
+  EXPECT_FALSE(jointController->SetPositionTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetVelocityTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetForce(2u, 1.0));
+
+  // A removed joint has no handle, and its commands are cleared
+  jointController->RemoveJoint(joint1.get());
+  EXPECT_EQ(-1, jointController->JointHandle(joint1->GetScopedName()));
+  EXPECT_FALSE(jointController->SetPositionTarget(handle1, 1.0));
+  EXPECT_TRUE(jointController->GetPositions().empty());
+  EXPECT_EQ(jointController->GetJoints().size(), 1u);
+  EXPECT_EQ(jointController->GetPositionPIDs().size(), 1u);
+
+  // It gets the same handle when added again
+  jointController->AddJoint(joint1);
+  EXPECT_EQ(handle1, jointController->JointHandle(joint1->GetScopedName()));
+  EXPECT_EQ(jointController->GetJoints().size(), 2u);
+
+  // Queued commands wait for the next update. Past the size of the queue
+  // the newest command of each kind per joint is kept.
+  for (int i = 0; i < 1030; ++i)
+    EXPECT_TRUE(jointController->QueuePositionTarget(handle1, i));
+  EXPECT_TRUE(jointController->QueueVelocityTarget(handle1, 1.5));
+  EXPECT_TRUE(jointController->QueueForce(handle1, 2.5));
+  EXPECT_TRUE(jointController->GetPositions().empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, JointCmd)
 {
@@ -344,6 +344,9 @@ void Model::Init()
   {
     (*iter)->Init();
   }
+
+  // The collisions are placed by now.
+  this->world->SpatialIndex().MarkDirty(this);
 }
 
 //////////////////////////////////////////////////
@@ -985,6 +988,7 @@ void Model::LoadJoint(sdf::ElementPtr _sdf)
   }
 
   this->joints.push_back(joint);
+  this->world->_InvalidateModelUpdateGroups();
 
   if (!this->jointController)
     this->jointController.reset(new JointController(
@@ -1425,6 +1429,7 @@ void Model::SetScale(const ignition::math::Vector3d &_scale,
         boost::static_pointer_cast<Link>(*iter)->SetScale(_scale);
       }
     }
+    this->world->SpatialIndex().MarkDirty(this);
   }
 
   if (_publish)
@@ -1606,6 +1611,7 @@ gazebo::physics::JointPtr Model::CreateJoint(
   // need to call Joint::Load to clone Joint::sdfJoint into Joint::sdf
   joint->Load(_parent, _child, ignition::math::Pose3d::Zero);
   this->joints.push_back(joint);
+  this->world->_InvalidateModelUpdateGroups();
   return joint;
 }
 
@@ -1659,6 +1665,7 @@ bool Model::RemoveJoint(const std::string &_name)
     this->joints.erase(
       std::remove(this->joints.begin(), this->joints.end(), joint),
       this->joints.end());
+    this->world->_InvalidateModelUpdateGroups();
     this->world->SetPaused(paused);
     return true;
   }
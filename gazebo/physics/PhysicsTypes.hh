@@ -57,6 +57,7 @@ namespace gazebo
     class Road;
     class Shape;
     class RayShape;
+    class SpatialIndex;
     class MultiRayShape;
     class Inertial;
     class SurfaceParams;
@@ -0,0 +1,880 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Plane.hh>
+
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/SpatialIndex.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Index of a missing node.
+static const int kNullNode = -1;
+
+/// \brief Bounds with a side longer than this, such as the bounds of
+/// planes, are kept out of the tree and tested by every query.
+static const double kMaxExtent = 1e6;
+
+/// \brief Number of lists of moved models. Models are spread across them,
+/// so that threads moving different models rarely wait for each other.
+static const size_t kMovedLists = 16;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A node of the tree.
+    class SpatialIndexNode
+    {
+      /// \brief Where a leaf is stored.
+      public: enum Placement
+      {
+        /// \brief Waiting for its bounds to be computed.
+        PENDING,
+
+        /// \brief In the tree.
+        TREE,
+
+        /// \brief In the list of unbounded leaves.
+        UNBOUNDED
+      };
+
+      /// \brief Box containing the boxes of the children, or the bounds of
+      /// a leaf grown by the margin.
+      public: ignition::math::AxisAlignedBox box;
+
+      /// \brief Parent node, or next free node.
+      public: int parent = kNullNode;
+
+      /// \brief First child of an internal node.
+      public: int child1 = kNullNode;
+
+      /// \brief Second child of an internal node.
+      public: int child2 = kNullNode;
+
+      /// \brief Height of the node in the tree, 0 for leaves, -1 for free
+      /// nodes.
+      public: int height = -1;
+
+      /// \brief Model of a leaf.
+      public: ModelPtr model;
+
+      /// \brief Bounds of the model of a leaf.
+      public: ignition::math::AxisAlignedBox bounds;
+
+      /// \brief Order in which the model of a leaf was added.
+      public: uint64_t order = 0;
+
+      /// \brief True if the bounds of a leaf must be computed again.
+      public: bool dirty = false;
+
+      /// \brief Where a leaf is stored.
+      public: Placement placement = PENDING;
+    };
+
+    /// \internal
+    /// \brief Models moved since the last refit, see
+    /// SpatialIndex::MarkMoved.
+    class SpatialIndexMoved
+    {
+      /// \brief Protects models.
+      public: std::mutex mutex;
+
+      /// \brief The moved models, possibly more than once. They may have
+      /// been removed since, so they are only dereferenced once found in
+      /// SpatialIndexPrivate::leaves.
+      public: std::vector<const Base *> models;
+    };
+
+    /// \internal
+    /// \brief Private data for the SpatialIndex class
+    class SpatialIndexPrivate
+    {
+      /// \brief Get a new node.
+      /// \return Index of the node.
+      public: int Allocate();
+
+      /// \brief Release a node.
+      /// \param[in] _node Index of the node.
+      public: void Free(const int _node);
+
+      /// \brief Add a model and its nested models.
+      /// \param[in] _model Model to add.
+      public: void Add(const ModelPtr &_model);
+
+      /// \brief Remove a model and its nested models.
+      /// \param[in] _model Model to remove.
+      public: void Remove(const ModelPtr &_model);
+
+      /// \brief Compute the changed bounds again, and update the tree.
+      public: void Refit();
+
+      /// \brief Insert a leaf in the tree.
+      /// \param[in] _leaf Index of the leaf.
+      public: void InsertLeaf(const int _leaf);
+
+      /// \brief Remove a leaf from the tree.
+      /// \param[in] _leaf Index of the leaf.
+      public: void RemoveLeaf(const int _leaf);
+
+      /// \brief Update the boxes and heights of the ancestors of a node,
+      /// rebalancing them.
+      /// \param[in] _node Index of the first node to update.
+      public: void UpdateAncestors(int _node);
+
+      /// \brief Rotate a child up if the heights of the children of a node
+      /// differ by more than one.
+      /// \param[in] _node Index of the node.
+      /// \return Index of the node replacing _node.
+      public: int Balance(const int _node);
+
+      /// \brief Remove a leaf from the list of unbounded leaves.
+      /// \param[in] _leaf Index of the leaf.
+      public: void RemoveUnbounded(const int _leaf);
+
+      /// \brief Find the leaves passing a test.
+      /// \param[in] _test Test of the boxes of nodes and the bounds of leaves.
+      /// \return The models of the leaves, in the order they were added.
+      public: Model_V Collect(const std::function<bool(
+                  const ignition::math::AxisAlignedBox &)> &_test);
+
+      /// \brief Nodes of the tree, and free nodes.
+      public: std::vector<SpatialIndexNode> nodes;
+
+      /// \brief Root of the tree.
+      public: int root = kNullNode;
+
+      /// \brief First free node.
+      public: int freeList = kNullNode;
+
+      /// \brief Leaf of each model.
+      public: std::unordered_map<const Base *, int> leaves;
+
+      /// \brief Leaves whose bounds must be computed again.
+      public: std::vector<int> dirty;
+
+      /// \brief Leaves whose bounds are too large for the tree.
+      public: std::vector<int> unbounded;
+
+      /// \brief Margin added to the bounds stored in the tree.
+      public: double margin = 0.1;
+
+      /// \brief Order of the next added model.
+      public: uint64_t nextOrder = 0;
+
+      /// \brief Protects all of the above.
+      public: std::mutex mutex;
+
+      /// \brief Models moved since the last refit, each protected by its
+      /// own mutex rather than by the mutex above.
+      public: SpatialIndexMoved moved[kMovedLists];
+
+      /// \brief Storage swapped with the lists of moved models by Refit,
+      /// so that it allocates nothing once warm.
+      public: std::vector<const Base *> movedScratch;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the box containing two boxes.
+static ignition::math::AxisAlignedBox merge(
+    const ignition::math::AxisAlignedBox &_a,
+    const ignition::math::AxisAlignedBox &_b)
+{
+  ignition::math::Vector3d min = _a.Min();
+  ignition::math::Vector3d max = _a.Max();
+  min.Min(_b.Min());
+  max.Max(_b.Max());
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the cost of a box in the tree, half its surface area.
+static double cost(const ignition::math::AxisAlignedBox &_box)
+{
+  const ignition::math::Vector3d size = _box.Max() - _box.Min();
+  return size.X() * size.Y() + size.Y() * size.Z() + size.Z() * size.X();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a box contains another box.
+static bool contains(const ignition::math::AxisAlignedBox &_outer,
+    const ignition::math::AxisAlignedBox &_inner)
+{
+  return _outer.Min().X() <= _inner.Min().X() &&
+         _outer.Min().Y() <= _inner.Min().Y() &&
+         _outer.Min().Z() <= _inner.Min().Z() &&
+         _outer.Max().X() >= _inner.Max().X() &&
+         _outer.Max().Y() >= _inner.Max().Y() &&
+         _outer.Max().Z() >= _inner.Max().Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether two boxes intersect, touching included.
+static bool intersects(const ignition::math::AxisAlignedBox &_a,
+    const ignition::math::AxisAlignedBox &_b)
+{
+  return _a.Min().X() <= _b.Max().X() && _b.Min().X() <= _a.Max().X() &&
+         _a.Min().Y() <= _b.Max().Y() && _b.Min().Y() <= _a.Max().Y() &&
+         _a.Min().Z() <= _b.Max().Z() && _b.Min().Z() <= _a.Max().Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the squared distance from a point to a box, zero inside.
+static double distanceSquared(const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Vector3d &_point)
+{
+  double result = 0;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    double d = 0;
+    if (_point[i] < _box.Min()[i])
+      d = _box.Min()[i] - _point[i];
+    else if (_point[i] > _box.Max()[i])
+      d = _point[i] - _box.Max()[i];
+    result += d * d;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a box is entirely outside one of the planes of a
+/// frustum, which is how Frustum::Contains rejects boxes.
+static bool outside(const ignition::math::Frustum &_frustum,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  for (int i = ignition::math::FRUSTUM_PLANE_NEAR;
+       i <= ignition::math::FRUSTUM_PLANE_BOTTOM; ++i)
+  {
+    if (_frustum.Plane(static_cast<ignition::math::FrustumPlane>(i)).Side(
+          _box) == ignition::math::Planed::NEGATIVE_SIDE)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the bounds of a model: its bounding box grown to contain its
+/// origin.
+static ignition::math::AxisAlignedBox modelBounds(const Model &_model)
+{
+  ignition::math::Vector3d min = _model.WorldPose().Pos();
+  ignition::math::Vector3d max = min;
+
+  // The bounding box of a model without collisions is inverted.
+  const ignition::math::AxisAlignedBox box = _model.BoundingBox();
+  if (box.Min().X() <= box.Max().X() && box.Min().Y() <= box.Max().Y() &&
+      box.Min().Z() <= box.Max().Z())
+  {
+    min.Min(box.Min());
+    max.Max(box.Max());
+  }
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+int SpatialIndexPrivate::Allocate()
+{
+  int node = this->freeList;
+  if (node == kNullNode)
+  {
+    node = static_cast<int>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+  else
+  {
+    this->freeList = this->nodes[node].parent;
+  }
+
+  SpatialIndexNode &result = this->nodes[node];
+  result.parent = kNullNode;
+  result.child1 = kNullNode;
+  result.child2 = kNullNode;
+  result.height = 0;
+  result.dirty = false;
+  result.placement = SpatialIndexNode::PENDING;
+  return node;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Free(const int _node)
+{
+  SpatialIndexNode &node = this->nodes[_node];
+  node.model.reset();
+  node.height = -1;
+  node.parent = this->freeList;
+  this->freeList = _node;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Add(const ModelPtr &_model)
+{
+  if (!_model)
+    return;
+
+  if (this->leaves.find(_model.get()) == this->leaves.end())
+  {
+    const int leaf = this->Allocate();
+    SpatialIndexNode &node = this->nodes[leaf];
+    node.model = _model;
+    node.order = this->nextOrder++;
+    node.dirty = true;
+    this->dirty.push_back(leaf);
+    this->leaves[_model.get()] = leaf;
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    this->Add(nested);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Remove(const ModelPtr &_model)
+{
+  if (!_model)
+    return;
+
+  auto iter = this->leaves.find(_model.get());
+  if (iter != this->leaves.end())
+  {
+    const int leaf = iter->second;
+    this->leaves.erase(iter);
+
+    if (this->nodes[leaf].dirty)
+    {
+      this->dirty.erase(
+          std::find(this->dirty.begin(), this->dirty.end(), leaf));
+    }
+
+    if (this->nodes[leaf].placement == SpatialIndexNode::TREE)
+      this->RemoveLeaf(leaf);
+    else if (this->nodes[leaf].placement == SpatialIndexNode::UNBOUNDED)
+      this->RemoveUnbounded(leaf);
+
+    this->Free(leaf);
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    this->Remove(nested);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Refit()
+{
+  // Collect the models moved by Entity::SetWorldPose since the last refit.
+  for (auto &moved : this->moved)
+  {
+    {
+      std::lock_guard<std::mutex> lock(moved.mutex);
+      std::swap(moved.models, this->movedScratch);
+    }
+
+    for (const Base *model : this->movedScratch)
+    {
+      auto iter = this->leaves.find(model);
+      if (iter == this->leaves.end())
+        continue;
+
+      SpatialIndexNode &node = this->nodes[iter->second];
+      if (!node.dirty)
+      {
+        node.dirty = true;
+        this->dirty.push_back(iter->second);
+      }
+    }
+    this->movedScratch.clear();
+  }
+
+  for (const int leaf : this->dirty)
+  {
+    SpatialIndexNode &node = this->nodes[leaf];
+    node.dirty = false;
+    node.bounds = modelBounds(*node.model);
+
+    const ignition::math::Vector3d size =
+      node.bounds.Max() - node.bounds.Min();
+    if (!(size.X() <= kMaxExtent && size.Y() <= kMaxExtent &&
+          size.Z() <= kMaxExtent))
+    {
+      if (node.placement == SpatialIndexNode::TREE)
+        this->RemoveLeaf(leaf);
+      if (node.placement != SpatialIndexNode::UNBOUNDED)
+        this->unbounded.push_back(leaf);
+      node.placement = SpatialIndexNode::UNBOUNDED;
+      continue;
+    }
+
+    // Models moving inside their box don't change the tree.
+    if (node.placement == SpatialIndexNode::TREE)
+    {
+      if (contains(node.box, node.bounds))
+        continue;
+      this->RemoveLeaf(leaf);
+    }
+    else if (node.placement == SpatialIndexNode::UNBOUNDED)
+    {
+      this->RemoveUnbounded(leaf);
+    }
+
+    const ignition::math::Vector3d margin(
+        this->margin, this->margin, this->margin);
+    node.box = ignition::math::AxisAlignedBox(
+        node.bounds.Min() - margin, node.bounds.Max() + margin);
+    node.placement = SpatialIndexNode::TREE;
+
+    // Inserting allocates nodes, node isn't used after this.
+    this->InsertLeaf(leaf);
+  }
+  this->dirty.clear();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::InsertLeaf(const int _leaf)
+{
+  if (this->root == kNullNode)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNullNode;
+    return;
+  }
+
+  // Descend towards the sibling that increases the cost of the tree the
+  // least.
+  const ignition::math::AxisAlignedBox box = this->nodes[_leaf].box;
+  int index = this->root;
+  while (this->nodes[index].height > 0)
+  {
+    const SpatialIndexNode &node = this->nodes[index];
+    const double combined = cost(merge(node.box, box));
+
+    // Cost of making a new parent for this node and the leaf, and minimum
+    // cost of pushing the leaf further down.
+    const double here = 2 * combined;
+    const double inheritance = 2 * (combined - cost(node.box));
+
+    auto descend = [&](const int _child)
+    {
+      const SpatialIndexNode &child = this->nodes[_child];
+      double result = cost(merge(child.box, box)) + inheritance;
+      if (child.height > 0)
+        result -= cost(child.box);
+      return result;
+    };
+    const double cost1 = descend(node.child1);
+    const double cost2 = descend(node.child2);
+
+    if (here < cost1 && here < cost2)
+      break;
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const int sibling = index;
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->Allocate();
+
+  SpatialIndexNode &parent = this->nodes[newParent];
+  parent.parent = oldParent;
+  parent.box = merge(box, this->nodes[sibling].box);
+  parent.height = this->nodes[sibling].height + 1;
+  parent.child1 = sibling;
+  parent.child2 = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  if (oldParent == kNullNode)
+    this->root = newParent;
+  else if (this->nodes[oldParent].child1 == sibling)
+    this->nodes[oldParent].child1 = newParent;
+  else
+    this->nodes[oldParent].child2 = newParent;
+
+  this->UpdateAncestors(newParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::RemoveLeaf(const int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = kNullNode;
+    return;
+  }
+
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].child1 == _leaf ?
+    this->nodes[parent].child2 : this->nodes[parent].child1;
+
+  // The sibling replaces the parent.
+  this->nodes[sibling].parent = grandParent;
+  if (grandParent == kNullNode)
+    this->root = sibling;
+  else if (this->nodes[grandParent].child1 == parent)
+    this->nodes[grandParent].child1 = sibling;
+  else
+    this->nodes[grandParent].child2 = sibling;
+
+  this->Free(parent);
+  this->nodes[_leaf].parent = kNullNode;
+  this->UpdateAncestors(grandParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::UpdateAncestors(int _node)
+{
+  while (_node != kNullNode)
+  {
+    _node = this->Balance(_node);
+
+    SpatialIndexNode &node = this->nodes[_node];
+    const SpatialIndexNode &child1 = this->nodes[node.child1];
+    const SpatialIndexNode &child2 = this->nodes[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.box = merge(child1.box, child2.box);
+    _node = node.parent;
+  }
+}
+
+/////////////////////////////////////////////////
+int SpatialIndexPrivate::Balance(const int _node)
+{
+  SpatialIndexNode &a = this->nodes[_node];
+  if (a.height < 2)
+    return _node;
+
+  const int balance =
+    this->nodes[a.child2].height - this->nodes[a.child1].height;
+  if (balance >= -1 && balance <= 1)
+    return _node;
+
+  // Rotate the taller child up, it becomes the parent of a.
+  const int up = balance > 1 ? a.child2 : a.child1;
+  const int other = balance > 1 ? a.child1 : a.child2;
+  SpatialIndexNode &u = this->nodes[up];
+
+  u.parent = a.parent;
+  a.parent = up;
+  if (u.parent == kNullNode)
+    this->root = up;
+  else if (this->nodes[u.parent].child1 == _node)
+    this->nodes[u.parent].child1 = up;
+  else
+    this->nodes[u.parent].child2 = up;
+
+  // u keeps its taller child, and a takes the other one in place of u.
+  int taller = u.child1;
+  int shorter = u.child2;
+  if (this->nodes[taller].height < this->nodes[shorter].height)
+    std::swap(taller, shorter);
+
+  u.child1 = _node;
+  u.child2 = taller;
+  if (a.child1 == up)
+    a.child1 = shorter;
+  else
+    a.child2 = shorter;
+  this->nodes[shorter].parent = _node;
+
+  a.box = merge(this->nodes[other].box, this->nodes[shorter].box);
+  a.height = 1 + std::max(this->nodes[other].height,
+      this->nodes[shorter].height);
+  u.box = merge(a.box, this->nodes[taller].box);
+  u.height = 1 + std::max(a.height, this->nodes[taller].height);
+  return up;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::RemoveUnbounded(const int _leaf)
+{
+  auto iter = std::find(this->unbounded.begin(), this->unbounded.end(),
+      _leaf);
+  if (iter != this->unbounded.end())
+  {
+    *iter = this->unbounded.back();
+    this->unbounded.pop_back();
+  }
+}
+
+/////////////////////////////////////////////////
+Model_V SpatialIndexPrivate::Collect(const std::function<bool(
+    const ignition::math::AxisAlignedBox &)> &_test)
+{
+  this->Refit();
+
+  std::vector<int> found;
+  std::vector<int> stack;
+  if (this->root != kNullNode)
+    stack.push_back(this->root);
+
+  while (!stack.empty())
+  {
+    const SpatialIndexNode &node = this->nodes[stack.back()];
+    const int index = stack.back();
+    stack.pop_back();
+
+    if (!_test(node.box))
+      continue;
+
+    if (node.height > 0)
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+    else if (_test(node.bounds))
+    {
+      found.push_back(index);
+    }
+  }
+
+  for (const int leaf : this->unbounded)
+  {
+    if (_test(this->nodes[leaf].bounds))
+      found.push_back(leaf);
+  }
+
+  std::sort(found.begin(), found.end(), [this](const int _a, const int _b)
+      {
+        return this->nodes[_a].order < this->nodes[_b].order;
+      });
+
+  Model_V result;
+  result.reserve(found.size());
+  for (const int leaf : found)
+    result.push_back(this->nodes[leaf].model);
+  return result;
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::SpatialIndex()
+  : dataPtr(new SpatialIndexPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::~SpatialIndex()
+{
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::AddModel(const ModelPtr &_model)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Add(_model);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::RemoveModel(const ModelPtr &_model)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Remove(_model);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->nodes.clear();
+  this->dataPtr->root = kNullNode;
+  this->dataPtr->freeList = kNullNode;
+  this->dataPtr->leaves.clear();
+  this->dataPtr->dirty.clear();
+  this->dataPtr->unbounded.clear();
+  for (auto &moved : this->dataPtr->moved)
+  {
+    std::lock_guard<std::mutex> movedLock(moved.mutex);
+    moved.models.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+size_t SpatialIndex::ModelCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->leaves.size();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::MarkDirty(const Base *_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->leaves.empty())
+    return;
+
+  // Only models have leaves, other entities are skipped. The parents are
+  // kept alive by their children.
+  for (const Base *base = _entity; base; base = base->GetParent().get())
+  {
+    auto iter = this->dataPtr->leaves.find(base);
+    if (iter == this->dataPtr->leaves.end())
+      continue;
+
+    SpatialIndexNode &node = this->dataPtr->nodes[iter->second];
+    if (!node.dirty)
+    {
+      node.dirty = true;
+      this->dataPtr->dirty.push_back(iter->second);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::MarkMoved(const Model *_model)
+{
+  // Pick a list from the address of the model, so that the links of a model
+  // usually find it at the end of the list.
+  SpatialIndexMoved &moved = this->dataPtr->moved[
+    (reinterpret_cast<uintptr_t>(_model) / sizeof(Model)) % kMovedLists];
+
+  std::lock_guard<std::mutex> lock(moved.mutex);
+  if (moved.models.empty() || moved.models.back() != _model)
+    moved.models.push_back(_model);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Refit()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refit();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::SetMargin(const double _margin)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->margin = std::max(0.0, _margin);
+}
+
+/////////////////////////////////////////////////
+double SpatialIndex::Margin() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->margin;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Bounds(const ModelPtr &_model,
+    ignition::math::AxisAlignedBox &_bounds) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refit();
+
+  auto iter = this->dataPtr->leaves.find(_model.get());
+  if (iter == this->dataPtr->leaves.end())
+    return false;
+
+  _bounds = this->dataPtr->nodes[iter->second].bounds;
+  return true;
+}
+
+/////////////////////////////////////////////////
+Model_V SpatialIndex::ModelsInBox(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Collect(
+      [&_box](const ignition::math::AxisAlignedBox &_b)
+      {
+        return intersects(_box, _b);
+      });
+}
+
+/////////////////////////////////////////////////
+Model_V SpatialIndex::ModelsInSphere(const ignition::math::Vector3d &_center,
+    const double _radius) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const double radiusSquared = _radius * _radius;
+  return this->dataPtr->Collect(
+      [&_center, radiusSquared](const ignition::math::AxisAlignedBox &_b)
+      {
+        return distanceSquared(_b, _center) <= radiusSquared;
+      });
+}
+
+/////////////////////////////////////////////////
+Model_V SpatialIndex::ModelsInFrustum(
+    const ignition::math::Frustum &_frustum) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Collect(
+      [&_frustum](const ignition::math::AxisAlignedBox &_b)
+      {
+        return !outside(_frustum, _b);
+      });
+}
+
+/////////////////////////////////////////////////
+Model_V SpatialIndex::NearestModels(const ignition::math::Vector3d &_point,
+    const unsigned int _count) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refit();
+
+  Model_V result;
+  if (_count == 0)
+    return result;
+
+  const std::vector<SpatialIndexNode> &nodes = this->dataPtr->nodes;
+
+  // Best first search. Internal nodes are keyed by the distance to their
+  // box, which no leaf below them is closer than, and leaves by the
+  // distance to their bounds. A leaf popped from the queue is therefore
+  // closer than everything left.
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  auto push = [&](const int _node)
+  {
+    const SpatialIndexNode &node = nodes[_node];
+    queue.push(Entry(distanceSquared(
+            node.height > 0 ? node.box : node.bounds, _point), _node));
+  };
+
+  if (this->dataPtr->root != kNullNode)
+    push(this->dataPtr->root);
+  for (const int leaf : this->dataPtr->unbounded)
+    push(leaf);
+
+  while (!queue.empty() && result.size() < _count)
+  {
+    const SpatialIndexNode &node = nodes[queue.top().second];
+    queue.pop();
+
+    if (node.height > 0)
+    {
+      push(node.child1);
+      push(node.child2);
+    }
+    else
+    {
+      result.push_back(node.model);
+    }
+  }
+  return result;
+}
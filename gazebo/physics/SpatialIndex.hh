@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SPATIALINDEX_HH_
+#define GAZEBO_PHYSICS_SPATIALINDEX_HH_
+
+#include <memory>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class SpatialIndexPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SpatialIndex SpatialIndex.hh physics/physics.hh
+    /// \brief Dynamic bounding volume tree of the models of a world, used to
+    /// find the models near a point or inside a region without testing every
+    /// model.
+    ///
+    /// The bounds of a model are its bounding box, grown to contain the
+    /// origin of the model. Models without collisions are indexed by their
+    /// origin. Nested models are indexed on their own, their bounds don't
+    /// contain the nested models.
+    ///
+    /// The world adds and removes models. Setting the pose of a model or of
+    /// one of its links, including by the physics engine during
+    /// World::Update, adds the model to a list of moved models without
+    /// locking the index. The list is collected, and the changed bounds
+    /// computed again, at the end of World::Update or by the next query, so
+    /// a refit costs time proportional to the number of moved models.
+    /// A leaf of the tree stores the bounds grown by a margin, so that models
+    /// moving by less than the margin don't change the tree.
+    ///
+    /// Queries may be called from any thread. They return the models whose
+    /// bounds pass the test, and callers needing the exact test against the
+    /// bounding box of a model still apply it to the returned models.
+    class GZ_PHYSICS_VISIBLE SpatialIndex
+    {
+      /// \brief Constructor.
+      public: SpatialIndex();
+
+      /// \brief Destructor.
+      public: virtual ~SpatialIndex();
+
+      /// \brief Add a model and its nested models. Their bounds are computed
+      /// by the next refit.
+      /// \param[in] _model Model to add.
+      public: void AddModel(const ModelPtr &_model);
+
+      /// \brief Remove a model and its nested models.
+      /// \param[in] _model Model to remove.
+      public: void RemoveModel(const ModelPtr &_model);
+
+      /// \brief Remove all the models.
+      public: void Clear();
+
+      /// \brief Get the number of indexed models, including nested models.
+      /// \return Number of models.
+      public: size_t ModelCount() const;
+
+      /// \brief Mark the bounds of the model containing an entity, and of the
+      /// models it is nested in, as changed.
+      /// \param[in] _entity A model, or an entity inside a model.
+      public: void MarkDirty(const Base *_entity);
+
+      /// \brief Record that a model moved, without locking the index. The
+      /// model is collected by the next refit, and ignored if it isn't
+      /// indexed by then. Called by Entity::SetWorldPose.
+      /// \param[in] _model The model.
+      public: void MarkMoved(const Model *_model);
+
+      /// \brief Compute the changed bounds again, and update the tree.
+      public: void Refit();
+
+      /// \brief Set the margin added to the bounds stored in the tree.
+      /// Larger margins make refits cheaper for moving models, and queries
+      /// test more candidates. Takes effect as models move.
+      /// \param[in] _margin Margin in meters, the default is 0.1.
+      public: void SetMargin(const double _margin);
+
+      /// \brief Get the margin added to the bounds stored in the tree.
+      /// \return Margin in meters.
+      public: double Margin() const;
+
+      /// \brief Get the bounds of a model.
+      /// \param[in] _model An indexed model.
+      /// \param[out] _bounds Bounds of the model.
+      /// \return False if the model isn't indexed.
+      public: bool Bounds(const ModelPtr &_model,
+                  ignition::math::AxisAlignedBox &_bounds) const;
+
+      /// \brief Get the models whose bounds intersect a box.
+      /// \param[in] _box Box, in the world frame.
+      /// \return The models, in the order they were added.
+      public: Model_V ModelsInBox(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Get the models whose bounds intersect a sphere.
+      /// \param[in] _center Center of the sphere, in the world frame.
+      /// \param[in] _radius Radius of the sphere.
+      /// \return The models, in the order they were added.
+      public: Model_V ModelsInSphere(const ignition::math::Vector3d &_center,
+                  const double _radius) const;
+
+      /// \brief Get the models whose bounds aren't entirely outside one of
+      /// the planes of a frustum. This includes every model for which
+      /// Frustum::Contains(model->BoundingBox()) is true.
+      /// \param[in] _frustum Frustum, in the world frame.
+      /// \return The models, in the order they were added.
+      public: Model_V ModelsInFrustum(
+                  const ignition::math::Frustum &_frustum) const;
+
+      /// \brief Get the models whose bounds are closest to a point.
+      /// \param[in] _point Point, in the world frame.
+      /// \param[in] _count Maximum number of models to return.
+      /// \return Up to _count models, closest first. The distance to a
+      /// model is zero when the point is inside its bounds.
+      public: Model_V NearestModels(const ignition::math::Vector3d &_point,
+                  const unsigned int _count) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SpatialIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/SpatialIndex.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SpatialIndexTest : public ServerFixture
+{
+  /// \brief Get the names of models, sorted.
+  /// \param[in] _models The models.
+  /// \return The sorted names.
+  public: std::vector<std::string> Names(const physics::Model_V &_models)
+          {
+            std::vector<std::string> result;
+            for (auto const &model : _models)
+              result.push_back(model->GetName());
+            std::sort(result.begin(), result.end());
+            return result;
+          }
+};
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, Queries)
+{
+  this->Load("worlds/blank.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::SpatialIndex &index = world->SpatialIndex();
+
+  // Unit boxes along the x axis
+  for (int i = 0; i < 5; ++i)
+  {
+    this->SpawnBox("box_" + std::to_string(i),
+        ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 10, 0, 0.5),
+        ignition::math::Vector3d::Zero, true);
+  }
+
+  // A model without collisions is indexed by its origin
+  this->SpawnEmptyLink("empty", ignition::math::Vector3d(0, 10, 0));
+
+  world->Step(1);
+  EXPECT_EQ(world->ModelCount(), index.ModelCount());
+
+  ignition::math::AxisAlignedBox bounds;
+  ASSERT_TRUE(index.Bounds(world->ModelByName("box_1"), bounds));
+  EXPECT_EQ(ignition::math::Vector3d(9.5, -0.5, 0), bounds.Min());
+  EXPECT_EQ(ignition::math::Vector3d(10.5, 0.5, 1), bounds.Max());
+  ASSERT_TRUE(index.Bounds(world->ModelByName("empty"), bounds));
+  EXPECT_EQ(ignition::math::Vector3d(0, 10, 0), bounds.Min());
+  EXPECT_EQ(ignition::math::Vector3d(0, 10, 0), bounds.Max());
+
+  // Box
+  EXPECT_EQ(std::vector<std::string>({"box_1", "box_2"}),
+      this->Names(index.ModelsInBox(ignition::math::AxisAlignedBox(
+            ignition::math::Vector3d(10, -1, 0),
+            ignition::math::Vector3d(20, 1, 1)))));
+  EXPECT_TRUE(index.ModelsInBox(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(1, 1, 0),
+          ignition::math::Vector3d(9, 9, 1))).empty());
+
+  // Sphere
+  EXPECT_EQ(std::vector<std::string>({"box_0", "empty"}),
+      this->Names(index.ModelsInSphere(
+          ignition::math::Vector3d(0, 5, 0), 5.5)));
+  EXPECT_EQ(std::vector<std::string>({"box_4"}),
+      this->Names(index.ModelsInSphere(
+          ignition::math::Vector3d(41, 0, 0.5), 1)));
+
+  // Nearest, closest first
+  physics::Model_V nearest =
+    index.NearestModels(ignition::math::Vector3d(28, 0, 0.5), 3);
+  ASSERT_EQ(3u, nearest.size());
+  EXPECT_EQ("box_3", nearest[0]->GetName());
+  EXPECT_EQ("box_2", nearest[1]->GetName());
+  EXPECT_EQ("box_4", nearest[2]->GetName());
+  EXPECT_EQ(world->ModelCount(),
+      index.NearestModels(ignition::math::Vector3d::Zero, 100).size());
+  EXPECT_TRUE(index.NearestModels(ignition::math::Vector3d::Zero, 0).empty());
+
+  // Frustum looking down the x axis, which sees the boxes but not the
+  // empty model.
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(100);
+  frustum.SetFOV(IGN_DTOR(60));
+  frustum.SetAspectRatio(1);
+  frustum.SetPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  physics::Model_V inFrustum = index.ModelsInFrustum(frustum);
+  for (int i = 0; i < 5; ++i)
+  {
+    physics::ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    if (frustum.Contains(model->BoundingBox()))
+    {
+      EXPECT_NE(std::find(inFrustum.begin(), inFrustum.end(), model),
+          inFrustum.end()) << model->GetName();
+    }
+  }
+  EXPECT_EQ(5u, inFrustum.size());
+
+  // Moving a model updates its bounds
+  physics::ModelPtr box = world->ModelByName("box_4");
+  box->SetWorldPose(ignition::math::Pose3d(0, -10, 0.5, 0, 0, 0));
+  EXPECT_EQ(std::vector<std::string>({"box_0", "box_4"}),
+      this->Names(index.ModelsInSphere(ignition::math::Vector3d(0, -5, 0), 5)));
+
+  // Removed models are removed from the index
+  world->RemoveModel("box_4");
+  EXPECT_EQ(world->ModelCount(), index.ModelCount());
+  EXPECT_EQ(std::vector<std::string>({"box_0"}),
+      this->Names(index.ModelsInSphere(ignition::math::Vector3d(0, -5, 0), 5)));
+
+  // A model moved and removed before the next refit is ignored by it
+  world->ModelByName("box_3")->SetWorldPose(
+      ignition::math::Pose3d(0, -10, 0.5, 0, 0, 0));
+  world->RemoveModel("box_3");
+  EXPECT_EQ(world->ModelCount(), index.ModelCount());
+  EXPECT_EQ(std::vector<std::string>({"box_0"}),
+      this->Names(index.ModelsInSphere(ignition::math::Vector3d(0, -5, 0), 5)));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, Physics)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::SpatialIndex &index = world->SpatialIndex();
+
+  this->SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d::Zero);
+  world->Step(1);
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  // The ground plane, whose bounds are too large for the tree, is still
+  // found by queries.
+  physics::Model_V near =
+    index.NearestModels(ignition::math::Vector3d(100, 100, 0), 1);
+  ASSERT_EQ(1u, near.size());
+  EXPECT_EQ("ground_plane", near[0]->GetName());
+
+  physics::Model_V above =
+    index.ModelsInSphere(ignition::math::Vector3d(0, 0, 5), 0.1);
+  EXPECT_NE(std::find(above.begin(), above.end(), sphere), above.end());
+
+  // The sphere falls, and the physics engine updates its bounds
+  world->Step(1000);
+  EXPECT_LT(sphere->WorldPose().Pos().Z(), 2);
+
+  ignition::math::AxisAlignedBox bounds;
+  ASSERT_TRUE(index.Bounds(sphere, bounds));
+  EXPECT_EQ(sphere->BoundingBox().Min(), bounds.Min());
+  EXPECT_EQ(sphere->BoundingBox().Max(), bounds.Max());
+
+  above = index.ModelsInSphere(ignition::math::Vector3d(0, 0, 5), 0.1);
+  EXPECT_EQ(std::find(above.begin(), above.end(), sphere), above.end());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
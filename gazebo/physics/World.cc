@@ -22,8 +22,10 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
 #include <deque>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -53,6 +55,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 #include "gazebo/common/Time.hh"
@@ -96,18 +99,107 @@ bool g_clearModels;
 
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: explicit ModelUpdate_TBB(std::vector<Base_V> *_groups)
+          : groups(_groups) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
     {
-      (*models)[i]->Update();
+      for (auto &entity : (*groups)[i])
+        entity->Update();
     }
   }
 
-  private: Model_V *models;
+  private: std::vector<Base_V> *groups;
 };
 
+/// \brief Loads mesh files into the MeshManager in parallel.
+class MeshLoad_TBB
+{
+  public: explicit MeshLoad_TBB(const std::vector<std::string> *_files)
+          : files(_files) {}
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    for (size_t i = _r.begin(); i != _r.end(); i++)
+    {
+      // The entity using the mesh fails to load later on
+      try
+      {
+        common::MeshManager::Instance()->Load((*files)[i]);
+      }
+      catch(common::Exception &_e)
+      {
+        gzerr << "Error loading mesh[" << (*files)[i] << "]: " << _e << "\n";
+      }
+    }
+  }
+
+  private: const std::vector<std::string> *files;
+};
+
+//////////////////////////////////////////////////
+/// \brief Collect the mesh files used by collisions and actors, as the
+/// shapes and actors will look them up when they load.
+/// \param[in] _sdf Element to search recursively.
+/// \param[out] _files Mesh files.
+static void collectMeshFiles(const sdf::ElementPtr &_sdf,
+    std::set<std::string> &_files)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+
+  if (_sdf->GetName() == "collision" && _sdf->HasElement("geometry"))
+  {
+    sdf::ElementPtr geomElem = _sdf->GetElement("geometry");
+    if (geomElem->HasElement("mesh"))
+    {
+      sdf::ElementPtr meshElem = geomElem->GetElement("mesh");
+      std::string uri = common::asFullPath(meshElem->Get<std::string>("uri"),
+          meshElem->FilePath());
+      if (meshManager->IsValidFilename(uri))
+      {
+        std::string filename = common::find_file(uri);
+        if (!filename.empty())
+          _files.insert(filename);
+      }
+    }
+    return;
+  }
+
+  if (_sdf->GetName() == "actor")
+  {
+    if (_sdf->HasElement("skin"))
+    {
+      std::string filename =
+        _sdf->GetElement("skin")->Get<std::string>("filename");
+      if (meshManager->IsValidFilename(filename))
+        _files.insert(filename);
+    }
+
+    sdf::ElementPtr animElem = _sdf->GetElementImpl("animation");
+    while (animElem)
+    {
+      std::string filename = animElem->Get<std::string>("filename");
+      if (meshManager->IsValidFilename(filename))
+        _files.insert(filename);
+      animElem = animElem->GetNextElement("animation");
+    }
+    return;
+  }
+
+  if (_sdf->GetName() != "world" && _sdf->GetName() != "model" &&
+      _sdf->GetName() != "link")
+  {
+    return;
+  }
+
+  sdf::ElementPtr childElem = _sdf->GetFirstElement();
+  while (childElem)
+  {
+    collectMeshFiles(childElem, _files);
+    childElem = childElem->GetNextElement();
+  }
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -148,6 +240,9 @@ World::World(const std::string &_name)
   this->dataPtr->enableWind = true;
   this->dataPtr->enableAtmosphere = true;
 
+  // Entities mark their models in the index from the time they're loaded.
+  this->dataPtr->spatialIndex.reset(new physics::SpatialIndex());
+
   this->dataPtr->sleepOffset = common::Time(0);
 
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
@@ -259,6 +354,11 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // Skeleton poses of all the actors, published once per update
+  this->dataPtr->skeletonPosePub =
+    this->dataPtr->node->Advertise<msgs::PoseAnimation_V>(
+        "~/skeleton_pose/info_v", 10);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -420,13 +520,20 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
+  // Choose threaded or unthreaded model updating. The model update
+  // strategy is not part of the SDFormat spec.
   this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  const std::string kModelUpdateStrategy = "gz:model_update_strategy";
+  if (this->dataPtr->sdf->HasElement(kModelUpdateStrategy))
+  {
+    std::string strategy =
+      this->dataPtr->sdf->Get<std::string>(kModelUpdateStrategy);
+    if (!this->SetModelUpdateStrategy(strategy))
+    {
+      gzerr << "Unknown <" << kModelUpdateStrategy << "> [" << strategy
+            << "], using [serial]" << std::endl;
+    }
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -736,6 +843,218 @@ void World::_SetSensorsInitialized(const bool _init)
   this->dataPtr->sensorsInitialized = _init;
 }
 
+//////////////////////////////////////////////////
+void World::_AddToEntityIndex(const BasePtr &_base)
+{
+  if (!_base || _base->GetWorld().get() != this)
+    return;
+
+  // Only entities of the entity tree are indexed, so that looking up a
+  // missing entity doesn't require walking the tree.
+  BasePtr parent = _base->GetParent();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    if (parent)
+    {
+      if (this->dataPtr->entityIndex.find(parent.get()) ==
+          this->dataPtr->entityIndex.end())
+      {
+        return;
+      }
+    }
+    else if (_base != this->dataPtr->rootElement)
+    {
+      return;
+    }
+  }
+
+  // Collect the entity and its descendants, which may have been added to
+  // it before it joined the tree.
+  std::vector<BasePtr> bases;
+  bases.push_back(_base);
+  for (size_t i = 0; i < bases.size(); ++i)
+  {
+    for (unsigned int c = 0; c < bases[i]->GetChildCount(); ++c)
+      bases.push_back(bases[i]->GetChild(c));
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  for (auto const &base : bases)
+  {
+    if (!base || base->GetWorld().get() != this ||
+        this->dataPtr->entityIndex.count(base.get()))
+    {
+      continue;
+    }
+
+    WorldEntityIndexEntry &entry = this->dataPtr->entityIndex[base.get()];
+    entry.base = base;
+    entry.scopedName = base->GetScopedName();
+    entry.name = base->GetName();
+    entry.id = base->GetId();
+
+    this->dataPtr->entityIndexByScopedName.emplace(entry.scopedName,
+        base.get());
+    this->dataPtr->entityIndexByName.emplace(entry.name, base.get());
+    this->dataPtr->entityIndexById[entry.id] = base.get();
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove an entity from a multimap of the entity index.
+/// \param[in] _map The multimap.
+/// \param[in] _key Key the entity is indexed under.
+/// \param[in] _base The entity.
+static void eraseEntityIndexKey(
+    std::unordered_multimap<std::string, const Base *> &_map,
+    const std::string &_key, const Base *_base)
+{
+  auto range = _map.equal_range(_key);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second == _base)
+    {
+      _map.erase(iter);
+      return;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void World::_UpdateEntityIndex(const Base *_base)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  auto iter = this->dataPtr->entityIndex.find(_base);
+  if (iter == this->dataPtr->entityIndex.end())
+    return;
+
+  WorldEntityIndexEntry &entry = iter->second;
+  std::string scopedName = _base->GetScopedName();
+  if (scopedName != entry.scopedName)
+  {
+    eraseEntityIndexKey(this->dataPtr->entityIndexByScopedName,
+        entry.scopedName, _base);
+    entry.scopedName = scopedName;
+    this->dataPtr->entityIndexByScopedName.emplace(scopedName, _base);
+  }
+
+  std::string name = _base->GetName();
+  if (name != entry.name)
+  {
+    eraseEntityIndexKey(this->dataPtr->entityIndexByName, entry.name, _base);
+    entry.name = name;
+    this->dataPtr->entityIndexByName.emplace(name, _base);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::_RemoveFromEntityIndex(const Base *_base)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  auto iter = this->dataPtr->entityIndex.find(_base);
+  if (iter == this->dataPtr->entityIndex.end())
+    return;
+
+  eraseEntityIndexKey(this->dataPtr->entityIndexByScopedName,
+      iter->second.scopedName, _base);
+  eraseEntityIndexKey(this->dataPtr->entityIndexByName,
+      iter->second.name, _base);
+  auto idIter = this->dataPtr->entityIndexById.find(iter->second.id);
+  if (idIter != this->dataPtr->entityIndexById.end() &&
+      idIter->second == _base)
+  {
+    this->dataPtr->entityIndexById.erase(idIter);
+  }
+  this->dataPtr->entityIndex.erase(iter);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether an entity is a descendant of another one.
+/// \param[in] _base The entity.
+/// \param[in] _scope The other entity.
+/// \return True if _base is _scope or one of its descendants.
+static bool inEntityScope(const BasePtr &_base, const Base *_scope)
+{
+  // Every indexed entity descends from the root
+  if (!_scope->GetParent())
+    return true;
+
+  for (BasePtr p = _base; p; p = p->GetParent())
+  {
+    if (p.get() == _scope)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool World::_EntityIndexByName(const std::string &_name, const Base *_scope,
+    BasePtr &_result) const
+{
+  _result.reset();
+
+  // Copy the candidates, the entities are locked without holding the
+  // mutex since releasing the last reference to one removes it from the
+  // index.
+  std::vector<boost::weak_ptr<Base>> candidates;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    if (!this->dataPtr->entityIndex.count(_scope))
+      return false;
+
+    auto scopedRange =
+      this->dataPtr->entityIndexByScopedName.equal_range(_name);
+    for (auto iter = scopedRange.first; iter != scopedRange.second; ++iter)
+      candidates.push_back(this->dataPtr->entityIndex.at(iter->second).base);
+
+    auto range = this->dataPtr->entityIndexByName.equal_range(_name);
+    for (auto iter = range.first; iter != range.second; ++iter)
+      candidates.push_back(this->dataPtr->entityIndex.at(iter->second).base);
+  }
+
+  for (auto const &candidate : candidates)
+  {
+    BasePtr base = candidate.lock();
+    if (!base || base == _result || !inEntityScope(base, _scope))
+      continue;
+
+    // Base::GetByName returns the first match of a depth first search,
+    // only the tree knows which one it is.
+    if (_result)
+    {
+      _result.reset();
+      return false;
+    }
+    _result = base;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::_EntityIndexById(const uint32_t _id, const Base *_scope,
+    BasePtr &_result) const
+{
+  _result.reset();
+
+  boost::weak_ptr<Base> candidate;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    if (!this->dataPtr->entityIndex.count(_scope))
+      return false;
+
+    auto iter = this->dataPtr->entityIndexById.find(_id);
+    if (iter != this->dataPtr->entityIndexById.end())
+      candidate = this->dataPtr->entityIndex.at(iter->second).base;
+  }
+
+  BasePtr base = candidate.lock();
+  if (base && inEntityScope(base, _scope))
+    _result = base;
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool World::SensorsInitialized() const
 {
@@ -921,6 +1240,20 @@ void World::Update()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Model::Update");
 
+  IGN_PROFILE_BEGIN("PublishSkeletonPoses");
+  // Publish the skeleton poses of the actors updated above together
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->skeletonPosesMutex);
+    if (this->dataPtr->skeletonPoses.pose_animation_size() > 0)
+    {
+      if (this->dataPtr->skeletonPosePub)
+        this->dataPtr->skeletonPosePub->Publish(this->dataPtr->skeletonPoses);
+      this->dataPtr->skeletonPoses.clear_pose_animation();
+    }
+  }
+  IGN_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "PublishSkeletonPoses");
+
   IGN_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
   this->dataPtr->physicsEngine->UpdateCollision();
@@ -982,6 +1315,13 @@ void World::Update()
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
   }
 
+  // Setting the poses above marked the models that moved, update their
+  // bounds before the sensors query them.
+  IGN_PROFILE_BEGIN("SpatialIndex::Refit");
+  this->dataPtr->spatialIndex->Refit();
+  IGN_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "SpatialIndex::Refit");
+
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
@@ -1039,6 +1379,7 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->skeletonPosePub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
@@ -1069,6 +1410,8 @@ void World::Fini()
       model->Fini();
   }
   this->dataPtr->models.clear();
+  this->dataPtr->spatialIndex->Clear();
+  this->_InvalidateModelUpdateGroups();
 
   for (auto &road : this->dataPtr->roads)
   {
@@ -1089,9 +1432,25 @@ void World::Fini()
     this->dataPtr->rootElement->Fini();
     this->dataPtr->rootElement.reset();
   }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    this->dataPtr->entityIndex.clear();
+    this->dataPtr->entityIndexByScopedName.clear();
+    this->dataPtr->entityIndexByName.clear();
+    this->dataPtr->entityIndexById.clear();
+  }
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
+  this->dataPtr->logFilteredModels.clear();
+  this->dataPtr->logFilteredModelsDirty = true;
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+    this->dataPtr->logInsertedModels.clear();
+    this->dataPtr->logInsertedLights.clear();
+    this->dataPtr->logDeletedModels.clear();
+    this->dataPtr->logDeletedLights.clear();
+  }
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1170,6 +1529,12 @@ Wind &World::Wind() const
   return *this->dataPtr->wind;
 }
 
+//////////////////////////////////////////////////
+SpatialIndex &World::SpatialIndex() const
+{
+  return *this->dataPtr->spatialIndex;
+}
+
 //////////////////////////////////////////////////
 Atmosphere &World::Atmosphere() const
 {
@@ -1295,6 +1660,13 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
 
   this->PublishModelPose(model);
   this->dataPtr->models.push_back(model);
+  this->dataPtr->spatialIndex->AddModel(model);
+  if (model)
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+    LogInsertion(model->GetName(), model, this->dataPtr->logInsertedModels);
+  }
+  this->_InvalidateModelUpdateGroups();
   return model;
 }
 
@@ -1320,6 +1692,11 @@ LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
   light->SetWorld(shared_from_this());
   light->Load(_sdf);
   this->dataPtr->lights.push_back(light);
+  this->_InvalidateModelUpdateGroups();
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+    LogInsertion(light->GetName(), light, this->dataPtr->logInsertedLights);
+  }
 
   // msg should contain scoped name (consistent with other entities)
   msg->set_name(light->GetScopedName());
@@ -1350,6 +1727,13 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   this->EnableAllModels();
   this->PublishModelPose(actor);
   this->dataPtr->models.push_back(actor);
+  this->dataPtr->spatialIndex->AddModel(actor);
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+    LogInsertion<ModelPtr>(actor->GetName(), actor,
+        this->dataPtr->logInsertedModels);
+  }
+  this->_InvalidateModelUpdateGroups();
 
   return actor;
 }
@@ -1366,6 +1750,21 @@ RoadPtr World::LoadRoad(sdf::ElementPtr _sdf , BasePtr _parent)
 //////////////////////////////////////////////////
 void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 {
+  DIAG_TIMER_START("World::LoadEntities");
+  common::Time startTime = common::Time::GetWallTime();
+
+  // Parsing mesh files takes most of the time of loading large worlds. The
+  // files are parsed in parallel first, so that creating the entities,
+  // which must happen in order, finds them in the MeshManager.
+  std::set<std::string> meshFiles;
+  collectMeshFiles(_sdf, meshFiles);
+  std::vector<std::string> meshFileList(meshFiles.begin(), meshFiles.end());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, meshFileList.size()),
+      MeshLoad_TBB(&meshFileList));
+
+  common::Time meshTime = common::Time::GetWallTime();
+  DIAG_TIMER_LAP("World::LoadEntities", "loadMeshes");
+
   if (_sdf->HasElement("light"))
   {
     sdf::ElementPtr childElem = _sdf->GetElement("light");
@@ -1413,6 +1812,15 @@ void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
       childElem = childElem->GetNextElement("road");
     }
   }
+
+  DIAG_TIMER_LAP("World::LoadEntities", "createEntities");
+  DIAG_TIMER_STOP("World::LoadEntities");
+
+  common::Time endTime = common::Time::GetWallTime();
+  gzlog << "Loaded entities of world[" << this->Name() << "] in "
+        << (endTime - startTime).Double() << " s, including "
+        << meshFileList.size() << " mesh files in "
+        << (meshTime - startTime).Double() << " s\n";
 }
 
 //////////////////////////////////////////////////
@@ -1763,12 +2171,154 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::ModelUpdateTBB()
+{
+  if (this->dataPtr->modelUpdateGroupsDirty)
+    this->BuildModelUpdateGroups();
+
+  // Nothing can run concurrently, avoid the cost of spawning tasks.
+  if (this->dataPtr->modelUpdateGroups.size() < 2)
+  {
+    this->ModelUpdateSingleLoop();
+    return;
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0,
+      this->dataPtr->modelUpdateGroups.size()),
+      ModelUpdate_TBB(&this->dataPtr->modelUpdateGroups));
+}
+
+//////////////////////////////////////////////////
+void World::BuildModelUpdateGroups()
+{
+  this->dataPtr->modelUpdateGroupsDirty = false;
+  this->dataPtr->modelUpdateGroups.clear();
+
+  const unsigned int count = this->dataPtr->rootElement->GetChildCount();
+
+  // Union-find over the root entities, joined by joints.
+  std::vector<unsigned int> parents(count);
+  std::map<Base *, unsigned int> rootIndices;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    parents[i] = i;
+    rootIndices[this->dataPtr->rootElement->GetChild(i).get()] = i;
+  }
+
+  // Index of the root entity containing a link, which may be in a nested
+  // model.
+  BasePtr rootElement = this->dataPtr->rootElement;
+  auto rootIndex = [&rootIndices, &rootElement](const LinkPtr &_link)
+  {
+    BasePtr entity = _link;
+    while (entity && entity->GetParent() != rootElement)
+      entity = entity->GetParent();
+    return rootIndices.find(entity.get());
+  };
+
+  auto findRoot = [&parents](unsigned int _i)
+  {
+    while (parents[_i] != _i)
+    {
+      parents[_i] = parents[parents[_i]];
+      _i = parents[_i];
+    }
+    return _i;
+  };
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (!child->HasType(Base::MODEL))
+      continue;
+
+    // Visit the model and all of its nested models, which are updated by
+    // Model::Update.
+    std::list<ModelPtr> modelList;
+    modelList.push_back(boost::static_pointer_cast<Model>(child));
+    while (!modelList.empty())
+    {
+      ModelPtr model = modelList.front();
+      modelList.pop_front();
+
+      for (auto const &nested : model->NestedModels())
+        modelList.push_back(nested);
+
+      for (auto const &joint : model->GetJoints())
+      {
+        for (auto const &link : {joint->GetParent(), joint->GetChild()})
+        {
+          if (!link)
+            continue;
+
+          auto iter = rootIndex(link);
+          if (iter != rootIndices.end())
+            parents[findRoot(iter->second)] = findRoot(i);
+        }
+      }
+    }
+  }
+
+  // Build the groups, keeping the order of the root entities.
+  std::map<unsigned int, size_t> groupIndices;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    unsigned int root = findRoot(i);
+    auto iter = groupIndices.find(root);
+    if (iter == groupIndices.end())
+    {
+      iter = groupIndices.insert(
+          std::make_pair(root, this->dataPtr->modelUpdateGroups.size())).first;
+      this->dataPtr->modelUpdateGroups.push_back(Base_V());
+    }
+    this->dataPtr->modelUpdateGroups[iter->second].push_back(
+        this->dataPtr->rootElement->GetChild(i));
+  }
+}
+
+//////////////////////////////////////////////////
+void World::_InvalidateModelUpdateGroups()
+{
+  this->dataPtr->modelUpdateGroupsDirty = true;
+}
+
+//////////////////////////////////////////////////
+std::vector<Base_V> World::_ModelUpdateGroups()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  if (this->dataPtr->modelUpdateGroupsDirty)
+    this->BuildModelUpdateGroups();
+  return this->dataPtr->modelUpdateGroups;
+}
+
+//////////////////////////////////////////////////
+bool World::SetModelUpdateStrategy(const std::string &_strategy)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  if (_strategy == "serial")
+  {
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+  }
+  else if (_strategy == "parallel")
+  {
+    this->dataPtr->modelUpdateGroupsDirty = true;
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  }
+  else
+  {
+    return false;
+  }
+
+  this->dataPtr->modelUpdateStrategy = _strategy;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string World::ModelUpdateStrategy() const
+{
+  return this->dataPtr->modelUpdateStrategy;
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -3014,6 +3564,81 @@ void World::PublishLightPose(const physics::LightPtr _light)
 }
 
 //////////////////////////////////////////////////
+void World::PublishSkeletonPose(msgs::PoseAnimation &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->skeletonPosesMutex);
+  // add_pose_animation reuses a message cleared after the last publication
+  this->dataPtr->skeletonPoses.add_pose_animation()->Swap(&_msg);
+}
+
+//////////////////////////////////////////////////
+bool World::HasSkeletonPoseConnections() const
+{
+  return this->dataPtr->skeletonPosePub &&
+    this->dataPtr->skeletonPosePub->HasConnections();
+}
+
+//////////////////////////////////////////////////
+/// \brief Record the insertion of an entity for the next log update.
+/// \param[in] _name Name of the entity.
+/// \param[in] _entity The entity.
+/// \param[in,out] _inserted Entities inserted since the last log update.
+template<typename T>
+static void LogInsertion(const std::string &_name, const T &_entity,
+    std::map<std::string, T> &_inserted)
+{
+  _inserted[_name] = _entity;
+}
+
+//////////////////////////////////////////////////
+/// \brief Record the deletion of an entity for the next log update. An
+/// entity inserted since the last log update is simply forgotten.
+/// \param[in] _name Name of the entity.
+/// \param[in,out] _inserted Entities inserted since the last log update.
+/// \param[in,out] _deleted Entities deleted since the last log update.
+template<typename T>
+static void LogDeletion(const std::string &_name,
+    std::map<std::string, T> &_inserted, std::set<std::string> &_deleted)
+{
+  if (_inserted.erase(_name) == 0)
+    _deleted.insert(_name);
+}
+
+//////////////////////////////////////////////////
+/// \brief Take the models and lights inserted and deleted since the last
+/// log update, as recorded when they were loaded and removed. The result is
+/// in the same order as the insertions and deletions of a WorldState
+/// difference.
+/// \param[in,out] _data Private data of the world, whose insertions and
+/// deletions are cleared.
+/// \param[out] _insertions SDF of the inserted models and lights.
+/// \param[out] _deletions Names of the deleted models and lights.
+/// \return True if there was any insertion or deletion.
+static bool LogInsertionsDeletions(WorldPrivate &_data,
+    std::vector<std::string> &_insertions,
+    std::vector<std::string> &_deletions)
+{
+  std::lock_guard<std::mutex> lock(_data.logEntitiesMutex);
+
+  _deletions.insert(_deletions.end(), _data.logDeletedModels.begin(),
+      _data.logDeletedModels.end());
+  _deletions.insert(_deletions.end(), _data.logDeletedLights.begin(),
+      _data.logDeletedLights.end());
+
+  for (auto const &model : _data.logInsertedModels)
+    _insertions.push_back(model.second->UnscaledSDF()->ToString(""));
+  for (auto const &light : _data.logInsertedLights)
+    _insertions.push_back(light.second->GetSDF()->ToString(""));
+
+  _data.logDeletedModels.clear();
+  _data.logDeletedLights.clear();
+  _data.logInsertedModels.clear();
+  _data.logInsertedLights.clear();
+
+  return !_insertions.empty() || !_deletions.empty();
+}
+
+/////////////////////////////////////////////////
 void World::LogWorker()
 {
   std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
@@ -3023,48 +3648,70 @@ void World::LogWorker()
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  // The entities loaded so far are part of the first state
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+    this->dataPtr->logInsertedModels.clear();
+    this->dataPtr->logInsertedLights.clear();
+    this->dataPtr->logDeletedModels.clear();
+    this->dataPtr->logDeletedLights.clear();
+  }
 
   while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
-    {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
-    }
-
-    // compute world state diff and find out about insertions and deletions
     std::vector<std::string> insertions;
     std::vector<std::string> deletions;
     bool insertDelete = false;
+    bool capture = false;
+    int currState = (this->dataPtr->stateToggle + 1) % 2;
+    auto simTime = this->SimTime();
 
     {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
+      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+
+      // Find out about insertions and deletions. They are recorded as
+      // entities are loaded and removed, which is much cheaper than loading
+      // and comparing the state of every entity.
+      insertDelete = LogInsertionsDeletions(*this->dataPtr, insertions,
+          deletions);
+
+      // Throttle state capture based on log recording frequency.
+      capture = (simTime - this->dataPtr->logLastStateTime >=
+          util::LogRecord::Instance()->Period()) || insertDelete;
+
+      if (capture)
       {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
+        // Only match the models against the filter when it has changed, or
+        // when models were inserted or deleted.
+        auto filterRegex = util::LogRecord::Instance()->FilterRegex();
+        if (insertDelete || filterRegex != this->dataPtr->logFilterRegex)
+          this->dataPtr->logFilteredModelsDirty = true;
+
+        if (this->dataPtr->logFilteredModelsDirty)
+        {
+          this->dataPtr->logFilteredModels = this->Models();
+          if (filterRegex)
+          {
+            auto &models = this->dataPtr->logFilteredModels;
+            models.erase(std::remove_if(models.begin(), models.end(),
+                  [&filterRegex](const ModelPtr &_model)
+                  {
+                    return !boost::regex_match(_model->GetName(),
+                        *filterRegex);
+                  }), models.end());
+          }
+          this->dataPtr->logFilterRegex = filterRegex;
+          this->dataPtr->logFilteredModelsDirty = false;
+        }
+
+        // compute diff for filtered states
+        this->dataPtr->prevStates[currState].Load(self,
+            this->dataPtr->logFilteredModels);
       }
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
+    if (capture)
     {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
-
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
-      {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
-      }
       WorldState diffState = this->dataPtr->prevStates[currState] -
           this->dataPtr->prevStates[this->dataPtr->stateToggle];
       this->dataPtr->logPrevIteration = this->dataPtr->iterations;
@@ -3167,8 +3814,15 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        this->dataPtr->spatialIndex->RemoveModel(*model);
+        {
+          std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+          LogDeletion((*model)->GetName(), this->dataPtr->logInsertedModels,
+              this->dataPtr->logDeletedModels);
+        }
         this->dataPtr->models.erase(model);
         this->dataPtr->rootElement->RemoveChild(_name);
+        this->_InvalidateModelUpdateGroups();
         break;
       }
     }
@@ -3189,7 +3843,13 @@ void World::RemoveModel(const std::string &_name)
           // list
           (*light)->GetParent()->RemoveChild(*light);
         }
+        {
+          std::lock_guard<std::mutex> eLock(this->dataPtr->logEntitiesMutex);
+          LogDeletion((*light)->GetName(), this->dataPtr->logInsertedLights,
+              this->dataPtr->logDeletedLights);
+        }
         this->dataPtr->lights.erase(light);
+        this->_InvalidateModelUpdateGroups();
         break;
       }
     }
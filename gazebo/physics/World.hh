@@ -39,6 +39,7 @@
 
 #include "gazebo/physics/Base.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/WorldState.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/util/system.hh"
@@ -156,6 +157,11 @@ namespace gazebo
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
 
+      /// \brief Get a reference to the spatial index of the models, used to
+      /// find the models inside a region or near a point.
+      /// \return Reference to the spatial index.
+      public: physics::SpatialIndex &SpatialIndex() const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr SphericalCoords() const;
@@ -401,6 +407,22 @@ namespace gazebo
       /// \param[in] _light Pointer to the light to publish.
       public: void PublishLightPose(const physics::LightPtr _light);
 
+      /// \brief Publish the skeleton pose of an actor. The skeleton poses
+      /// added while models are updated are published together, in one
+      /// msgs::PoseAnimation_V on ~/skeleton_pose/info_v, once models are
+      /// updated. This function is thread safe.
+      /// \param[in,out] _msg Skeleton pose of the actor. It is swapped with
+      /// a cleared message of a previous update, instead of being copied,
+      /// so that the caller can reuse its storage.
+      /// \sa HasSkeletonPoseConnections
+      public: void PublishSkeletonPose(msgs::PoseAnimation &_msg);
+
+      /// \brief Get whether skeleton poses published with
+      /// PublishSkeletonPose have subscribers. Actors don't build their
+      /// skeleton pose message if they don't.
+      /// \return True if there are subscribers.
+      public: bool HasSkeletonPoseConnections() const;
+
       /// \brief Get the total number of iterations.
       /// \return Number of iterations that simulation has taken.
       public: uint32_t Iterations() const;
@@ -439,6 +461,48 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \internal
+      /// \brief Inform the World that models or joints were added or
+      /// removed, so that the groups used by the parallel model update are
+      /// rebuilt before the next update.
+      public: void _InvalidateModelUpdateGroups();
+
+      /// \internal
+      /// \brief Get the groups of root entities used by the "parallel"
+      /// model update strategy. Groups are updated concurrently, and the
+      /// entities of a group in order.
+      /// \return The groups.
+      public: std::vector<Base_V> _ModelUpdateGroups();
+
+      /// \brief Set how models are updated at the start of each step.
+      ///
+      /// "serial" updates every model, one after the other, on the world
+      /// thread. This is the default.
+      ///
+      /// "parallel" splits the top level models into independent groups
+      /// and updates the groups concurrently. Models connected by a joint
+      /// are placed in the same group and are updated in order by a single
+      /// task. With this strategy:
+      ///  - Model::Update, Joint::Update and JointController::Update of
+      ///    different groups may run at the same time, and so may callbacks
+      ///    connected to Joint::ConnectJointUpdate.
+      ///  - State owned by a model (links, joints, animations, joint
+      ///    controller) may only be modified from its own group.
+      ///  - World state may only be modified through functions that are
+      ///    already thread safe, such as Entity::SetWorldPose and
+      ///    World::PublishModelPose.
+      /// World update events, such as Events::worldUpdateBegin, are still
+      /// emitted on the world thread.
+      /// \param[in] _strategy "serial" or "parallel".
+      /// \return True if the strategy was recognized.
+      /// \sa ModelUpdateStrategy
+      public: bool SetModelUpdateStrategy(const std::string &_strategy);
+
+      /// \brief Get the name of the model update strategy.
+      /// \return "serial" or "parallel".
+      /// \sa SetModelUpdateStrategy
+      public: std::string ModelUpdateStrategy() const;
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
@@ -449,6 +513,47 @@ namespace gazebo
       /// \param[in] _init True if sensors have been initialized.
       public: void _SetSensorsInitialized(const bool _init);
 
+      /// \internal
+      /// \brief Add an entity and its descendants to the index used to
+      /// look up entities by name and id. This should only be called by
+      /// Base, when the entity joins the entity tree of this world.
+      /// \param[in] _base The entity.
+      public: void _AddToEntityIndex(const BasePtr &_base);
+
+      /// \internal
+      /// \brief Update the entity index after an entity was renamed. This
+      /// should only be called by Base.
+      /// \param[in] _base The entity.
+      public: void _UpdateEntityIndex(const Base *_base);
+
+      /// \internal
+      /// \brief Remove an entity from the entity index. This should only
+      /// be called by Base.
+      /// \param[in] _base The entity.
+      public: void _RemoveFromEntityIndex(const Base *_base);
+
+      /// \internal
+      /// \brief Look up an entity by scoped name or name in the entity
+      /// index.
+      /// \param[in] _name Scoped name or name of the entity.
+      /// \param[in] _scope Only consider this entity and its descendants.
+      /// \param[out] _result The entity, nullptr if there is none.
+      /// \return False if the index can't answer, because _scope is not
+      /// indexed or because several entities match. The entity tree must be
+      /// searched instead.
+      public: bool _EntityIndexByName(const std::string &_name,
+                  const Base *_scope, BasePtr &_result) const;
+
+      /// \internal
+      /// \brief Look up an entity by id in the entity index.
+      /// \param[in] _id Id of the entity.
+      /// \param[in] _scope Only consider this entity and its descendants.
+      /// \param[out] _result The entity, nullptr if there is none.
+      /// \return False if the index can't answer, because _scope is not
+      /// indexed. The entity tree must be searched instead.
+      public: bool _EntityIndexById(const uint32_t _id, const Base *_scope,
+                  BasePtr &_result) const;
+
       /// \brief Return the URI of the world.
       /// \return URI of this world.
       public: common::URI URI() const;
@@ -567,6 +672,10 @@ namespace gazebo
       /// \brief TBB version of model updating.
       private: void ModelUpdateTBB();
 
+      /// \brief Rebuild the groups of independent root entities used by
+      /// ModelUpdateTBB.
+      private: void BuildModelUpdateGroups();
+
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
@@ -21,14 +21,17 @@
 #include <deque>
 #include <vector>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <sdf/sdf.hh>
 #include <string>
+#include <unordered_map>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
 
+#include <boost/weak_ptr.hpp>
 #include <ignition/transport.hh>
 
 #include "gazebo/common/Event.hh"
@@ -40,12 +43,29 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief An entity of the entity index.
+    class WorldEntityIndexEntry
+    {
+      /// \brief The entity.
+      public: boost::weak_ptr<Base> base;
+
+      /// \brief Scoped name the entity is indexed under.
+      public: std::string scopedName;
+
+      /// \brief Name the entity is indexed under.
+      public: std::string name;
+
+      /// \brief Id of the entity.
+      public: uint32_t id = 0;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -58,6 +78,9 @@ namespace gazebo
       /// \brief Unique pointer the wind. The world owns this pointer.
       public: std::unique_ptr<Wind> wind;
 
+      /// \brief Spatial index of the models. The world owns this pointer.
+      public: std::unique_ptr<SpatialIndex> spatialIndex;
+
       /// \brief Unique pointer the atmosphere model.
       /// The world owns this pointer.
       public: std::unique_ptr<Atmosphere> atmosphere;
@@ -119,6 +142,9 @@ namespace gazebo
       /// \brief Publisher for pose messages.
       public: transport::PublisherPtr posePub;
 
+      /// \brief Publisher for the skeleton poses of actors.
+      public: transport::PublisherPtr skeletonPosePub;
+
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
@@ -158,6 +184,18 @@ namespace gazebo
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Name of the model update strategy, see
+      /// World::SetModelUpdateStrategy.
+      public: std::string modelUpdateStrategy = "serial";
+
+      /// \brief Groups of root entities used by the parallel model update.
+      /// Entities that are connected by a joint share a group, and the
+      /// entities of a group are updated in order by a single task.
+      public: std::vector<Base_V> modelUpdateGroups;
+
+      /// \brief True when modelUpdateGroups must be rebuilt.
+      public: std::atomic<bool> modelUpdateGroupsDirty{true};
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
@@ -176,6 +214,27 @@ namespace gazebo
       /// \brief Mutex to protext loading of lights.
       public: std::mutex loadLightMutex;
 
+      /// \brief Protects the entity index.
+      public: mutable std::mutex entityIndexMutex;
+
+      /// \brief All the entities of the entity tree, so that they can be
+      /// looked up by name and id without walking the tree. An entity is
+      /// indexed only if its parent is, starting with rootElement.
+      public: std::unordered_map<const Base *, WorldEntityIndexEntry>
+              entityIndex;
+
+      /// \brief Indexed entities, by scoped name. Links and joints of a
+      /// model may share a scoped name.
+      public: std::unordered_multimap<std::string, const Base *>
+              entityIndexByScopedName;
+
+      /// \brief Indexed entities, by name.
+      public: std::unordered_multimap<std::string, const Base *>
+              entityIndexByName;
+
+      /// \brief Indexed entities, by id.
+      public: std::unordered_map<uint32_t, const Base *> entityIndexById;
+
       /// \TODO: Add an accessor for this, and make it private
       /// Used in Entity.cc.
       /// Entity::Reset to call Entity::SetWorldPose and Entity::SetRelativePose
@@ -274,9 +333,33 @@ namespace gazebo
       /// \brief Buffer of prev states
       public: WorldState prevStates[2];
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
+      /// \brief Models inserted since the previous log update, by name.
+      public: std::map<std::string, ModelPtr> logInsertedModels;
+
+      /// \brief Lights inserted since the previous log update, by name.
+      public: std::map<std::string, LightPtr> logInsertedLights;
+
+      /// \brief Names of the models deleted since the previous log update,
+      /// which existed at that update.
+      public: std::set<std::string> logDeletedModels;
+
+      /// \brief Names of the lights deleted since the previous log update,
+      /// which existed at that update.
+      public: std::set<std::string> logDeletedLights;
+
+      /// \brief Mutex to protect the insertions and deletions above.
+      public: std::mutex logEntitiesMutex;
+
+      /// \brief Models that pass the log filter. Only rebuilt when the
+      /// filter changes or models are inserted or deleted.
+      public: Model_V logFilteredModels;
+
+      /// \brief Filter that logFilteredModels was built with, see
+      /// util::LogRecord::FilterRegex.
+      public: std::shared_ptr<const boost::regex> logFilterRegex;
+
+      /// \brief True when logFilteredModels must be rebuilt.
+      public: bool logFilteredModelsDirty = true;
 
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
@@ -300,6 +383,14 @@ namespace gazebo
       /// \brief The list of lights that need to publish their pose.
       public: std::set<LightPtr> publishLightPoses;
 
+      /// \brief Skeleton poses of actors to publish after the models are
+      /// updated. Cleared elements are reused by the next update.
+      public: msgs::PoseAnimation_V skeletonPoses;
+
+      /// \brief Mutex to protect skeletonPoses, which actors in different
+      /// model update groups add to concurrently.
+      public: std::mutex skeletonPosesMutex;
+
       /// \brief Info passed through the WorldUpdateBegin event.
       public: common::UpdateInfo updateInfo;
 
@@ -17,6 +17,7 @@
 /* Desc: A world state
  * Author: Nate Koenig
  */
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/common/Console.hh"
@@ -90,15 +91,6 @@ void WorldState::LoadWithFilter(const WorldPtr _world,
 /////////////////////////////////////////////////
 void WorldState::Load(const WorldPtr _world)
 {
-  this->world = _world;
-  this->name = _world->Name();
-  this->wallTime = common::Time::GetWallTime();
-  this->simTime = _world->SimTime();
-  this->realTime = _world->RealTime();
-  this->iterations = _world->Iterations();
-  this->insertions.clear();
-  this->deletions.clear();
-
   std::string filter = worldStateFilter;
   std::list<std::string> mainParts, parts;
   boost::split(mainParts, filter, boost::is_any_of("/"));
@@ -110,30 +102,42 @@ void WorldState::Load(const WorldPtr _world)
     if (parts.empty() && !mainParts.front().empty())
       parts.push_back(mainParts.front());
   }
-  std::list<std::string>::iterator partIter = parts.begin();
 
-  // Add a state for all the models that match the filter
+  // The first element in the filter must be a model name or a star.
   Model_V models = _world->Models();
-  for (Model_V::const_iterator iter = models.begin();
-       iter != models.end(); ++iter)
+  if (!parts.empty() && !parts.front().empty() && parts.front() != "*")
   {
-    bool add = true;
+    std::string regexStr = parts.front();
+    boost::replace_all(regexStr, "*", ".*");
+    boost::regex regex(regexStr);
+
+    models.erase(std::remove_if(models.begin(), models.end(),
+          [&regex](const ModelPtr &_model)
+          {
+            return !boost::regex_match(_model->GetName(), regex);
+          }), models.end());
+  }
 
-    // The first element in the filter must be a model name or a star.
-    if (partIter != parts.end() && !parts.empty() &&
-        !(*partIter).empty() && (*partIter) != "*")
-    {
-      std::string regexStr = *partIter;
-      boost::replace_all(regexStr, "*", ".*");
-      boost::regex regex(regexStr);
-      add = boost::regex_match((*iter)->GetName(), regex);
-    }
+  this->Load(_world, models);
+}
 
-    if (add)
-    {
-      this->modelStates[(*iter)->GetName()].Load(*iter, this->realTime,
-          this->simTime, this->iterations);
-    }
+/////////////////////////////////////////////////
+void WorldState::Load(const WorldPtr _world, const Model_V &_models)
+{
+  this->world = _world;
+  this->name = _world->Name();
+  this->wallTime = common::Time::GetWallTime();
+  this->simTime = _world->SimTime();
+  this->realTime = _world->RealTime();
+  this->iterations = _world->Iterations();
+  this->insertions.clear();
+  this->deletions.clear();
+
+  // Add a state for all the models
+  for (auto const &model : _models)
+  {
+    this->modelStates[model->GetName()].Load(model, this->realTime,
+        this->simTime, this->iterations);
   }
 
   // Remove models that no longer exist. We determine this by check the time
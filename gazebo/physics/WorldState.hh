@@ -78,6 +78,16 @@ namespace gazebo
       public: void LoadWithFilter(const WorldPtr _world,
           const std::string &_filter);
 
+      /// \brief Load from a World pointer, only adding states for some of
+      /// its models.
+      ///
+      /// Generate a WorldState from an instance of a World, for example
+      /// with the models that pass a log filter. The cost is proportional to
+      /// the number of models given.
+      /// \param[in] _world Pointer to a world
+      /// \param[in] _models Models of the world to add states for.
+      public: void Load(const WorldPtr _world, const Model_V &_models);
+
       /// \brief Load state from SDF element.
       ///
       /// Set a WorldState from an SDF element containing WorldState info.
@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -216,6 +218,88 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldTest, ModelUpdateStrategy)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Serial is the default
+  EXPECT_EQ("serial", world->ModelUpdateStrategy());
+
+  // Unknown strategies are rejected
+  EXPECT_FALSE(world->SetModelUpdateStrategy("unknown"));
+  EXPECT_EQ("serial", world->ModelUpdateStrategy());
+
+  EXPECT_TRUE(world->SetModelUpdateStrategy("parallel"));
+  EXPECT_EQ("parallel", world->ModelUpdateStrategy());
+
+  // The world keeps stepping and simulation time advances
+  common::Time simTime = world->SimTime();
+  world->Step(100);
+  EXPECT_GT(world->SimTime(), simTime);
+
+  // Models spawned afterwards are updated too
+  SpawnBox("new_box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 5, 2), ignition::math::Vector3d::Zero);
+  auto model = world->ModelByName("new_box");
+  ASSERT_NE(nullptr, model);
+  world->Step(1000);
+  EXPECT_NEAR(model->WorldPose().Pos().Z(), 0.5, 0.01);
+
+  EXPECT_TRUE(world->SetModelUpdateStrategy("serial"));
+  EXPECT_EQ("serial", world->ModelUpdateStrategy());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, ModelUpdateGroupsNested)
+{
+  this->Load("worlds/nested_model.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  EXPECT_TRUE(world->SetModelUpdateStrategy("parallel"));
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 5, 2), ignition::math::Vector3d::Zero);
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  auto model = world->ModelByName("model_00");
+  ASSERT_NE(nullptr, model);
+  auto nestedModel = model->NestedModel("model_01");
+  ASSERT_NE(nullptr, nestedModel);
+  auto nestedLink = nestedModel->GetLink("link_01");
+  ASSERT_NE(nullptr, nestedLink);
+
+  // Index of the group updating a root entity
+  auto groupOf = [&world](const physics::BasePtr &_entity)
+  {
+    auto groups = world->_ModelUpdateGroups();
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+      if (std::find(groups[i].begin(), groups[i].end(), _entity) !=
+          groups[i].end())
+      {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  };
+
+  EXPECT_NE(-1, groupOf(box));
+  EXPECT_NE(-1, groupOf(model));
+  EXPECT_NE(groupOf(box), groupOf(model));
+
+  // A joint to a link of a nested model joins the top level models
+  auto joint = box->CreateJoint("nested_joint", "revolute", nestedLink,
+      box->GetLink("body"));
+  ASSERT_NE(nullptr, joint);
+  EXPECT_EQ(groupOf(box), groupOf(model));
+
+  EXPECT_TRUE(box->RemoveJoint("nested_joint"));
+  EXPECT_NE(groupOf(box), groupOf(model));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -28,6 +28,20 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Bullet height field whose heights can be moved.
+class BulletMovableHeightfieldShape : public btHeightfieldTerrainShape
+{
+  /// \brief Constructors of btHeightfieldTerrainShape.
+  public: using btHeightfieldTerrainShape::btHeightfieldTerrainShape;
+
+  /// \brief Point the height field to other heights, of the same size.
+  /// \param[in] _heights The heights.
+  public: void SetHeights(const float *_heights)
+          {
+            this->m_heightfieldDataUnknown = _heights;
+          }
+};
+
 //////////////////////////////////////////////////
 BulletHeightmapShape::BulletHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
@@ -53,16 +67,24 @@ void BulletHeightmapShape::Init()
   int upIndex = 2;
   btVector3 localScaling(this->scale.X(), this->scale.Y(), 1.0);
 
-  this->heightFieldShape  = new btHeightfieldTerrainShape(
+  auto shape = new BulletMovableHeightfieldShape(
       this->vertSize,     // # of heights along width
       this->vertSize,     // # of height along height
-      &this->heights[0],  // The heights
+      this->HeightData(),  // The heights
       1,                  // Height scaling
       minHeight,          // Min height
       maxHeight,          // Max height
       upIndex,            // Up axis
       PHY_FLOAT,
       false);             // Flip quad edges
+  this->heightFieldShape = shape;
+
+  // Bullet doesn't copy the heights. Point it to the heights copied by
+  // SetHeight, so that height changes reach the collision.
+  this->SetHeightsCopiedCallback([shape](const HeightType *_heights)
+      {
+        shape->SetHeights(_heights);
+      });
 
   this->heightFieldShape->setLocalScaling(localScaling);
 
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <string>
+#include <thread>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Rand.hh>
@@ -213,20 +214,21 @@ void UpdateContacts(btDynamicsWorld *_world, btScalar _timeStep)
         localTorque2 = body2Pose.Rot().RotateVectorReverse(
             BulletTypes::ConvertVector3Ign(torqueB));
 
-        contactFeedback->positions[j] = BulletTypes::ConvertVector3Ign(ptB);
-        contactFeedback->normals[j] = BulletTypes::ConvertVector3Ign(normalOnB);
-        contactFeedback->depths[j] = -pt.getDistance();
+        int c = contactFeedback->count;
+        contactFeedback->Resize(c + 1);
+        contactFeedback->positions[c] = BulletTypes::ConvertVector3Ign(ptB);
+        contactFeedback->normals[c] = BulletTypes::ConvertVector3Ign(normalOnB);
+        contactFeedback->depths[c] = -pt.getDistance();
         if (!link1->IsStatic())
         {
-          contactFeedback->wrench[j].body1Force = localForce1;
-          contactFeedback->wrench[j].body1Torque = localTorque1;
+          contactFeedback->wrench[c].body1Force = localForce1;
+          contactFeedback->wrench[c].body1Torque = localTorque1;
         }
         if (!link2->IsStatic())
         {
-          contactFeedback->wrench[j].body2Force = localForce2;
-          contactFeedback->wrench[j].body2Torque = localTorque2;
+          contactFeedback->wrench[c].body2Force = localForce2;
+          contactFeedback->wrench[c].body2Torque = localTorque2;
         }
-        contactFeedback->count++;
       }
     }
   }
@@ -261,42 +263,99 @@ bool ContactProcessed(btManifoldPoint &/*_cp*/, void * /*_body0*/,
 //////////////////////////////////////////////////
 BulletPhysics::BulletPhysics(WorldPtr _world)
     : PhysicsEngine(_world)
+{
+  this->CreateDynamicsWorld(1);
+
+  // Set random seed for physics engine based on gazebo's random seed.
+  // Note: this was moved from physics::PhysicsEngine constructor.
+  this->SetSeed(ignition::math::Rand::Seed());
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::CreateDynamicsWorld(const unsigned int _threads)
 {
   // This function currently follows the pattern of bullet/Demos/HelloWorld
 
-  // Default setup for memory and collisions
-  this->collisionConfig = new btDefaultCollisionConfiguration();
-
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
-
-  // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
-  // to detect pairs of objects that may be in contact.
-  // The narrow-phase collision detection evaluates each pair generated by the
-  // broadphase.
-  // "btDbvtBroadphase uses a fast dynamic bounding volume hierarchy based on
-  // AABB tree" according to Bullet_User_Manual.pdf
-  // "btAxis3Sweep and bt32BitAxisSweep3 implement incremental 3d sweep and
-  // prune" also according to the user manual.
-  // btCudaBroadphase can be used if GPU hardware is available
-  // Here we are using btDbvtBroadphase.
-  this->broadPhase = new btDbvtBroadphase();
-
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
-
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
-
-  btOverlapFilterCallback *filterCallback = new CollisionFilter();
+  this->threads = 1;
+
+#ifdef LIBBULLET_MULTITHREADING
+  // The task scheduler is global in bullet, so all dynamics worlds share it
+  static btITaskScheduler *taskScheduler = btCreateDefaultTaskScheduler();
+  if (_threads > 1 && taskScheduler)
+  {
+    taskScheduler->setNumThreads(std::min(static_cast<int>(_threads),
+          taskScheduler->getMaxNumThreads()));
+    btSetTaskScheduler(taskScheduler);
+    this->threads = taskScheduler->getNumThreads();
+
+    // Collision algorithms and manifolds are allocated from pools, which
+    // are only thread safe as long as they don't have to grow.
+    btDefaultCollisionConstructionInfo info;
+    info.m_defaultMaxPersistentManifoldPoolSize = 80000;
+    info.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+    this->collisionConfig = new btDefaultCollisionConfiguration(info);
+
+    // Narrowphase collision detection of the overlapping pairs is split in
+    // batches of 40 pairs
+    this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig, 40);
+
+    this->broadPhase = new btDbvtBroadphase();
+
+    // Simulation islands are solved in parallel by a pool of solvers, and
+    // large islands are solved by the parallel solver.
+    btConstraintSolverPoolMt *solverPool =
+      new btConstraintSolverPoolMt(this->threads);
+    this->solver = solverPool;
+    this->solverMt = new btSequentialImpulseConstraintSolverMt();
+
+    // Contacts are still reported by the internal tick callback, which
+    // runs on the stepping thread once the constraints are solved.
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, solverPool, this->solverMt, this->collisionConfig);
+  }
+  else
+#endif
+  {
+    if (_threads > 1)
+    {
+      gzwarn << "Bullet was built without multithreading support, stepping "
+             << "the world on one thread.\n";
+    }
+
+    // Default setup for memory and collisions
+    this->collisionConfig = new btDefaultCollisionConfiguration();
+
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+
+    // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
+    // to detect pairs of objects that may be in contact.
+    // The narrow-phase collision detection evaluates each pair generated by
+    // the broadphase.
+    // "btDbvtBroadphase uses a fast dynamic bounding volume hierarchy based
+    // on AABB tree" according to Bullet_User_Manual.pdf
+    // "btAxis3Sweep and bt32BitAxisSweep3 implement incremental 3d sweep and
+    // prune" also according to the user manual.
+    // btCudaBroadphase can be used if GPU hardware is available
+    // Here we are using btDbvtBroadphase.
+    this->broadPhase = new btDbvtBroadphase();
+
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
+
+  this->filterCallback = new CollisionFilter();
   btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
   GZ_ASSERT(pairCache != nullptr,
       "Bullet broadphase overlapping pair cache is null");
-  pairCache->setOverlapFilterCallback(filterCallback);
+  pairCache->setOverlapFilterCallback(this->filterCallback);
 
   // TODO: Enable this to do custom contact setting
   gContactAddedCallback = ContactCallback;
@@ -305,11 +364,33 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   this->dynamicsWorld->setInternalTickCallback(
       InternalTickCallback, static_cast<void *>(this));
 
-  // Set random seed for physics engine based on gazebo's random seed.
-  // Note: this was moved from physics::PhysicsEngine constructor.
-  this->SetSeed(ignition::math::Rand::Seed());
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::DestroyDynamicsWorld()
+{
+  // Delete in reverse-order of creation
+  delete this->dynamicsWorld;
+  this->dynamicsWorld = nullptr;
+
+  delete this->filterCallback;
+  this->filterCallback = nullptr;
+
+  delete this->solverMt;
+  this->solverMt = nullptr;
+
+  delete this->solver;
+  this->solver = nullptr;
+
+  delete this->broadPhase;
+  this->broadPhase = nullptr;
 
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  delete this->dispatcher;
+  this->dispatcher = nullptr;
+
+  delete this->collisionConfig;
+  this->collisionConfig = nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -325,6 +406,24 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  // Number of threads to step the world with, 0 for one per core. This is
+  // not part of the SDFormat spec.
+  const std::string kThreads = "gz:threads";
+  if (bulletElem->HasElement(kThreads))
+  {
+    int value = bulletElem->Get<int>(kThreads);
+    unsigned int count = value > 0 ? static_cast<unsigned int>(value) :
+      std::max(1u, std::thread::hardware_concurrency());
+
+    // No bodies were added to the world yet
+    if (count != this->threads)
+    {
+      this->DestroyDynamicsWorld();
+      this->CreateDynamicsWorld(count);
+    }
+    gzlog << "Bullet stepping with " << this->threads << " threads\n";
+  }
+
   auto g = this->world->Gravity();
   // ODEPhysics checks this, so we will too.
   if (g == ignition::math::Vector3d::Zero)
@@ -533,26 +632,7 @@ void BulletPhysics::UpdatePhysics()
 //////////////////////////////////////////////////
 void BulletPhysics::Fini()
 {
-  // Delete in reverse-order of creation
-  if (this->dynamicsWorld)
-    delete this->dynamicsWorld;
-  this->dynamicsWorld = nullptr;
-
-  if (this->solver)
-    delete this->solver;
-  this->solver = nullptr;
-
-  if (this->broadPhase)
-    delete this->broadPhase;
-  this->broadPhase = nullptr;
-
-  if (this->dispatcher)
-    delete this->dispatcher;
-  this->dispatcher = nullptr;
-
-  if (this->collisionConfig)
-    delete this->collisionConfig;
-  this->collisionConfig = nullptr;
+  this->DestroyDynamicsWorld();
 
   PhysicsEngine::Fini();
 }
@@ -721,6 +801,8 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+    _value = static_cast<int>(this->threads);
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -172,12 +172,35 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Create the collision configuration, dispatcher,
+      /// broadphase, solver and dynamics world.
+      /// \param[in] _threads Number of threads to step the world with. The
+      /// multithreaded dynamics world is used if greater than 1.
+      private: void CreateDynamicsWorld(const unsigned int _threads);
+
+      /// \brief Delete the objects created by CreateDynamicsWorld.
+      private: void DestroyDynamicsWorld();
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
-      private: btSequentialImpulseConstraintSolver *solver;
+
+      /// \brief Constraint solver, or pool of constraint solvers of the
+      /// multithreaded dynamics world.
+      private: btConstraintSolver *solver;
+
+      /// \brief Parallel constraint solver of the multithreaded dynamics
+      /// world, null if not used.
+      private: btConstraintSolver *solverMt = nullptr;
+
+      /// \brief Filters pairs of objects that may collide.
+      private: btOverlapFilterCallback *filterCallback = nullptr;
+
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Number of threads the dynamics world steps with.
+      private: unsigned int threads = 1;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
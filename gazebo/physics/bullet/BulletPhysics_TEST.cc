@@ -108,6 +108,10 @@ TEST_F(BulletPhysics_TEST, PhysicsParam)
   EXPECT_DOUBLE_EQ(splitImpulsePenetrationThreshold,
     splitImpulsePenetrationThresholdRet);
 
+  // Worlds are stepped on a single thread by default
+  value = bulletPhysics->GetParam("threads");
+  EXPECT_EQ(1, boost::any_cast<int>(value));
+
   // Set params to different values and verify the old values are correctly
   // replaced by the new ones.
   iters = 55;
@@ -15,6 +15,8 @@
  *
 */
 
+#include <vector>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/dart/DARTCollision.hh"
@@ -63,8 +65,10 @@ void DARTHeightmapShape::Init()
   HeightmapShape::Init();
 
   GZ_ASSERT(this->dataPtr->Shape(), "Shape is NULL");
+  // DART keeps its own copy of the heights
   this->dataPtr->Shape()->setHeightField(this->vertSize, this->vertSize,
-                                         this->heights);
+      std::vector<HeightmapShape::HeightType>(this->HeightData(),
+      this->HeightData() + this->vertSize * this->vertSize));
   this->dataPtr->Shape()->setScale(Vector3(this->scale.X(),
                                            this->scale.Y(), 1));
 }
@@ -258,11 +258,16 @@ void DARTLink::Init()
   // We don't add dart body node to the skeleton here because dart body node
   // should be set its parent joint before being added. This body node will be
   // added to the skeleton in DARTModel::Init().
+
+  this->dataPtr->dartPhysics->SetLinksDirty();
 }
 
 //////////////////////////////////////////////////
 void DARTLink::Fini()
 {
+  if (this->dataPtr->dartPhysics)
+    this->dataPtr->dartPhysics->SetLinksDirty();
+
   Link::Fini();
 }
 
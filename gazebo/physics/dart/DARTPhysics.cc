@@ -18,6 +18,10 @@
 // required for HAVE_DART_BULLET define
 #include <gazebo/gazebo_config.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #ifdef HAVE_DART_BULLET
 #include <dart/collision/bullet/bullet.hpp>
 #endif
@@ -116,6 +120,11 @@ void DARTPhysics::Init()
 //////////////////////////////////////////////////
 void DARTPhysics::Fini()
 {
+  // Links keep a pointer to the physics engine
+  this->dataPtr->links.clear();
+  this->dataPtr->bodyNodeLinks.clear();
+  this->dataPtr->linksDirty = true;
+
   PhysicsEngine::Fini();
 }
 
@@ -132,154 +141,57 @@ void DARTPhysics::InitForThread()
 
 
 //////////////////////////////////////////////////
-// Helper class to maintain unique pairs of links in maps
-class LinkPair
+void DARTPhysics::SetLinksDirty()
 {
-  /// \brief Constructor.
-  /// \param _link1[in] and _link2[in] are the DART links for the contact.
-  ///   Their order may be swapped around.
-  public: LinkPair(const DARTLinkPtr &_link1,
-                   const DARTLinkPtr &_link2)
-          {
-            this->SetDARTLinks(_link1, _link2);
-          }
-
-  /// \brief Copy constructor
-  public: LinkPair(const LinkPair&_linkPair):
-            dtLink1(_linkPair.dtLink1),
-            dtLink2(_linkPair.dtLink2)
-          {}
-
-  /// \brief Destructor.
-  public: virtual ~LinkPair() {}
-
-  /// \brief Comparison operator
-  /// which always chooses the link which evaluates to lower by operator <
-  /// \param[in] _dtLink1 the first link
-  /// \param[in] _dtLink2 the second link
-  public: void SetDARTLinks(const DARTLinkPtr &_dtLink1,
-                            const DARTLinkPtr &_dtLink2)
-          {
-            if (cmpLink(_dtLink1, _dtLink2) < 0)
-            {
-              this->dtLink1 = _dtLink1;
-              this->dtLink2 = _dtLink2;
-            }
-            else
-            {
-              this->dtLink2 = _dtLink1;
-              this->dtLink1 = _dtLink2;
-            }
-          }
-
-  /// \brief Assignment operator
-  /// \param[in] _c Link pair to copy
-  /// \return *this
-  public: LinkPair &operator =(const LinkPair& _linkPair)
-          {
-            this->dtLink1 = _linkPair.dtLink1;
-            this->dtLink2 = _linkPair.dtLink2;
-            return *this;
-          }
-
-  /// \brief Comparison operator
-  /// \param[in] c the link pair
-  /// \return true if this is lower than \e c
-  public: bool operator<(const LinkPair& c) const
-          {
-            int cmp1 = cmpLink(this->dtLink1, c.dtLink1);
-            if (cmp1 < 0) return true;
-            int cmp2 = cmpLink(this->dtLink2, c.dtLink2);
-            return (cmp1 == 0) && (cmp2 < 0);
-          }
-
-  // \brief returns the first link
-  public: DARTLinkPtr DARTLink1() const { return this->dtLink1; }
-
-  // \brief returns the second link
-  public: DARTLinkPtr DARTLink2() const { return this->dtLink2; }
-
-  // \brief internally used comparison operator for links
-  // \param[in] l1 the first link
-  // \param[in] l2 the second link
-  // \retval -1 l1 < l2
-  // \retval 0 l1 == l2
-  // \retval 1 l1 > l2
-  private: int cmpLink(const DARTLinkPtr &l1, const DARTLinkPtr &l2) const
-           {
-            // Comparing by address is required because names can be
-            // the same for different links. Could use the model name of the
-            // link in addition, but that's even more expensive.
-             return l1.get() < l2.get() ? -1 : l1.get() == l2.get() ? 0 : 1;
-           }
-
-  /// \brief Pointer to the first link object
-  private: DARTLinkPtr dtLink1;
-
-  /// \brief Pointer to the second link object
-  private: DARTLinkPtr dtLink2;
-};
+  this->dataPtr->linksDirty = true;
+}
 
 //////////////////////////////////////////////////
-static DARTLinkPtr StaticFindDARTLink(
-    DARTPhysics *_dtPhysics,
-    const dart::dynamics::BodyNode *_dtBodyNode)
+void DARTPhysics::UpdateLinks()
 {
-  DARTLinkPtr res;
+  if (!this->dataPtr->linksDirty.exchange(false))
+    return;
 
-  const Model_V& models = _dtPhysics->World()->Models();
+  this->dataPtr->links.clear();
+  this->dataPtr->bodyNodeLinks.clear();
 
-  for (Model_V::const_iterator itModel = models.begin();
-       itModel != models.end(); ++itModel)
+  for (const auto &model : this->world->Models())
   {
-    const Link_V& links = (*itModel)->GetLinks();
-
-    for (Link_V::const_iterator itLink = links.begin();
-         itLink != links.end(); ++itLink)
+    for (const auto &link : model->GetLinks())
     {
-      DARTLinkPtr dartLink = boost::dynamic_pointer_cast<DARTLink>(*itLink);
+      DARTLinkPtr dartLink = boost::dynamic_pointer_cast<DARTLink>(link);
+      if (!dartLink)
+        continue;
 
-      if (dartLink->DARTBodyNode() == _dtBodyNode)
-      {
-        res = dartLink;
-        break;
-      }
+      this->dataPtr->links.push_back(dartLink);
+      if (dartLink->DARTBodyNode())
+        this->dataPtr->bodyNodeLinks[dartLink->DARTBodyNode()] = dartLink;
     }
   }
-
-  return res;
 }
 
 //////////////////////////////////////////////////
-static void RetrieveDARTCollisions(
-    DARTPhysics* _dtPhysics,
-    const dart::collision::CollisionResult *_dtLastResult,
-    ContactManager *_mgr)
+void DARTPhysics::RetrieveDARTCollisions(
+    const dart::collision::CollisionResult &_dtResult)
 {
-  _mgr->ResetCount();
-  int numContacts = _dtLastResult->getNumContacts();
+  ContactManager *mgr = this->GetContactManager();
+  mgr->ResetCount();
+
+  this->UpdateLinks();
 
   // DART returns all contact points individually, without grouping
   // them to link pairs first. The majority of the Gazebo code assumes
   // the contacts will come per link pair (e.g. all contacts of
   // link1 and link2 grouped together in one Contact object).
-  // We will have to do this mapping here first.
-  // This could be skipped for performance reasons by supplying
-  // an additional std::vector<std::pair<LinkPair, dart::collision::Contact>
-  // which is just filled with duplicates, skipping the map step.
-
-  typedef std::map<LinkPair, std::deque<const dart::collision::Contact*>>
-    PairedContactsMap;
-  // Attention: The map uses a reference to dart::collision::Contact&, but this
-  // is retrieved from dtLastResult directly and used only within this function,
-  // so it will be safe to use within the scope of this function.
-  PairedContactsMap pairedContacts;
-
-  // insert all the contacts
-  for (int i = 0; i < numContacts; ++i)
+  // The contact points are sorted by link pair to group them, in a vector
+  // which keeps its capacity between steps.
+  std::vector<DARTLinkContact> &linkContacts = this->dataPtr->linkContacts;
+  linkContacts.clear();
+
+  std::size_t numContacts = _dtResult.getNumContacts();
+  for (std::size_t i = 0; i < numContacts; ++i)
   {
-    const dart::collision::Contact &dtContact =
-        _dtLastResult->getContact(i);
+    const dart::collision::Contact &dtContact = _dtResult.getContact(i);
 
     dart::collision::CollisionObject *dtCollObj1 = dtContact.collisionObject1;
     dart::collision::CollisionObject *dtCollObj2 = dtContact.collisionObject2;
@@ -287,9 +199,6 @@ static void RetrieveDARTCollisions(
     GZ_ASSERT(dtCollObj1, "collision object 1 is null!");
     GZ_ASSERT(dtCollObj2, "collision object 2 is null!");
 
-    dart::dynamics::ConstBodyNodePtr dtBodyNode1;
-    dart::dynamics::ConstBodyNodePtr dtBodyNode2;
-
     const dart::dynamics::ShapeFrame *dtShapeFrame1 =
       dtCollObj1->getShapeFrame();
     const dart::dynamics::ShapeFrame *dtShapeFrame2 =
@@ -300,33 +209,54 @@ static void RetrieveDARTCollisions(
     GZ_ASSERT(dtShapeFrame1->asShapeNode(), "shape frame 1 is no shape node!");
     GZ_ASSERT(dtShapeFrame2->asShapeNode(), "shape frame 2 is no shape node!");
 
+    const dart::dynamics::BodyNode *dtBodyNode1 = nullptr;
+    const dart::dynamics::BodyNode *dtBodyNode2 = nullptr;
     if (dtShapeFrame1->isShapeNode())
-      dtBodyNode1 = dtShapeFrame1->asShapeNode()->getBodyNodePtr();
+      dtBodyNode1 = dtShapeFrame1->asShapeNode()->getBodyNodePtr().get();
     if (dtShapeFrame2->isShapeNode())
-      dtBodyNode2 = dtShapeFrame2->asShapeNode()->getBodyNodePtr();
+      dtBodyNode2 = dtShapeFrame2->asShapeNode()->getBodyNodePtr().get();
 
     GZ_ASSERT(dtBodyNode1, "body node 1 is null!");
     GZ_ASSERT(dtBodyNode2, "body node 2 is null!");
 
-    DARTLinkPtr dartLink1 = StaticFindDARTLink(_dtPhysics, dtBodyNode1);
-    DARTLinkPtr dartLink2 = StaticFindDARTLink(_dtPhysics, dtBodyNode2);
+    DARTLink *dartLink1 = this->FindDARTLink(dtBodyNode1).get();
+    DARTLink *dartLink2 = this->FindDARTLink(dtBodyNode2).get();
 
     GZ_ASSERT(dartLink1, "dartLink1 in collision pair is null");
     GZ_ASSERT(dartLink2, "dartLink2 in collision pair is null");
 
-    LinkPair dtLinkPair(dartLink1, dartLink2);
-    pairedContacts[dtLinkPair].push_back(&dtContact);
+    // Comparing by address is required because names can be the same for
+    // different links.
+    if (dartLink2 < dartLink1)
+      std::swap(dartLink1, dartLink2);
+
+    linkContacts.push_back({dartLink1, dartLink2, &dtContact});
   }
 
-  for (PairedContactsMap::iterator it = pairedContacts.begin();
-       it != pairedContacts.end(); ++it)
+  // Stable, so that the contact points of a pair keep DART's order
+  std::stable_sort(linkContacts.begin(), linkContacts.end(),
+      [](const DARTLinkContact &_a, const DARTLinkContact &_b)
+      {
+        return _a.link1 < _b.link1 ||
+          (_a.link1 == _b.link1 && _a.link2 < _b.link2);
+      });
+
+  auto pairBegin = linkContacts.begin();
+  while (pairBegin != linkContacts.end())
   {
-    DARTLinkPtr dartLink1 = it->first.DARTLink1();
-    DARTLinkPtr dartLink2 = it->first.DARTLink2();
-    const std::deque<const dart::collision::Contact*> &dtContacts = it->second;
+    auto pairEnd = pairBegin;
+    while (pairEnd != linkContacts.end() &&
+           pairEnd->link1 == pairBegin->link1 &&
+           pairEnd->link2 == pairBegin->link2)
+    {
+      ++pairEnd;
+    }
 
-    GZ_ASSERT(!dtContacts.empty(),
-           "dtContacts is empty, at least one contact should have been added");
+    DARTLink *dartLink1 = pairBegin->link1;
+    DARTLink *dartLink2 = pairBegin->link2;
+    const int pairCount = static_cast<int>(pairEnd - pairBegin);
+    auto contIt = pairBegin;
+    pairBegin = pairEnd;
 
     unsigned int colIndex = 0;
     CollisionPtr collisionPtr1 = dartLink1->GetCollision(colIndex);
@@ -334,15 +264,9 @@ static void RetrieveDARTCollisions(
 
     // Add a new contact to the manager. This will return nullptr if no one is
     // listening for contact information.
-    // It would be nice to do this in the first loop in order to save
-    // computation, but we can only add a new contact once per link pair,
-    // which is information we only have after the first loop.
-    // We could avoid all the computation however if the contact manager
-    // had a function returning in advance whether the ContactManger::NewContact
-    // will return NULL!
-    Contact *contactFeedback = _mgr->NewContact(
+    Contact *contactFeedback = mgr->NewContact(
                                  collisionPtr1.get(), collisionPtr2.get(),
-                                 _dtPhysics->World()->SimTime());
+                                 this->world->SimTime());
     if (!contactFeedback)
       continue;
 
@@ -351,15 +275,13 @@ static void RetrieveDARTCollisions(
     dart::dynamics::BodyNode *dtBodyNode1 = dartLink1->DARTBodyNode();
     dart::dynamics::BodyNode *dtBodyNode2 = dartLink2->DARTBodyNode();
 
-    contactFeedback->count = 0;
+    contactFeedback->Resize(std::min(pairCount, MAX_CONTACT_JOINTS));
 
-    std::deque<const dart::collision::Contact*>::const_iterator contIt;
-    int contNum = 0;
-    for (contIt = dtContacts.begin();
-         (contNum < MAX_CONTACT_JOINTS) && (contIt != dtContacts.end());
+    for (int contNum = 0;
+         (contNum < MAX_CONTACT_JOINTS) && (contNum < pairCount);
          ++contIt, ++contNum)
     {
-      const dart::collision::Contact *dtContact = *contIt;
+      const dart::collision::Contact *dtContact = contIt->contact;
 
       ignition::math::Vector3d localForce1;
       ignition::math::Vector3d localForce2;
@@ -405,8 +327,6 @@ static void RetrieveDARTCollisions(
         contactFeedback->wrench[contNum].body2Force = localForce2;
         contactFeedback->wrench[contNum].body2Torque = localTorque2;
       }
-
-      ++contactFeedback->count;
     }
   }
 }
@@ -431,7 +351,7 @@ void DARTPhysics::UpdateCollision()
     // so get the results and store them locally.
     this->dataPtr->dtWorld->checkCollision(opt, &localResult);
 
-    RetrieveDARTCollisions(this, &localResult, this->GetContactManager());
+    this->RetrieveDARTCollisions(localResult);
   }
   IGN_PROFILE_END();
 }
@@ -452,30 +372,12 @@ void DARTPhysics::UpdatePhysics()
         this->dataPtr->resetAllForcesAfterSimulationStep);
 
   // Update all the transformation of DART's links to gazebo's links
-  // TODO: How to visit all the links in the world?
-  unsigned int modelCount = this->world->ModelCount();
-  ModelPtr modelItr;
-
-  for (unsigned int i = 0; i < modelCount; ++i)
-  {
-    modelItr = this->world->ModelByIndex(i);
-    // TODO: need to improve speed
-    Link_V links = modelItr->GetLinks();
-    unsigned int linkCount = links.size();
-    DARTLinkPtr dartLinkItr;
-
-    for (unsigned int j = 0; j < linkCount; ++j)
-    {
-      dartLinkItr
-          = boost::dynamic_pointer_cast<DARTLink>(links.at(j));
-      dartLinkItr->updateDirtyPoseFromDARTTransformation();
-    }
-  }
+  this->UpdateLinks();
+  for (const auto &dartLink : this->dataPtr->links)
+    dartLink->updateDirtyPoseFromDARTTransformation();
 
-  RetrieveDARTCollisions(
-        this,
-        &(this->dataPtr->dtWorld->getLastCollisionResult()),
-        this->GetContactManager());
+  this->RetrieveDARTCollisions(
+        this->dataPtr->dtWorld->getLastCollisionResult());
   IGN_PROFILE_END();
 }
 
@@ -889,5 +791,8 @@ void DARTPhysics::OnPhysicsMsg(ConstPhysicsPtr& _msg)
 DARTLinkPtr DARTPhysics::FindDARTLink(
     const dart::dynamics::BodyNode *_dtBodyNode)
 {
-  return StaticFindDARTLink(this, _dtBodyNode);
+  auto iter = this->dataPtr->bodyNodeLinks.find(_dtBodyNode);
+  if (iter == this->dataPtr->bodyNodeLinks.end())
+    return DARTLinkPtr();
+  return iter->second;
 }
@@ -159,6 +159,10 @@ namespace gazebo
       /// detector has been loaded yet, the empty string is returned.
       public: std::string CollisionDetectorInUse() const;
 
+      /// \brief Gather the links of the world again before the next update.
+      /// Called by DART links when they are initialized or finalized.
+      public: void SetLinksDirty();
+
       // Documentation inherited
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
@@ -171,6 +175,16 @@ namespace gazebo
       private: DARTLinkPtr FindDARTLink(
           const dart::dynamics::BodyNode *_dtBodyNode);
 
+      /// \brief Gather the DART links of all the models, if they changed
+      /// since they were last gathered.
+      private: void UpdateLinks();
+
+      /// \brief Report the contact points of a DART collision result to the
+      /// contact manager, grouped by pairs of links.
+      /// \param[in] _dtResult The DART collision result.
+      private: void RetrieveDARTCollisions(
+          const dart::collision::CollisionResult &_dtResult);
+
       /// \internal
       /// \brief Pointer to private data.
       private: DARTPhysicsPrivate *dataPtr = nullptr;
@@ -18,12 +18,33 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
 #include "gazebo/physics/dart/dart_inc.h"
+#include "gazebo/physics/dart/DARTTypes.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \internal
+    /// \brief A DART contact point and the links of its body nodes. The
+    /// links are ordered by address, so that the contacts of a pair of links
+    /// are grouped together by sorting.
+    struct DARTLinkContact
+    {
+      /// \brief Link with the lower address.
+      DARTLink *link1;
+
+      /// \brief Link with the higher address.
+      DARTLink *link2;
+
+      /// \brief The contact point, owned by the DART collision result.
+      const dart::collision::Contact *contact;
+    };
+
     /// \internal
     /// \brief Private data class for DARTPhysics
     class DARTPhysicsPrivate
@@ -50,6 +71,23 @@ namespace gazebo
       /// and torques (both internal and external) after completing a simulation
       /// step. Default value is true.
       public: bool resetAllForcesAfterSimulationStep;
+
+      /// \brief Links of all the models, whose poses are updated after
+      /// every step.
+      public: std::vector<DARTLinkPtr> links;
+
+      /// \brief Links indexed by their DART body node, to find the links
+      /// of the contact points.
+      public: std::unordered_map<const dart::dynamics::BodyNode *,
+              DARTLinkPtr> bodyNodeLinks;
+
+      /// \brief True when links were initialized or finalized since links
+      /// and bodyNodeLinks were last gathered.
+      public: std::atomic<bool> linksDirty{true};
+
+      /// \brief Contact points of the last collision result, reused between
+      /// steps to avoid allocations.
+      public: std::vector<DARTLinkContact> linkContacts;
     };
   }
 }
@@ -24,6 +24,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -32,6 +33,21 @@
 using namespace gazebo;
 using namespace physics;
 
+//////////////////////////////////////////////////
+/// \brief Invalidate the geometry snapshots of a world. Snapshot geoms may
+/// share mesh and heightfield data with a collision that is going away.
+/// \param[in] _world World of the collision.
+static void InvalidateGeomSnapshots(const WorldPtr &_world)
+{
+  if (!_world)
+    return;
+
+  ODEPhysicsPtr physics =
+    boost::dynamic_pointer_cast<ODEPhysics>(_world->Physics());
+  if (physics)
+    physics->_InvalidateGeomSnapshots();
+}
+
 //////////////////////////////////////////////////
 ODECollision::ODECollision(LinkPtr _link)
 : Collision(_link)
@@ -49,6 +65,8 @@ ODECollision::ODECollision(LinkPtr _link)
 //////////////////////////////////////////////////
 ODECollision::~ODECollision()
 {
+  InvalidateGeomSnapshots(this->world);
+
   if (this->collisionId)
     dGeomDestroy(this->collisionId);
   this->collisionId = nullptr;
@@ -204,6 +222,9 @@ void ODECollision::Fini()
      this->spaceId = nullptr;
      */
 
+  // The shape, and the mesh data it owns, is released by Collision::Fini
+  InvalidateGeomSnapshots(this->world);
+
   Collision::Fini();
 }
 
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <memory>
+#include <vector>
+
+#include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODEGeomSnapshot.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief A geom of a snapshot and the live geom it was copied from.
+    class ODEGeomSnapshotEntry
+    {
+      /// \brief Live geom.
+      public: dGeomID source = nullptr;
+
+      /// \brief Copy of the live geom, nullptr if the geom class can't be
+      /// copied.
+      public: dGeomID geom = nullptr;
+
+      /// \brief Collision information, referenced by the geom data.
+      public: ODEGeomSnapshotInfo info;
+    };
+
+    /// \internal
+    /// \brief Private data for ODEGeomSnapshot
+    class ODEGeomSnapshotPrivate
+    {
+      /// \brief Space holding the copied geoms.
+      public: dSpaceID spaceId = nullptr;
+
+      /// \brief Geoms of the snapshot, in the order of the live geoms.
+      public: std::vector<std::unique_ptr<ODEGeomSnapshotEntry>> entries;
+
+      /// \brief Live geoms found during the last update. Kept to reuse its
+      /// memory.
+      public: std::vector<dGeomID> liveGeoms;
+
+      /// \brief Simulation time of the snapshot.
+      public: common::Time simTime;
+
+      /// \brief Version of the snapshot.
+      public: uint64_t version = 0;
+
+      /// \brief False when the geoms must not be queried, see
+      /// ODEGeomSnapshot::Valid.
+      public: mutable bool valid = false;
+
+      /// \brief Serializes queries on the snapshot space.
+      public: mutable std::mutex queryMutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect all the non-space geoms of a space and its sub-spaces.
+/// Rays are skipped, since they are never hit by other rays.
+/// \param[in] _spaceId Space to search.
+/// \param[out] _geoms Geoms found.
+static void CollectGeoms(dSpaceID _spaceId, std::vector<dGeomID> &_geoms)
+{
+  int count = dSpaceGetNumGeoms(_spaceId);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(_spaceId, i);
+    if (dGeomIsSpace(geom))
+      CollectGeoms(reinterpret_cast<dSpaceID>(geom), _geoms);
+    else if (dGeomGetClass(geom) != dRayClass)
+      _geoms.push_back(geom);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a copy of a geom.
+/// \param[in] _spaceId Space to add the copy to.
+/// \param[in] _geom Geom to copy.
+/// \return The copy, or nullptr if the geom class is not supported.
+static dGeomID CopyGeom(dSpaceID _spaceId, dGeomID _geom)
+{
+  switch (dGeomGetClass(_geom))
+  {
+    case dSphereClass:
+      return dCreateSphere(_spaceId, dGeomSphereGetRadius(_geom));
+    case dBoxClass:
+    {
+      dVector3 lengths;
+      dGeomBoxGetLengths(_geom, lengths);
+      return dCreateBox(_spaceId, lengths[0], lengths[1], lengths[2]);
+    }
+    case dCapsuleClass:
+    {
+      dReal radius, length;
+      dGeomCapsuleGetParams(_geom, &radius, &length);
+      return dCreateCapsule(_spaceId, radius, length);
+    }
+    case dCylinderClass:
+    {
+      dReal radius, length;
+      dGeomCylinderGetParams(_geom, &radius, &length);
+      return dCreateCylinder(_spaceId, radius, length);
+    }
+    case dPlaneClass:
+    {
+      dVector4 params;
+      dGeomPlaneGetParams(_geom, params);
+      return dCreatePlane(_spaceId, params[0], params[1], params[2],
+          params[3]);
+    }
+    // Triangle meshes and heightfields share their (read-only) data with
+    // the live geom.
+    case dTriMeshClass:
+      return dCreateTriMesh(_spaceId, dGeomTriMeshGetTriMeshDataID(_geom),
+          nullptr, nullptr, nullptr);
+    case dHeightfieldClass:
+      return dCreateHeightfield(_spaceId,
+          dGeomHeightfieldGetHeightfieldData(_geom), 1);
+    default:
+      return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy the size, pose and collide flags of a live geom.
+/// \param[in] _source Live geom.
+/// \param[in] _geom Copy created by CopyGeom.
+static void SyncGeom(dGeomID _source, dGeomID _geom)
+{
+  switch (dGeomGetClass(_source))
+  {
+    case dSphereClass:
+      dGeomSphereSetRadius(_geom, dGeomSphereGetRadius(_source));
+      break;
+    case dBoxClass:
+    {
+      dVector3 lengths;
+      dGeomBoxGetLengths(_source, lengths);
+      dGeomBoxSetLengths(_geom, lengths[0], lengths[1], lengths[2]);
+      break;
+    }
+    case dCapsuleClass:
+    {
+      dReal radius, length;
+      dGeomCapsuleGetParams(_source, &radius, &length);
+      dGeomCapsuleSetParams(_geom, radius, length);
+      break;
+    }
+    case dCylinderClass:
+    {
+      dReal radius, length;
+      dGeomCylinderGetParams(_source, &radius, &length);
+      dGeomCylinderSetParams(_geom, radius, length);
+      break;
+    }
+    case dPlaneClass:
+    {
+      dVector4 params;
+      dGeomPlaneGetParams(_source, params);
+      dGeomPlaneSetParams(_geom, params[0], params[1], params[2], params[3]);
+      break;
+    }
+    default:
+      break;
+  }
+
+  // Planes are not placeable
+  if (dGeomGetClass(_source) != dPlaneClass)
+  {
+    const dReal *pos = dGeomGetPosition(_source);
+    dGeomSetPosition(_geom, pos[0], pos[1], pos[2]);
+    dGeomSetRotation(_geom, dGeomGetRotation(_source));
+  }
+
+  dGeomSetCategoryBits(_geom, dGeomGetCategoryBits(_source));
+  dGeomSetCollideBits(_geom, dGeomGetCollideBits(_source));
+
+  if (dGeomIsEnabled(_source))
+    dGeomEnable(_geom);
+  else
+    dGeomDisable(_geom);
+}
+
+/////////////////////////////////////////////////
+ODEGeomSnapshot::ODEGeomSnapshot()
+  : dataPtr(new ODEGeomSnapshotPrivate)
+{
+  this->dataPtr->spaceId = dHashSpaceCreate(0);
+  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+}
+
+/////////////////////////////////////////////////
+ODEGeomSnapshot::~ODEGeomSnapshot()
+{
+  // The space destroys the geoms it contains.
+  dSpaceSetCleanup(this->dataPtr->spaceId, 1);
+  dSpaceDestroy(this->dataPtr->spaceId);
+}
+
+/////////////////////////////////////////////////
+common::Time ODEGeomSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t ODEGeomSnapshot::Version() const
+{
+  return this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+dSpaceID ODEGeomSnapshot::SpaceId() const
+{
+  return this->dataPtr->spaceId;
+}
+
+/////////////////////////////////////////////////
+std::mutex &ODEGeomSnapshot::QueryMutex() const
+{
+  return this->dataPtr->queryMutex;
+}
+
+/////////////////////////////////////////////////
+bool ODEGeomSnapshot::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+void ODEGeomSnapshot::Invalidate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queryMutex);
+  this->dataPtr->valid = false;
+}
+
+/////////////////////////////////////////////////
+void ODEGeomSnapshot::Update(dSpaceID _spaceId, const common::Time &_simTime,
+    const uint64_t _version)
+{
+  auto &entries = this->dataPtr->entries;
+  auto &liveGeoms = this->dataPtr->liveGeoms;
+
+  liveGeoms.clear();
+  CollectGeoms(_spaceId, liveGeoms);
+
+  // Only recreate the geoms when the set of live geoms has changed. Most
+  // steps only need to copy poses. An invalid snapshot is always recreated,
+  // since a new geom may have the address of a destroyed one.
+  bool changed = !this->dataPtr->valid || liveGeoms.size() != entries.size();
+  for (size_t i = 0; !changed && i < liveGeoms.size(); ++i)
+    changed = liveGeoms[i] != entries[i]->source;
+
+  if (changed)
+  {
+    for (auto &entry : entries)
+    {
+      if (entry->geom)
+        dGeomDestroy(entry->geom);
+    }
+    entries.clear();
+
+    for (auto const &source : liveGeoms)
+    {
+      std::unique_ptr<ODEGeomSnapshotEntry> entry(new ODEGeomSnapshotEntry);
+      entry->source = source;
+
+      ODECollision *collision =
+        static_cast<ODECollision *>(dGeomGetData(source));
+      if (collision)
+        entry->geom = CopyGeom(this->dataPtr->spaceId, source);
+
+      if (entry->geom)
+      {
+        entry->info.name = collision->GetScopedName();
+        dGeomSetData(entry->geom, &entry->info);
+      }
+
+      entries.push_back(std::move(entry));
+    }
+  }
+
+  for (auto &entry : entries)
+  {
+    if (!entry->geom)
+      continue;
+
+    SyncGeom(entry->source, entry->geom);
+    entry->info.laserRetro = static_cast<ODECollision *>(
+        dGeomGetData(entry->source))->GetLaserRetro();
+  }
+
+  this->dataPtr->simTime = _simTime;
+  this->dataPtr->version = _version;
+  this->dataPtr->valid = true;
+}
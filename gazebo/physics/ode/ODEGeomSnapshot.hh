@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ODE_ODEGEOMSNAPSHOT_HH_
+#define GAZEBO_PHYSICS_ODE_ODEGEOMSNAPSHOT_HH_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/ode/ode_inc.h"
+#include "gazebo/physics/ode/ODETypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class ODEGeomSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics_ode
+    /// \{
+
+    /// \brief Information about the collision a snapshot geom was copied
+    /// from. The geoms of a snapshot point to one of these with dGeomGetData.
+    class GZ_PHYSICS_VISIBLE ODEGeomSnapshotInfo
+    {
+      /// \brief Scoped name of the collision.
+      public: std::string name;
+
+      /// \brief Laser retro value of the collision.
+      public: double laserRetro = 0;
+    };
+
+    /// \brief Copy of the collision geometry of an ODE world, taken at the
+    /// end of a physics step.
+    ///
+    /// ODEPhysics publishes a new snapshot after every step once one has
+    /// been requested with ODEPhysics::GeomSnapshot. A published snapshot is
+    /// never modified again, so ray queries can run against it without
+    /// locking the physics engine. ODE spaces can't be collided from two
+    /// threads at once, so readers of the same snapshot must hold
+    /// QueryMutex while colliding with SpaceId.
+    class GZ_PHYSICS_VISIBLE ODEGeomSnapshot
+    {
+      /// \brief Constructor.
+      public: ODEGeomSnapshot();
+
+      /// \brief Destructor.
+      public: virtual ~ODEGeomSnapshot();
+
+      /// \brief Get the simulation time of the step that produced this
+      /// snapshot.
+      /// \return Simulation time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the world iteration that produced this snapshot.
+      /// Snapshots with a larger version are more recent.
+      /// \return Snapshot version.
+      public: uint64_t Version() const;
+
+      /// \brief Get the space holding the copied geoms.
+      /// \return ODE space id.
+      public: dSpaceID SpaceId() const;
+
+      /// \brief Get the mutex that serializes queries on this snapshot.
+      /// \return Query mutex.
+      public: std::mutex &QueryMutex() const;
+
+      /// \brief Check whether the geoms of this snapshot can still be
+      /// queried. A snapshot becomes invalid when a live collision is
+      /// destroyed, because triangle meshes and heightfields share their data
+      /// with the live geoms. Check it while holding QueryMutex.
+      /// \return True if the snapshot can be queried.
+      public: bool Valid() const;
+
+      /// \internal
+      /// \brief Mark this snapshot as invalid. Waits for the current query
+      /// to finish. The next Update recreates every geom.
+      public: void Invalidate() const;
+
+      /// \internal
+      /// \brief Copy the geometry of a live ODE space into this snapshot.
+      /// Only ODEPhysics should call this, on a snapshot that no reader
+      /// holds, with the physics update mutex locked.
+      /// \param[in] _spaceId Top level space of the ODE world.
+      /// \param[in] _simTime Simulation time of the step.
+      /// \param[in] _version World iteration of the step.
+      public: void Update(dSpaceID _spaceId, const common::Time &_simTime,
+                  const uint64_t _version);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ODEGeomSnapshotPrivate> dataPtr;
+    };
+
+    /// \}
+  }
+}
+#endif
@@ -110,23 +110,31 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
-
-  // Step 4: Restrict the bounds of the AABB to improve efficiency
-  dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
-      this->GetMaxHeight());
+  auto buildHeightfield = [this](const HeightType *_heights)
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        _heights,
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+
+    // Step 4: Restrict the bounds of the AABB to improve efficiency
+    dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
+        this->GetMaxHeight());
+  };
+  buildHeightfield(this->HeightData());
+
+  // ODE doesn't copy the heights. Point it to the heights copied by
+  // SetHeight, so that height changes reach the collision.
+  this->SetHeightsCopiedCallback(buildHeightfield);
 
   oParent->SetCollision(dCreateHeightfield(0, this->odeData, 1), false);
   oParent->SetStatic(true);
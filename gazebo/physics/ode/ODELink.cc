@@ -38,6 +38,7 @@ ODELink::ODELink(EntityPtr _parent)
     : Link(_parent)
 {
   this->linkId = nullptr;
+  this->spaceId = nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -225,7 +226,7 @@ void ODELink::SetSelfCollide(bool _collide)
 {
   this->sdf->GetElement("self_collide")->Set(_collide);
   if (_collide)
-    this->spaceId = dSimpleSpaceCreate(this->odePhysics->GetSpaceId());
+    this->spaceId = dSimpleSpaceCreate(this->odePhysics->DynamicSpaceId());
 }
 
 //////////////////////////////////////////////////
@@ -782,3 +783,13 @@ void ODELink::SetLinkStatic(bool /*_static*/)
 {
   gzlog << "To be implemented\n";
 }
+
+//////////////////////////////////////////////////
+void ODELink::SetStatic(const bool &_static)
+{
+  Link::SetStatic(_static);
+
+  // Keep the space of the model with the models it has to collide with
+  if (this->odePhysics)
+    this->odePhysics->SetModelSpaceStatic(this->spaceId, _static);
+}
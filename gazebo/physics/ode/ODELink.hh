@@ -182,6 +182,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      // Documentation inherited
+      public: virtual void SetStatic(const bool &_static);
+
       /// \brief ODE link handle
       private: dBodyID linkId;
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
  */
+#include <mutex>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -21,6 +23,7 @@
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODEGeomSnapshot.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODERayShape.hh"
 #include "gazebo/physics/ode/ODEMultiRayShape.hh"
@@ -88,6 +91,27 @@ void ODEMultiRayShape::UpdateRays()
   if (ode == nullptr)
     gzthrow("Invalid physics engine. Must use ODE.");
 
+  // Rays attached to a collision are tested against the latest geometry
+  // snapshot, so that sensors don't wait for the physics update.
+  if (this->defaultUpdate)
+  {
+    ODEGeomSnapshotPtr snapshot = ode->GeomSnapshot();
+    if (snapshot)
+    {
+      std::lock_guard<std::mutex> lock(snapshot->QueryMutex());
+      if (snapshot->Valid())
+      {
+        dSpaceCollide2((dGeomID) (this->superSpaceId),
+            (dGeomID) (snapshot->SpaceId()),
+            this, &SnapshotCallback);
+        this->snapshotSimTime = snapshot->SimTime();
+        return;
+      }
+    }
+  }
+
+  this->snapshotSimTime = common::Time::Zero;
+
   // Do we need to lock the physics engine here? YES!
   // especially when spawning models with sensors
   {
@@ -205,6 +229,67 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
   }
 }
 
+//////////////////////////////////////////////////
+void ODEMultiRayShape::SnapshotCallback(void *_data, dGeomID _o1,
+    dGeomID _o2)
+{
+  ODEMultiRayShape *self = static_cast<ODEMultiRayShape*>(_data);
+
+  // The snapshot space is flat, so the only space to recurse into is the
+  // ray space.
+  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
+  {
+    dSpaceCollide2(_o1, _o2, self, &SnapshotCallback);
+    return;
+  }
+
+  dGeomID rayId = nullptr;
+  dGeomID hitId = nullptr;
+  if (dGeomGetClass(_o1) == dRayClass)
+  {
+    rayId = _o1;
+    hitId = _o2;
+  }
+  else if (dGeomGetClass(_o2) == dRayClass)
+  {
+    rayId = _o2;
+    hitId = _o1;
+  }
+  else
+    return;
+
+  // Ray geoms point to their live collision, snapshot geoms to the
+  // information about the collision they were copied from.
+  ODECollision *rayCollision = static_cast<ODECollision*>(dGeomGetData(rayId));
+  ODEGeomSnapshotInfo *hitInfo =
+    static_cast<ODEGeomSnapshotInfo*>(dGeomGetData(hitId));
+  if (!rayCollision || !hitInfo)
+    return;
+
+  dGeomRaySetParams(rayId, 0, 0);
+  dGeomRaySetClosestHit(rayId, 1);
+
+  dContactGeom contact;
+  if (dCollide(_o1, _o2, 1, &contact, sizeof(contact)) > 0)
+  {
+    RayShape *shape =
+      boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get();
+
+    if (shape && contact.depth < shape->GetLength())
+    {
+      shape->SetLength(contact.depth);
+      shape->SetRetro(hitInfo->laserRetro);
+      shape->SetCollisionName(hitInfo->name);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+common::Time ODEMultiRayShape::SnapshotSimTime() const
+{
+  return this->snapshotSimTime;
+}
+
 //////////////////////////////////////////////////
 void ODEMultiRayShape::AddRay(const ignition::math::Vector3d &_start,
     const ignition::math::Vector3d &_end)
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/util/system.hh"
 
@@ -44,6 +45,14 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void UpdateRays();
 
+      /// \brief Get the simulation time of the geometry used by the last
+      /// call to UpdateRays. Rays of a shape attached to a collision are
+      /// tested against ODEPhysics::GeomSnapshot when one is available, which
+      /// can be a step behind the world.
+      /// \return Simulation time of the geometry snapshot, or zero if the
+      /// last update locked the physics engine instead.
+      public: common::Time SnapshotSimTime() const;
+
       /// \brief Ray-intersection callback.
       /// \param[in] _data Pointer to user data.
       /// \param[in] _o1 First geom to check for collisions.
@@ -51,6 +60,13 @@ namespace gazebo
       private: static void UpdateCallback(void *_data, dGeomID _o1,
                                           dGeomID _o2);
 
+      /// \brief Ray-intersection callback used with a geometry snapshot.
+      /// \param[in] _data Pointer to user data.
+      /// \param[in] _o1 First geom to check for collisions.
+      /// \param[in] _o2 Second geom to check for collisions.
+      private: static void SnapshotCallback(void *_data, dGeomID _o1,
+                                            dGeomID _o2);
+
       /// \brief Add a ray to the collision.
       /// \param[in] _start Start of a ray.
       /// \param[in] _end End of a ray.
@@ -66,6 +82,9 @@ namespace gazebo
       /// \brief Helper to get the correct ray shape in the UpdateCallback
       /// function.
       private: bool defaultUpdate = true;
+
+      /// \brief Simulation time of the snapshot used by the last update.
+      private: common::Time snapshotSimTime;
     };
     /// \}
   }
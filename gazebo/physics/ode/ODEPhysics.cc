@@ -17,15 +17,21 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
@@ -52,6 +58,7 @@
 #include "gazebo/physics/ContactManager.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODEGeomSnapshot.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
@@ -103,33 +110,6 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
-{
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
-
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
-    }
-  }
-
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
-
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
 {
@@ -151,11 +131,15 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->spaceId = dHashSpaceCreate(0);
   dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  this->dataPtr->dynamicSpaceId = this->dataPtr->spaceId;
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
   this->dataPtr->colliders.resize(100);
 
+  for (int i = 0; i < MAX_CONTACT_JOINTS; ++i)
+    this->dataPtr->identityIndices[i] = i;
+
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
@@ -239,6 +223,22 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
     gzthrow(std::string("Invalid step type[") + this->dataPtr->stepType);
+
+  // Optional parallel narrow-phase, not part of the SDFormat spec.
+  const std::string kCollideThreads = "gz:collide_threads";
+  if (odeElem->HasElement(kCollideThreads))
+  {
+    int threads = odeElem->Get<int>(kCollideThreads);
+    if (threads < 0)
+    {
+      gzerr << "<" << kCollideThreads << "> must be non-negative, "
+            << "using the serial narrow-phase.\n";
+      threads = 0;
+    }
+    this->SetCollideThreads(threads);
+  }
+
+  this->LoadBroadphase(odeElem);
 }
 
 /////////////////////////////////////////////////
@@ -380,17 +380,33 @@ void ODEPhysics::UpdateCollision()
   // Reset the contact count
   this->contactManager->ResetCount();
 
+  if (this->dataPtr->broadphase == "hash_auto")
+    this->TuneHashLevels();
+
   // Do collision detection; this will add contacts to the contact group
-  dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
+  dSpaceCollide(this->dataPtr->dynamicSpaceId, this, CollisionCallback);
+  if (this->dataPtr->staticSpaceId)
+  {
+    dSpaceCollide2((dGeomID)this->dataPtr->dynamicSpaceId,
+        (dGeomID)this->dataPtr->staticSpaceId, this, CollisionCallback);
+  }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  if (this->dataPtr->collideArena)
+  {
+    this->ParallelCollide();
+  }
+  else
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
   IGN_PROFILE_END();
@@ -456,14 +472,68 @@ void ODEPhysics::UpdatePhysics()
              col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
       }
     }
+
+    if (this->dataPtr->geomSnapshotRequested)
+      this->PublishGeomSnapshot();
   }
 
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+ODEGeomSnapshotPtr ODEPhysics::GeomSnapshot() const
+{
+  this->dataPtr->geomSnapshotRequested = true;
+  return std::atomic_load(&this->dataPtr->geomSnapshot);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::_InvalidateGeomSnapshots()
+{
+  std::atomic_store(&this->dataPtr->geomSnapshot, ODEGeomSnapshotPtr());
+
+  // Wait for the queries running on old snapshots
+  for (auto const &snapshot : this->dataPtr->geomSnapshotPool)
+    snapshot->Invalidate();
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::PublishGeomSnapshot()
+{
+  IGN_PROFILE("ODEPhysics::PublishGeomSnapshot");
+
+  // Reuse a snapshot that is held only by the pool: it is neither
+  // published nor used by a reader.
+  std::shared_ptr<ODEGeomSnapshot> snapshot;
+  for (auto const &pooled : this->dataPtr->geomSnapshotPool)
+  {
+    if (pooled.use_count() == 1)
+    {
+      snapshot = pooled;
+      break;
+    }
+  }
+
+  if (!snapshot)
+  {
+    snapshot = std::make_shared<ODEGeomSnapshot>();
+    this->dataPtr->geomSnapshotPool.push_back(snapshot);
+  }
+
+  snapshot->Update(this->dataPtr->spaceId, this->world->SimTime(),
+      this->world->Iterations());
+
+  std::atomic_store(&this->dataPtr->geomSnapshot,
+      ODEGeomSnapshotPtr(snapshot));
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
+  // Snapshot geoms must be destroyed before ODE is closed.
+  std::atomic_store(&this->dataPtr->geomSnapshot, ODEGeomSnapshotPtr());
+  this->dataPtr->geomSnapshotPool.clear();
+
   dCloseODE();
 
   if (this->dataPtr->contactGroup)
@@ -478,6 +548,18 @@ void ODEPhysics::Fini()
   }
   this->dataPtr->jointFeedbacks.clear();
 
+  // The dynamic and static spaces are children of the world space when
+  // static models have their own space
+  if (this->dataPtr->staticSpaceId)
+  {
+    dSpaceSetCleanup(this->dataPtr->staticSpaceId, 0);
+    dSpaceDestroy(this->dataPtr->staticSpaceId);
+    dSpaceSetCleanup(this->dataPtr->dynamicSpaceId, 0);
+    dSpaceDestroy(this->dataPtr->dynamicSpaceId);
+  }
+  this->dataPtr->staticSpaceId = nullptr;
+  this->dataPtr->dynamicSpaceId = nullptr;
+
   if (this->dataPtr->spaceId)
   {
     dSpaceSetCleanup(this->dataPtr->spaceId, 0);
@@ -511,8 +593,13 @@ LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
   iter = this->dataPtr->spaces.find(_parent->GetName());
 
   if (iter == this->dataPtr->spaces.end())
+  {
+    dSpaceID parentSpace = this->dataPtr->dynamicSpaceId;
+    if (this->dataPtr->staticSpaceId && _parent->IsStatic())
+      parentSpace = this->dataPtr->staticSpaceId;
     this->dataPtr->spaces[_parent->GetName()] =
-      dSimpleSpaceCreate(this->dataPtr->spaceId);
+      dSimpleSpaceCreate(parentSpace);
+  }
 
   ODELinkPtr link(new ODELink(_parent));
 
@@ -917,6 +1004,34 @@ dSpaceID ODEPhysics::GetSpaceId() const
   return this->dataPtr->spaceId;
 }
 
+//////////////////////////////////////////////////
+dSpaceID ODEPhysics::DynamicSpaceId() const
+{
+  return this->dataPtr->dynamicSpaceId;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetModelSpaceStatic(dSpaceID _spaceId, const bool _static)
+{
+  if (!this->dataPtr->staticSpaceId || !_spaceId)
+    return;
+
+  dSpaceID target = _static ? this->dataPtr->staticSpaceId :
+    this->dataPtr->dynamicSpaceId;
+  dSpaceID current = dGeomGetSpace((dGeomID)_spaceId);
+
+  // Only move model spaces, which are in the static or the dynamic space
+  if (current == target || (current != this->dataPtr->staticSpaceId &&
+        current != this->dataPtr->dynamicSpaceId))
+  {
+    return;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  dSpaceRemove(current, (dGeomID)_spaceId);
+  dSpaceAdd(target, (dGeomID)_spaceId);
+}
+
 //////////////////////////////////////////////////
 std::string ODEPhysics::GetStepType() const
 {
@@ -1017,11 +1132,27 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->CollideGeoms(_collision1, _collision2,
+      _contactCollisions, this->dataPtr->indices);
+
+  // Return if no contacts.
+  if (numc == 0)
+    return;
+
+  this->CreateContactJoints(_collision1, _collision2, _contactCollisions,
+      this->dataPtr->indices, numc);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::CollideGeoms(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    int *_indices) const
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1033,7 +1164,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
@@ -1050,15 +1181,17 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must less than the size of _indices
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
   // max_contacts specified globally
-  if (this->GetMaxContacts() > 0 && this->GetMaxContacts() < MAX_CONTACT_JOINTS)
-    maxCollide = this->GetMaxContacts();
+  if (this->dataPtr->maxContacts > 0 &&
+      this->dataPtr->maxContacts < MAX_CONTACT_JOINTS)
+  {
+    maxCollide = this->dataPtr->maxContacts;
+  }
 
   // over-ride with minimum of max_contacts from both collisions
   if (_collision1->GetMaxContacts() < maxCollide)
@@ -1073,11 +1206,11 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
   // Return if no contacts.
   if (numc == 0)
-    return;
+    return 0;
 
   // Store the indices of the contacts.
   for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+    _indices[i] = i;
 
   // Choose only the best contacts if too many were generated.
   if (maxCollide > 0 && numc > maxCollide)
@@ -1088,7 +1221,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        _indices[maxCollide-1] = i;
       }
     }
 
@@ -1096,6 +1229,16 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CreateContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    const int *_indices, unsigned int _numc)
+{
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1205,11 +1348,11 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       ignition::math::Vector3d fdir1 = fd.Normalized();
       ignition::math::Vector3d contactNormalCopy, contactPositionCopy;
       // for each pair of contact point and normal
-      for (unsigned int c = 0; c < numc; ++c)
+      for (unsigned int c = 0; c < _numc; ++c)
       {
         // Copy the contact normal
         dReal *contactNormal =
-          _contactCollisions[this->dataPtr->indices[c]].normal;
+          _contactCollisions[_indices[c]].normal;
         contactNormalCopy.Set(
           contactNormal[0], contactNormal[1], contactNormal[2]);
 
@@ -1239,7 +1382,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
         // Construct displacement vector from wheel center to contact point
         dReal *contactPosition =
-          _contactCollisions[this->dataPtr->indices[c]].pos;
+          _contactCollisions[_indices[c]].pos;
         contactPositionCopy.Set(contactPosition[0] - wheelPosition[0],
                                 contactPosition[1] - wheelPosition[1],
                                 contactPosition[2] - wheelPosition[2]);
@@ -1271,12 +1414,12 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   contact.surface.slip3 = surf1->slipTorsion + surf2->slipTorsion;
   // The slip parameter acts like a damper at each contact point
   // so the total damping for each collision is multiplied by the
-  // number of contact points (numc).
-  // To eliminate this dependence on numc, the inverse damping
-  // is multipled by numc.
-  contact.surface.slip1 *= numc;
-  contact.surface.slip2 *= numc;
-  contact.surface.slip3 *= numc;
+  // number of contact points (_numc).
+  // To eliminate this dependence on _numc, the inverse damping
+  // is multipled by _numc.
+  contact.surface.slip1 *= _numc;
+  contact.surface.slip2 *= _numc;
+  contact.surface.slip3 *= _numc;
 
   // Combine torsional friction patch radius values
   contact.surface.patch_radius =
@@ -1378,12 +1521,17 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     this->dataPtr->jointFeedbackIndex++;
     jointFeedback->count = 0;
     jointFeedback->contact = contactFeedback;
+
+    // ODE keeps pointers to the feedbacks, so size them before creating
+    // any joint.
+    jointFeedback->feedbacks.resize(_numc);
+    contactFeedback->Resize(_numc);
   }
 
   // Create a joint for each contact
-  for (unsigned int j = 0; j < numc; ++j)
+  for (unsigned int j = 0; j < _numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contactCollisions[_indices[j]];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1395,25 +1543,24 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[_indices[j]].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[_indices[j]].pos[0],
+          _contactCollisions[_indices[j]].pos[1],
+          _contactCollisions[_indices[j]].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[_indices[j]].normal[0],
+          _contactCollisions[_indices[j]].normal[1],
+          _contactCollisions[_indices[j]].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
 
-      // Increase the counters
-      contactFeedback->count++;
+      // Increase the counter
       jointFeedback->count++;
     }
 
@@ -1452,6 +1599,230 @@ void ODEPhysics::AddCollider(ODECollision *_collision1,
   this->dataPtr->collidersCount++;
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::ParallelCollide()
+{
+  const unsigned int count = this->dataPtr->collidersCount;
+  if (this->dataPtr->colliderResults.size() < count)
+    this->dataPtr->colliderResults.resize(count);
+
+  // Generate the contacts of every collider. Each thread only writes into its
+  // own scratch space and into the results of the colliders it handles.
+  this->dataPtr->collideArena->execute([this, count]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 16),
+        [this](const tbb::blocked_range<size_t> &_r)
+    {
+      ODEContactScratch &scratch = this->dataPtr->contactScratch.local();
+      if (!scratch.odeDataAllocated)
+      {
+        dAllocateODEDataForThread(dAllocateMaskAll);
+        scratch.odeDataAllocated = true;
+      }
+
+      for (size_t i = _r.begin(); i != _r.end(); ++i)
+      {
+        ODECollision *collision1 = this->dataPtr->colliders[i].first;
+        ODECollision *collision2 = this->dataPtr->colliders[i].second;
+        ODEColliderResult &result = this->dataPtr->colliderResults[i];
+
+        // ODE heightfields keep temporary buffers inside the geom, so they
+        // can't be collided concurrently. Leave them for the world thread.
+        if (collision1->HasType(Base::HEIGHTMAP_SHAPE) ||
+            collision2->HasType(Base::HEIGHTMAP_SHAPE))
+        {
+          result.scratch = nullptr;
+          result.count = 0;
+          continue;
+        }
+
+        result.scratch = &scratch;
+        result.offset = scratch.contacts.size();
+        result.count = this->CollideGeoms(collision1, collision2,
+            scratch.contactCollisions, scratch.indices);
+
+        for (unsigned int c = 0; c < result.count; ++c)
+        {
+          scratch.contacts.push_back(
+              scratch.contactCollisions[scratch.indices[c]]);
+        }
+      }
+    });
+  });
+
+  // Create the contact joints in collider order, so that the contact group
+  // and the contact manager end up exactly as with the serial narrow-phase.
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ODECollision *collision1 = this->dataPtr->colliders[i].first;
+    ODECollision *collision2 = this->dataPtr->colliders[i].second;
+    const ODEColliderResult &result = this->dataPtr->colliderResults[i];
+
+    if (!result.scratch)
+    {
+      this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    }
+    else if (result.count > 0)
+    {
+      this->CreateContactJoints(collision1, collision2,
+          &result.scratch->contacts[result.offset],
+          this->dataPtr->identityIndices, result.count);
+    }
+  }
+
+  for (auto &scratch : this->dataPtr->contactScratch)
+    scratch.contacts.clear();
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::SetCollideThreads(unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  this->dataPtr->collideThreads = _threads;
+  if (_threads > 0)
+    this->dataPtr->collideArena.reset(new tbb::task_arena(_threads));
+  else
+    this->dataPtr->collideArena.reset();
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::LoadBroadphase(sdf::ElementPtr _odeElem)
+{
+  // Neither option is part of the SDFormat spec.
+  const std::string kBroadphase = "gz:broadphase";
+  const std::string kStaticSpace = "gz:static_space";
+
+  std::string broadphase = "hash";
+  if (_odeElem->HasElement(kBroadphase))
+    broadphase = _odeElem->Get<std::string>(kBroadphase);
+
+  bool staticSpace = false;
+  if (_odeElem->HasElement(kStaticSpace))
+    staticSpace = _odeElem->Get<bool>(kStaticSpace);
+
+  if (broadphase != "hash" && broadphase != "hash_auto" &&
+      broadphase != "sap" && broadphase != "quadtree")
+  {
+    gzerr << "Unknown <" << kBroadphase << "> [" << broadphase << "], "
+          << "using [hash]\n";
+    broadphase = "hash";
+  }
+
+  // The constructor already created the default space
+  if (broadphase == "hash" && !staticSpace)
+    return;
+
+  if (!this->dataPtr->spaces.empty() ||
+      dSpaceGetNumGeoms(this->dataPtr->spaceId) > 0)
+  {
+    gzerr << "Unable to change the ODE broadphase once links were created\n";
+    return;
+  }
+
+  dSpaceSetCleanup(this->dataPtr->spaceId, 0);
+  dSpaceDestroy(this->dataPtr->spaceId);
+
+  // With a static space, the world space is a simple space holding the
+  // dynamic and the static spaces, so that rays still see all the geoms.
+  // Only the dynamic space is collided with itself.
+  dSpaceID parentSpace = nullptr;
+  if (staticSpace)
+  {
+    this->dataPtr->spaceId = dSimpleSpaceCreate(0);
+    parentSpace = this->dataPtr->spaceId;
+  }
+
+  dSpaceID dynamicSpace = nullptr;
+  if (broadphase == "sap")
+  {
+    // Most models rest on the ground, so sort along x rather than z
+    dynamicSpace = dSweepAndPruneSpaceCreate(parentSpace, dSAP_AXES_XYZ);
+  }
+  else if (broadphase == "quadtree")
+  {
+    const std::string kCenter = "gz:quadtree_center";
+    const std::string kExtents = "gz:quadtree_extents";
+    const std::string kDepth = "gz:quadtree_depth";
+
+    ignition::math::Vector3d center = ignition::math::Vector3d::Zero;
+    ignition::math::Vector3d extents(1000, 1000, 100);
+    int depth = 6;
+    if (_odeElem->HasElement(kCenter))
+      center = _odeElem->Get<ignition::math::Vector3d>(kCenter);
+    if (_odeElem->HasElement(kExtents))
+      extents = _odeElem->Get<ignition::math::Vector3d>(kExtents);
+    if (_odeElem->HasElement(kDepth))
+      depth = std::max(1, _odeElem->Get<int>(kDepth));
+
+    dVector3 dCenter = {center.X(), center.Y(), center.Z(), 0};
+    dVector3 dExtents = {extents.X(), extents.Y(), extents.Z(), 0};
+    dynamicSpace = dQuadTreeSpaceCreate(parentSpace, dCenter, dExtents, depth);
+  }
+  else
+  {
+    dynamicSpace = dHashSpaceCreate(parentSpace);
+    dHashSpaceSetLevels(dynamicSpace, -2, 8);
+  }
+
+  this->dataPtr->dynamicSpaceId = dynamicSpace;
+  if (staticSpace)
+  {
+    // Static geoms never move, so their bounding boxes are computed once
+    // and static pairs are never tested.
+    this->dataPtr->staticSpaceId = dSimpleSpaceCreate(parentSpace);
+  }
+  else
+  {
+    this->dataPtr->spaceId = dynamicSpace;
+  }
+
+  this->dataPtr->broadphase = broadphase;
+  this->dataPtr->tunedGeomCount = -1;
+
+  gzlog << "ODE broadphase [" << broadphase << "]"
+        << (staticSpace ? " with a static space" : "") << std::endl;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::TuneHashLevels()
+{
+  dSpaceID space = this->dataPtr->dynamicSpaceId;
+  const int count = dSpaceGetNumGeoms(space);
+  if (count == this->dataPtr->tunedGeomCount)
+    return;
+  this->dataPtr->tunedGeomCount = count;
+
+  // Cells of level n are 2^n wide. Each geom goes to the level of its size,
+  // and geoms larger than the top level are tested against every geom, so
+  // cover the range of sizes of the geoms in the space. Infinite geoms such
+  // as planes are left out.
+  double minSize = std::numeric_limits<double>::max();
+  double maxSize = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    dReal aabb[6];
+    dGeomGetAABB(dSpaceGetGeom(space, i), aabb);
+    double size = std::max({aabb[1] - aabb[0], aabb[3] - aabb[2],
+        aabb[5] - aabb[4]});
+    if (size <= 0 || size >= dInfinity)
+      continue;
+    minSize = std::min(minSize, size);
+    maxSize = std::max(maxSize, size);
+  }
+
+  if (maxSize <= 0)
+    return;
+
+  const int kMinLevel = -10;
+  const int kMaxLevel = 24;
+  int minLevel = ignition::math::clamp(
+      static_cast<int>(std::floor(std::log2(minSize))), kMinLevel, kMaxLevel);
+  int maxLevel = ignition::math::clamp(
+      static_cast<int>(std::ceil(std::log2(maxSize))), minLevel, kMaxLevel);
+  dHashSpaceSetLevels(space, minLevel, maxLevel);
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::DebugPrint() const
 {
@@ -1648,6 +2019,16 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "collide_threads")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "collide_threads must be non-negative\n";
+        return false;
+      }
+      this->SetCollideThreads(value);
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet;
@@ -1773,6 +2154,12 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "collide_threads")
+    _value = static_cast<int>(this->dataPtr->collideThreads);
+  else if (_key == "broadphase")
+    _value = this->dataPtr->broadphase;
+  else if (_key == "static_space")
+    _value = this->dataPtr->staticSpaceId != nullptr;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -228,6 +228,18 @@ namespace gazebo
       /// \return The space id for the world.
       public: dSpaceID GetSpaceId() const;
 
+      /// \brief Return the space of the dynamic models. This is the world
+      /// space, unless static models are kept in their own space.
+      /// \return The space id for the dynamic models.
+      public: dSpaceID DynamicSpaceId() const;
+
+      /// \brief Move the space of a model to the static or the dynamic
+      /// space, when static models are kept in their own space. Called when
+      /// the model becomes static or dynamic.
+      /// \param[in] _spaceId Space of the model.
+      /// \param[in] _static True if the model is static.
+      public: void SetModelSpaceStatic(dSpaceID _spaceId, const bool _static);
+
       /// \brief Get the world id.
       /// \return The world id.
       public: dWorldID GetWorldId();
@@ -291,6 +303,19 @@ namespace gazebo
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
+      /// \brief Get the most recent copy of the collision geometry. Ray
+      /// queries on a snapshot don't need the physics update mutex, see
+      /// ODEGeomSnapshot. Snapshots are published at the end of every step
+      /// after the first call to this function, so it returns nullptr until
+      /// the next step completes.
+      /// \return Latest snapshot, or nullptr if none is available.
+      public: ODEGeomSnapshotPtr GeomSnapshot() const;
+
+      /// \internal
+      /// \brief Invalidate every geometry snapshot. Called when a live geom
+      /// is destroyed, with the physics update mutex locked.
+      public: void _InvalidateGeomSnapshots();
+
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
@@ -315,6 +340,58 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Generate the contacts between two collision objects and
+      /// select the ones that will become contact joints. This does not
+      /// modify the ODE world or the contact manager, so it may be called
+      /// concurrently for different colliders.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of MAX_COLLIDE_RETURNS
+      /// contacts.
+      /// \param[out] _indices Array of MAX_CONTACT_JOINTS indices into
+      /// _contactCollisions of the selected contacts.
+      /// \return Number of selected contacts.
+      private: unsigned int CollideGeoms(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions, int *_indices) const;
+
+      /// \brief Create contact joints and contact feedback for contacts
+      /// generated by CollideGeoms.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in,out] _contactCollisions Array of contacts.
+      /// \param[in] _indices Indices of the selected contacts.
+      /// \param[in] _numc Number of selected contacts.
+      private: void CreateContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions, const int *_indices,
+                   unsigned int _numc);
+
+      /// \brief Generate non-trimesh contacts using collideThreads threads.
+      /// Contacts are computed in parallel and then turned into contact
+      /// joints in collider order, which gives the same result as the
+      /// serial path.
+      private: void ParallelCollide();
+
+      /// \brief Set the number of threads used by the narrow-phase.
+      /// \param[in] _threads Number of threads, zero to disable the
+      /// parallel narrow-phase.
+      private: void SetCollideThreads(unsigned int _threads);
+
+      /// \brief Create the collision spaces selected by the custom
+      /// <gz:broadphase> and <gz:static_space> elements of <ode>. Must be
+      /// called before any link is created.
+      /// \param[in] _odeElem The <ode> element.
+      private: void LoadBroadphase(sdf::ElementPtr _odeElem);
+
+      /// \brief Set the levels of the hash_auto broadphase from the sizes of
+      /// the geoms in the dynamic space.
+      private: void TuneHashLevels();
+
+      /// \brief Copy the collision geometry into an unused snapshot and
+      /// publish it.
+      private: void PublishGeomSnapshot();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
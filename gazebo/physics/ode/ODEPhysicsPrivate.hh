@@ -18,7 +18,12 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <utility>
@@ -41,8 +46,42 @@ namespace gazebo
       /// \brief Number of elements in feedbacks array.
       public: int count;
 
-      /// \brief Contact joint feedback information.
-      public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
+      /// \brief Contact joint feedback information, sized to the number of
+      /// contact joints.
+      public: std::vector<dJointFeedback> feedbacks;
+    };
+
+    /// \brief Per-thread scratch space used by the parallel narrow-phase.
+    class ODEContactScratch
+    {
+      /// \brief Raw contacts returned by dCollide.
+      public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
+
+      /// \brief Indices of the contacts selected from contactCollisions.
+      public: int indices[MAX_CONTACT_JOINTS];
+
+      /// \brief Selected contacts of every collider handled by this thread,
+      /// stored back to back. The capacity is reused between steps.
+      public: std::vector<dContactGeom> contacts;
+
+      /// \brief True once ODE thread local data has been allocated for the
+      /// thread that owns this scratch space.
+      public: bool odeDataAllocated = false;
+    };
+
+    /// \brief Location of the contacts generated for one collider by the
+    /// parallel narrow-phase.
+    class ODEColliderResult
+    {
+      /// \brief Scratch space holding the contacts, nullptr if the collider
+      /// must be processed on the world thread.
+      public: ODEContactScratch *scratch = nullptr;
+
+      /// \brief Offset of the first contact in scratch->contacts.
+      public: size_t offset = 0;
+
+      /// \brief Number of contacts.
+      public: unsigned int count = 0;
     };
 
     class ODEPhysicsPrivate
@@ -53,6 +92,22 @@ namespace gazebo
       /// \brief Top-level space for all sub-spaces/collisions
       public: dSpaceID spaceId;
 
+      /// \brief Space holding the dynamic models. This is spaceId, unless
+      /// static models are kept in their own space.
+      public: dSpaceID dynamicSpaceId = nullptr;
+
+      /// \brief Space holding the static models, nullptr if static models
+      /// share the dynamic space.
+      public: dSpaceID staticSpaceId = nullptr;
+
+      /// \brief Broadphase used by the dynamic space: hash, hash_auto, sap
+      /// or quadtree.
+      public: std::string broadphase = "hash";
+
+      /// \brief Number of geoms in the dynamic space when the levels of the
+      /// hash_auto broadphase were last tuned, -1 if never tuned.
+      public: int tunedGeomCount = -1;
+
       /// \brief Collision attributes
       public: dJointGroupID contactGroup;
 
@@ -92,6 +147,37 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Number of threads used to generate non-trimesh contacts.
+      /// Zero runs the narrow-phase serially on the world thread.
+      public: unsigned int collideThreads = 0;
+
+      /// \brief Task arena limiting the parallel narrow-phase to
+      /// collideThreads threads.
+      public: std::unique_ptr<tbb::task_arena> collideArena;
+
+      /// \brief Scratch space for each thread of the parallel narrow-phase.
+      public: tbb::enumerable_thread_specific<ODEContactScratch> contactScratch;
+
+      /// \brief Contacts generated for each normal collider by the parallel
+      /// narrow-phase, in the same order as colliders.
+      public: std::vector<ODEColliderResult> colliderResults;
+
+      /// \brief Identity mapping used when creating contact joints from
+      /// contacts that have already been selected.
+      public: int identityIndices[MAX_CONTACT_JOINTS];
+
+      /// \brief True once a geometry snapshot has been requested. Snapshots
+      /// are only published after that.
+      public: mutable std::atomic<bool> geomSnapshotRequested{false};
+
+      /// \brief Most recently published geometry snapshot. Only accessed
+      /// with std::atomic_load and std::atomic_store.
+      public: ODEGeomSnapshotPtr geomSnapshot;
+
+      /// \brief Every geometry snapshot allocated, published or not.
+      /// Snapshots that no reader holds are reused.
+      public: std::vector<std::shared_ptr<ODEGeomSnapshot>> geomSnapshotPool;
     };
   }
 }
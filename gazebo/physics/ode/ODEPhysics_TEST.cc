@@ -16,9 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODEGeomSnapshot.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -320,6 +325,36 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test collide_threads
+  {
+    // the parallel narrow-phase should be disabled by default
+    int collideThreads = 1;
+    EXPECT_NO_THROW(collideThreads =
+      boost::any_cast<int>(odePhysics->GetParam("collide_threads")));
+    EXPECT_EQ(collideThreads, 0);
+
+    // try enabling threads, then disabling
+    std::vector<int> threads = {1, 4, 0};
+    for (auto const collideThreadsSet : threads)
+    {
+      EXPECT_TRUE(odePhysics->SetParam("collide_threads", collideThreadsSet));
+      EXPECT_NO_THROW(collideThreads =
+        boost::any_cast<int>(odePhysics->GetParam("collide_threads")));
+      EXPECT_EQ(collideThreads, collideThreadsSet);
+    }
+
+    // negative values are rejected
+    EXPECT_FALSE(odePhysics->SetParam("collide_threads", -1));
+  }
+
+  // Test broadphase, which defaults to a hash space shared by all models
+  {
+    EXPECT_EQ("hash",
+        boost::any_cast<std::string>(odePhysics->GetParam("broadphase")));
+    EXPECT_FALSE(boost::any_cast<bool>(odePhysics->GetParam("static_space")));
+    EXPECT_EQ(odePhysics->GetSpaceId(), odePhysics->DynamicSpaceId());
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -374,6 +409,135 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
   }
 }
 
+/////////////////////////////////////////////////
+/// Test that models keep colliding with static models when they become
+/// static or dynamic, with static models in their own space
+TEST_F(ODEPhysics_TEST, StaticSpaceSetStatic)
+{
+  boost::filesystem::path path =
+    common::SystemPaths::Instance()->TmpInstancePath();
+  boost::filesystem::create_directories(path);
+  path /= "ode_static_space.world";
+  {
+    std::ofstream out(path.string());
+    out << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'><world name='default'>"
+      << "<physics type='ode'><ode>"
+      << "<gz:static_space>true</gz:static_space>"
+      << "</ode></physics>"
+      << "<include><uri>model://ground_plane</uri></include>"
+      << "<model name='box'><pose>0 0 2 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<box><size>1 1 1</size></box></geometry></collision></link>"
+      << "</model></world></sdf>";
+  }
+
+  Load(path.string(), true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+  EXPECT_TRUE(boost::any_cast<bool>(odePhysics->GetParam("static_space")));
+
+  ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  ODECollisionPtr collision = boost::dynamic_pointer_cast<ODECollision>(
+      model->GetLink("link")->GetCollision("collision"));
+  ASSERT_TRUE(collision != nullptr);
+  dSpaceID space = collision->GetSpaceId();
+  ASSERT_TRUE(space != nullptr);
+  EXPECT_EQ(odePhysics->DynamicSpaceId(), dGeomGetSpace((dGeomID)space));
+
+  // The space of the model follows its static flag
+  model->SetStatic(true);
+  EXPECT_NE(odePhysics->DynamicSpaceId(), dGeomGetSpace((dGeomID)space));
+  model->SetStatic(false);
+  EXPECT_EQ(odePhysics->DynamicSpaceId(), dGeomGetSpace((dGeomID)space));
+
+  // The box lands on the static ground plane
+  world->Step(2000);
+  EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+}
+
+/////////////////////////////////////////////////
+/// Test the geometry snapshots used by ray queries
+TEST_F(ODEPhysics_TEST, GeomSnapshot)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+    boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // Snapshots are only published once requested
+  EXPECT_TRUE(odePhysics->GeomSnapshot() == nullptr);
+  world->Step(1);
+
+  ODEGeomSnapshotPtr snapshot = odePhysics->GeomSnapshot();
+  ASSERT_TRUE(snapshot != nullptr);
+  EXPECT_EQ(snapshot->SimTime(), world->SimTime());
+  EXPECT_EQ(snapshot->Version(), world->Iterations());
+
+  // Cast a ray at the box, which is centered at (0, 0, 0.5)
+  dGeomID ray = dCreateRay(nullptr, 10);
+  dGeomRaySet(ray, -2, 0, 0.5, 1, 0, 0);
+  dGeomRaySetClosestHit(ray, 1);
+
+  auto castRay = [&ray](ODEGeomSnapshotPtr _snapshot, std::string &_name)
+  {
+    std::lock_guard<std::mutex> lock(_snapshot->QueryMutex());
+    double dist = 10;
+    dSpaceID spaceId = _snapshot->SpaceId();
+    for (int i = 0; i < dSpaceGetNumGeoms(spaceId); ++i)
+    {
+      dGeomID geom = dSpaceGetGeom(spaceId, i);
+      dContactGeom contact;
+      if (dCollide(ray, geom, 1, &contact, sizeof(contact)) > 0 &&
+          contact.depth < dist)
+      {
+        dist = contact.depth;
+        _name = static_cast<ODEGeomSnapshotInfo*>(dGeomGetData(geom))->name;
+      }
+    }
+    return dist;
+  };
+
+  std::string name;
+  EXPECT_NEAR(castRay(snapshot, name), 1.5, 1e-4);
+  EXPECT_EQ(name, "box::link::collision");
+
+  // A snapshot held by a reader is not modified by later steps
+  world->Step(1);
+  EXPECT_EQ(snapshot->Version(), world->Iterations() - 1);
+  ODEGeomSnapshotPtr next = odePhysics->GeomSnapshot();
+  ASSERT_TRUE(next != nullptr);
+  EXPECT_NE(next, snapshot);
+  EXPECT_EQ(next->Version(), world->Iterations());
+
+  // Removing a collision invalidates every snapshot
+  world->RemoveModel("box");
+  EXPECT_FALSE(snapshot->Valid());
+  EXPECT_FALSE(next->Valid());
+  EXPECT_TRUE(odePhysics->GeomSnapshot() == nullptr);
+  snapshot.reset();
+  next.reset();
+
+  world->Step(1);
+  snapshot = odePhysics->GeomSnapshot();
+  ASSERT_TRUE(snapshot != nullptr);
+  EXPECT_TRUE(snapshot->Valid());
+
+  name.clear();
+  EXPECT_NEAR(castRay(snapshot, name), 10, 1e-4);
+  EXPECT_TRUE(name.empty());
+
+  dGeomDestroy(ray);
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics_TEST::OnPhysicsMsgResponse(ConstResponsePtr &_msg)
 {
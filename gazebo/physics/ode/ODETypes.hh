@@ -15,6 +15,7 @@
  *
 */
 
+#include <memory>
 #include <boost/shared_ptr.hpp>
 #include "gazebo/util/system.hh"
 
@@ -25,6 +26,7 @@ namespace gazebo
   namespace physics
   {
     class ODECollision;
+    class ODEGeomSnapshot;
     class ODEJoint;
     class ODELink;
     class ODERayShape;
@@ -38,6 +40,10 @@ namespace gazebo
     /// \brief Boost shared point to ODECollision
     typedef boost::shared_ptr<ODECollision> ODECollisionPtr;
 
+    /// \def ODEGeomSnapshotPtr
+    /// \brief Shared pointer to a published, read-only ODEGeomSnapshot.
+    typedef std::shared_ptr<const ODEGeomSnapshot> ODEGeomSnapshotPtr;
+
     /// \def ODEJointPtr
     /// \brief Boost shared point to ODEJoint
     typedef boost::shared_ptr<ODEJoint> ODEJointPtr;
@@ -520,6 +520,7 @@ void SimbodyPhysics::UpdateCollision()
 
               // get detail
               const SimTK::ContactDetail &detail = patch.getContactDetail(i);
+              contactFeedback->Resize(count + 1);
               // get contact information from simbody and
               // add them to contactFeedback.
               // Store the contact depth
@@ -603,9 +604,8 @@ void SimbodyPhysics::UpdateCollision()
               contactFeedback->wrench[count].body2Torque.Set(
                 t2cg[0], t2cg[1], t2cg[2]);
 
-              // Increase the counters
+              // Increase the counter
               ++count;
-              contactFeedback->count = count;
             }
           }
         }
@@ -15,7 +15,10 @@
  *
 */
 
+#include <chrono>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -52,6 +55,7 @@
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/Distortion.hh"
+#include "gazebo/rendering/FrameWriter.hh"
 #include "gazebo/rendering/CameraPrivate.hh"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/RenderEvents.hh"
@@ -127,6 +131,8 @@ Camera::Camera(const std::string &_name, ScenePtr _scene,
 
   this->dataPtr->antiAliasingValue = 4;
 
+  this->dataPtr->frameWriter = FrameWriter::Shared();
+
   this->dataPtr->cameraIntrinsicMatrix = ignition::math::Matrix3d::Identity;
 }
 
@@ -385,6 +391,15 @@ void Camera::Init()
 //////////////////////////////////////////////////
 void Camera::Fini()
 {
+  // Frames given to the writer may use the video encoder, and the codecs
+  // of the render engine. The writer is shared, only wait for the frames
+  // of this camera.
+  if (this->dataPtr->frameWriter)
+  {
+    this->dataPtr->frameWriter->Flush(this);
+    this->FlushVideo();
+  }
+
   this->dataPtr->videoEncoder.Reset();
 
   if (this->saveFrameBuffer)
@@ -713,18 +728,18 @@ void Camera::PostRender()
 
     if (this->captureDataOnce)
     {
-      this->SaveFrame(this->FrameFilename());
+      this->QueueSaveFrame(this->FrameFilename());
       this->captureDataOnce = false;
     }
     else if (this->dataPtr->videoEncoder.IsEncoding())
     {
-      this->dataPtr->videoEncoder.AddFrame(buffer, width, height);
+      this->QueueVideoFrame();
     }
 
     if (this->sdf->HasElement("save") &&
         this->sdf->GetElement("save")->Get<bool>("enabled"))
     {
-      this->SaveFrame(this->FrameFilename());
+      this->QueueSaveFrame(this->FrameFilename());
     }
 
     // do last minute conversion if Bayer pattern is requested, go from R8G8B8
@@ -1243,6 +1258,91 @@ bool Camera::SaveFrame(const std::string &_filename)
                           this->ImageFormat(), _filename);
 }
 
+//////////////////////////////////////////////////
+void Camera::SetSaveFrameWriter(const FrameWriterPtr &_writer)
+{
+  // Keep the video frames in order
+  this->FlushVideo();
+  this->dataPtr->frameWriter = _writer;
+}
+
+//////////////////////////////////////////////////
+FrameWriterPtr Camera::SaveFrameWriter() const
+{
+  return this->dataPtr->frameWriter;
+}
+
+//////////////////////////////////////////////////
+void Camera::QueueSaveFrame(const std::string &_filename)
+{
+  FrameWriterPtr writer = this->dataPtr->frameWriter;
+  if (!writer || !this->saveFrameBuffer)
+  {
+    this->SaveFrame(_filename);
+    return;
+  }
+
+  unsigned int width = this->ImageWidth();
+  unsigned int height = this->ImageHeight();
+  int depth = this->ImageDepth();
+  std::string format = this->ImageFormat();
+
+  std::vector<unsigned char> frame = writer->Buffer(
+      Ogre::PixelUtil::getMemorySize(width, height, 1,
+        static_cast<Ogre::PixelFormat>(this->imageFormat)));
+  memcpy(frame.data(), this->saveFrameBuffer, frame.size());
+
+  // The frames of a camera are saved in order, in the lane of the camera.
+  writer->Push(std::move(frame),
+      [width, height, depth, format, _filename](
+        const std::vector<unsigned char> &_frame)
+      {
+        return Camera::SaveFrame(_frame.data(), width, height, depth, format,
+            _filename);
+      }, this);
+}
+
+//////////////////////////////////////////////////
+void Camera::QueueVideoFrame()
+{
+  unsigned int width = this->ImageWidth();
+  unsigned int height = this->ImageHeight();
+
+  // The encoder skips frames using the time they were rendered at, not the
+  // time they are encoded at.
+  auto timestamp = std::chrono::steady_clock::now();
+
+  FrameWriterPtr writer = this->dataPtr->frameWriter;
+  common::VideoEncoder *encoder = &this->dataPtr->videoEncoder;
+  if (!writer)
+  {
+    encoder->AddFrame(this->saveFrameBuffer, width, height, timestamp);
+    return;
+  }
+
+  std::vector<unsigned char> frame = writer->Buffer(
+      Ogre::PixelUtil::getMemorySize(width, height, 1,
+        static_cast<Ogre::PixelFormat>(this->imageFormat)));
+  memcpy(frame.data(), this->saveFrameBuffer, frame.size());
+
+  // Frames of the encoder are added one at a time, in order.
+  writer->Push(std::move(frame),
+      [encoder, width, height, timestamp](
+        const std::vector<unsigned char> &_frame)
+      {
+        // Frames skipped because of the frame rate aren't failures.
+        encoder->AddFrame(_frame.data(), width, height, timestamp);
+        return true;
+      }, encoder);
+}
+
+//////////////////////////////////////////////////
+void Camera::FlushVideo()
+{
+  if (this->dataPtr->frameWriter)
+    this->dataPtr->frameWriter->Flush(&this->dataPtr->videoEncoder);
+}
+
 //////////////////////////////////////////////////
 std::string Camera::FrameFilename()
 {
@@ -1507,6 +1607,7 @@ bool Camera::StartVideo(const std::string &_format,
 //////////////////////////////////////////////////
 bool Camera::StopVideo()
 {
+  this->FlushVideo();
   return this->dataPtr->videoEncoder.Stop();
 }
 
@@ -1515,12 +1616,14 @@ bool Camera::SaveVideo(const std::string &_filename)
 {
   // This will stop video encoding, save the video file, and reset
   // video encoding.
+  this->FlushVideo();
   return this->dataPtr->videoEncoder.SaveToFile(_filename);
 }
 
 //////////////////////////////////////////////////
 bool Camera::ResetVideo()
 {
+  this->FlushVideo();
   this->dataPtr->videoEncoder.Reset();
   return true;
 }
@@ -426,6 +426,19 @@ namespace gazebo
       /// \return True if saving was successful
       public: bool SaveFrame(const std::string &_filename);
 
+      /// \brief Set the writer used to save frames and encode video when
+      /// saving is enabled, when a screenshot is requested and when a video
+      /// is recorded. Frames are copied to the writer, which encodes them
+      /// off the rendering thread. All cameras share FrameWriter::Shared()
+      /// by default.
+      /// \param[in] _writer The writer, or null to save frames and encode
+      /// video in PostRender.
+      public: void SetSaveFrameWriter(const FrameWriterPtr &_writer);
+
+      /// \brief Get the writer used to save frames and encode video.
+      /// \return The writer, null if frames are saved in PostRender.
+      public: FrameWriterPtr SaveFrameWriter() const;
+
       /// \brief Get a pointer to the ogre camera
       /// \return Pointer to the OGRE camera
       public: Ogre::Camera *OgreCamera() const;
@@ -897,6 +910,17 @@ namespace gazebo
       /// \brief Create the ogre camera.
       private: void CreateCamera();
 
+      /// \brief Save the last frame with the frame writer.
+      /// \param[in] _filename File in which to save the frame.
+      private: void QueueSaveFrame(const std::string &_filename);
+
+      /// \brief Encode the last frame with the frame writer.
+      private: void QueueVideoFrame();
+
+      /// \brief Wait for the video frames given to the frame writer to be
+      /// encoded.
+      private: void FlushVideo();
+
       /// \brief Compute the intrinsic camera matrix, this matrix is different
       ///        than the one used by OpenGL internally and contains the camera
       ///        calibrated values
@@ -26,6 +26,7 @@
 #include "gazebo/common/PID.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
@@ -112,6 +113,10 @@ namespace gazebo
       /// \brief Video encoder.
       public: common::VideoEncoder videoEncoder;
 
+      /// \brief Writer saving frames and encoding video off the rendering
+      /// thread, null to do it in PostRender.
+      public: FrameWriterPtr frameWriter;
+
       /// \brief If set to true, the camera yaws around a fixed axis.
       public: bool yawFixed;
 
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/FrameWriter.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/rendering/Scene.hh"
@@ -85,6 +86,14 @@ TEST_F(Camera_TEST, Create)
     EXPECT_NEAR(near, camera->NearClip(), 1e-3);
     EXPECT_DOUBLE_EQ(far, camera->FarClip());
 
+    // frames are saved by the shared writer by default
+    EXPECT_EQ(camera->SaveFrameWriter(), rendering::FrameWriter::Shared());
+    rendering::FrameWriterPtr writer(new rendering::FrameWriter(2, 4));
+    camera->SetSaveFrameWriter(writer);
+    EXPECT_EQ(camera->SaveFrameWriter(), writer);
+    camera->SetSaveFrameWriter(nullptr);
+    EXPECT_TRUE(camera->SaveFrameWriter() == nullptr);
+
     scene->RemoveCamera(camera->Name());
   }
 
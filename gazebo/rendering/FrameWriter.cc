@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/FrameWriter.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief A frame waiting to be written.
+    class FrameWriterJob
+    {
+      /// \brief Order in which the frame was pushed.
+      public: uint64_t sequence = 0;
+
+      /// \brief The frame.
+      public: std::vector<unsigned char> frame;
+
+      /// \brief Function writing the frame.
+      public: FrameWriter::WriteFunc write;
+
+      /// \brief Lane of the frame, null if it has none.
+      public: const void *lane = nullptr;
+    };
+
+    /// \internal
+    /// \brief FrameWriter private data.
+    class FrameWriterPrivate
+    {
+      /// \brief Write frames until the writer is destroyed, called by each
+      /// worker thread.
+      public: void Work();
+
+      /// \brief Get the number of frames queued or being written. The
+      /// mutex must be locked.
+      /// \return Number of frames.
+      public: size_t Depth() const
+              {
+                return this->queue.size() + this->running.size();
+              }
+
+      /// \brief Keep the buffer of a frame for a later frame. The mutex
+      /// must be locked.
+      /// \param[in] _frame Buffer of the frame.
+      public: void Recycle(std::vector<unsigned char> &&_frame)
+              {
+                if (this->buffers.size() < this->capacity)
+                  this->buffers.push_back(std::move(_frame));
+              }
+
+      /// \brief Number of worker threads.
+      public: unsigned int threadCount = 1;
+
+      /// \brief Maximum number of frames queued or being written.
+      public: size_t capacity = 16;
+
+      /// \brief What Push does when the queue is full.
+      public: FrameWriter::Policy policy = FrameWriter::BLOCK;
+
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Signals frames to write to the worker threads.
+      public: std::condition_variable jobCondition;
+
+      /// \brief Signals written and dropped frames to the threads waiting
+      /// in Push and Flush.
+      public: std::condition_variable doneCondition;
+
+      /// \brief Frames waiting to be written, in push order.
+      public: std::deque<FrameWriterJob> queue;
+
+      /// \brief Sequence numbers and lanes of the frames being written.
+      public: std::vector<std::pair<uint64_t, const void *>> running;
+
+      /// \brief Buffers of written frames, reused by Buffer.
+      public: std::vector<std::vector<unsigned char>> buffers;
+
+      /// \brief Worker threads, started by the first push.
+      public: std::vector<std::thread> threads;
+
+      /// \brief Sequence number of the next frame pushed.
+      public: uint64_t nextSequence = 0;
+
+      /// \brief Set when the writer is destroyed.
+      public: bool stop = false;
+
+      /// \brief Counters.
+      public: FrameWriterStats stats;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+FrameWriter::FrameWriter(const unsigned int _threads, const size_t _capacity,
+    const Policy _policy)
+  : dataPtr(new FrameWriterPrivate)
+{
+  this->dataPtr->threadCount = _threads;
+  if (this->dataPtr->threadCount == 0)
+  {
+    this->dataPtr->threadCount =
+      std::max(1u, std::thread::hardware_concurrency());
+  }
+  this->dataPtr->capacity = std::max<size_t>(1, _capacity);
+  this->dataPtr->policy = _policy;
+}
+
+/////////////////////////////////////////////////
+FrameWriter::~FrameWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->jobCondition.notify_all();
+
+  for (auto &thread : this->dataPtr->threads)
+    thread.join();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<FrameWriter> FrameWriter::Shared()
+{
+  static std::mutex sharedMutex;
+  static std::weak_ptr<FrameWriter> shared;
+
+  std::lock_guard<std::mutex> lock(sharedMutex);
+  std::shared_ptr<FrameWriter> writer = shared.lock();
+  if (!writer)
+  {
+    // Leave most cores to rendering and physics.
+    unsigned int threads = std::max(1u,
+        std::min(4u, std::thread::hardware_concurrency() / 2));
+    writer.reset(new FrameWriter(threads));
+    shared = writer;
+  }
+  return writer;
+}
+
+/////////////////////////////////////////////////
+unsigned int FrameWriter::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void FrameWriter::SetCapacity(const size_t _capacity)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->capacity = std::max<size_t>(1, _capacity);
+  }
+  this->dataPtr->doneCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+size_t FrameWriter::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->capacity;
+}
+
+/////////////////////////////////////////////////
+void FrameWriter::SetPolicy(const Policy _policy)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->policy = _policy;
+}
+
+/////////////////////////////////////////////////
+FrameWriter::Policy FrameWriter::QueuePolicy() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->policy;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned char> FrameWriter::Buffer(const size_t _size)
+{
+  std::vector<unsigned char> buffer;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->buffers.empty())
+    {
+      buffer = std::move(this->dataPtr->buffers.back());
+      this->dataPtr->buffers.pop_back();
+    }
+  }
+  buffer.resize(_size);
+  return buffer;
+}
+
+/////////////////////////////////////////////////
+bool FrameWriter::Push(std::vector<unsigned char> &&_frame,
+    const WriteFunc &_write, const void *_lane)
+{
+  auto &d = *this->dataPtr;
+  std::unique_lock<std::mutex> lock(d.mutex);
+
+  if (d.threads.empty())
+  {
+    for (unsigned int i = 0; i < d.threadCount; ++i)
+      d.threads.push_back(std::thread(&FrameWriterPrivate::Work, &d));
+  }
+
+  ++d.stats.pushed;
+
+  if (d.Depth() >= d.capacity)
+  {
+    switch (d.policy)
+    {
+      case BLOCK:
+      {
+        auto start = std::chrono::steady_clock::now();
+        d.doneCondition.wait(lock, [&d] {return d.Depth() < d.capacity;});
+        d.stats.blockedTime += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        break;
+      }
+
+      case DROP_OLDEST:
+      {
+        // Frames being written can't be dropped.
+        if (!d.queue.empty())
+        {
+          d.Recycle(std::move(d.queue.front().frame));
+          d.queue.pop_front();
+          ++d.stats.dropped;
+          d.doneCondition.notify_all();
+          break;
+        }
+        ++d.stats.dropped;
+        d.Recycle(std::move(_frame));
+        return false;
+      }
+
+      case DROP_NEWEST:
+      default:
+      {
+        ++d.stats.dropped;
+        d.Recycle(std::move(_frame));
+        return false;
+      }
+    }
+  }
+
+  FrameWriterJob job;
+  job.sequence = d.nextSequence++;
+  job.frame = std::move(_frame);
+  job.write = _write;
+  job.lane = _lane;
+  d.queue.push_back(std::move(job));
+  d.stats.maxDepth = std::max(d.stats.maxDepth, d.Depth());
+
+  lock.unlock();
+  d.jobCondition.notify_one();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void FrameWriter::Flush(const void *_lane)
+{
+  auto &d = *this->dataPtr;
+  std::unique_lock<std::mutex> lock(d.mutex);
+
+  const uint64_t end = d.nextSequence;
+  d.doneCondition.wait(lock, [&d, end, _lane]
+      {
+        for (auto const &job : d.queue)
+        {
+          if (job.sequence < end && (!_lane || job.lane == _lane))
+            return false;
+        }
+        for (auto const &job : d.running)
+        {
+          if (job.first < end && (!_lane || job.second == _lane))
+            return false;
+        }
+        return true;
+      });
+}
+
+/////////////////////////////////////////////////
+FrameWriterStats FrameWriter::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  FrameWriterStats result = this->dataPtr->stats;
+  result.depth = this->dataPtr->Depth();
+  return result;
+}
+
+/////////////////////////////////////////////////
+void FrameWriterPrivate::Work()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    // Take the oldest frame whose lane isn't being written.
+    auto next = this->queue.end();
+    this->jobCondition.wait(lock, [this, &next]
+        {
+          for (next = this->queue.begin(); next != this->queue.end(); ++next)
+          {
+            const void *lane = next->lane;
+            if (!lane || std::none_of(this->running.begin(),
+                  this->running.end(),
+                  [lane](const std::pair<uint64_t, const void *> &_job)
+                  {return _job.second == lane;}))
+            {
+              return true;
+            }
+          }
+          return this->stop && this->queue.empty();
+        });
+
+    if (next == this->queue.end())
+      break;
+
+    FrameWriterJob job = std::move(*next);
+    this->queue.erase(next);
+    this->running.push_back(std::make_pair(job.sequence, job.lane));
+    lock.unlock();
+
+    bool written = false;
+    try
+    {
+      written = job.write(job.frame);
+    }
+    catch(const std::exception &_e)
+    {
+      gzerr << "Unable to write frame: " << _e.what() << std::endl;
+    }
+
+    lock.lock();
+    this->running.erase(std::find(this->running.begin(), this->running.end(),
+          std::make_pair(job.sequence, job.lane)));
+    if (written)
+      ++this->stats.written;
+    else
+      ++this->stats.failed;
+    this->Recycle(std::move(job.frame));
+
+    this->doneCondition.notify_all();
+
+    // The next frame of the lane can be written now.
+    if (job.lane)
+      this->jobCondition.notify_all();
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_FRAMEWRITER_HH_
+#define GAZEBO_RENDERING_FRAMEWRITER_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class
+    class FrameWriterPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \brief Counters of a FrameWriter.
+    class GZ_RENDERING_VISIBLE FrameWriterStats
+    {
+      /// \brief Number of frames pushed, including the dropped ones.
+      public: uint64_t pushed = 0;
+
+      /// \brief Number of frames written.
+      public: uint64_t written = 0;
+
+      /// \brief Number of frames whose write function failed.
+      public: uint64_t failed = 0;
+
+      /// \brief Number of frames dropped because the queue was full.
+      public: uint64_t dropped = 0;
+
+      /// \brief Number of frames queued or being written.
+      public: size_t depth = 0;
+
+      /// \brief Largest depth reached.
+      public: size_t maxDepth = 0;
+
+      /// \brief Time spent waiting for room in the queue by the threads
+      /// pushing frames, in seconds.
+      public: double blockedTime = 0;
+    };
+
+    /// \class FrameWriter FrameWriter.hh rendering/rendering.hh
+    /// \brief A bounded queue of frames written to disk by a pool of
+    /// threads, so that images are encoded off the rendering thread.
+    ///
+    /// Push takes ownership of a frame buffer along with the function
+    /// writing it. Buffers are recycled once written: get them from
+    /// Buffer to avoid an allocation per frame. Frames pushed with the
+    /// same lane are written one at a time, in order, which is needed to
+    /// feed a video encoder. Frames of different lanes, and frames without
+    /// a lane, are written in parallel.
+    ///
+    /// Worker threads are started by the first push. The destructor waits
+    /// for the queued frames to be written.
+    class GZ_RENDERING_VISIBLE FrameWriter
+    {
+      /// \brief What Push does when the queue is full.
+      public: enum Policy
+      {
+        /// \brief Wait for room in the queue.
+        BLOCK,
+
+        /// \brief Drop the pushed frame.
+        DROP_NEWEST,
+
+        /// \brief Drop the oldest queued frame that isn't being written.
+        DROP_OLDEST
+      };
+
+      /// \brief Function writing a frame.
+      /// \param[in] _frame The frame.
+      /// \return False if the frame couldn't be written.
+      public: using WriteFunc =
+                std::function<bool(const std::vector<unsigned char> &_frame)>;
+
+      /// \brief Constructor.
+      /// \param[in] _threads Number of threads writing frames. Zero uses
+      /// the number of hardware threads.
+      /// \param[in] _capacity Maximum number of frames queued or being
+      /// written.
+      /// \param[in] _policy What Push does when the queue is full.
+      public: explicit FrameWriter(const unsigned int _threads = 1,
+                  const size_t _capacity = 16,
+                  const Policy _policy = BLOCK);
+
+      /// \brief Destructor. Waits for the queued frames to be written.
+      public: virtual ~FrameWriter();
+
+      /// \brief Get the writer shared by the cameras. It is created when
+      /// needed, and destroyed with the last camera that uses it.
+      /// \return The shared writer.
+      public: static std::shared_ptr<FrameWriter> Shared();
+
+      /// \brief Get the number of threads writing frames.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Set the maximum number of frames queued or being written.
+      /// \param[in] _capacity Number of frames, at least 1.
+      public: void SetCapacity(const size_t _capacity);
+
+      /// \brief Get the maximum number of frames queued or being written.
+      /// \return Number of frames.
+      public: size_t Capacity() const;
+
+      /// \brief Set what Push does when the queue is full.
+      /// \param[in] _policy The policy.
+      public: void SetPolicy(const Policy _policy);
+
+      /// \brief Get what Push does when the queue is full.
+      /// \return The policy.
+      public: Policy QueuePolicy() const;
+
+      /// \brief Get a buffer for a frame, recycled from the frames already
+      /// written when possible.
+      /// \param[in] _size Size of the frame, in bytes.
+      /// \return The buffer.
+      public: std::vector<unsigned char> Buffer(const size_t _size);
+
+      /// \brief Queue a frame.
+      /// \param[in] _frame The frame, owned by the writer from now on.
+      /// \param[in] _write Function writing the frame, called by a worker
+      /// thread.
+      /// \param[in] _lane Frames with the same non null lane are written in
+      /// order, one at a time.
+      /// \return False if the frame was dropped.
+      public: bool Push(std::vector<unsigned char> &&_frame,
+                  const WriteFunc &_write, const void *_lane = nullptr);
+
+      /// \brief Wait for the frames pushed before the call to be written.
+      /// \param[in] _lane Only wait for the frames of this lane, null to
+      /// wait for all frames.
+      public: void Flush(const void *_lane = nullptr);
+
+      /// \brief Get the counters of the writer.
+      /// \return The counters.
+      public: FrameWriterStats Stats() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<FrameWriterPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gazebo/rendering/FrameWriter.hh"
+
+using namespace gazebo;
+
+/// \brief Keeps a frame writer busy until opened.
+class Gate
+{
+  /// \brief Get a write function that waits for the gate to open, and
+  /// records the first byte of the frames.
+  /// \return The function.
+  public: rendering::FrameWriter::WriteFunc Write()
+          {
+            return [this](const std::vector<unsigned char> &_frame)
+            {
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->entered)
+                {
+                  this->entered = true;
+                  this->enteredPromise.set_value();
+                }
+              }
+              this->open.wait();
+
+              std::lock_guard<std::mutex> lock(this->mutex);
+              this->frames.push_back(_frame[0]);
+              return true;
+            };
+          }
+
+  /// \brief Wait for the first frame to be written.
+  public: void WaitEntered()
+          {
+            this->enteredPromise.get_future().wait();
+          }
+
+  /// \brief Let the frames be written.
+  public: void Open()
+          {
+            this->openPromise.set_value();
+          }
+
+  /// \brief Protects entered and frames.
+  public: std::mutex mutex;
+
+  /// \brief True once a frame started to be written.
+  public: bool entered = false;
+
+  /// \brief Signals the first frame.
+  public: std::promise<void> enteredPromise;
+
+  /// \brief Opens the gate.
+  public: std::promise<void> openPromise;
+
+  /// \brief Future of openPromise.
+  public: std::shared_future<void> open = openPromise.get_future().share();
+
+  /// \brief First byte of the written frames, in write order.
+  public: std::vector<unsigned char> frames;
+};
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, Write)
+{
+  rendering::FrameWriter writer(4, 8);
+  EXPECT_EQ(writer.ThreadCount(), 4u);
+  EXPECT_EQ(writer.Capacity(), 8u);
+  EXPECT_EQ(writer.QueuePolicy(), rendering::FrameWriter::BLOCK);
+
+  std::mutex mutex;
+  std::vector<int> written;
+  auto write = [&](const std::vector<unsigned char> &_frame)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    written.push_back(_frame[0] + _frame[1] * 256);
+    return true;
+  };
+
+  for (int i = 0; i < 100; ++i)
+  {
+    std::vector<unsigned char> frame = writer.Buffer(2);
+    ASSERT_EQ(frame.size(), 2u);
+    frame[0] = i % 256;
+    frame[1] = i / 256;
+    EXPECT_TRUE(writer.Push(std::move(frame), write));
+  }
+  writer.Flush();
+
+  std::sort(written.begin(), written.end());
+  ASSERT_EQ(written.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(written[i], i);
+
+  auto stats = writer.Stats();
+  EXPECT_EQ(stats.pushed, 100u);
+  EXPECT_EQ(stats.written, 100u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.failed, 0u);
+  EXPECT_EQ(stats.depth, 0u);
+  EXPECT_GE(stats.maxDepth, 1u);
+  EXPECT_LE(stats.maxDepth, 8u);
+
+  // Failures
+  writer.Push(writer.Buffer(1),
+      [](const std::vector<unsigned char> &) {return false;});
+  writer.Push(writer.Buffer(1), [](const std::vector<unsigned char> &) -> bool
+      {throw std::runtime_error("test");});
+  writer.Flush();
+  EXPECT_EQ(writer.Stats().failed, 2u);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, Lanes)
+{
+  rendering::FrameWriter writer(4, 16);
+
+  // Frames of a lane are written in order, one at a time, while frames
+  // without a lane keep the other threads busy.
+  int lanes[2];
+  std::vector<unsigned char> order[2];
+  std::atomic<int> busy[2];
+  std::atomic<bool> overlap(false);
+  for (int lane = 0; lane < 2; ++lane)
+    busy[lane] = 0;
+
+  for (int i = 0; i < 50; ++i)
+  {
+    for (int lane = 0; lane < 2; ++lane)
+    {
+      std::vector<unsigned char> frame = writer.Buffer(1);
+      frame[0] = i;
+      writer.Push(std::move(frame),
+          [&, lane](const std::vector<unsigned char> &_frame)
+          {
+            if (busy[lane]++ != 0)
+              overlap = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            order[lane].push_back(_frame[0]);
+            --busy[lane];
+            return true;
+          }, &lanes[lane]);
+    }
+    writer.Push(writer.Buffer(1), [](const std::vector<unsigned char> &)
+        {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+          return true;
+        });
+  }
+
+  writer.Flush(&lanes[0]);
+  EXPECT_EQ(order[0].size(), 50u);
+  writer.Flush();
+  EXPECT_FALSE(overlap);
+  for (int lane = 0; lane < 2; ++lane)
+  {
+    ASSERT_EQ(order[lane].size(), 50u);
+    for (int i = 0; i < 50; ++i)
+      EXPECT_EQ(order[lane][i], i);
+  }
+  EXPECT_EQ(writer.Stats().written, 150u);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, DropNewest)
+{
+  rendering::FrameWriter writer(1, 2, rendering::FrameWriter::DROP_NEWEST);
+  Gate gate;
+
+  for (unsigned char i = 0; i < 5; ++i)
+  {
+    std::vector<unsigned char> frame(1, i);
+    EXPECT_EQ(writer.Push(std::move(frame), gate.Write()), i < 2);
+  }
+  EXPECT_EQ(writer.Stats().depth, 2u);
+  EXPECT_EQ(writer.Stats().dropped, 3u);
+
+  gate.Open();
+  writer.Flush();
+  EXPECT_EQ(gate.frames, std::vector<unsigned char>({0, 1}));
+  EXPECT_EQ(writer.Stats().pushed, 5u);
+  EXPECT_EQ(writer.Stats().written, 2u);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, DropOldest)
+{
+  rendering::FrameWriter writer(1, 2, rendering::FrameWriter::DROP_OLDEST);
+  Gate gate;
+
+  // The first frame is being written and can't be dropped.
+  writer.Push(std::vector<unsigned char>(1, 0), gate.Write());
+  gate.WaitEntered();
+
+  for (unsigned char i = 1; i < 5; ++i)
+    EXPECT_TRUE(writer.Push(std::vector<unsigned char>(1, i), gate.Write()));
+  EXPECT_EQ(writer.Stats().dropped, 3u);
+
+  gate.Open();
+  writer.Flush();
+  EXPECT_EQ(gate.frames, std::vector<unsigned char>({0, 4}));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, Block)
+{
+  rendering::FrameWriter writer(1, 1);
+  Gate gate;
+
+  writer.Push(std::vector<unsigned char>(1, 0), gate.Write());
+  gate.WaitEntered();
+
+  // The queue is full, the second frame waits for room.
+  std::atomic<bool> pushed(false);
+  std::thread producer([&]
+      {
+        writer.Push(std::vector<unsigned char>(1, 1), gate.Write());
+        pushed = true;
+      });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(pushed);
+
+  gate.Open();
+  producer.join();
+  EXPECT_TRUE(pushed);
+  writer.Flush();
+
+  auto stats = writer.Stats();
+  EXPECT_EQ(gate.frames, std::vector<unsigned char>({0, 1}));
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.maxDepth, 1u);
+  EXPECT_GT(stats.blockedTime, 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameWriter_TEST, Buffers)
+{
+  rendering::FrameWriter writer;
+
+  // Written frames are recycled.
+  std::vector<unsigned char> frame = writer.Buffer(1024);
+  const unsigned char *data = frame.data();
+  writer.Push(std::move(frame),
+      [](const std::vector<unsigned char> &) {return true;});
+  writer.Flush();
+
+  frame = writer.Buffer(512);
+  EXPECT_EQ(frame.data(), data);
+  EXPECT_EQ(frame.size(), 512u);
+
+  // The shared writer lives as long as it is used.
+  std::shared_ptr<rendering::FrameWriter> shared =
+    rendering::FrameWriter::Shared();
+  ASSERT_TRUE(shared != nullptr);
+  EXPECT_EQ(shared, rendering::FrameWriter::Shared());
+  EXPECT_GE(shared->ThreadCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,7 @@
 */
 
 #include <memory>
+#include <string>
 
 #include <string.h>
 #include <math.h>
@@ -31,6 +32,7 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Dem.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/HeightmapBuffer.hh"
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/transport/TransportIface.hh"
@@ -470,18 +472,19 @@ void Heightmap::Load()
       else
         scale.Z(fabs(this->dataPtr->terrainSize.Z()) / heightmapSizeZ);
 
-      // Construct the heightmap lookup table
-      std::vector<float> lookup;
-      this->dataPtr->heightmapData->FillHeightMap(this->dataPtr->sampling,
-          vertSize, this->dataPtr->terrainSize, scale, flipY, lookup);
+      // Construct the heightmap lookup table, shared with the physics
+      // heightmap shapes of the same process and cached on disk
+      common::HeightmapBufferPtr lookup = common::HeightmapBuffer::Load(
+          *this->dataPtr->heightmapData, this->dataPtr->filename,
+          this->dataPtr->sampling, vertSize, this->dataPtr->terrainSize,
+          scale, flipY);
 
-      for (unsigned int y = 0; y < vertSize; ++y)
+      this->dataPtr->heights.reserve(lookup->Count());
+      for (unsigned int y = 0; y < vertSize && lookup->Count() > 0; ++y)
       {
+        const float *row = lookup->Data() + (vertSize - y - 1) * vertSize;
         for (unsigned int x = 0; x < vertSize; ++x)
-        {
-          int index = (vertSize - y - 1) * vertSize + x;
-          this->dataPtr->heights.push_back(lookup[index] - minElevation);
-        }
+          this->dataPtr->heights.push_back(row[x] - minElevation);
       }
 
       this->dataPtr->dataSize = vertSize;
@@ -495,24 +498,42 @@ void Heightmap::Load()
           << "(is it in the GAZEBO_RESOURCE_PATH?)- requesting data from "
           << "the server" << std::endl;
 
-    msgs::Geometry geomMsg;
-
-    boost::shared_ptr<msgs::Response> response = transport::request(
-       this->dataPtr->scene->Name(), "heightmap_data");
-
-    if (response->response() != "error" &&
-        response->type() == geomMsg.GetTypeName())
+    // Request the heights in tiles of rows chosen by the server, so that
+    // no message holds the whole terrain
+    unsigned int row = 0;
+    while (true)
     {
+      msgs::Geometry geomMsg;
+      boost::shared_ptr<msgs::Response> response = transport::request(
+         this->dataPtr->scene->Name(), "heightmap_data",
+         std::to_string(row) + " 0");
+
+      if (response->response() == "error" ||
+          response->type() != geomMsg.GetTypeName())
+      {
+        this->dataPtr->heights.clear();
+        break;
+      }
       geomMsg.ParseFromString(response->serialized_data());
+      const msgs::HeightmapGeom &heightmapMsg = geomMsg.heightmap();
 
       // Copy the height data.
-      this->dataPtr->terrainSize = msgs::ConvertIgn(geomMsg.heightmap().size());
-      this->dataPtr->heights.resize(geomMsg.heightmap().heights().size());
-      memcpy(&this->dataPtr->heights[0], geomMsg.heightmap().heights().data(),
-          sizeof(this->dataPtr->heights[0]) *
-          geomMsg.heightmap().heights().size());
+      this->dataPtr->terrainSize = msgs::ConvertIgn(heightmapMsg.size());
+      this->dataPtr->dataSize = heightmapMsg.width();
+      const size_t offset = this->dataPtr->heights.size();
+      this->dataPtr->heights.resize(offset + heightmapMsg.heights().size());
+      if (heightmapMsg.heights().size() > 0)
+      {
+        memcpy(&this->dataPtr->heights[offset], heightmapMsg.heights().data(),
+            sizeof(this->dataPtr->heights[0]) * heightmapMsg.heights().size());
+      }
 
-      this->dataPtr->dataSize = geomMsg.heightmap().width();
+      // Servers that don't send tiles send all the heights at once
+      if (!heightmapMsg.has_tile_rows() || heightmapMsg.tile_rows() == 0)
+        break;
+      row += heightmapMsg.tile_rows();
+      if (row >= this->dataPtr->dataSize)
+        break;
     }
   }
 
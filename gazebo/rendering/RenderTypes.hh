@@ -72,6 +72,7 @@ namespace gazebo
     class Distortion;
     class LensFlare;
     class Road2d;
+    class FrameWriter;
 
 #ifdef HAVE_OCULUS
     class OculusCamera;
@@ -205,6 +206,10 @@ namespace gazebo
     /// \brief Shared pointer to Road2d
     typedef std::shared_ptr<Road2d> Road2dPtr;
 
+    /// \def FrameWriterPtr
+    /// \brief Shared pointer to FrameWriter
+    typedef std::shared_ptr<FrameWriter> FrameWriterPtr;
+
 #ifdef HAVE_OCULUS
     /// \def OculusCameraPtr
     /// \brief Shared pointer to OculusCamera
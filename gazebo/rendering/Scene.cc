@@ -178,6 +178,9 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   this->dataPtr->skeletonPoseSub =
       this->dataPtr->node->Subscribe("~/skeleton_pose/info",
       &Scene::OnSkeletonPoseMsg, this);
+  this->dataPtr->skeletonPosesSub =
+      this->dataPtr->node->Subscribe("~/skeleton_pose/info_v",
+      &Scene::OnSkeletonPosesMsg, this);
   this->dataPtr->skySub =
       this->dataPtr->node->Subscribe("~/sky", &Scene::OnSkyMsg, this);
   this->dataPtr->modelInfoSub = this->dataPtr->node->Subscribe("~/model/info",
@@ -263,6 +266,7 @@ void Scene::Clear()
   this->dataPtr->sensorSub.reset();
   this->dataPtr->sceneSub.reset();
   this->dataPtr->skeletonPoseSub.reset();
+  this->dataPtr->skeletonPosesSub.reset();
   this->dataPtr->visSub.reset();
   this->dataPtr->skySub.reset();
   this->dataPtr->lightFactorySub.reset();
@@ -3013,20 +3017,32 @@ void Scene::OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg)
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
   SkeletonPoseMsgs_L::iterator iter;
 
-  // Find an old model message, and remove them
+  // Replace an old model message in place, which keeps its list node
   for (iter = this->dataPtr->skeletonPoseMsgs.begin();
         iter != this->dataPtr->skeletonPoseMsgs.end(); ++iter)
   {
     if ((*iter)->model_name() == _msg->model_name())
     {
-      this->dataPtr->skeletonPoseMsgs.erase(iter);
-      break;
+      *iter = _msg;
+      return;
     }
   }
 
   this->dataPtr->skeletonPoseMsgs.push_back(_msg);
 }
 
+/////////////////////////////////////////////////
+void Scene::OnSkeletonPosesMsg(ConstPoseAnimation_VPtr &_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  // Each pose shares the ownership of _msg instead of being copied
+  for (auto const &poseAnim : _msg->pose_animation())
+  {
+    ConstPoseAnimationPtr pose(_msg, &poseAnim);
+    this->OnSkeletonPoseMsg(pose);
+  }
+}
+
 /////////////////////////////////////////////////
 void Scene::OnRoadMsg(ConstRoadPtr &_msg)
 {
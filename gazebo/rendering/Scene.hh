@@ -754,6 +754,11 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg);
 
+      /// \brief Callback for the skeleton animations of all the actors,
+      /// published once per world update.
+      /// \param[in] _msg The message data.
+      private: void OnSkeletonPosesMsg(ConstPoseAnimation_VPtr &_msg);
+
       /// \brief Road message callback.
       /// \param[in] _msg The message data.
       private: void OnRoadMsg(ConstRoadPtr &_msg);
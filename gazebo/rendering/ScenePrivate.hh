@@ -267,6 +267,9 @@ namespace gazebo
       /// \brief Subscribe to skeleton pose updates.
       public: transport::SubscriberPtr skeletonPoseSub;
 
+      /// \brief Subscribe to the skeleton pose updates of all the actors.
+      public: transport::SubscriberPtr skeletonPosesSub;
+
       /// \brief Subscribe to sky updates.
       public: transport::SubscriberPtr skySub;
 
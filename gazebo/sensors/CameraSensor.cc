@@ -345,18 +345,19 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
     auto simTime = this->scene->SimTime();
     if (this->imagePub && this->imagePub->HasConnections())
     {
-      msgs::ImageStamped msg;
-      msgs::Set(msg.mutable_time(), simTime);
-      msg.mutable_image()->set_width(this->camera->ImageWidth());
-      msg.mutable_image()->set_height(this->camera->ImageHeight());
-      msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
+      // Published without a copy, the message is shared with the subscribers
+      boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+      msgs::Set(msg->mutable_time(), simTime);
+      msg->mutable_image()->set_width(this->camera->ImageWidth());
+      msg->mutable_image()->set_height(this->camera->ImageHeight());
+      msg->mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
             this->camera->ImageFormat()));
 
-      msg.mutable_image()->set_step(this->camera->ImageWidth() *
+      msg->mutable_image()->set_step(this->camera->ImageWidth() *
           this->camera->ImageDepth());
-      msg.mutable_image()->set_data(this->camera->ImageData(),
-          msg.image().width() * this->camera->ImageDepth() *
-          msg.image().height());
+      msg->mutable_image()->set_data(this->camera->ImageData(),
+          msg->image().width() * this->camera->ImageDepth() *
+          msg->image().height());
 
       this->imagePub->Publish(msg);
     }
@@ -151,17 +151,18 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
       // generating point clouds instead
       this->dataPtr->depthCamera->DepthData())
   {
-    msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->SimTime());
-    msg.mutable_image()->set_width(this->camera->ImageWidth());
-    msg.mutable_image()->set_height(this->camera->ImageHeight());
-    msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
+    // Published without a copy, the message is shared with the subscribers
+    boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+    msgs::Set(msg->mutable_time(), this->scene->SimTime());
+    msg->mutable_image()->set_width(this->camera->ImageWidth());
+    msg->mutable_image()->set_height(this->camera->ImageHeight());
+    msg->mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
 
 
-    msg.mutable_image()->set_step(this->camera->ImageWidth() *
+    msg->mutable_image()->set_step(this->camera->ImageWidth() *
         this->camera->ImageDepth());
 
-    unsigned int depthSamples = msg.image().width() * msg.image().height();
+    unsigned int depthSamples = msg->image().width() * msg->image().height();
     float f;
     // cppchecker recommends using sizeof(varname)
     unsigned int depthBufferSize = depthSamples * sizeof(f);
@@ -184,7 +185,7 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
         this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
       }
     }
-    msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
+    msg->mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
   }
 
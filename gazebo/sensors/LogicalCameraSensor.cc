@@ -20,6 +20,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/LogicalCameraSensorPrivate.hh"
@@ -129,11 +130,6 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
       msgs::Set(modelMsg->mutable_pose(),
           model->WorldPose() - _myPose);
     }
-    // Check nested models
-    // Note, the model AABB does not necessarily contain the nested model
-    // so nested models must be searched even if the frustum does not contain
-    // the parent model.
-    AddVisibleModels(_myPose, model->NestedModels());
   }
 }
 
@@ -158,8 +154,9 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Check if the models and nested models near the frustum are in it.
+    this->dataPtr->AddVisibleModels(myPose,
+        this->world->SpatialIndex().ModelsInFrustum(this->dataPtr->frustum));
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
@@ -34,7 +34,8 @@ namespace gazebo
     {
       /// \brief Add models that are visible to the camera to a vector of models
       /// \param[in] _myPose pose of the logical camera
-      /// \param[in] _models list of models to test against frustum
+      /// \param[in] _models list of models to test against frustum, nested
+      /// models are not visited
       public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
         const physics::Model_V &_models);
 
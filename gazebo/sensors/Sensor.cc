@@ -258,7 +258,7 @@ void Sensor::Update(const bool _force)
         // Adjust time-to-update period to compensate for delays caused by
         // another sensor's update in the same thread.
         // NOTE: If you change this equation, also change the matching equation
-        // in Sensor::NeedsUpdate
+        // in Sensor::NeedsUpdate and Sensor::NextUpdateTime
         common::Time adjustedElapsed = simTime -
           this->lastUpdateTime + this->dataPtr->updateDelay;
 
@@ -540,3 +540,16 @@ bool Sensor::StrictRate() const
 {
   return this->useStrictRate;
 }
+
+//////////////////////////////////////////////////
+common::Time Sensor::NextUpdateTime() const
+{
+  if (this->useStrictRate || this->updatePeriod <= common::Time::Zero)
+    return common::Time::Zero;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+
+  // NOTE: This must match the adjusted elapsed time in Sensor::Update
+  return std::max(common::Time::Zero,
+      this->lastUpdateTime + this->updatePeriod - this->dataPtr->updateDelay);
+}
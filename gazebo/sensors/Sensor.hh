@@ -189,6 +189,13 @@ namespace gazebo
       /// \return True when sensor should follow strict update rate
       public: bool StrictRate() const;
 
+      /// \brief Get the simulation time at which Update will next generate
+      /// data. The SensorManager uses it to skip sensors that are not due.
+      /// \return The time, zero if the sensor updates on every call, which
+      /// is the case of sensors with a strict update rate or without an
+      /// update rate.
+      public: common::Time NextUpdateTime() const;
+
       /// \brief This gets overwritten by derived sensor types.
       ///        This function is called during Sensor::Update.
       ///        And in turn, Sensor::Update is called by
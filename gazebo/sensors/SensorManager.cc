@@ -15,9 +15,12 @@
  *
 */
 
+#include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <boost/bind/bind.hpp>
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsIface.hh"
@@ -114,6 +117,7 @@ SensorManager::~SensorManager()
     delete (*iter);
   }
   this->sensorContainers.clear();
+  this->scheduler.reset();
 
   this->initSensors.clear();
 }
@@ -125,10 +129,29 @@ void SensorManager::RunThreads()
   // sensorsContainers list are the image-based sensors, which rely on the
   // rendering engine, which in turn requires that they run in the main
   // thread.
+  if (!this->scheduler)
+  {
+    unsigned int threads = 0;
+    const char *threadsStr = common::getEnv("GAZEBO_SENSOR_THREADS");
+    if (threadsStr)
+      threads = static_cast<unsigned int>(std::max(0, std::atoi(threadsStr)));
+
+    // Pool threads update sensors that may query the physics engine.
+    this->scheduler.reset(new SensorScheduler(threads, []()
+        {
+          physics::WorldPtr world = physics::get_world();
+          if (world && world->Physics())
+            world->Physics()->InitForThread();
+        }));
+    gzlog << "Updating non-image sensors with "
+          << this->scheduler->ThreadCount() << " threads\n";
+  }
+
   for (SensorContainer_V::iterator iter = ++this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
+    (*iter)->SetScheduler(this->scheduler.get());
     (*iter)->Run();
   }
 }
@@ -142,7 +165,9 @@ void SensorManager::Stop()
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
     (*iter)->Stop();
+    (*iter)->SetScheduler(nullptr);
   }
+  this->scheduler.reset();
 
   if (!physics::worlds_running())
     this->worlds.clear();
@@ -282,6 +307,9 @@ void PublishPerformanceMetrics()
       sensorPerformanceMetric.second.sensorRealUpdateRate);
     performanceSensorMetricsMsg->set_sim_update_rate(
       sensorPerformanceMetric.second.sensorSimUpdateRate);
+    performanceSensorMetricsMsg->set_update_latency(
+      sensors::SensorManager::Instance()->SensorUpdateLatency(
+        sensorPerformanceMetric.first).Double());
     if (sensorPerformanceMetric.second.sensorAvgFPS >= 0.0)
     {
       performanceSensorMetricsMsg->set_fps(
@@ -457,7 +485,9 @@ void SensorManager::Fini()
     GZ_ASSERT((*iter) != nullptr, "SensorContainer is null");
     (*iter)->Fini();
     (*iter)->Stop();
+    (*iter)->SetScheduler(nullptr);
   }
+  this->scheduler.reset();
 
   this->removeSensors.clear();
   this->initSensors.clear();
@@ -620,6 +650,18 @@ void SensorManager::RemoveSensor(const std::string &_name)
   }
 }
 
+//////////////////////////////////////////////////
+common::Time SensorManager::SensorUpdateLatency(const std::string &_name) const
+{
+  common::Time latency;
+  for (auto const &container : this->sensorContainers)
+  {
+    if (container->UpdateLatency(_name, latency))
+      break;
+  }
+  return latency;
+}
+
 //////////////////////////////////////////////////
 bool SensorManager::WaitForPrerendered(double _timeoutsec)
 {
@@ -813,6 +855,16 @@ void SensorManager::SensorContainer::RunLoop()
     // Set the default sleep time
     eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
 
+    // Sleep until the next sensor is due when all the sensors have a
+    // deadline. Otherwise some sensor updates on every call, at the
+    // highest update rate.
+    common::Time nextUpdateTime = this->NextUpdateTime();
+    if (nextUpdateTime > common::Time::Zero)
+    {
+      eventTime = std::max(common::Time::Zero,
+          nextUpdateTime - world->SimTime());
+    }
+
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
     if (diffTime.sec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
@@ -855,15 +907,109 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
-  // Update all the sensors in this container.
-  for (Sensor_V::iterator iter = this->sensors.begin();
-       iter != this->sensors.end(); ++iter)
+  // Find the sensors due for an update. Without a scheduler, all the
+  // sensors are updated, since image sensors use the scene time.
+  Sensor_V due;
+  due.reserve(this->sensors.size());
+  common::Time simTime;
+  physics::WorldPtr world;
+  if (this->scheduler && !_force)
+    world = physics::get_world();
+  if (world)
+    simTime = world->SimTime();
+
+  for (auto const &sensor : this->sensors)
   {
-    GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    IGN_PROFILE_BEGIN((*iter)->Name().c_str());
-    (*iter)->Update(_force);
-    IGN_PROFILE_END();
+    GZ_ASSERT(sensor != nullptr, "Sensor is null");
+    if (world && (!sensor->IsActive() || sensor->NextUpdateTime() > simTime))
+      continue;
+    due.push_back(sensor);
+  }
+
+  // Update the sensors, in parallel when there is a scheduler. All the
+  // updates complete before returning, as lockstep requires.
+  std::vector<common::Time> latency(due.size());
+  std::vector<char> updated(due.size(), false);
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(due.size());
+  for (size_t i = 0; i < due.size(); ++i)
+  {
+    tasks.push_back([&, i]()
+        {
+          const SensorPtr &sensor = due[i];
+          common::Time lastUpdate = sensor->LastUpdateTime();
+          common::Time lastMeasurement = sensor->LastMeasurementTime();
+
+          IGN_PROFILE_BEGIN(sensor->Name().c_str());
+          // Time::GetWallTime is not thread safe
+          auto start = std::chrono::steady_clock::now();
+          sensor->Update(_force);
+          latency[i] = common::Time(std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count());
+          IGN_PROFILE_END();
+
+          updated[i] = sensor->LastUpdateTime() != lastUpdate ||
+            sensor->LastMeasurementTime() != lastMeasurement;
+        });
+  }
+
+  if (this->scheduler)
+    this->scheduler->Run(tasks);
+  else
+  {
+    for (auto const &task : tasks)
+      task();
   }
+
+  // Only keep the latency of updates that generated data
+  std::lock_guard<std::mutex> latencyLock(this->latencyMutex);
+  for (size_t i = 0; i < due.size(); ++i)
+  {
+    if (updated[i])
+      this->updateLatency[due[i]->ScopedName()] = latency[i];
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::SetScheduler(SensorScheduler *_scheduler)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->scheduler = _scheduler;
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::SensorContainer::UpdateLatency(const std::string &_name,
+    common::Time &_latency) const
+{
+  std::lock_guard<std::mutex> lock(this->latencyMutex);
+  auto iter = this->updateLatency.find(_name);
+  if (iter == this->updateLatency.end())
+    return false;
+  _latency = iter->second;
+  return true;
+}
+
+//////////////////////////////////////////////////
+common::Time SensorManager::SensorContainer::NextUpdateTime() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  common::Time next;
+  bool first = true;
+  for (auto const &sensor : this->sensors)
+  {
+    if (!sensor->IsActive())
+      continue;
+
+    common::Time sensorNext = sensor->NextUpdateTime();
+    if (sensorNext <= common::Time::Zero)
+      return common::Time::Zero;
+
+    if (first || sensorNext < next)
+      next = sensorNext;
+    first = false;
+  }
+  return next;
 }
 
 //////////////////////////////////////////////////
@@ -924,6 +1070,10 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
 
     if ((*iter)->ScopedName() == _name)
     {
+      {
+        std::lock_guard<std::mutex> latencyLock(this->latencyMutex);
+        this->updateLatency.erase(_name);
+      }
       (*iter)->Fini();
       this->sensors.erase(iter);
       removed = true;
@@ -971,6 +1121,9 @@ void SensorManager::SensorContainer::RemoveSensors()
   g_sensorsDirty = true;
 
   this->sensors.clear();
+
+  std::lock_guard<std::mutex> latencyLock(this->latencyMutex);
+  this->updateLatency.clear();
 }
 
 //////////////////////////////////////////////////
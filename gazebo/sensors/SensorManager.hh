@@ -23,6 +23,8 @@
 #include <list>
 #include <map>
 #include <condition_variable>
+#include <memory>
+#include <mutex>
 
 #include <sdf/sdf.hh>
 
@@ -31,6 +33,7 @@
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorScheduler.hh"
 #include "gazebo/util/system.hh"
 
 /// \brief Explicit instantiation for typed SingletonT.
@@ -115,7 +118,11 @@ namespace gazebo
       public: void Init();
 
       /// \brief Run sensor updates in separate threads.
-      /// This will only run non-image based sensor updates.
+      /// This will only run non-image based sensor updates. The sensors
+      /// due for an update are updated in parallel by a pool of threads.
+      /// The size of the pool is set by the GAZEBO_SENSOR_THREADS
+      /// environment variable, and defaults to the number of hardware
+      /// threads.
       public: void RunThreads();
 
       /// \brief Stop the run thread
@@ -128,6 +135,13 @@ namespace gazebo
       /// \return True if running.
       public: bool Running() const;
 
+      /// \brief Get the real time it took to update a sensor the last
+      /// time it generated data.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \return The update latency, zero if the sensor has not been
+      /// updated yet.
+      public: common::Time SensorUpdateLatency(const std::string &_name) const;
+
       /// \brief Get all the sensor types
       /// \param[out] All the sensor types.
       public: void GetSensorTypes(std::vector<std::string> &_types) const;
@@ -254,6 +268,26 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Set the scheduler used to update the sensors
+                 /// in parallel.
+                 /// \param[in] _scheduler The scheduler, nullptr to update
+                 /// the sensors one after the other.
+                 public: void SetScheduler(SensorScheduler *_scheduler);
+
+                 /// \brief Get the real time it took to update a sensor
+                 /// the last time it generated data.
+                 /// \param[in] _name Scoped name of the sensor.
+                 /// \param[out] _latency The update latency.
+                 /// \return True if the sensor was found.
+                 public: bool UpdateLatency(const std::string &_name,
+                                            common::Time &_latency) const;
+
+                 /// \brief Get the earliest simulation time at which an
+                 /// active sensor is due for an update.
+                 /// \return The time, zero if a sensor updates on every
+                 /// call.
+                 private: common::Time NextUpdateTime() const;
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
@@ -277,6 +311,17 @@ namespace gazebo
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief Scheduler used to update sensors in parallel,
+                 /// nullptr to update them one after the other.
+                 private: SensorScheduler *scheduler = nullptr;
+
+                 /// \brief Protects updateLatency.
+                 private: mutable std::mutex latencyMutex;
+
+                 /// \brief Last update latency of each sensor, indexed by
+                 /// scoped name.
+                 private: std::map<std::string, common::Time> updateLatency;
                };
       /// \endcond
 
@@ -331,6 +376,9 @@ namespace gazebo
       /// \brief Pointer to the sim time event handler.
       private: SimTimeEventHandler *simTimeEventHandler;
 
+      /// \brief Pool of threads used by the non-image sensor containers.
+      private: std::unique_ptr<SensorScheduler> scheduler;
+
       /// \brief All the worlds whose sensors have been initialized. This
       /// includes worlds without sensors..
       private: std::map<std::string, physics::WorldPtr> worlds;
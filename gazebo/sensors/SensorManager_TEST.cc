@@ -94,6 +94,14 @@ TEST_F(SensorManager_TEST, Data)
     ASSERT_TRUE(sensor != nullptr);
     EXPECT_TRUE(sensor->LastMeasurementTime() > time);
   }
+
+  // The update latency of each sensor is reported
+  for (auto const &s : mgr->GetSensors())
+  {
+    EXPECT_GT(mgr->SensorUpdateLatency(s->ScopedName()), common::Time::Zero)
+      << s->ScopedName();
+  }
+  EXPECT_EQ(common::Time::Zero, mgr->SensorUpdateLatency("no_such_sensor"));
 }
 
 /////////////////////////////////////////////////
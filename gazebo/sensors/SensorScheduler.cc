@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/sensors/SensorScheduler.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Tasks submitted by one call to SensorScheduler::Run.
+    class SensorSchedulerBatch
+    {
+      /// \brief Number of tasks not completed yet.
+      public: std::atomic<size_t> pending{0};
+    };
+
+    /// \internal
+    /// \brief A task waiting in a queue.
+    class SensorSchedulerTask
+    {
+      /// \brief The task, owned by the caller of Run.
+      public: const std::function<void()> *func = nullptr;
+
+      /// \brief Batch the task belongs to.
+      public: SensorSchedulerBatch *batch = nullptr;
+    };
+
+    /// \internal
+    /// \brief Queue of tasks of a pool thread.
+    class SensorSchedulerQueue
+    {
+      /// \brief Protects tasks.
+      public: std::mutex mutex;
+
+      /// \brief The tasks. The owner thread takes tasks from the back,
+      /// other threads steal them from the front.
+      public: std::deque<SensorSchedulerTask> tasks;
+    };
+
+    /// \internal
+    /// \brief SensorScheduler private data.
+    class SensorSchedulerPrivate
+    {
+      /// \brief Take a task, from the queue of a pool thread first, then
+      /// from the other queues.
+      /// \param[in] _self Index of the queue of the calling thread, or the
+      /// number of queues if the thread has no queue.
+      /// \param[out] _task The task.
+      /// \return True if a task was taken.
+      public: bool Take(const size_t _self, SensorSchedulerTask &_task);
+
+      /// \brief Run a task, and wake up the threads waiting for its batch
+      /// once it is complete.
+      /// \param[in] _task The task.
+      public: void Execute(const SensorSchedulerTask &_task);
+
+      /// \brief Main loop of a pool thread.
+      /// \param[in] _index Index of the queue of the thread.
+      public: void Loop(const size_t _index);
+
+      /// \brief One queue per pool thread.
+      public: std::vector<std::unique_ptr<SensorSchedulerQueue>> queues;
+
+      /// \brief Pool threads.
+      public: std::vector<std::thread> threads;
+
+      /// \brief Function called by each pool thread when it starts.
+      public: std::function<void()> threadInit;
+
+      /// \brief Number of tasks in all the queues.
+      public: std::atomic<size_t> queued{0};
+
+      /// \brief Queue the next batch starts at, so that the first tasks of
+      /// each batch don't always go to the same thread.
+      public: std::atomic<size_t> nextQueue{0};
+
+      /// \brief Protects stop, and is used with condition.
+      public: std::mutex mutex;
+
+      /// \brief Notified when tasks are queued, when a batch completes and
+      /// when stopping.
+      public: std::condition_variable condition;
+
+      /// \brief True when the pool threads must exit.
+      public: bool stop = false;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+bool SensorSchedulerPrivate::Take(const size_t _self,
+    SensorSchedulerTask &_task)
+{
+  if (this->queued == 0)
+    return false;
+
+  if (_self < this->queues.size())
+  {
+    SensorSchedulerQueue &own = *this->queues[_self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty())
+    {
+      _task = own.tasks.back();
+      own.tasks.pop_back();
+      --this->queued;
+      return true;
+    }
+  }
+
+  // Steal from the other queues, starting after our own one.
+  for (size_t i = 1; i <= this->queues.size(); ++i)
+  {
+    SensorSchedulerQueue &other =
+      *this->queues[(_self + i) % this->queues.size()];
+    std::lock_guard<std::mutex> lock(other.mutex);
+    if (!other.tasks.empty())
+    {
+      _task = other.tasks.front();
+      other.tasks.pop_front();
+      --this->queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+void SensorSchedulerPrivate::Execute(const SensorSchedulerTask &_task)
+{
+  (*_task.func)();
+
+  if (--_task.batch->pending == 0)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->condition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorSchedulerPrivate::Loop(const size_t _index)
+{
+  if (this->threadInit)
+    this->threadInit();
+
+  SensorSchedulerTask task;
+  while (true)
+  {
+    if (this->Take(_index, task))
+    {
+      this->Execute(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->condition.wait(lock, [this]
+        {
+          return this->stop || this->queued > 0;
+        });
+    if (this->stop)
+      return;
+  }
+}
+
+//////////////////////////////////////////////////
+SensorScheduler::SensorScheduler(const unsigned int _threads,
+    const std::function<void()> &_threadInit)
+  : dataPtr(new SensorSchedulerPrivate)
+{
+  unsigned int count = _threads;
+  if (count == 0)
+    count = std::max(1u, std::thread::hardware_concurrency());
+
+  this->dataPtr->threadInit = _threadInit;
+
+  // The thread that calls Run also runs tasks
+  for (unsigned int i = 1; i < count; ++i)
+  {
+    this->dataPtr->queues.push_back(
+        std::unique_ptr<SensorSchedulerQueue>(new SensorSchedulerQueue));
+  }
+
+  for (size_t i = 0; i < this->dataPtr->queues.size(); ++i)
+  {
+    this->dataPtr->threads.push_back(
+        std::thread(&SensorSchedulerPrivate::Loop, this->dataPtr.get(), i));
+  }
+}
+
+//////////////////////////////////////////////////
+SensorScheduler::~SensorScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->condition.notify_all();
+  }
+
+  for (auto &thread : this->dataPtr->threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorScheduler::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->queues.size()) + 1;
+}
+
+//////////////////////////////////////////////////
+void SensorScheduler::Run(const std::vector<std::function<void()>> &_tasks)
+{
+  // Nothing to gain from the pool
+  if (this->dataPtr->queues.empty() || _tasks.size() <= 1)
+  {
+    for (auto const &task : _tasks)
+      task();
+    return;
+  }
+
+  SensorSchedulerBatch batch;
+  batch.pending = _tasks.size();
+
+  size_t queueCount = this->dataPtr->queues.size();
+  size_t first = this->dataPtr->nextQueue++;
+  for (size_t i = 0; i < _tasks.size(); ++i)
+  {
+    SensorSchedulerTask task;
+    task.func = &_tasks[i];
+    task.batch = &batch;
+
+    SensorSchedulerQueue &queue =
+      *this->dataPtr->queues[(first + i) % queueCount];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+    ++this->dataPtr->queued;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->condition.notify_all();
+  }
+
+  // Help running tasks until the batch is complete. Tasks of other
+  // batches may be run too, which is fine since their callers wait for
+  // them.
+  SensorSchedulerTask task;
+  while (batch.pending > 0)
+  {
+    if (this->dataPtr->Take(queueCount, task))
+    {
+      this->dataPtr->Execute(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->condition.wait(lock, [&]
+        {
+          return batch.pending == 0 || this->dataPtr->queued > 0;
+        });
+  }
+}
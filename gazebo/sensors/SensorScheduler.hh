@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORSCHEDULER_HH_
+#define GAZEBO_SENSORS_SENSORSCHEDULER_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class
+    class SensorSchedulerPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class SensorScheduler SensorScheduler.hh sensors/sensors.hh
+    /// \brief A pool of threads used by the SensorManager to update
+    /// sensors in parallel.
+    ///
+    /// Each thread has its own queue of tasks. A thread that runs out of
+    /// tasks steals tasks from the other queues, so a few slow sensors
+    /// don't keep the other threads idle. Several threads may call Run
+    /// concurrently, and each of them helps running tasks until its own
+    /// tasks are done.
+    class GZ_SENSORS_VISIBLE SensorScheduler
+    {
+      /// \brief Constructor.
+      /// \param[in] _threads Number of threads in the pool, including the
+      /// thread that calls Run. Zero uses the number of hardware threads.
+      /// \param[in] _threadInit Function called once by each pool thread
+      /// before it runs any task.
+      public: explicit SensorScheduler(const unsigned int _threads = 0,
+                  const std::function<void()> &_threadInit = nullptr);
+
+      /// \brief Destructor. Stops the pool threads.
+      public: virtual ~SensorScheduler();
+
+      /// \brief Get the number of threads running tasks, including the
+      /// thread that calls Run.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Run tasks in parallel, and wait for all of them to
+      /// complete.
+      /// \param[in] _tasks Tasks to run.
+      public: void Run(const std::vector<std::function<void()>> &_tasks);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SensorSchedulerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/sensors/SensorScheduler.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SensorScheduler : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SensorScheduler, RunAll)
+{
+  std::atomic<int> inits(0);
+  sensors::SensorScheduler scheduler(4, [&inits]() { ++inits; });
+  EXPECT_EQ(4u, scheduler.ThreadCount());
+
+  std::vector<int> counts(100, 0);
+  std::vector<std::function<void()>> tasks;
+  for (auto &count : counts)
+    tasks.push_back([&count]() { ++count; });
+
+  for (int i = 0; i < 10; ++i)
+    scheduler.Run(tasks);
+
+  // Every task ran once per call
+  for (auto const &count : counts)
+    EXPECT_EQ(10, count);
+
+  // Empty batches are fine
+  scheduler.Run({});
+
+  // The thread calling Run is not initialized by the scheduler
+  while (inits < 3)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_EQ(3, inits);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorScheduler, Parallel)
+{
+  sensors::SensorScheduler scheduler(4);
+
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  std::atomic<int> running(0);
+  std::atomic<int> maxRunning(0);
+
+  std::vector<std::function<void()>> tasks;
+  for (int i = 0; i < 8; ++i)
+  {
+    tasks.push_back([&]()
+        {
+          int now = ++running;
+          int prev = maxRunning;
+          while (now > prev && !maxRunning.compare_exchange_weak(prev, now))
+          {
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          --running;
+
+          std::lock_guard<std::mutex> lock(mutex);
+          ids.insert(std::this_thread::get_id());
+        });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  scheduler.Run(tasks);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_GT(maxRunning, 1);
+  EXPECT_GT(ids.size(), 1u);
+  EXPECT_LT(elapsed, std::chrono::milliseconds(8 * 20));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorScheduler, ConcurrentCallers)
+{
+  sensors::SensorScheduler scheduler(3);
+
+  std::atomic<int> total(0);
+  std::vector<std::function<void()>> tasks(50, [&total]() { ++total; });
+
+  // Sensor containers call Run from their own threads at the same time
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i)
+  {
+    callers.push_back(std::thread([&]()
+          {
+            for (int j = 0; j < 20; ++j)
+              scheduler.Run(tasks);
+          }));
+  }
+  for (auto &caller : callers)
+    caller.join();
+
+  EXPECT_EQ(4 * 20 * 50, total);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorScheduler, SingleThread)
+{
+  sensors::SensorScheduler scheduler(1);
+  EXPECT_EQ(1u, scheduler.ThreadCount());
+
+  // Tasks run in order in the calling thread
+  std::vector<int> order;
+  std::vector<std::function<void()>> tasks;
+  for (int i = 0; i < 5; ++i)
+    tasks.push_back([&order, i]() { order.push_back(i); });
+  scheduler.Run(tasks);
+
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), order);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -68,6 +68,9 @@ extern void dummy_callback_fn(uint32_t);
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
 
+/// \brief Maximum size of the messages batched in a single socket write.
+static const size_t kMaxBatchSize = 4096;
+
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
 // is stolen from adress::is_unspecified function in boost v1.52.
@@ -296,6 +299,22 @@ void Connection::EnqueueMsg(const std::string &_buffer, bool _force)
 //////////////////////////////////////////////////
 void Connection::EnqueueMsg(const std::string &_buffer,
     boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  this->EnqueueMsgImpl(_buffer, nullptr, _cb, _id, _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const std::shared_ptr<const std::string> &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  if (_buffer)
+    this->EnqueueMsgImpl(*_buffer, _buffer, _cb, _id, _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsgImpl(const std::string &_buffer,
+    const std::shared_ptr<const std::string> &_shared,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
 {
   // Don't enqueue empty messages
   if (_buffer.empty() || !this->IsOpen())
@@ -312,15 +331,27 @@ void Connection::EnqueueMsg(const std::string &_buffer,
 
     if (this->writeQueue.empty() ||
         (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
+        this->writeQueue.back().payload ||
+        (this->writeQueue.back().Size() + HEADER_LENGTH + _buffer.size() >
+         kMaxBatchSize))
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
+      this->writeQueue.push_back(ConnectionWrite());
       this->callbacks.push_back({std::make_pair(_cb, _id)});
+
+      ConnectionWrite &write = this->writeQueue.back();
+      write.data.assign(headerBuffer, HEADER_LENGTH);
+
+      // Messages too large to be batched are written from the shared
+      // buffer, without copying them.
+      if (_shared && HEADER_LENGTH + _buffer.size() > kMaxBatchSize)
+        write.payload = _shared;
+      else
+        write.data += _buffer;
     }
     else
     {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
+      this->writeQueue.back().data.append(headerBuffer, HEADER_LENGTH);
+      this->writeQueue.back().data += _buffer;
       this->callbacks.back().push_back(std::make_pair(_cb, _id));
     }
   }
@@ -358,11 +389,15 @@ void Connection::ProcessWriteQueue(bool _blocking)
   // Write the serialized data to the socket. We use
   // "gather-write" to send both the head and the data in
   // a single write operation
+  const ConnectionWrite &write = this->writeQueue.front();
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.push_back(boost::asio::buffer(write.data));
+  if (write.payload)
+    buffers.push_back(boost::asio::buffer(*write.payload));
+
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
+    boost::asio::async_write(*this->socket, buffers,
           common::weakBind(&Connection::OnWrite, this->shared_from_this(),
             boost::asio::placeholders::error));
   }
@@ -370,9 +405,7 @@ void Connection::ProcessWriteQueue(bool _blocking)
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, buffers);
     }
     catch(...)
     {
@@ -44,6 +44,7 @@
 #include <iostream>
 #include <iomanip>
 #include <deque>
+#include <memory>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
@@ -107,6 +108,24 @@ namespace gazebo
       /// \brief The data to send to the boost function pointer
       private: std::string data;
     };
+
+    /// \brief Data sent by a single write on a connection socket.
+    class GZ_TRANSPORT_VISIBLE ConnectionWrite
+    {
+      /// \brief Get the number of bytes to write.
+      /// \return Size of data plus the size of payload.
+      public: size_t Size() const
+              { return this->data.size() + (this->payload ?
+                  this->payload->size() : 0); }
+
+      /// \brief Message headers and message data copied into the write.
+      /// Small messages are batched here.
+      public: std::string data;
+
+      /// \brief Message data written after data. It is shared with the
+      /// publisher instead of being copied.
+      public: std::shared_ptr<const std::string> payload;
+    };
     /// \endcond
 
     /// \addtogroup gazebo_transport Transport
@@ -193,6 +212,33 @@ namespace gazebo
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write shared data to the socket. Large buffers are written
+      /// directly from _buffer instead of being copied into the outgoing
+      /// queue, so _buffer must not be modified afterwards.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(const std::shared_ptr<const std::string> &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
+      /// \brief Implementation of EnqueueMsg.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _shared Shared pointer to _buffer, or nullptr if the
+      /// data must be copied.
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket.
+      private: void EnqueueMsgImpl(const std::string &_buffer,
+                   const std::shared_ptr<const std::string> &_shared,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id,
+                   bool _force);
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -418,7 +464,7 @@ namespace gazebo
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
       /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      private: std::deque<ConnectionWrite> writeQueue;
 
       /// \brief List of callbacks, paired with writeQueue. The callbacks
       /// are used to notify a publisher when a message is successfully sent.
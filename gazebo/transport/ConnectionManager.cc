@@ -74,6 +74,7 @@ ConnectionManager::ConnectionManager()
   this->initialized = false;
   this->stop = false;
   this->stopped = true;
+  this->updatePending = false;
 
   this->eventConnections.push_back(
       event::Events::ConnectStop(boost::bind(&ConnectionManager::Stop, this)));
@@ -82,10 +83,11 @@ ConnectionManager::ConnectionManager()
 //////////////////////////////////////////////////
 ConnectionManager::~ConnectionManager()
 {
+  // Fini stops the update loop, which uses updateMutex.
+  this->Fini();
+
   boost::mutex::scoped_lock lock(this->updateMutex);
   this->eventConnections.clear();
-
-  this->Fini();
 }
 
 //////////////////////////////////////////////////
@@ -257,6 +259,7 @@ void ConnectionManager::Fini()
 void ConnectionManager::Stop()
 {
   this->stop = true;
+  this->TriggerUpdate();
 }
 
 //////////////////////////////////////////////////
@@ -307,15 +310,22 @@ void ConnectionManager::RunUpdate()
 //////////////////////////////////////////////////
 void ConnectionManager::Run()
 {
-  boost::mutex::scoped_lock lock(this->updateMutex);
-
   this->stopped = false;
 
   while (!this->stop && this->masterConn && this->masterConn->IsOpen())
   {
     this->RunUpdate();
-    this->updateCondition.timed_wait(lock,
-       boost::posix_time::milliseconds(100));
+
+    // Wait for the next trigger. The update runs without holding
+    // updateMutex, so that triggers received meanwhile are recorded in
+    // updatePending instead of being lost.
+    boost::mutex::scoped_lock lock(this->updateMutex);
+    if (!this->updatePending && !this->stop)
+    {
+      this->updateCondition.timed_wait(lock,
+          boost::posix_time::milliseconds(100));
+    }
+    this->updatePending = false;
   }
   this->RunUpdate();
 
@@ -496,6 +506,11 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
 
+    // A subscriber on the same host may read messages from shared memory.
+    // It waits for the answer before reading any message.
+    if (sub.has_shm_name())
+      subLink->InitSharedMemory(sub.shm_name());
+
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
   }
@@ -710,6 +725,10 @@ ConnectionPtr ConnectionManager::FindConnection(const std::string &_host,
 //////////////////////////////////////////////////
 void ConnectionManager::TriggerUpdate()
 {
+  {
+    boost::mutex::scoped_lock lock(this->updateMutex);
+    this->updatePending = true;
+  }
   this->updateCondition.notify_all();
 }
 
@@ -176,6 +176,11 @@ namespace gazebo
       /// \brief Mutex for updateCondition
       private: boost::mutex updateMutex;
 
+      /// \brief True when TriggerUpdate was called since the last update.
+      /// Protected by updateMutex, so that a trigger received while the
+      /// update loop is running is not lost.
+      private: bool updatePending;
+
       private: ConnectionPtr masterConn;
       private: ConnectionPtr serverConn;
 
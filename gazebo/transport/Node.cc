@@ -200,6 +200,16 @@ bool Node::HandleData(const std::string &_topic, const std::string &_msg)
   return true;
 }
 
+/////////////////////////////////////////////////
+bool Node::HandleData(const std::string &_topic, const char *_data,
+    const size_t _size)
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  this->incomingMsgs[_topic].emplace_back(_data, _size);
+  ConnectionManager::Instance()->TriggerUpdate();
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
@@ -389,3 +399,27 @@ void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
     }
   }
 }
+
+/////////////////////////////////////////////////
+void Node::SetSharedMemory(const std::string &_topic, const bool _enabled,
+    const size_t _slotSize, const unsigned int _slotCount)
+{
+  SubscribeOptions ops;
+  ops.SetSharedMemory(_enabled, _slotSize, _slotCount);
+
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  this->sharedMemoryTopics[this->DecodeTopicName(_topic)] = ops;
+}
+
+/////////////////////////////////////////////////
+void Node::ApplySharedMemory(SubscribeOptions &_ops)
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  auto iter = this->sharedMemoryTopics.find(_ops.GetTopic());
+  if (iter != this->sharedMemoryTopics.end())
+  {
+    _ops.SetSharedMemory(iter->second.SharedMemory(),
+        iter->second.SharedMemorySlotSize(),
+        iter->second.SharedMemorySlotCount());
+  }
+}
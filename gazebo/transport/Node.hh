@@ -273,6 +273,7 @@ namespace gazebo
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        this->ApplySharedMemory(ops);
 
         {
           using namespace boost::placeholders;
@@ -303,6 +304,7 @@ namespace gazebo
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        this->ApplySharedMemory(ops);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
@@ -333,6 +335,7 @@ namespace gazebo
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
+        this->ApplySharedMemory(ops);
 
         {
           using namespace boost::placeholders;
@@ -362,6 +365,7 @@ namespace gazebo
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
+        this->ApplySharedMemory(ops);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
@@ -377,6 +381,20 @@ namespace gazebo
         return result;
       }
 
+      /// \brief Receive the messages of a topic through shared memory from
+      /// the publishers that run on the same host. Applies to the
+      /// subscriptions created afterwards by this node.
+      /// \param[in] _topic The topic.
+      /// \param[in] _enabled True to use shared memory.
+      /// \param[in] _slotSize Maximum size of a message in shared memory.
+      /// \param[in] _slotCount Number of messages in shared memory.
+      /// \sa SubscribeOptions::SetSharedMemory
+      public: void SetSharedMemory(const std::string &_topic,
+          const bool _enabled,
+          const size_t _slotSize = SubscribeOptions::kDefaultShmSlotSize,
+          const unsigned int _slotCount =
+              SubscribeOptions::kDefaultShmSlotCount);
+
       /// \brief Handle incoming data.
       /// \param[in] _topic Topic for which the data was received
       /// \param[in] _msg The message that was received
@@ -384,6 +402,16 @@ namespace gazebo
       public: bool HandleData(const std::string &_topic,
                               const std::string &_msg);
 
+      /// \brief Handle incoming data from a buffer that is only valid
+      /// during the call. The data is copied once, into the queue of
+      /// incoming messages.
+      /// \param[in] _topic Topic for which the data was received
+      /// \param[in] _data Start of the message that was received
+      /// \param[in] _size Size of the message
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleData(const std::string &_topic, const char *_data,
+                              const size_t _size);
+
       /// \brief Handle incoming msg.
       /// \param[in] _topic Topic for which the data was received
       /// \param[in] _msg The message that was received
@@ -435,6 +463,11 @@ namespace gazebo
                                 const common::Time &_maxWait,
                                 const bool _fallbackToDefault);
 
+      /// \brief Set the shared memory options of a subscription from the
+      /// SetSharedMemory settings of its topic.
+      /// \param[in,out] _ops Options of the subscription.
+      private: void ApplySharedMemory(SubscribeOptions &_ops);
+
       private: std::string topicNamespace;
       private: std::vector<PublisherPtr> publishers;
       private: std::vector<PublisherPtr>::iterator publishersIter;
@@ -462,6 +495,10 @@ namespace gazebo
       /// from separate threads.
       private: boost::recursive_mutex processIncomingMutex;
 
+      /// \brief Shared memory settings by topic, see SetSharedMemory.
+      /// Protected by incomingMutex.
+      private: std::map<std::string, SubscribeOptions> sharedMemoryTopics;
+
       private: bool initialized;
     };
     /// \}
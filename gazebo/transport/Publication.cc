@@ -15,6 +15,7 @@
  *
 */
 
+#include <memory>
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include "gazebo/common/WeakBind.hh"
@@ -139,6 +140,8 @@ void Publication::AddTransport(const PublicationTransportPtr &_publink)
     using namespace boost::placeholders;
     _publink->AddCallback(common::weakBind(&Publication::LocalPublish,
                 this->shared_from_this(), _1));
+    _publink->AddDataCallback(common::weakBind(
+          &Publication::LocalPublishBuffer, this->shared_from_this(), _1, _2));
     this->transports.push_back(_publink);
   }
 }
@@ -290,6 +293,54 @@ void Publication::LocalPublish(const std::string &_data)
   }
 }
 
+//////////////////////////////////////////////////
+void Publication::LocalPublishBuffer(const char *_data, const size_t _size)
+{
+  std::list<NodePtr>::iterator iter, endIter;
+
+  {
+    boost::mutex::scoped_lock lock(this->nodeMutex);
+
+    iter = this->nodes.begin();
+    endIter = this->nodes.end();
+    while (iter != endIter)
+    {
+      if ((*iter)->HandleData(this->topic, _data, _size))
+        ++iter;
+      else
+        this->nodes.erase(iter++);
+    }
+  }
+
+  this->RemoveNodes();
+
+  {
+    // Local callbacks take a string, built for the first one only.
+    std::unique_ptr<std::string> data;
+
+    boost::mutex::scoped_lock lock(this->callbackMutex);
+    std::list< CallbackHelperPtr >::iterator cbIter;
+    cbIter = this->callbacks.begin();
+    while (cbIter != this->callbacks.end())
+    {
+      if ((*cbIter)->IsLocal())
+      {
+        if (!data)
+          data.reset(new std::string(_data, _size));
+
+        using namespace boost::placeholders;
+        if ((*cbIter)->HandleData(*data,
+              boost::bind(&dummy_callback_fn, _1), 0))
+          ++cbIter;
+        else
+          cbIter = this->callbacks.erase(cbIter);
+      }
+      else
+        ++cbIter;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
     uint32_t _id)
@@ -321,14 +372,24 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // Serialize once. Every callback, and every connection of a remote
+      // subscriber, shares the same buffer.
+      auto data = std::make_shared<std::string>();
+      _msg->SerializeToString(data.get());
+      std::shared_ptr<const std::string> constData = data;
+
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        // Only remote subscribers make use of the shared buffer. They are
+        // found with a cast, to keep CallbackHelper unchanged.
+        auto remote =
+          boost::dynamic_pointer_cast<SubscriptionTransport>(*cbIter);
+        bool handled = remote ? remote->HandleBuffer(constData, _cb, _id) :
+          (*cbIter)->HandleData(*constData, _cb, _id);
+        if (handled)
         {
           ++result;
           ++cbIter;
@@ -116,6 +116,12 @@ namespace gazebo
       /// \param[in] _data The data to be published
       public: void LocalPublish(const std::string &_data);
 
+      /// \brief Publish data to local subscribers, from a buffer that is
+      /// only valid during the call, such as a shared memory ring slot.
+      /// \param[in] _data Start of the data to be published
+      /// \param[in] _size Size of the data
+      public: void LocalPublishBuffer(const char *_data, const size_t _size);
+
       /// \brief Publish data to remote subscribers
       /// \param[in] _msg Message to be published
       /// \param[in] _cb Callback to be invoked after publishing
@@ -51,6 +51,7 @@ PublicationTransport::~PublicationTransport()
     ConnectionManager::Instance()->RemoveConnection(this->connection);
   }
   this->callback.clear();
+  this->dataCallback.clear();
 }
 
 /////////////////////////////////////////////////
@@ -63,6 +64,11 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  if (this->ring)
+  {
+    sub.set_shm_name(this->ring->Name());
+    this->ringPending = true;
+  }
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -74,6 +80,18 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
 }
 
 
+/////////////////////////////////////////////////
+bool PublicationTransport::RequestSharedMemory(const size_t _slotSize,
+    const unsigned int _slotCount)
+{
+  std::unique_ptr<SharedMemoryRing> newRing(new SharedMemoryRing);
+  if (!newRing->Create(_slotSize, _slotCount))
+    return false;
+
+  this->ring = std::move(newRing);
+  return true;
+}
+
 /////////////////////////////////////////////////
 void PublicationTransport::AddCallback(
     const boost::function<void(const std::string &)> &cb_)
@@ -81,12 +99,31 @@ void PublicationTransport::AddCallback(
   this->callback = cb_;
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::AddDataCallback(
+    const boost::function<void(const char *, const size_t)> &_cb)
+{
+  this->dataCallback = _cb;
+}
+
 /////////////////////////////////////////////////
 void PublicationTransport::OnPublish(const std::string &_data)
 {
   if (this->connection && this->connection->IsOpen())
   {
     using namespace boost::placeholders;
+
+    // Messages of the ring are handled in their slot, which is released
+    // before reading the next message, so that slots are released in order.
+    if (this->ring && !_data.empty())
+    {
+      this->ReadSharedMemory(_data);
+      this->connection->AsyncRead(
+          common::weakBind(&PublicationTransport::OnPublish,
+              this->shared_from_this(), _1));
+      return;
+    }
+
     this->connection->AsyncRead(
         common::weakBind(&PublicationTransport::OnPublish,
             this->shared_from_this(), _1));
@@ -99,6 +136,56 @@ void PublicationTransport::OnPublish(const std::string &_data)
   }
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::ReadSharedMemory(const std::string &_frame)
+{
+  // The first message is the answer of the publisher
+  if (this->ringPending)
+  {
+    this->ringPending = false;
+
+    bool accepted;
+    if (SharedMemoryRing::ParseReply(_frame, accepted))
+    {
+      if (accepted)
+      {
+        // Both processes have mapped the segment, so its name can go. It
+        // is not left behind if either of them crashes.
+        this->ring->Unlink();
+      }
+      else
+      {
+        gzlog << "Publisher of [" << this->topic << "] can't use shared "
+              << "memory, receiving over the connection\n";
+        this->ring.reset();
+      }
+      return;
+    }
+
+    // A publisher that does not know about rings sends messages over the
+    // connection right away, starting with the latched one.
+    gzlog << "Publisher of [" << this->topic << "] does not support shared "
+          << "memory, receiving over the connection\n";
+    this->ring.reset();
+    if (this->callback)
+      (this->callback)(_frame);
+    return;
+  }
+
+  const char *data;
+  size_t size;
+  uint64_t seq;
+  if (!this->ring->ReadFrame(_frame, data, size, seq))
+    return;
+
+  if (this->dataCallback)
+    (this->dataCallback)(data, size);
+  else if (this->callback)
+    (this->callback)(std::string(data, size));
+
+  this->ring->Release(seq);
+}
+
 /////////////////////////////////////////////////
 const ConnectionPtr PublicationTransport::GetConnection() const
 {
@@ -20,9 +20,11 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/SharedMemoryRing.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
 
@@ -55,6 +57,16 @@ namespace gazebo
       /// topic.
       public: void Init(const ConnectionPtr &_conn, bool _latched);
 
+      /// \brief Ask the remote publisher to write messages to a shared
+      /// memory ring, instead of sending them over the connection. The
+      /// publisher falls back to the connection when it runs on another
+      /// host. Must be called before Init.
+      /// \param[in] _slotSize Maximum size of a message in the ring.
+      /// \param[in] _slotCount Number of messages in the ring.
+      /// \return True if the ring was created.
+      public: bool RequestSharedMemory(const size_t _slotSize,
+                  const unsigned int _slotCount);
+
       /// \brief Finalize the transport
       public: void Fini();
 
@@ -63,6 +75,14 @@ namespace gazebo
       public: void AddCallback(
                   const boost::function<void(const std::string &)> &_cb);
 
+      /// \brief Add a callback that receives messages in place. Messages
+      /// read from a shared memory ring are passed without copying them
+      /// out of their slot, which is released when the callback returns.
+      /// The callback added by AddCallback is used when this one is unset.
+      /// \param[in] _cb The callback, which gets the message data and size.
+      public: void AddDataCallback(
+                  const boost::function<void(const char *, const size_t)> &_cb);
+
       /// \brief Get the underlying connection
       /// \return Pointer to the underlying connection
       public: const ConnectionPtr GetConnection() const;
@@ -79,6 +99,11 @@ namespace gazebo
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Handle a message of a publisher that was asked to use the
+      /// shared memory ring, and pass the published data to the callbacks.
+      /// \param[in] _frame Message received over the connection.
+      private: void ReadSharedMemory(const std::string &_frame);
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -91,6 +116,17 @@ namespace gazebo
       /// \brief Callback used when OnPublish is called.
       private: boost::function<void (const std::string &)> callback;
 
+      /// \brief Callback used for messages read in place.
+      private: boost::function<void (const char *, const size_t)> dataCallback;
+
+      /// \brief Shared memory ring the publisher writes to, nullptr if the
+      /// messages are sent over the connection.
+      private: std::unique_ptr<SharedMemoryRing> ring;
+
+      /// \brief True until the publisher has answered the shared memory
+      /// request.
+      private: bool ringPending = false;
+
       /// \brief Counter to give the publication transport a unique id.
       private: static int counter;
 
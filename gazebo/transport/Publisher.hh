@@ -27,6 +27,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <type_traits>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -101,6 +102,23 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a message on the topic without copying it. The
+      /// publisher keeps a reference to the message, which is serialized
+      /// once and shared by all the subscribers. The message must not be
+      /// modified after this call. This is the preferred way to publish
+      /// large messages, such as images and point clouds.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      /// \sa Publish(M, bool)
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                  bool _block = false)
+              {
+                this->PublishImpl(boost::const_pointer_cast<
+                    typename std::remove_const<M>::type>(_message), _block);
+              }
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +165,25 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for messages that are not copied.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(MessagePtr _message, bool _block);
+
+      /// \brief Check whether a message can be published now. Fails if the
+      /// message has the wrong type or is not initialized, or if the
+      /// publisher is throttled.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message should be published.
+      private: bool CheckPublish(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message for publication.
+      /// \param[in] _message Message to publish. It is not copied.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void QueueMessage(MessagePtr _message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <signal.h>
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/SharedMemoryRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief Identifies a gazebo shared memory ring.
+static const uint64_t kRingMagic = 0x474a5348524e4731ULL;
+
+/// \brief Version of the ring layout.
+static const uint32_t kRingVersion = 1;
+
+/// \brief Alignment of the slots, a cache line.
+static const size_t kSlotAlignment = 64;
+
+/// \brief Frame holding the sequence number of a message of the ring.
+static const char kRingFrame = 'r';
+
+/// \brief Frame holding the data of a message.
+static const char kDataFrame = 'd';
+
+/// \brief Prefix of the segment names, followed by the pid of the reader.
+static const char kNamePrefix[] = "gazebo_shm_";
+
+/// \brief Reply of a publisher that writes to the ring. A serialized
+/// message never starts with a null byte, since 0 is not a valid field
+/// number, so replies can't be mistaken for messages.
+static const std::string kAcceptedReply("\0shm", 4);
+
+/// \brief Reply of a publisher that could not open the ring.
+static const std::string kRefusedReply("\0tcp", 4);
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \brief Header at the start of a ring segment.
+    class SharedMemoryRingHeader
+    {
+      /// \brief kRingMagic.
+      public: uint64_t magic;
+
+      /// \brief kRingVersion.
+      public: uint32_t version;
+
+      /// \brief Number of slots.
+      public: uint32_t slotCount;
+
+      /// \brief Maximum size of a message.
+      public: uint64_t slotSize;
+
+      /// \brief Last sequence number read by the reader.
+      public: std::atomic<uint64_t> readSeq;
+    };
+
+    /// \brief Header of a slot, followed by the message data.
+    class SharedMemoryRingSlot
+    {
+      /// \brief Sequence number of the message in the slot, 0 while the
+      /// slot is written.
+      public: std::atomic<uint64_t> seq;
+
+      /// \brief Size of the message.
+      public: uint64_t size;
+    };
+
+    /// \internal
+    /// \brief Private data for SharedMemoryRing
+    class SharedMemoryRingPrivate
+    {
+      /// \brief Get the header of a slot.
+      /// \param[in] _seq Sequence number stored in the slot.
+      /// \return Slot header.
+      public: SharedMemoryRingSlot *Slot(const uint64_t _seq) const
+              {
+                return reinterpret_cast<SharedMemoryRingSlot *>(
+                    this->slots + (_seq % this->header->slotCount) *
+                    this->slotStride);
+              }
+
+      /// \brief Name of the segment.
+      public: std::string name;
+
+      /// \brief True if this object created the segment, and its name has
+      /// not been removed yet.
+      public: bool owner = false;
+
+      /// \brief Mapping of the segment.
+      public: boost::interprocess::mapped_region region;
+
+      /// \brief Ring header, at the start of the mapping.
+      public: SharedMemoryRingHeader *header = nullptr;
+
+      /// \brief First slot.
+      public: char *slots = nullptr;
+
+      /// \brief Distance between two slots, in bytes.
+      public: size_t slotStride = 0;
+
+      /// \brief Last sequence number written.
+      public: uint64_t writeSeq = 0;
+
+      /// \brief Serializes writers.
+      public: std::mutex writeMutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the distance between two slots.
+/// \param[in] _slotSize Maximum size of a message.
+/// \return Slot stride in bytes.
+static size_t SlotStride(const size_t _slotSize)
+{
+  size_t size = sizeof(SharedMemoryRingSlot) + _slotSize;
+  return (size + kSlotAlignment - 1) / kSlotAlignment * kSlotAlignment;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the offset of the first slot.
+/// \return Offset in bytes.
+static size_t SlotsOffset()
+{
+  return (sizeof(SharedMemoryRingHeader) + kSlotAlignment - 1) /
+    kSlotAlignment * kSlotAlignment;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove the segments left by readers that are no longer running,
+/// for example after a crash. The name of a segment is only removed once
+/// the publisher has opened it, see SharedMemoryRing::Unlink.
+static void RemoveStaleRings()
+{
+#ifndef _WIN32
+  boost::system::error_code ec;
+  boost::filesystem::directory_iterator iter("/dev/shm", ec), end;
+  for (; !ec && iter != end; iter.increment(ec))
+  {
+    std::string name = iter->path().filename().string();
+    if (name.compare(0, sizeof(kNamePrefix) - 1, kNamePrefix) != 0)
+      continue;
+
+    char *pidEnd = nullptr;
+    const char *pidStart = name.c_str() + sizeof(kNamePrefix) - 1;
+    long pid = strtol(pidStart, &pidEnd, 10);
+    if (pidEnd == pidStart || *pidEnd != '_' || pid <= 0 || pid == getpid())
+      continue;
+
+    if (kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH)
+    {
+      gzlog << "Removing stale shared memory ring [" << name << "]\n";
+      boost::interprocess::shared_memory_object::remove(name.c_str());
+    }
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+SharedMemoryRing::SharedMemoryRing()
+  : dataPtr(new SharedMemoryRingPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemoryRing::~SharedMemoryRing()
+{
+  this->Unlink();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Create(const size_t _slotSize,
+    const unsigned int _slotCount)
+{
+  if (!this->dataPtr->name.empty())
+  {
+    gzerr << "Shared memory ring [" << this->dataPtr->name
+          << "] is already open\n";
+    return false;
+  }
+
+  if (_slotSize == 0 || _slotCount == 0)
+  {
+    gzerr << "Invalid shared memory ring size [" << _slotCount << " x "
+          << _slotSize << "]\n";
+    return false;
+  }
+
+  RemoveStaleRings();
+
+  // The name must not collide with a ring of another process, on this host
+  // or on another one. It holds the pid of the reader, so that the segment
+  // can be removed if the reader dies before calling Unlink.
+  std::random_device device;
+  std::ostringstream stream;
+  stream << kNamePrefix;
+#ifndef _WIN32
+  stream << getpid() << "_";
+#endif
+  stream << std::hex << std::setfill('0')
+         << std::setw(8) << device() << std::setw(8) << device()
+         << std::setw(8) << device();
+  std::string name = stream.str();
+
+  size_t stride = SlotStride(_slotSize);
+  size_t size = SlotsOffset() + stride * _slotCount;
+
+  try
+  {
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::create_only, name.c_str(),
+        boost::interprocess::read_write);
+    this->dataPtr->name = name;
+    this->dataPtr->owner = true;
+
+    shm.truncate(size);
+    boost::interprocess::mapped_region region(shm,
+        boost::interprocess::read_write);
+    this->dataPtr->region.swap(region);
+  }
+  catch(const boost::interprocess::interprocess_exception &_e)
+  {
+    gzerr << "Unable to create shared memory ring [" << name << "]: "
+          << _e.what() << "\n";
+    return false;
+  }
+
+  char *base = static_cast<char *>(this->dataPtr->region.get_address());
+
+  auto header = new (base) SharedMemoryRingHeader;
+  header->magic = kRingMagic;
+  header->version = kRingVersion;
+  header->slotCount = _slotCount;
+  header->slotSize = _slotSize;
+  header->readSeq.store(0);
+
+  this->dataPtr->header = header;
+  this->dataPtr->slots = base + SlotsOffset();
+  this->dataPtr->slotStride = stride;
+
+  for (unsigned int i = 0; i < _slotCount; ++i)
+  {
+    auto slot = new (this->dataPtr->slots + i * stride) SharedMemoryRingSlot;
+    slot->seq.store(0);
+    slot->size = 0;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Open(const std::string &_name)
+{
+  if (!this->dataPtr->name.empty())
+  {
+    gzerr << "Shared memory ring [" << this->dataPtr->name
+          << "] is already open\n";
+    return false;
+  }
+
+  try
+  {
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::open_only, _name.c_str(),
+        boost::interprocess::read_write);
+    boost::interprocess::mapped_region region(shm,
+        boost::interprocess::read_write);
+    this->dataPtr->region.swap(region);
+  }
+  catch(const boost::interprocess::interprocess_exception &)
+  {
+    // The segment is on another host.
+    return false;
+  }
+
+  char *base = static_cast<char *>(this->dataPtr->region.get_address());
+  auto header = reinterpret_cast<SharedMemoryRingHeader *>(base);
+  size_t size = this->dataPtr->region.get_size();
+
+  if (size < SlotsOffset() || header->magic != kRingMagic ||
+      header->version != kRingVersion || header->slotCount == 0 ||
+      size < SlotsOffset() + SlotStride(header->slotSize) * header->slotCount)
+  {
+    gzerr << "Invalid shared memory ring [" << _name << "]\n";
+    boost::interprocess::mapped_region empty;
+    this->dataPtr->region.swap(empty);
+    return false;
+  }
+
+  this->dataPtr->name = _name;
+  this->dataPtr->header = header;
+  this->dataPtr->slots = base + SlotsOffset();
+  this->dataPtr->slotStride = SlotStride(header->slotSize);
+  this->dataPtr->writeSeq = header->readSeq.load();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryRing::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+size_t SharedMemoryRing::SlotSize() const
+{
+  return this->dataPtr->header ? this->dataPtr->header->slotSize : 0;
+}
+
+/////////////////////////////////////////////////
+unsigned int SharedMemoryRing::SlotCount() const
+{
+  return this->dataPtr->header ? this->dataPtr->header->slotCount : 0;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Write(const std::string &_data, uint64_t &_seq)
+{
+  SharedMemoryRingHeader *header = this->dataPtr->header;
+  if (!header || _data.size() > header->slotSize)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+  uint64_t seq = this->dataPtr->writeSeq + 1;
+
+  // The slot still holds a message that has not been read
+  if (seq - header->readSeq.load(std::memory_order_acquire) >
+      header->slotCount)
+  {
+    return false;
+  }
+
+  SharedMemoryRingSlot *slot = this->dataPtr->Slot(seq);
+  slot->seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->size = _data.size();
+  memcpy(reinterpret_cast<char *>(slot) + sizeof(SharedMemoryRingSlot),
+      _data.data(), _data.size());
+
+  slot->seq.store(seq, std::memory_order_release);
+
+  this->dataPtr->writeSeq = seq;
+  _seq = seq;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Read(const uint64_t _seq, const char *&_data,
+    size_t &_size) const
+{
+  SharedMemoryRingHeader *header = this->dataPtr->header;
+  if (!header || _seq == 0)
+    return false;
+
+  SharedMemoryRingSlot *slot = this->dataPtr->Slot(_seq);
+  if (slot->seq.load(std::memory_order_acquire) != _seq ||
+      slot->size > header->slotSize)
+  {
+    return false;
+  }
+
+  _data = reinterpret_cast<const char *>(slot) + sizeof(SharedMemoryRingSlot);
+  _size = slot->size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryRing::Release(const uint64_t _seq)
+{
+  SharedMemoryRingHeader *header = this->dataPtr->header;
+  if (!header || _seq == 0)
+    return;
+
+  // Only move the read sequence forward, a message released late must not
+  // give back the slots of the messages released after it.
+  uint64_t readSeq = header->readSeq.load(std::memory_order_relaxed);
+  while (readSeq < _seq && !header->readSeq.compare_exchange_weak(readSeq,
+        _seq, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryRing::WriteFrame(const std::string &_data)
+{
+  std::string frame;
+  uint64_t seq;
+  if (this->Write(_data, seq))
+  {
+    frame.resize(1 + sizeof(seq));
+    frame[0] = kRingFrame;
+    memcpy(&frame[1], &seq, sizeof(seq));
+  }
+  else
+  {
+    frame.reserve(1 + _data.size());
+    frame += kDataFrame;
+    frame += _data;
+  }
+  return frame;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::ReadFrame(const std::string &_frame,
+    const char *&_data, size_t &_size, uint64_t &_seq) const
+{
+  if (_frame.empty())
+    return false;
+
+  if (_frame[0] == kDataFrame)
+  {
+    _data = _frame.data() + 1;
+    _size = _frame.size() - 1;
+    _seq = 0;
+    return true;
+  }
+
+  uint64_t seq;
+  if (_frame[0] != kRingFrame || _frame.size() != 1 + sizeof(seq))
+  {
+    gzerr << "Invalid frame on shared memory ring [" << this->dataPtr->name
+          << "]\n";
+    return false;
+  }
+
+  memcpy(&seq, &_frame[1], sizeof(seq));
+  if (!this->Read(seq, _data, _size))
+  {
+    gzwarn << "Message [" << seq << "] of shared memory ring ["
+           << this->dataPtr->name << "] was overwritten\n";
+    return false;
+  }
+  _seq = seq;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryRing::Unlink()
+{
+  // The mapping stays valid in the other process after the name is removed.
+  if (this->dataPtr->owner)
+  {
+    boost::interprocess::shared_memory_object::remove(
+        this->dataPtr->name.c_str());
+    this->dataPtr->owner = false;
+  }
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryRing::Reply(const bool _accepted)
+{
+  return _accepted ? kAcceptedReply : kRefusedReply;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::ParseReply(const std::string &_msg, bool &_accepted)
+{
+  if (_msg == kAcceptedReply)
+    _accepted = true;
+  else if (_msg == kRefusedReply)
+    _accepted = false;
+  else
+    return false;
+  return true;
+}
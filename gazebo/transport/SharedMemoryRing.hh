@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHAREDMEMORYRING_HH_
+#define GAZEBO_TRANSPORT_SHAREDMEMORYRING_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class
+    class SharedMemoryRingPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class SharedMemoryRing SharedMemoryRing.hh transport/transport.hh
+    /// \brief A ring of fixed-size message slots in a named shared memory
+    /// segment, written by one process and read by another one on the same
+    /// host.
+    ///
+    /// The reader creates the segment, and removes its name once the
+    /// writer has opened it. The writer opens it by name. Segments left by
+    /// a reader that died are removed by the next one. Each message written
+    /// gets the next sequence number, and is stored in slot (sequence % slot
+    /// count). The reader reports the last sequence number it has released,
+    /// so that the writer never overwrites a slot that has not been
+    /// released. Write fails instead, and the caller sends the message by
+    /// other means.
+    class GZ_TRANSPORT_VISIBLE SharedMemoryRing
+    {
+      /// \brief Constructor.
+      public: SharedMemoryRing();
+
+      /// \brief Destructor. Removes the segment if it was created by this
+      /// object.
+      public: virtual ~SharedMemoryRing();
+
+      /// \brief Create a new segment, as the reader of the ring.
+      /// \param[in] _slotSize Maximum size of a message, in bytes.
+      /// \param[in] _slotCount Number of slots.
+      /// \return True on success.
+      public: bool Create(const size_t _slotSize,
+                          const unsigned int _slotCount);
+
+      /// \brief Open a segment created by another process, as the writer of
+      /// the ring.
+      /// \param[in] _name Name of the segment.
+      /// \return True on success.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Get the name of the segment.
+      /// \return Name of the segment, empty if none is open.
+      public: std::string Name() const;
+
+      /// \brief Get the maximum size of a message.
+      /// \return Slot size in bytes.
+      public: size_t SlotSize() const;
+
+      /// \brief Get the number of slots.
+      /// \return Number of slots.
+      public: unsigned int SlotCount() const;
+
+      /// \brief Write a message in the next slot.
+      /// \param[in] _data Message data.
+      /// \param[out] _seq Sequence number of the message.
+      /// \return False if the message does not fit in a slot, or if the
+      /// next slot has not been read yet.
+      public: bool Write(const std::string &_data, uint64_t &_seq);
+
+      /// \brief Get a message in place, without copying it out of its slot.
+      /// \param[in] _seq Sequence number of the message.
+      /// \param[out] _data Start of the message data, valid until the
+      /// message is released.
+      /// \param[out] _size Size of the message.
+      /// \return False if the slot does not hold that message.
+      /// \sa Release
+      public: bool Read(const uint64_t _seq, const char *&_data,
+                        size_t &_size) const;
+
+      /// \brief Release the slot of a message and of every message before
+      /// it, so that the writer can reuse them.
+      /// \param[in] _seq Sequence number of the message, 0 does nothing.
+      public: void Release(const uint64_t _seq);
+
+      /// \brief Encode a message to send over a connection whose subscriber
+      /// reads this ring. The message is written to the ring when possible,
+      /// and the frame only holds its sequence number. Otherwise the frame
+      /// holds the message data.
+      /// \param[in] _data Message data.
+      /// \return Frame to send over the connection.
+      public: std::string WriteFrame(const std::string &_data);
+
+      /// \brief Decode a frame created by WriteFrame.
+      /// \param[in] _frame Frame received over the connection.
+      /// \param[out] _data Start of the message data, in the ring or in
+      /// _frame.
+      /// \param[out] _size Size of the message.
+      /// \param[out] _seq Sequence number to release once the message has
+      /// been handled, 0 if the message is held by _frame.
+      /// \return False if the frame is invalid, or if the message was lost.
+      public: bool ReadFrame(const std::string &_frame, const char *&_data,
+                             size_t &_size, uint64_t &_seq) const;
+
+      /// \brief Remove the name of a segment created by this object. The
+      /// writer keeps its mapping, and the segment is freed once both
+      /// processes have unmapped it. Called by the destructor.
+      public: void Unlink();
+
+      /// \brief Get the first message a publisher sends to a subscriber
+      /// that requested a ring.
+      /// \param[in] _accepted True if the publisher opened the ring.
+      /// \return The message.
+      public: static std::string Reply(const bool _accepted);
+
+      /// \brief Parse a message created by Reply.
+      /// \param[in] _msg First message received from the publisher.
+      /// \param[out] _accepted True if the publisher opened the ring.
+      /// \return False if _msg is not a reply, which happens when the
+      /// publisher does not know about rings. _msg is then a published
+      /// message.
+      public: static bool ParseReply(const std::string &_msg,
+                                     bool &_accepted);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SharedMemoryRingPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/SharedMemoryRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SharedMemoryRing : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, WriteRead)
+{
+  transport::SharedMemoryRing reader;
+  ASSERT_TRUE(reader.Create(16, 2));
+  EXPECT_FALSE(reader.Name().empty());
+  EXPECT_EQ(16u, reader.SlotSize());
+  EXPECT_EQ(2u, reader.SlotCount());
+
+  transport::SharedMemoryRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+  EXPECT_EQ(16u, writer.SlotSize());
+  EXPECT_EQ(2u, writer.SlotCount());
+
+  uint64_t seq1, seq2, seq3;
+  EXPECT_TRUE(writer.Write("hello", seq1));
+  EXPECT_TRUE(writer.Write("world", seq2));
+
+  // The ring is full until a message is read
+  EXPECT_FALSE(writer.Write("full", seq3));
+
+  // Too large for a slot
+  EXPECT_FALSE(writer.Write(std::string(17, 'a'), seq3));
+
+  // Messages are read in place, and their slot is only reused once
+  // released
+  const char *data;
+  size_t size;
+  EXPECT_TRUE(reader.Read(seq1, data, size));
+  EXPECT_EQ("hello", std::string(data, size));
+  EXPECT_FALSE(writer.Write("again", seq3));
+  EXPECT_EQ("hello", std::string(data, size));
+  reader.Release(seq1);
+
+  EXPECT_TRUE(writer.Write("again", seq3));
+  EXPECT_TRUE(reader.Read(seq2, data, size));
+  EXPECT_EQ("world", std::string(data, size));
+  EXPECT_TRUE(reader.Read(seq3, data, size));
+  EXPECT_EQ("again", std::string(data, size));
+
+  // Releasing a message releases the ones before it
+  reader.Release(seq3);
+  uint64_t seq4, seq5;
+  EXPECT_TRUE(writer.Write("one", seq4));
+  EXPECT_TRUE(writer.Write("two", seq5));
+
+  // The slot of the first message was reused
+  EXPECT_FALSE(reader.Read(seq1, data, size));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, Frames)
+{
+  transport::SharedMemoryRing reader;
+  ASSERT_TRUE(reader.Create(16, 1));
+  transport::SharedMemoryRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+
+  // Written to the ring, the frame only holds the sequence number
+  std::string small(16, 's');
+  std::string frame1 = writer.WriteFrame(small);
+  EXPECT_LT(frame1.size(), small.size());
+
+  // The ring is full, the frame holds the data
+  std::string frame2 = writer.WriteFrame("full");
+  EXPECT_GT(frame2.size(), 4u);
+
+  // Too large for the ring
+  std::string large(1024, 'l');
+  std::string frame3 = writer.WriteFrame(large);
+  EXPECT_GT(frame3.size(), large.size());
+
+  const char *data;
+  size_t size;
+  uint64_t seq;
+  EXPECT_TRUE(reader.ReadFrame(frame1, data, size, seq));
+  EXPECT_EQ(small, std::string(data, size));
+  EXPECT_NE(0u, seq);
+  reader.Release(seq);
+
+  // Messages held by the frame have nothing to release
+  EXPECT_TRUE(reader.ReadFrame(frame2, data, size, seq));
+  EXPECT_EQ("full", std::string(data, size));
+  EXPECT_EQ(0u, seq);
+  EXPECT_TRUE(reader.ReadFrame(frame3, data, size, seq));
+  EXPECT_EQ(large, std::string(data, size));
+  EXPECT_EQ(0u, seq);
+
+  EXPECT_FALSE(reader.ReadFrame("", data, size, seq));
+  EXPECT_FALSE(reader.ReadFrame("x", data, size, seq));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, Reply)
+{
+  bool accepted = false;
+  EXPECT_TRUE(transport::SharedMemoryRing::ParseReply(
+        transport::SharedMemoryRing::Reply(true), accepted));
+  EXPECT_TRUE(accepted);
+  EXPECT_TRUE(transport::SharedMemoryRing::ParseReply(
+        transport::SharedMemoryRing::Reply(false), accepted));
+  EXPECT_FALSE(accepted);
+
+  // A message sent by a publisher that does not know about rings, even
+  // one that reads like the name of a reply, is not a reply.
+  msgs::GzString msg;
+  msg.set_data("shm");
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+  EXPECT_FALSE(transport::SharedMemoryRing::ParseReply(data, accepted));
+  EXPECT_FALSE(transport::SharedMemoryRing::ParseReply("shm", accepted));
+  EXPECT_FALSE(transport::SharedMemoryRing::ParseReply("tcp", accepted));
+  EXPECT_FALSE(transport::SharedMemoryRing::ParseReply("", accepted));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, Invalid)
+{
+  transport::SharedMemoryRing ring;
+  EXPECT_FALSE(ring.Create(0, 4));
+  EXPECT_FALSE(ring.Create(16, 0));
+
+  // A ring created on another host can't be opened
+  EXPECT_FALSE(ring.Open("gazebo_shm_does_not_exist"));
+  EXPECT_TRUE(ring.Name().empty());
+
+  uint64_t seq;
+  const char *data;
+  size_t size;
+  EXPECT_FALSE(ring.Write("data", seq));
+  EXPECT_FALSE(ring.Read(1, data, size));
+
+  // The name of a closed ring can't be opened
+  std::string name;
+  {
+    transport::SharedMemoryRing reader;
+    ASSERT_TRUE(reader.Create(16, 1));
+    name = reader.Name();
+  }
+  EXPECT_FALSE(ring.Open(name));
+
+  // Nor can the name of an unlinked ring, which stays usable by the
+  // writer that opened it before.
+  transport::SharedMemoryRing reader;
+  ASSERT_TRUE(reader.Create(16, 1));
+  transport::SharedMemoryRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+  reader.Unlink();
+  EXPECT_FALSE(ring.Open(reader.Name()));
+  EXPECT_TRUE(writer.Write("data", seq));
+  EXPECT_TRUE(reader.Read(seq, data, size));
+  EXPECT_EQ("data", std::string(data, size));
+}
+
+#ifndef _WIN32
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, StaleRings)
+{
+  // A segment left by a reader that is no longer running
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    close(fds[0]);
+    transport::SharedMemoryRing reader;
+    if (!reader.Create(16, 1))
+      _exit(1);
+    std::string created = reader.Name();
+    if (write(fds[1], created.c_str(), created.size()) !=
+        static_cast<ssize_t>(created.size()))
+    {
+      _exit(1);
+    }
+    // Leave without running the destructor, as after a crash
+    _exit(0);
+  }
+  close(fds[1]);
+
+  std::string name;
+  char buffer[64];
+  ssize_t count;
+  while ((count = read(fds[0], buffer, sizeof(buffer))) > 0)
+    name.append(buffer, count);
+  close(fds[0]);
+
+  int status;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+  ASSERT_FALSE(name.empty());
+
+  transport::SharedMemoryRing ring;
+  EXPECT_TRUE(ring.Open(name));
+
+  // Creating a ring removes it
+  transport::SharedMemoryRing reader;
+  ASSERT_TRUE(reader.Create(16, 1));
+  transport::SharedMemoryRing other;
+  EXPECT_FALSE(other.Open(name));
+}
+#endif
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
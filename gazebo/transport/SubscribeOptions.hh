@@ -39,6 +39,13 @@ namespace gazebo
               : latching(false)
               {}
 
+      /// \brief Default maximum size of a message sent through shared
+      /// memory, in bytes.
+      public: static const size_t kDefaultShmSlotSize = 8 * 1024 * 1024;
+
+      /// \brief Default number of messages in a shared memory ring.
+      public: static const unsigned int kDefaultShmSlotCount = 4;
+
       /// \brief Initialize the options
       /// \param[in] _topic Topic we're subscribing to
       /// \param[in,out] _node The associated node
@@ -103,10 +110,57 @@ namespace gazebo
                 return this->latching;
               }
 
+      /// \brief Receive the messages of remote publishers through a shared
+      /// memory ring when they run on the same host, instead of through
+      /// their TCP connection. Messages larger than a slot, or sent while
+      /// the ring is full, still go through the connection.
+      /// \param[in] _enabled True to use shared memory.
+      /// \param[in] _slotSize Maximum size of a message in the ring.
+      /// \param[in] _slotCount Number of messages in the ring.
+      public: void SetSharedMemory(const bool _enabled,
+                  const size_t _slotSize = kDefaultShmSlotSize,
+                  const unsigned int _slotCount = kDefaultShmSlotCount)
+              {
+                this->sharedMemory = _enabled;
+                this->shmSlotSize = _slotSize;
+                this->shmSlotCount = _slotCount;
+              }
+
+      /// \brief Get whether shared memory is used for local publishers.
+      /// \return True if shared memory is used.
+      /// \sa SetSharedMemory
+      public: bool SharedMemory() const
+              {
+                return this->sharedMemory;
+              }
+
+      /// \brief Get the maximum size of a message in the shared memory ring.
+      /// \return Slot size in bytes.
+      public: size_t SharedMemorySlotSize() const
+              {
+                return this->shmSlotSize;
+              }
+
+      /// \brief Get the number of messages in the shared memory ring.
+      /// \return Slot count.
+      public: unsigned int SharedMemorySlotCount() const
+              {
+                return this->shmSlotCount;
+              }
+
       private: std::string topic;
       private: std::string msgType;
       private: NodePtr node;
       private: bool latching;
+
+      /// \brief True to use shared memory for local publishers.
+      private: bool sharedMemory = false;
+
+      /// \brief Maximum size of a message in the shared memory ring.
+      private: size_t shmSlotSize = kDefaultShmSlotSize;
+
+      /// \brief Number of messages in the shared memory ring.
+      private: unsigned int shmSlotCount = kDefaultShmSlotCount;
     };
     /// \}
   }
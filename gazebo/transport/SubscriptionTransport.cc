@@ -43,19 +43,55 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitSharedMemory(const std::string &_name)
+{
+  std::unique_ptr<SharedMemoryRing> newRing(new SharedMemoryRing);
+  bool accepted = newRing->Open(_name);
+  if (accepted)
+    this->ring = std::move(newRing);
+
+  this->connection->EnqueueMsg(SharedMemoryRing::Reply(accepted));
+  return accepted;
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
-  std::string data;
-  _newMsg->SerializeToString(&data);
+  auto data = std::make_shared<std::string>();
+  _newMsg->SerializeToString(data.get());
   using namespace boost::placeholders;
-  return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  return this->HandleBuffer(data, boost::bind(&dummy_callback_fn, _1), 0);
 }
 
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
+  bool result = false;
+  if (this->connection->IsOpen())
+  {
+    if (this->ring)
+      this->connection->EnqueueMsg(this->ring->WriteFrame(_newdata), _cb, _id);
+    else
+      this->connection->EnqueueMsg(_newdata, _cb, _id);
+    result = true;
+  }
+  else
+    this->connection.reset();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleBuffer(
+    const std::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  // Messages written to the ring don't use the shared buffer
+  if (this->ring)
+    return this->HandleData(*_newdata, _cb, _id);
+
   bool result = false;
   if (this->connection->IsOpen())
   {
@@ -19,10 +19,12 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "SharedMemoryRing.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -50,6 +52,14 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Answer the request of a subscriber to receive messages
+      /// through a shared memory ring. The ring is only used when it can be
+      /// opened, that is when the subscriber runs on the same host. The
+      /// answer must be the first message sent over the connection.
+      /// \param[in] _name Name of the ring created by the subscriber.
+      /// \return True if messages are written to the ring.
+      public: bool InitSharedMemory(const std::string &_name);
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -59,6 +69,19 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      /// \brief Output a shared message buffer to a connection. Large
+      /// buffers are written to the socket without being copied. The
+      /// buffer is shared with every other callback of the publication and
+      /// must not be modified.
+      /// \param[in] _newdata The message to be handled
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleBuffer(
+                  const std::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -72,6 +95,10 @@ namespace gazebo
       public: virtual bool IsLocal() const;
 
       private: ConnectionPtr connection;
+
+      /// \brief Shared memory ring of the subscriber, nullptr if messages
+      /// are sent over the connection.
+      private: std::unique_ptr<SharedMemoryRing> ring;
     };
     /// \}
   }
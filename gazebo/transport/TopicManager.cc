@@ -71,6 +71,7 @@ void TopicManager::Init()
   this->advertisedTopics.clear();
   this->advertisedTopicsEnd = this->advertisedTopics.end();
   this->subscribedNodes.clear();
+  this->sharedMemoryTopics.clear();
   this->nodes.clear();
 }
 
@@ -91,6 +92,7 @@ void TopicManager::Fini()
   this->advertisedTopics.clear();
   this->advertisedTopicsEnd = this->advertisedTopics.end();
   this->subscribedNodes.clear();
+  this->sharedMemoryTopics.clear();
   this->nodes.clear();
 }
 
@@ -232,6 +234,15 @@ SubscriberPtr TopicManager::Subscribe(const SubscribeOptions &_ops)
   // topic
   this->subscribedNodes[_ops.GetTopic()].push_back(_ops.GetNode());
 
+  // Connections to remote publishers are shared by all the subscriptions of
+  // a topic, so one subscription requesting shared memory enables it for
+  // the new connections of the topic.
+  if (_ops.SharedMemory())
+  {
+    this->sharedMemoryTopics[_ops.GetTopic()] = std::make_pair(
+        _ops.SharedMemorySlotSize(), _ops.SharedMemorySlotCount());
+  }
+
   // The object that gets returned to the caller of this
   // function
   SubscriberPtr sub(new Subscriber(_ops.GetTopic(), _ops.GetNode()));
@@ -358,6 +369,13 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
         }
       }
 
+      auto shmIter = this->sharedMemoryTopics.find(_pub.topic());
+      if (shmIter != this->sharedMemoryTopics.end())
+      {
+        publink->RequestSharedMemory(shmIter->second.first,
+            shmIter->second.second);
+      }
+
       publink->Init(conn, latched);
 
       publication->AddTransport(publink);
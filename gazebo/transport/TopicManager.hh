@@ -24,6 +24,7 @@
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <map>
+#include <utility>
 #include <list>
 #include <string>
 #include <vector>
@@ -254,6 +255,12 @@ namespace gazebo
       private: PublicationPtr_M advertisedTopics;
       private: PublicationPtr_M::iterator advertisedTopicsEnd;
       private: SubNodeMap subscribedNodes;
+
+      /// \brief Slot size and slot count of the shared memory rings of the
+      /// subscribed topics that requested shared memory. Protected by
+      /// subscriberMutex.
+      private: std::map<std::string, std::pair<size_t, unsigned int> >
+               sharedMemoryTopics;
       private: std::vector<NodePtr> nodes;
 
       /// \brief Nodes that require processing.
@@ -0,0 +1,738 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogBinary.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Magic number at the start of a binary log.
+static const char kLogMagic[] = "GZBLOG01";
+
+/// \brief Magic number at the end of a binary log with an index.
+static const char kIndexMagic[] = "GZBIDX01";
+
+/// \brief Size of the magic numbers.
+static const size_t kMagicSize = 8;
+
+/// \brief Record holding a complete frame.
+static const uint8_t kKeyframeRecord = 1;
+
+/// \brief Record holding a frame as a delta against the keyframe.
+static const uint8_t kDeltaRecord = 2;
+
+/// \brief Record holding the block index.
+static const uint8_t kIndexRecord = 3;
+
+/// \brief Size of a record header: type, time flag, seconds, nanoseconds
+/// and payload size.
+static const size_t kRecordHeaderSize = 14;
+
+/// \brief Size of a block in the index.
+static const size_t kIndexEntrySize = 37;
+
+/// \brief Size of the trailer: index offset and magic number.
+static const size_t kTrailerSize = 8 + kMagicSize;
+
+/// \brief Beginning of a frame.
+static const std::string kStartFrame = "<sdf ";
+
+/// \brief End of a frame.
+static const std::string kEndFrame = "</sdf>";
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Private data for LogBinaryWriter
+    class LogBinaryWriterPrivate
+    {
+      /// \brief Maximum number of frames in a block.
+      public: unsigned int keyframeInterval = 100;
+
+      /// \brief Keyframe of the current block.
+      public: std::string keyframe;
+
+      /// \brief Offsets of the XML tokens of the keyframe.
+      public: std::vector<size_t> keyframeTokens;
+
+      /// \brief Blocks written so far.
+      public: std::vector<LogBinaryBlock> blocks;
+
+      /// \brief Number of bytes produced since Start.
+      public: uint64_t offset = 0;
+
+      /// \brief True once Finish has been called.
+      public: bool finished = false;
+
+      /// \brief Scratch space for the frame tokens.
+      public: std::vector<size_t> frameTokens;
+
+      /// \brief Scratch space for deltas.
+      public: std::string delta;
+    };
+
+    /// \internal
+    /// \brief Private data for LogBinaryReader
+    class LogBinaryReaderPrivate
+    {
+      /// \brief The open log file.
+      public: std::ifstream file;
+
+      /// \brief XML header of the log.
+      public: std::string header;
+
+      /// \brief Blocks of the log.
+      public: std::vector<LogBinaryBlock> blocks;
+
+      /// \brief True if the index was read from the log.
+      public: bool indexed = false;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Append an unsigned integer in little endian order.
+/// \param[out] _buffer Buffer to append to.
+/// \param[in] _value Value to append.
+/// \param[in] _bytes Number of bytes to use.
+static void AppendUint(std::string &_buffer, const uint64_t _value,
+    const unsigned int _bytes)
+{
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _buffer.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an unsigned integer stored in little endian order.
+/// \param[in] _data Data to read from.
+/// \param[in] _bytes Number of bytes to read.
+/// \return The value.
+static uint64_t ReadUint(const char *_data, const unsigned int _bytes)
+{
+  uint64_t value = 0;
+  for (unsigned int i = 0; i < _bytes; ++i)
+  {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(_data[i]))
+      << (8 * i);
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a variable length unsigned integer.
+/// \param[out] _buffer Buffer to append to.
+/// \param[in] _value Value to append.
+static void AppendVarint(std::string &_buffer, uint64_t _value)
+{
+  while (_value >= 0x80)
+  {
+    _buffer.push_back(static_cast<char>((_value & 0x7F) | 0x80));
+    _value >>= 7;
+  }
+  _buffer.push_back(static_cast<char>(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a variable length unsigned integer.
+/// \param[in] _data Data to read from.
+/// \param[in,out] _pos Position in _data, moved past the value.
+/// \param[out] _value The value.
+/// \return False if _data ends before the value.
+static bool ReadVarint(const std::string &_data, size_t &_pos,
+    uint64_t &_value)
+{
+  _value = 0;
+  for (unsigned int shift = 0; _pos < _data.size() && shift < 64; shift += 7)
+  {
+    unsigned char byte = static_cast<unsigned char>(_data[_pos++]);
+    _value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Split a frame into XML tokens, each one starting at a '<'. The
+/// first token holds any text before the first '<'.
+/// \param[in] _frame Frame to split.
+/// \param[out] _offsets Offset of each token.
+static void Tokenize(const std::string &_frame, std::vector<size_t> &_offsets)
+{
+  _offsets.clear();
+  _offsets.push_back(0);
+  for (size_t pos = _frame.find('<', 1); pos != std::string::npos;
+       pos = _frame.find('<', pos + 1))
+  {
+    _offsets.push_back(pos);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the length of a token.
+/// \param[in] _offsets Token offsets.
+/// \param[in] _index Index of the token.
+/// \param[in] _size Size of the tokenized string.
+/// \return Length of the token.
+static size_t TokenLength(const std::vector<size_t> &_offsets,
+    const size_t _index, const size_t _size)
+{
+  size_t end = _index + 1 < _offsets.size() ? _offsets[_index + 1] : _size;
+  return end - _offsets[_index];
+}
+
+/////////////////////////////////////////////////
+/// \brief Encode a frame as a delta against a keyframe. Tokens are compared
+/// at the same index, which matches the layout of consecutive world states.
+/// The delta is a list of groups: the number of tokens to copy from the
+/// keyframe, then the length + 1 of a token that replaces the next
+/// keyframe token, followed by the token. A length of zero ends the delta.
+/// \param[in] _base Keyframe.
+/// \param[in] _baseTokens Token offsets of the keyframe.
+/// \param[in] _frame Frame to encode.
+/// \param[in,out] _frameTokens Scratch space for the frame tokens.
+/// \param[out] _delta The delta.
+static void EncodeDelta(const std::string &_base,
+    const std::vector<size_t> &_baseTokens, const std::string &_frame,
+    std::vector<size_t> &_frameTokens, std::string &_delta)
+{
+  _delta.clear();
+  Tokenize(_frame, _frameTokens);
+
+  uint64_t run = 0;
+  for (size_t i = 0; i < _frameTokens.size(); ++i)
+  {
+    size_t length = TokenLength(_frameTokens, i, _frame.size());
+    if (i < _baseTokens.size() &&
+        length == TokenLength(_baseTokens, i, _base.size()) &&
+        _frame.compare(_frameTokens[i], length, _base, _baseTokens[i],
+          length) == 0)
+    {
+      ++run;
+      continue;
+    }
+
+    AppendVarint(_delta, run);
+    AppendVarint(_delta, length + 1);
+    _delta.append(_frame, _frameTokens[i], length);
+    run = 0;
+  }
+
+  AppendVarint(_delta, run);
+  AppendVarint(_delta, 0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Decode a delta created by EncodeDelta.
+/// \param[in] _base Keyframe.
+/// \param[in] _baseTokens Token offsets of the keyframe.
+/// \param[in] _delta The delta.
+/// \param[out] _frame The decoded frame is appended to this.
+/// \return False if the delta is corrupted.
+static bool DecodeDelta(const std::string &_base,
+    const std::vector<size_t> &_baseTokens, const std::string &_delta,
+    std::string &_frame)
+{
+  size_t pos = 0;
+  size_t cursor = 0;
+  while (true)
+  {
+    uint64_t copy, length;
+    if (!ReadVarint(_delta, pos, copy) || cursor + copy > _baseTokens.size())
+      return false;
+
+    if (copy > 0)
+    {
+      size_t from = _baseTokens[cursor];
+      size_t to = cursor + copy < _baseTokens.size() ?
+        _baseTokens[cursor + copy] : _base.size();
+      _frame.append(_base, from, to - from);
+      cursor += copy;
+    }
+
+    if (!ReadVarint(_delta, pos, length))
+      return false;
+
+    if (length == 0)
+      return true;
+
+    if (pos + length - 1 > _delta.size())
+      return false;
+
+    _frame.append(_delta, pos, length - 1);
+    pos += length - 1;
+    ++cursor;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Compress data with zlib.
+/// \param[in] _data Data to compress.
+/// \param[out] _out Compressed data.
+static void Compress(const std::string &_data, std::string &_out)
+{
+  _out.clear();
+  boost::iostreams::filtering_ostream out;
+  out.push(boost::iostreams::zlib_compressor());
+  out.push(boost::iostreams::back_inserter(_out));
+  out.write(_data.data(), _data.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Decompress zlib data.
+/// \param[in] _data Data to decompress.
+/// \param[out] _out Decompressed data.
+/// \return False if the data could not be decompressed.
+static bool Decompress(const std::string &_data, std::string &_out)
+{
+  _out.clear();
+  try
+  {
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::make_iterator_range(_data));
+    boost::iostreams::copy(in, boost::iostreams::back_inserter(_out));
+  }
+  catch(const boost::iostreams::zlib_error &_e)
+  {
+    gzerr << "Unable to decompress binary log record: " << _e.what()
+          << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the simulation time of a frame.
+/// \param[in] _frame The frame.
+/// \param[out] _time The simulation time.
+/// \return False if the frame has no <sim_time>.
+static bool FrameTime(const std::string &_frame, common::Time &_time)
+{
+  static const std::string kStartTime = "<sim_time>";
+  static const std::string kEndTime = "</sim_time>";
+
+  auto from = _frame.find(kStartTime);
+  if (from == std::string::npos)
+    return false;
+
+  from += kStartTime.size();
+  auto to = _frame.find(kEndTime, from);
+  if (to == std::string::npos)
+    return false;
+
+  std::stringstream ss(_frame.substr(from, to - from));
+  ss >> _time;
+  return true;
+}
+
+/////////////////////////////////////////////////
+LogBinaryWriter::LogBinaryWriter()
+  : dataPtr(new LogBinaryWriterPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LogBinaryWriter::~LogBinaryWriter()
+{
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::Start(const std::string &_header, std::string &_buffer)
+{
+  this->dataPtr->keyframe.clear();
+  this->dataPtr->keyframeTokens.clear();
+  this->dataPtr->blocks.clear();
+  this->dataPtr->finished = false;
+
+  size_t size = _buffer.size();
+  _buffer.append(kLogMagic, kMagicSize);
+  AppendUint(_buffer, _header.size(), 4);
+  _buffer.append(_header);
+  this->dataPtr->offset = _buffer.size() - size;
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::AddFrames(const std::string &_data,
+    std::string &_buffer)
+{
+  if (this->dataPtr->finished)
+  {
+    gzerr << "Unable to add frames to a finished binary log" << std::endl;
+    return;
+  }
+
+  std::string payload;
+  size_t pos = 0;
+  while (true)
+  {
+    auto from = _data.find(kStartFrame, pos);
+    if (from == std::string::npos)
+      break;
+
+    auto to = _data.find(kEndFrame, from);
+    if (to == std::string::npos)
+    {
+      gzerr << "Incomplete <sdf> frame in log data" << std::endl;
+      break;
+    }
+    to += kEndFrame.size();
+    pos = to;
+
+    const std::string frame = _data.substr(from, to - from);
+
+    bool keyframe = this->dataPtr->blocks.empty() ||
+      this->dataPtr->blocks.back().frameCount >=
+      this->dataPtr->keyframeInterval;
+
+    // Use a new keyframe when the structure of the frame has changed too
+    // much, for example after the world description or an insertion.
+    if (!keyframe)
+    {
+      EncodeDelta(this->dataPtr->keyframe, this->dataPtr->keyframeTokens,
+          frame, this->dataPtr->frameTokens, this->dataPtr->delta);
+      keyframe = this->dataPtr->delta.size() * 2 > frame.size();
+    }
+
+    if (keyframe)
+    {
+      this->dataPtr->keyframe = frame;
+      Tokenize(this->dataPtr->keyframe, this->dataPtr->keyframeTokens);
+
+      LogBinaryBlock block;
+      block.offset = this->dataPtr->offset;
+      this->dataPtr->blocks.push_back(block);
+
+      Compress(frame, payload);
+    }
+    else
+    {
+      Compress(this->dataPtr->delta, payload);
+    }
+
+    LogBinaryBlock &block = this->dataPtr->blocks.back();
+    common::Time time;
+    bool hasTime = FrameTime(frame, time);
+    if (hasTime)
+    {
+      if (!block.hasTime)
+        block.startTime = time;
+      block.hasTime = true;
+      block.endTime = time;
+    }
+
+    _buffer.push_back(static_cast<char>(
+          keyframe ? kKeyframeRecord : kDeltaRecord));
+    _buffer.push_back(static_cast<char>(hasTime ? 1 : 0));
+    AppendUint(_buffer, static_cast<uint32_t>(time.sec), 4);
+    AppendUint(_buffer, static_cast<uint32_t>(time.nsec), 4);
+    AppendUint(_buffer, payload.size(), 4);
+    _buffer.append(payload);
+
+    block.frameCount++;
+    block.size += kRecordHeaderSize + payload.size();
+    this->dataPtr->offset += kRecordHeaderSize + payload.size();
+  }
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::Finish(std::string &_buffer)
+{
+  if (this->dataPtr->finished)
+    return;
+
+  const uint64_t indexOffset = this->dataPtr->offset;
+
+  _buffer.push_back(static_cast<char>(kIndexRecord));
+  AppendUint(_buffer, this->dataPtr->blocks.size(), 4);
+  for (auto const &block : this->dataPtr->blocks)
+  {
+    AppendUint(_buffer, block.offset, 8);
+    AppendUint(_buffer, block.size, 8);
+    AppendUint(_buffer, block.frameCount, 4);
+    _buffer.push_back(static_cast<char>(block.hasTime ? 1 : 0));
+    AppendUint(_buffer, static_cast<uint32_t>(block.startTime.sec), 4);
+    AppendUint(_buffer, static_cast<uint32_t>(block.startTime.nsec), 4);
+    AppendUint(_buffer, static_cast<uint32_t>(block.endTime.sec), 4);
+    AppendUint(_buffer, static_cast<uint32_t>(block.endTime.nsec), 4);
+  }
+
+  AppendUint(_buffer, indexOffset, 8);
+  _buffer.append(kIndexMagic, kMagicSize);
+
+  this->dataPtr->finished = true;
+}
+
+/////////////////////////////////////////////////
+void LogBinaryWriter::SetKeyframeInterval(const unsigned int _frames)
+{
+  this->dataPtr->keyframeInterval = std::max(_frames, 1u);
+}
+
+/////////////////////////////////////////////////
+unsigned int LogBinaryWriter::KeyframeInterval() const
+{
+  return this->dataPtr->keyframeInterval;
+}
+
+/////////////////////////////////////////////////
+const std::vector<LogBinaryBlock> &LogBinaryWriter::Blocks() const
+{
+  return this->dataPtr->blocks;
+}
+
+/////////////////////////////////////////////////
+LogBinaryReader::LogBinaryReader()
+  : dataPtr(new LogBinaryReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LogBinaryReader::~LogBinaryReader()
+{
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::IsBinaryLog(const std::string &_filename)
+{
+  std::ifstream file(_filename, std::ios::binary);
+  char magic[kMagicSize];
+  return file.read(magic, kMagicSize) &&
+    std::memcmp(magic, kLogMagic, kMagicSize) == 0;
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::Open(const std::string &_filename)
+{
+  this->dataPtr->header.clear();
+  this->dataPtr->blocks.clear();
+  this->dataPtr->indexed = false;
+
+  auto &file = this->dataPtr->file;
+  if (file.is_open())
+    file.close();
+  file.clear();
+
+  file.open(_filename, std::ios::binary);
+  if (!file)
+  {
+    gzerr << "Unable to open binary log[" << _filename << "]" << std::endl;
+    return false;
+  }
+
+  file.seekg(0, std::ios::end);
+  const uint64_t fileSize = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  // Header
+  char buf[kIndexEntrySize];
+  if (!file.read(buf, kMagicSize + 4) ||
+      std::memcmp(buf, kLogMagic, kMagicSize) != 0)
+  {
+    gzerr << "File[" << _filename << "] is not a binary log" << std::endl;
+    return false;
+  }
+
+  const uint64_t headerSize = ReadUint(buf + kMagicSize, 4);
+  if (kMagicSize + 4 + headerSize > fileSize)
+  {
+    gzerr << "Binary log[" << _filename << "] has a truncated header"
+          << std::endl;
+    return false;
+  }
+  this->dataPtr->header.resize(headerSize);
+  file.read(&this->dataPtr->header[0], headerSize);
+  const uint64_t dataOffset = kMagicSize + 4 + headerSize;
+
+  // Index, found through the trailer
+  if (fileSize >= dataOffset + 1 + 4 + kTrailerSize)
+  {
+    file.seekg(fileSize - kTrailerSize);
+    if (file.read(buf, kTrailerSize) &&
+        std::memcmp(buf + 8, kIndexMagic, kMagicSize) == 0)
+    {
+      const uint64_t indexOffset = ReadUint(buf, 8);
+      file.seekg(indexOffset);
+      if (indexOffset >= dataOffset && file.read(buf, 5) &&
+          static_cast<uint8_t>(buf[0]) == kIndexRecord)
+      {
+        const uint64_t count = ReadUint(buf + 1, 4);
+        this->dataPtr->indexed =
+          indexOffset + 5 + count * kIndexEntrySize + kTrailerSize == fileSize;
+
+        for (uint64_t i = 0; this->dataPtr->indexed && i < count; ++i)
+        {
+          file.read(buf, kIndexEntrySize);
+          LogBinaryBlock block;
+          block.offset = ReadUint(buf, 8);
+          block.size = ReadUint(buf + 8, 8);
+          block.frameCount = ReadUint(buf + 16, 4);
+          block.hasTime = buf[20] != 0;
+          block.startTime.Set(static_cast<int32_t>(ReadUint(buf + 21, 4)),
+              static_cast<int32_t>(ReadUint(buf + 25, 4)));
+          block.endTime.Set(static_cast<int32_t>(ReadUint(buf + 29, 4)),
+              static_cast<int32_t>(ReadUint(buf + 33, 4)));
+
+          this->dataPtr->indexed = file &&
+            block.offset >= dataOffset &&
+            block.offset + block.size <= indexOffset;
+          this->dataPtr->blocks.push_back(block);
+        }
+      }
+    }
+    file.clear();
+  }
+
+  if (this->dataPtr->indexed)
+    return true;
+
+  // No valid index: rebuild it from the record headers, skipping payloads.
+  gzwarn << "Binary log[" << _filename << "] has no index, "
+         << "probably because recording was interrupted. Rebuilding it."
+         << std::endl;
+  this->dataPtr->blocks.clear();
+
+  uint64_t offset = dataOffset;
+  file.seekg(offset);
+  while (offset + kRecordHeaderSize <= fileSize &&
+         file.read(buf, kRecordHeaderSize))
+  {
+    const uint8_t type = static_cast<uint8_t>(buf[0]);
+    const uint64_t payloadSize = ReadUint(buf + 10, 4);
+    if ((type != kKeyframeRecord && type != kDeltaRecord) ||
+        (type == kDeltaRecord && this->dataPtr->blocks.empty()) ||
+        offset + kRecordHeaderSize + payloadSize > fileSize)
+    {
+      break;
+    }
+
+    if (type == kKeyframeRecord)
+    {
+      LogBinaryBlock block;
+      block.offset = offset;
+      this->dataPtr->blocks.push_back(block);
+    }
+
+    LogBinaryBlock &block = this->dataPtr->blocks.back();
+    if (buf[1] != 0)
+    {
+      common::Time time(static_cast<int32_t>(ReadUint(buf + 2, 4)),
+          static_cast<int32_t>(ReadUint(buf + 6, 4)));
+      if (!block.hasTime)
+        block.startTime = time;
+      block.hasTime = true;
+      block.endTime = time;
+    }
+    block.frameCount++;
+    block.size += kRecordHeaderSize + payloadSize;
+
+    offset += kRecordHeaderSize + payloadSize;
+    file.seekg(offset);
+  }
+  file.clear();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::string &LogBinaryReader::Header() const
+{
+  return this->dataPtr->header;
+}
+
+/////////////////////////////////////////////////
+const std::vector<LogBinaryBlock> &LogBinaryReader::Blocks() const
+{
+  return this->dataPtr->blocks;
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::Indexed() const
+{
+  return this->dataPtr->indexed;
+}
+
+/////////////////////////////////////////////////
+bool LogBinaryReader::Block(const size_t _index, std::string &_data)
+{
+  _data.clear();
+  if (_index >= this->dataPtr->blocks.size())
+    return false;
+
+  const LogBinaryBlock &block = this->dataPtr->blocks[_index];
+
+  std::string records(block.size, '\0');
+  auto &file = this->dataPtr->file;
+  file.clear();
+  file.seekg(block.offset);
+  if (!file.read(&records[0], block.size))
+  {
+    gzerr << "Unable to read block " << _index << " of binary log"
+          << std::endl;
+    return false;
+  }
+
+  std::string keyframe;
+  std::vector<size_t> keyframeTokens;
+  std::string payload;
+  std::string text;
+
+  size_t pos = 0;
+  while (pos + kRecordHeaderSize <= records.size())
+  {
+    const uint8_t type = static_cast<uint8_t>(records[pos]);
+    const uint64_t size = ReadUint(&records[pos + 10], 4);
+    pos += kRecordHeaderSize;
+    if (pos + size > records.size())
+      break;
+
+    payload.assign(records, pos, size);
+    pos += size;
+
+    if (!Decompress(payload, text))
+      return false;
+
+    if (type == kKeyframeRecord)
+    {
+      keyframe = text;
+      Tokenize(keyframe, keyframeTokens);
+      _data.append(keyframe);
+    }
+    else if (type != kDeltaRecord || keyframe.empty() ||
+             !DecodeDelta(keyframe, keyframeTokens, text, _data))
+    {
+      gzerr << "Corrupted record in block " << _index << " of binary log"
+            << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
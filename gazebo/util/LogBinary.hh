@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGBINARY_HH_
+#define GAZEBO_UTIL_LOGBINARY_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data classes
+    class LogBinaryReaderPrivate;
+    class LogBinaryWriterPrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \brief A block of a binary log: a keyframe followed by frames stored
+    /// as deltas against that keyframe. A block can be decoded without
+    /// reading any other part of the log.
+    class GZ_UTIL_VISIBLE LogBinaryBlock
+    {
+      /// \brief File offset of the first record of the block.
+      public: uint64_t offset = 0;
+
+      /// \brief Size of the records of the block, in bytes.
+      public: uint64_t size = 0;
+
+      /// \brief Number of frames in the block.
+      public: uint32_t frameCount = 0;
+
+      /// \brief True if at least one frame of the block has a <sim_time>.
+      public: bool hasTime = false;
+
+      /// \brief Simulation time of the first timed frame of the block.
+      public: common::Time startTime;
+
+      /// \brief Simulation time of the last timed frame of the block.
+      public: common::Time endTime;
+    };
+
+    /// \class LogBinaryWriter LogBinary.hh util/util.hh
+    /// \brief Encodes log frames in the "binary" log encoding.
+    ///
+    /// A binary log starts with a magic number and the XML header of the
+    /// log. It is followed by length prefixed records, each holding one
+    /// zlib compressed <sdf> frame. The first record of a block is a
+    /// keyframe holding the complete frame. The other records of the block
+    /// only hold the XML elements that differ from the keyframe. A new
+    /// block starts after a fixed number of frames, or when a delta would
+    /// not be much smaller than the frame. Finish appends an index of the
+    /// blocks with their simulation times, used by LogBinaryReader to seek.
+    ///
+    /// \sa LogRecord, LogBinaryReader
+    class GZ_UTIL_VISIBLE LogBinaryWriter
+    {
+      /// \brief Constructor.
+      public: LogBinaryWriter();
+
+      /// \brief Destructor.
+      public: virtual ~LogBinaryWriter();
+
+      /// \brief Start a new log, discarding the state of any previous log.
+      /// \param[in] _header XML header of the log.
+      /// \param[out] _buffer Buffer the encoded data is appended to.
+      public: void Start(const std::string &_header, std::string &_buffer);
+
+      /// \brief Encode a sequence of <sdf> frames.
+      /// \param[in] _data One or more complete <sdf>...</sdf> frames.
+      /// \param[out] _buffer Buffer the encoded data is appended to.
+      public: void AddFrames(const std::string &_data, std::string &_buffer);
+
+      /// \brief Append the block index and the trailer. No frame can be
+      /// added afterwards.
+      /// \param[out] _buffer Buffer the encoded data is appended to.
+      public: void Finish(std::string &_buffer);
+
+      /// \brief Set the maximum number of frames in a block.
+      /// \param[in] _frames Number of frames, at least 1.
+      public: void SetKeyframeInterval(const unsigned int _frames);
+
+      /// \brief Get the maximum number of frames in a block.
+      /// \return Number of frames.
+      public: unsigned int KeyframeInterval() const;
+
+      /// \brief Get the blocks written so far.
+      /// \return Blocks, in file order.
+      public: const std::vector<LogBinaryBlock> &Blocks() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogBinaryWriterPrivate> dataPtr;
+    };
+
+    /// \class LogBinaryReader LogBinary.hh util/util.hh
+    /// \brief Reads logs written with LogBinaryWriter.
+    ///
+    /// Only the header and the block index are read when opening a log.
+    /// Blocks are read from disk on demand. When a log has no index, for
+    /// example because the recording was interrupted, the index is rebuilt
+    /// by reading the record headers.
+    class GZ_UTIL_VISIBLE LogBinaryReader
+    {
+      /// \brief Constructor.
+      public: LogBinaryReader();
+
+      /// \brief Destructor.
+      public: virtual ~LogBinaryReader();
+
+      /// \brief Check whether a file starts with the binary log magic
+      /// number.
+      /// \param[in] _filename Path to the file.
+      /// \return True if the file is a binary log.
+      public: static bool IsBinaryLog(const std::string &_filename);
+
+      /// \brief Open a binary log.
+      /// \param[in] _filename Path to the log.
+      /// \return True on success.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Get the XML header of the open log.
+      /// \return The header.
+      public: const std::string &Header() const;
+
+      /// \brief Get the blocks of the open log.
+      /// \return Blocks, in file order.
+      public: const std::vector<LogBinaryBlock> &Blocks() const;
+
+      /// \brief Get whether the block index was read from the log, instead
+      /// of being rebuilt.
+      /// \return True if the log has an index.
+      public: bool Indexed() const;
+
+      /// \brief Decode all the frames of a block.
+      /// \param[in] _index Index of the block.
+      /// \param[out] _data The frames, concatenated.
+      /// \return True if the block was decoded.
+      public: bool Block(const size_t _index, std::string &_data);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogBinaryReaderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
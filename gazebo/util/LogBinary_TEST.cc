@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/util/LogBinary.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogBinary_TEST : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a world state frame.
+  /// \param[in] _iteration Iteration of the frame.
+  /// \return The frame.
+  public: std::string Frame(const unsigned int _iteration) const
+  {
+    std::ostringstream stream;
+    stream << "<sdf version ='1.6'>\n<state world_name='default'>"
+           << "<sim_time>" << _iteration / 1000 << " "
+           << (_iteration % 1000) * 1000000 << "</sim_time>"
+           << "<iterations>" << _iteration << "</iterations>"
+           << "<model name='box'><pose>0 0 " << _iteration * 0.001
+           << " 0 0 0</pose><scale>1 1 1</scale></model>"
+           << "<model name='ground_plane'><pose>0 0 0 0 0 0</pose>"
+           << "<scale>1 1 1</scale></model>"
+           << "</state></sdf>";
+    return stream.str();
+  }
+
+  /// \brief Write a buffer to a temporary file.
+  /// \param[in] _buffer Data to write.
+  /// \return Name of the file.
+  public: std::string WriteFile(const std::string &_buffer) const
+  {
+    std::ostringstream stream;
+    stream << "/tmp/__gz_log_binary" << std::this_thread::get_id();
+    std::ofstream file(stream.str(), std::ios::binary);
+    file << _buffer;
+    return stream.str();
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Write frames and read them back.
+TEST_F(LogBinary_TEST, RoundTrip)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  const std::string header = "<header>\n<log_version>1.0</log_version>\n"
+    "</header>\n";
+  const std::string world = "<sdf version='1.6'><world name='default'>"
+    "<gravity>0 0 -9.8</gravity></world></sdf>";
+
+  util::LogBinaryWriter writer;
+  writer.SetKeyframeInterval(10);
+  EXPECT_EQ(writer.KeyframeInterval(), 10u);
+
+  std::string buffer;
+  writer.Start(header, buffer);
+  writer.AddFrames(world, buffer);
+
+  std::string data;
+  for (unsigned int i = 0; i < 35; ++i)
+    data += this->Frame(i);
+  writer.AddFrames(data, buffer);
+  writer.Finish(buffer);
+
+  // The world description gets a block of its own, the states fill blocks
+  // of 10 frames.
+  auto const &blocks = writer.Blocks();
+  ASSERT_EQ(blocks.size(), 5u);
+  EXPECT_EQ(blocks[0].frameCount, 1u);
+  EXPECT_FALSE(blocks[0].hasTime);
+  EXPECT_EQ(blocks[1].frameCount, 10u);
+  EXPECT_EQ(blocks[4].frameCount, 5u);
+  EXPECT_TRUE(blocks[4].hasTime);
+  EXPECT_EQ(blocks[4].startTime, common::Time(0, 30000000));
+  EXPECT_EQ(blocks[4].endTime, common::Time(0, 34000000));
+
+  // Deltas are much smaller than keyframes.
+  {
+    util::LogBinaryWriter keyframeWriter;
+    keyframeWriter.SetKeyframeInterval(1);
+    std::string keyframes;
+    for (unsigned int i = 0; i < 10; ++i)
+      keyframeWriter.AddFrames(this->Frame(i), keyframes);
+    EXPECT_EQ(keyframeWriter.Blocks().size(), 10u);
+    EXPECT_LT(blocks[1].size, keyframes.size());
+  }
+
+  std::string filename = this->WriteFile(buffer);
+  EXPECT_TRUE(util::LogBinaryReader::IsBinaryLog(filename));
+
+  util::LogBinaryReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+  EXPECT_TRUE(reader.Indexed());
+  EXPECT_EQ(reader.Header(), header);
+  ASSERT_EQ(reader.Blocks().size(), blocks.size());
+
+  std::string block;
+  EXPECT_TRUE(reader.Block(0, block));
+  EXPECT_EQ(block, world);
+
+  // Blocks can be read in any order.
+  EXPECT_TRUE(reader.Block(3, block));
+  std::string expected;
+  for (unsigned int i = 20; i < 30; ++i)
+    expected += this->Frame(i);
+  EXPECT_EQ(block, expected);
+
+  EXPECT_TRUE(reader.Block(1, block));
+  expected.clear();
+  for (unsigned int i = 0; i < 10; ++i)
+    expected += this->Frame(i);
+  EXPECT_EQ(block, expected);
+
+  EXPECT_FALSE(reader.Block(5, block));
+  EXPECT_TRUE(block.empty());
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a log whose recording was interrupted before the index was
+/// written.
+TEST_F(LogBinary_TEST, MissingIndex)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  util::LogBinaryWriter writer;
+  writer.SetKeyframeInterval(4);
+
+  std::string buffer;
+  writer.Start("<header></header>", buffer);
+  for (unsigned int i = 0; i < 10; ++i)
+    writer.AddFrames(this->Frame(i), buffer);
+
+  // Truncate the last record.
+  std::string filename = this->WriteFile(buffer.substr(0, buffer.size() - 3));
+
+  util::LogBinaryReader reader;
+  ASSERT_TRUE(reader.Open(filename));
+  EXPECT_FALSE(reader.Indexed());
+
+  // The last block lost its incomplete record.
+  auto const &blocks = reader.Blocks();
+  ASSERT_EQ(blocks.size(), 3u);
+  EXPECT_EQ(blocks[0].frameCount, 4u);
+  EXPECT_EQ(blocks[2].frameCount, 1u);
+  EXPECT_EQ(blocks[1].startTime, common::Time(0, 4000000));
+  EXPECT_EQ(blocks[1].endTime, common::Time(0, 7000000));
+
+  std::string block;
+  EXPECT_TRUE(reader.Block(2, block));
+  EXPECT_EQ(block, this->Frame(8));
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that other files are not taken for binary logs.
+TEST_F(LogBinary_TEST, NotBinary)
+{
+  util::LogBinaryReader reader;
+  EXPECT_FALSE(util::LogBinaryReader::IsBinaryLog("/__no_such_file__"));
+  EXPECT_FALSE(reader.Open("/__no_such_file__"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,1386 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/regex.hpp>
+
+#include "gazebo/common/Base64.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogBinary.hh"
+#include "gazebo/util/LogExtract.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Magic number at the start of the binary output.
+static const char kColumnsMagic[] = "GZLOGCOL";
+
+/// \brief Version of the binary output.
+static const uint32_t kColumnsVersion = 1;
+
+/// \brief Names of the elements of a pose, in the order they are stored.
+static const char kPoseElements[] = "xyzrpa";
+
+/// \brief Names of the components of a link state.
+static const char *kLinkComponents[] = {
+  "pose", "velocity", "acceleration", "wrench"};
+
+/// \brief Number of bytes read from a text log at once.
+static const size_t kReadSize = 4 * 1024 * 1024;
+
+/// \brief Number of chunks decoded per thread ahead of the output.
+static const size_t kChunksPerThread = 4;
+
+/// \brief Beginning of a frame.
+static const std::string kStartFrame = "<sdf ";
+
+/// \brief End of a frame.
+static const std::string kEndFrame = "</sdf>";
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Columns of the values extracted from a model, -1 for the
+    /// values that aren't extracted.
+    class LogExtractModel
+    {
+      /// \brief Columns of the pose of the model.
+      public: std::array<int, 6> pose{{-1, -1, -1, -1, -1, -1}};
+
+      /// \brief Columns of the link component, by link name.
+      public: std::unordered_map<std::string, std::array<int, 6>> links;
+
+      /// \brief Columns of the joint angles, by joint name, indexed by axis.
+      public: std::unordered_map<std::string, std::vector<int>> joints;
+    };
+
+    /// \internal
+    /// \brief A chunk of a log, waiting to be decoded.
+    class LogExtractChunk
+    {
+      /// \brief Position of the chunk in the log.
+      public: uint64_t index = 0;
+
+      /// \brief Encoding of the chunk, empty for the blocks of a binary log.
+      public: std::string encoding;
+
+      /// \brief Encoded chunk.
+      public: std::string payload;
+
+      /// \brief Number of bytes read from the log for the chunk.
+      public: uint64_t inputBytes = 0;
+    };
+
+    /// \internal
+    /// \brief Output of a chunk.
+    class LogExtractResult
+    {
+      /// \brief False if the chunk couldn't be decoded.
+      public: bool ok = true;
+
+      /// \brief Formatted rows.
+      public: std::string output;
+
+      /// \brief Number of state frames in the chunk.
+      public: uint64_t frames = 0;
+
+      /// \brief Number of rows in the output.
+      public: uint64_t rows = 0;
+
+      /// \brief Number of bytes read from the log for the chunk.
+      public: uint64_t inputBytes = 0;
+
+      /// \brief Number of bytes of decoded state text.
+      public: uint64_t decodedBytes = 0;
+    };
+
+    /// \internal
+    /// \brief An XML tag found in state text.
+    class LogExtractTag
+    {
+      /// \brief Check the name of the tag.
+      /// \param[in] _data Text holding the tag.
+      /// \param[in] _name Expected name.
+      /// \return True if the tag has this name.
+      public: bool Is(const std::string &_data, const char *_name) const
+              {
+                return std::strlen(_name) == this->nameLength &&
+                  _data.compare(this->name, this->nameLength, _name) == 0;
+              }
+
+      /// \brief Position of the '<' of the tag.
+      public: size_t start = 0;
+
+      /// \brief Position of the name.
+      public: size_t name = 0;
+
+      /// \brief Length of the name.
+      public: size_t nameLength = 0;
+
+      /// \brief Position after the '>' of the tag.
+      public: size_t end = 0;
+
+      /// \brief True for an empty element tag, ending with "/>".
+      public: bool empty = false;
+    };
+
+    /// \internal
+    /// \brief Reads the chunks of a text log one at a time, without
+    /// parsing the log as an XML document.
+    class LogExtractTextReader
+    {
+      /// \brief Open a log.
+      /// \param[in] _filename Path to the log.
+      /// \return False if the log can't be read.
+      public: bool Open(const std::string &_filename)
+              {
+                this->file.close();
+                this->file.clear();
+                this->file.open(_filename, std::ios::binary);
+                this->buffer.clear();
+                this->pos = 0;
+                return this->file.is_open();
+              }
+
+      /// \brief Read the next chunk.
+      /// \param[out] _chunk The chunk.
+      /// \return False at the end of the log.
+      public: bool Next(LogExtractChunk &_chunk)
+              {
+                // Drop the chunks already read
+                this->buffer.erase(0, this->pos);
+                this->pos = 0;
+
+                size_t start, tagEnd, end;
+                if (!this->Find("<chunk", 0, start) ||
+                    !this->Find(">", start, tagEnd) ||
+                    !this->Find("</chunk>", tagEnd, end))
+                {
+                  return false;
+                }
+
+                _chunk.encoding.clear();
+                size_t attr = this->buffer.find("encoding=", start);
+                if (attr < tagEnd)
+                {
+                  const char quote = this->buffer[attr + 9];
+                  size_t valueEnd = this->buffer.find(quote, attr + 10);
+                  if (valueEnd < tagEnd)
+                  {
+                    _chunk.encoding =
+                      this->buffer.substr(attr + 10, valueEnd - attr - 10);
+                  }
+                }
+
+                size_t from = tagEnd + 1;
+                size_t to = end;
+                size_t cdata = this->buffer.find("<![CDATA[", from);
+                if (cdata < to)
+                {
+                  from = cdata + 9;
+                  size_t cdataEnd = this->buffer.rfind("]]>", to);
+                  if (cdataEnd != std::string::npos && cdataEnd >= from)
+                    to = cdataEnd;
+                }
+                _chunk.payload.assign(this->buffer, from, to - from);
+
+                this->pos = end + 8;
+                _chunk.inputBytes = this->pos;
+                return true;
+              }
+
+      /// \brief Find a string in the buffer, reading the log until found.
+      /// \param[in] _pattern String to find.
+      /// \param[in] _from Position to search from.
+      /// \param[out] _pos Position of the string.
+      /// \return False if the log ends first.
+      private: bool Find(const char *_pattern, size_t _from, size_t &_pos)
+               {
+                 const size_t length = std::strlen(_pattern);
+                 while ((_pos = this->buffer.find(_pattern, _from)) ==
+                        std::string::npos)
+                 {
+                   if (this->buffer.size() >= length)
+                     _from = std::max(_from, this->buffer.size() - length + 1);
+
+                   size_t size = this->buffer.size();
+                   this->buffer.resize(size + kReadSize);
+                   this->file.read(&this->buffer[size], kReadSize);
+                   this->buffer.resize(size + this->file.gcount());
+                   if (this->buffer.size() == size)
+                     return false;
+                 }
+                 return true;
+               }
+
+      /// \brief The log.
+      private: std::ifstream file;
+
+      /// \brief Data read from the log and not consumed yet.
+      private: std::string buffer;
+
+      /// \brief Position of the first byte not consumed in the buffer.
+      private: size_t pos = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for LogExtract
+    class LogExtractPrivate
+    {
+      /// \brief Find the columns in the first state frame of decoded data.
+      /// \param[in] _data Decoded chunk.
+      /// \return False if the data holds no state frame.
+      public: bool Discover(const std::string &_data);
+
+      /// \brief Extract the values of the frames of decoded data, and
+      /// format them.
+      /// \param[in] _data Decoded chunk.
+      /// \param[out] _result Formatted rows.
+      public: void Scan(const std::string &_data,
+                  LogExtractResult &_result) const;
+
+      /// \brief Extract the values of a model.
+      /// \param[in] _data Decoded chunk.
+      /// \param[in] _tag Start tag of the model.
+      /// \param[in] _model Columns of the model.
+      /// \param[out] _row Values of the row.
+      /// \param[in,out] _name Scratch space for names.
+      /// \return Position after the model element, npos if it has no end.
+      public: size_t ScanModel(const std::string &_data,
+                  const LogExtractTag &_tag, const LogExtractModel &_model,
+                  double *_row, std::string &_name) const;
+
+      /// \brief Decode a chunk.
+      /// \param[in,out] _chunk Chunk, whose payload may be moved.
+      /// \param[in] _reader Reader of a binary log, nullptr for text logs.
+      /// \param[out] _data Decoded chunk.
+      /// \return False if the chunk couldn't be decoded.
+      public: bool Decode(LogExtractChunk &_chunk, LogBinaryReader *_reader,
+                  std::string &_data) const;
+
+      /// \brief Read the next chunk of the log.
+      /// \param[out] _chunk The chunk.
+      /// \return False at the end of the log.
+      public: bool Next(LogExtractChunk &_chunk);
+
+      /// \brief Decode chunks until the output has been written, called by
+      /// each thread of the pool.
+      public: void Work();
+
+      /// \brief Model names to extract, null for all models.
+      public: std::unique_ptr<boost::regex> modelRegex;
+
+      /// \brief Pose elements of the models to extract.
+      public: std::vector<int> modelPose;
+
+      /// \brief True if link values are extracted.
+      public: bool extractLinks = false;
+
+      /// \brief Link names to extract, null for all links.
+      public: std::unique_ptr<boost::regex> linkRegex;
+
+      /// \brief Link component to extract, index in kLinkComponents.
+      public: int linkComponent = 0;
+
+      /// \brief Elements of the link component to extract.
+      public: std::vector<int> linkElements;
+
+      /// \brief True if joint angles are extracted.
+      public: bool extractJoints = false;
+
+      /// \brief Joint names to extract, null for all joints.
+      public: std::unique_ptr<boost::regex> jointRegex;
+
+      /// \brief Joint axes to extract, empty for all axes.
+      public: std::vector<unsigned int> jointAxes;
+
+      /// \brief Output format.
+      public: LogExtract::Format format = LogExtract::CSV;
+
+      /// \brief Number of threads, 0 for one per core.
+      public: unsigned int threads = 0;
+
+      /// \brief Simulation time of the first frame to extract.
+      public: common::Time startTime;
+
+      /// \brief Names of the columns.
+      public: std::vector<std::string> columns;
+
+      /// \brief Columns of the extracted models, by model name.
+      public: std::unordered_map<std::string, LogExtractModel> models;
+
+      /// \brief Counters of the last extraction.
+      public: LogExtractStats stats;
+
+      /// \brief Path to the log being extracted.
+      public: std::string filename;
+
+      /// \brief Reader of a text log, used when binaryReader is null.
+      public: LogExtractTextReader textReader;
+
+      /// \brief Reader of a binary log, used to list its blocks.
+      public: std::unique_ptr<LogBinaryReader> binaryReader;
+
+      /// \brief Next block of a binary log to read.
+      public: size_t nextBlock = 0;
+
+      /// \brief Chunks read while finding the columns, decoded first.
+      public: std::deque<LogExtractChunk> pending;
+
+      /// \brief Protects the reader and the chunk count.
+      public: std::mutex readMutex;
+
+      /// \brief Number of chunks read.
+      public: uint64_t chunkCount = 0;
+
+      /// \brief True once the log has been read.
+      public: bool endOfLog = false;
+
+      /// \brief Protects the results and the counters below.
+      public: std::mutex resultMutex;
+
+      /// \brief Signals new results, and written ones.
+      public: std::condition_variable resultCondition;
+
+      /// \brief Decoded chunks waiting to be written, by chunk index.
+      public: std::map<uint64_t, LogExtractResult> results;
+
+      /// \brief Number of chunks read and not written yet.
+      public: size_t inFlight = 0;
+
+      /// \brief Maximum number of chunks read and not written yet.
+      public: size_t maxInFlight = 1;
+
+      /// \brief Number of threads that are done.
+      public: unsigned int finished = 0;
+
+      /// \brief Set when the extraction stops early.
+      public: bool stop = false;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Append an unsigned integer in little endian order.
+/// \param[out] _buffer Buffer to append to.
+/// \param[in] _value Value to append.
+/// \param[in] _bytes Number of bytes to use.
+static void AppendUint(std::string &_buffer, const uint64_t _value,
+    const unsigned int _bytes)
+{
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _buffer.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a double in little endian order.
+/// \param[out] _buffer Buffer to append to.
+/// \param[in] _value Value to append.
+static void AppendDouble(std::string &_buffer, const double _value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  AppendUint(_buffer, bits, 8);
+}
+
+/////////////////////////////////////////////////
+/// \brief Compile a name pattern of the filter.
+/// \param[in] _pattern Name, which may use '*' wildcards.
+/// \param[out] _regex The regex, null if the pattern matches everything.
+/// \return False if the pattern is invalid.
+static bool NameRegex(const std::string &_pattern,
+    std::unique_ptr<boost::regex> &_regex)
+{
+  _regex.reset();
+  if (_pattern.empty() || _pattern == "*")
+    return true;
+
+  std::string regexStr = _pattern;
+  boost::replace_all(regexStr, "*", ".*");
+  try
+  {
+    _regex.reset(new boost::regex(regexStr));
+  }
+  catch(const boost::regex_error &_e)
+  {
+    gzerr << "Invalid name[" << _pattern << "] in log filter: "
+          << _e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the pose elements of the filter, such as "[x,y,a]".
+/// \param[in] _filter Elements, empty for all of them.
+/// \param[out] _elements Indices of the elements.
+/// \return False if an element is invalid.
+static bool PoseElements(std::string _filter, std::vector<int> &_elements)
+{
+  _elements.clear();
+  boost::erase_all(_filter, "[");
+  boost::erase_all(_filter, "]");
+
+  if (_filter.empty())
+  {
+    for (int i = 0; i < 6; ++i)
+      _elements.push_back(i);
+    return true;
+  }
+
+  std::vector<std::string> parts;
+  boost::split(parts, _filter, boost::is_any_of(","));
+  for (auto const &part : parts)
+  {
+    const char *element = part.empty() ? nullptr :
+      std::strchr(kPoseElements, std::tolower(part[0]));
+    if (!element || part.size() != 1)
+    {
+      gzerr << "Invalid pose value[" << part << "] in log filter"
+            << std::endl;
+      return false;
+    }
+    _elements.push_back(static_cast<int>(element - kPoseElements));
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the next start tag of an element's content.
+/// \param[in] _data Text.
+/// \param[in] _pos Position to search from.
+/// \param[out] _tag The tag. When the end tag of the element comes first,
+/// its position is stored in _tag.start.
+/// \return False if the end tag of the element comes first, or if the
+/// text ends.
+static bool NextTag(const std::string &_data, const size_t _pos,
+    LogExtractTag &_tag)
+{
+  size_t lt = _data.find('<', _pos);
+  if (lt == std::string::npos || lt + 1 >= _data.size())
+  {
+    _tag.start = std::string::npos;
+    return false;
+  }
+
+  _tag.start = lt;
+  if (_data[lt + 1] == '/')
+    return false;
+
+  size_t nameEnd = _data.find_first_of(" \t\r\n/>", lt + 1);
+  if (nameEnd == std::string::npos)
+  {
+    _tag.start = std::string::npos;
+    return false;
+  }
+
+  size_t gt = _data.find('>', nameEnd);
+  if (gt == std::string::npos)
+  {
+    _tag.start = std::string::npos;
+    return false;
+  }
+
+  _tag.name = lt + 1;
+  _tag.nameLength = nameEnd - lt - 1;
+  _tag.end = gt + 1;
+  _tag.empty = _data[gt - 1] == '/';
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the position after an end tag found by NextTag.
+/// \param[in] _data Text.
+/// \param[in] _tag Tag whose start is the end tag.
+/// \return Position after the end tag, npos if the text ends first.
+static size_t AfterEndTag(const std::string &_data, const LogExtractTag &_tag)
+{
+  if (_tag.start == std::string::npos)
+    return std::string::npos;
+
+  size_t gt = _data.find('>', _tag.start);
+  return gt == std::string::npos ? gt : gt + 1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the position after the end of an element.
+/// \param[in] _data Text.
+/// \param[in] _tag Start tag of the element.
+/// \return Position after the element, npos if the text ends first.
+static size_t ElementEnd(const std::string &_data, const LogExtractTag &_tag)
+{
+  if (_tag.empty)
+    return _tag.end;
+
+  const size_t length = _tag.nameLength;
+  unsigned int depth = 1;
+  size_t pos = _tag.end;
+  while (true)
+  {
+    size_t lt = _data.find('<', pos);
+    if (lt == std::string::npos || lt + length + 2 >= _data.size())
+      return std::string::npos;
+
+    if (_data[lt + 1] == '/')
+    {
+      if (_data.compare(lt + 2, length, _data, _tag.name, length) == 0 &&
+          _data[lt + 2 + length] == '>' && --depth == 0)
+      {
+        return lt + 3 + length;
+      }
+      pos = lt + 2;
+    }
+    else if (_data.compare(lt + 1, length, _data, _tag.name, length) == 0 &&
+             std::strchr(" \t\r\n/>", _data[lt + 1 + length]))
+    {
+      size_t gt = _data.find('>', lt);
+      if (gt == std::string::npos)
+        return std::string::npos;
+      if (_data[gt - 1] != '/')
+        ++depth;
+      pos = gt + 1;
+    }
+    else
+    {
+      pos = lt + 1;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an attribute of a tag.
+/// \param[in] _data Text.
+/// \param[in] _tag The tag.
+/// \param[in] _attribute Name of the attribute, followed by '='.
+/// \param[out] _value Value of the attribute.
+/// \return False if the tag has no such attribute.
+static bool Attribute(const std::string &_data, const LogExtractTag &_tag,
+    const char *_attribute, std::string &_value)
+{
+  const size_t length = std::strlen(_attribute);
+  size_t pos = _data.find(_attribute, _tag.name + _tag.nameLength);
+  if (pos == std::string::npos || pos + length >= _tag.end)
+    return false;
+
+  const char quote = _data[pos + length];
+  size_t end = _data.find(quote, pos + length + 1);
+  if (end == std::string::npos || end >= _tag.end)
+    return false;
+
+  _value.assign(_data, pos + length + 1, end - pos - length - 1);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the six numbers of a pose, or of a twist or a wrench, and
+/// store the extracted ones.
+/// \param[in] _data Text.
+/// \param[in] _pos Position of the numbers.
+/// \param[in] _columns Column of each number, -1 to skip it.
+/// \param[out] _row Values of the row.
+static void ReadValues(const std::string &_data, const size_t _pos,
+    const std::array<int, 6> &_columns, double *_row)
+{
+  const char *str = _data.c_str() + _pos;
+  for (int i = 0; i < 6; ++i)
+  {
+    char *end;
+    double value = std::strtod(str, &end);
+    if (end == str)
+      return;
+    if (_columns[i] >= 0)
+      _row[_columns[i]] = value;
+    str = end;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the next state frame.
+/// \param[in] _data Text holding frames.
+/// \param[in,out] _pos Position to search from, moved after the frame.
+/// \param[out] _state Start tag of the state element.
+/// \return False if there are no more state frames.
+static bool NextState(const std::string &_data, size_t &_pos,
+    LogExtractTag &_state)
+{
+  while (true)
+  {
+    size_t start = _data.find(kStartFrame, _pos);
+    if (start == std::string::npos)
+      return false;
+
+    size_t end = _data.find(kEndFrame, start);
+    if (end == std::string::npos)
+      return false;
+    _pos = end + kEndFrame.size();
+
+    // World descriptions are frames too, skip them.
+    LogExtractTag sdf;
+    if (NextTag(_data, start, sdf) && NextTag(_data, sdf.end, _state) &&
+        _state.Is(_data, "state") && !_state.empty)
+    {
+      return true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the names of the children of an element.
+/// \param[in] _data Text.
+/// \param[in] _tag Start tag of the element.
+/// \param[in] _child Name of the children.
+/// \param[in] _attribute Attribute holding the name of a child.
+/// \param[in] _regex Names to keep, null for all.
+/// \param[out] _names The names, with the start tag of the first child
+/// with each name.
+static void ChildNames(const std::string &_data, const LogExtractTag &_tag,
+    const char *_child, const char *_attribute, const boost::regex *_regex,
+    std::map<std::string, LogExtractTag> &_names)
+{
+  if (_tag.empty)
+    return;
+
+  std::string name;
+  LogExtractTag tag;
+  size_t pos = _tag.end;
+  while (pos != std::string::npos && NextTag(_data, pos, tag))
+  {
+    if (tag.Is(_data, _child) && Attribute(_data, tag, _attribute, name) &&
+        (!_regex || boost::regex_match(name, *_regex)))
+    {
+      _names.insert(std::make_pair(name, tag));
+    }
+    pos = ElementEnd(_data, tag);
+  }
+}
+
+/////////////////////////////////////////////////
+LogExtract::LogExtract()
+  : dataPtr(new LogExtractPrivate)
+{
+  this->SetFilter("");
+}
+
+/////////////////////////////////////////////////
+LogExtract::~LogExtract()
+{
+}
+
+/////////////////////////////////////////////////
+bool LogExtract::SetFilter(const std::string &_filter)
+{
+  auto &d = *this->dataPtr;
+  d.modelRegex.reset();
+  d.modelPose.clear();
+  d.extractLinks = false;
+  d.linkRegex.reset();
+  d.linkComponent = 0;
+  d.linkElements.clear();
+  d.extractJoints = false;
+  d.jointRegex.reset();
+  d.jointAxes.clear();
+
+  std::vector<std::string> mainParts;
+  boost::split(mainParts, _filter, boost::is_any_of("/"));
+  if (mainParts.size() > 3)
+  {
+    gzerr << "Invalid log filter[" << _filter << "]" << std::endl;
+    return false;
+  }
+
+  // Link
+  if (mainParts.size() > 1 && !mainParts[1].empty())
+  {
+    std::vector<std::string> parts;
+    boost::split(parts, mainParts[1], boost::is_any_of("."));
+    if (parts.size() > 3 || !NameRegex(parts[0], d.linkRegex))
+    {
+      gzerr << "Invalid link filter[" << mainParts[1] << "]" << std::endl;
+      return false;
+    }
+
+    if (parts.size() > 1)
+    {
+      auto component = std::find(std::begin(kLinkComponents),
+          std::end(kLinkComponents), parts[1]);
+      if (component == std::end(kLinkComponents))
+      {
+        gzerr << "Invalid link state component[" << parts[1] << "]"
+              << std::endl;
+        return false;
+      }
+      d.linkComponent =
+        static_cast<int>(component - std::begin(kLinkComponents));
+    }
+
+    if (!PoseElements(parts.size() > 2 ? parts[2] : "", d.linkElements))
+      return false;
+    d.extractLinks = true;
+  }
+
+  // Joint
+  if (mainParts.size() > 2 && !mainParts[2].empty())
+  {
+    std::vector<std::string> parts;
+    boost::split(parts, mainParts[2], boost::is_any_of("."));
+    if (parts.size() > 2 || !NameRegex(parts[0], d.jointRegex))
+    {
+      gzerr << "Invalid joint filter[" << mainParts[2] << "]" << std::endl;
+      return false;
+    }
+
+    if (parts.size() > 1)
+    {
+      std::string axes = parts[1];
+      boost::erase_all(axes, "[");
+      boost::erase_all(axes, "]");
+      std::vector<std::string> axisParts;
+      boost::split(axisParts, axes, boost::is_any_of(","));
+      for (auto const &axis : axisParts)
+      {
+        try
+        {
+          d.jointAxes.push_back(boost::lexical_cast<unsigned int>(axis));
+        }
+        catch(const boost::bad_lexical_cast &)
+        {
+          gzerr << "Invalid axis value[" << axis << "]" << std::endl;
+          return false;
+        }
+      }
+    }
+    d.extractJoints = true;
+  }
+
+  // Model
+  std::vector<std::string> parts;
+  boost::split(parts, mainParts[0], boost::is_any_of("."));
+  if (parts.size() > 3 || !NameRegex(parts[0], d.modelRegex))
+  {
+    gzerr << "Invalid model filter[" << mainParts[0] << "]" << std::endl;
+    return false;
+  }
+
+  if (parts.size() > 1 && parts[1] != "pose")
+  {
+    gzerr << "Invalid model state component[" << parts[1] << "]"
+          << std::endl;
+    return false;
+  }
+
+  // The pose is the default when nothing else is extracted.
+  if (parts.size() > 1 || (!d.extractLinks && !d.extractJoints))
+  {
+    if (!PoseElements(parts.size() > 2 ? parts[2] : "", d.modelPose))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogExtract::SetFormat(const Format _format)
+{
+  this->dataPtr->format = _format;
+}
+
+/////////////////////////////////////////////////
+void LogExtract::SetThreads(const unsigned int _threads)
+{
+  this->dataPtr->threads = _threads;
+}
+
+/////////////////////////////////////////////////
+void LogExtract::SetStartTime(const common::Time &_time)
+{
+  this->dataPtr->startTime = _time;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &LogExtract::Columns() const
+{
+  return this->dataPtr->columns;
+}
+
+/////////////////////////////////////////////////
+const LogExtractStats &LogExtract::Stats() const
+{
+  return this->dataPtr->stats;
+}
+
+/////////////////////////////////////////////////
+bool LogExtract::Extract(const std::string &_logFile, std::ostream &_out)
+{
+  auto &d = *this->dataPtr;
+  auto startTime = std::chrono::steady_clock::now();
+
+  d.stats = LogExtractStats();
+  d.columns.clear();
+  d.models.clear();
+  d.pending.clear();
+  d.results.clear();
+  d.filename = _logFile;
+  d.nextBlock = 0;
+  d.chunkCount = 0;
+  d.endOfLog = false;
+  d.inFlight = 0;
+  d.finished = 0;
+  d.stop = false;
+
+  d.binaryReader.reset();
+  if (LogBinaryReader::IsBinaryLog(_logFile))
+  {
+    d.binaryReader.reset(new LogBinaryReader);
+    if (!d.binaryReader->Open(_logFile))
+    {
+      gzerr << "Unable to open log file[" << _logFile << "]" << std::endl;
+      return false;
+    }
+  }
+  else if (!d.textReader.Open(_logFile))
+  {
+    gzerr << "Unable to open log file[" << _logFile << "]" << std::endl;
+    return false;
+  }
+
+  // Find the columns in the first state frame. The chunks read until then
+  // are kept, and decoded again by the pool.
+  {
+    std::deque<LogExtractChunk> read;
+    LogExtractChunk chunk;
+    std::string data;
+    bool found = false;
+    while (!found && d.Next(chunk))
+    {
+      LogExtractChunk copy = chunk;
+      if (!d.Decode(copy, d.binaryReader.get(), data))
+      {
+        gzerr << "Unable to decode chunk " << chunk.index << " of log file["
+              << _logFile << "]" << std::endl;
+        return false;
+      }
+      found = d.Discover(data);
+      read.push_back(std::move(chunk));
+    }
+    d.pending.swap(read);
+
+    if (!found)
+      d.columns.assign(1, "sim_time");
+  }
+
+  // Header
+  std::string header;
+  if (d.format == CSV)
+  {
+    header = boost::algorithm::join(d.columns, ",") + "\n";
+  }
+  else
+  {
+    header.append(kColumnsMagic, 8);
+    AppendUint(header, kColumnsVersion, 4);
+    AppendUint(header, d.columns.size(), 4);
+    for (auto const &column : d.columns)
+    {
+      AppendUint(header, column.size(), 4);
+      header.append(column);
+    }
+  }
+  _out.write(header.data(), header.size());
+  d.stats.outputBytes += header.size();
+
+  // Decode the chunks with a pool of threads, and write their rows in
+  // order.
+  unsigned int threadCount = d.threads;
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  d.maxInFlight = threadCount * kChunksPerThread;
+
+  std::vector<std::thread> pool;
+  for (unsigned int i = 0; i < threadCount; ++i)
+    pool.push_back(std::thread(&LogExtractPrivate::Work, &d));
+
+  bool ok = true;
+  uint64_t written = 0;
+  {
+    std::unique_lock<std::mutex> lock(d.resultMutex);
+    while (true)
+    {
+      auto next = d.results.find(written);
+      if (next == d.results.end())
+      {
+        if (d.finished == threadCount)
+          break;
+        d.resultCondition.wait(lock);
+        continue;
+      }
+
+      LogExtractResult result = std::move(next->second);
+      d.results.erase(next);
+      lock.unlock();
+
+      if (!result.ok)
+      {
+        gzerr << "Unable to decode chunk " << written << " of log file["
+              << _logFile << "]" << std::endl;
+        ok = false;
+      }
+      else
+      {
+        _out.write(result.output.data(), result.output.size());
+        if (!_out)
+        {
+          gzerr << "Unable to write the extracted columns" << std::endl;
+          ok = false;
+        }
+      }
+
+      lock.lock();
+      ++d.stats.chunks;
+      d.stats.frames += result.frames;
+      d.stats.rows += result.rows;
+      d.stats.inputBytes += result.inputBytes;
+      d.stats.decodedBytes += result.decodedBytes;
+      d.stats.outputBytes += result.output.size();
+      ++written;
+      --d.inFlight;
+      if (!ok)
+        d.stop = true;
+      d.resultCondition.notify_all();
+    }
+  }
+
+  for (auto &thread : pool)
+    thread.join();
+
+  _out.flush();
+  d.pending.clear();
+  d.results.clear();
+  d.binaryReader.reset();
+
+  d.stats.seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - startTime).count();
+  return ok;
+}
+
+/////////////////////////////////////////////////
+bool LogExtractPrivate::Next(LogExtractChunk &_chunk)
+{
+  if (!this->pending.empty())
+  {
+    _chunk = std::move(this->pending.front());
+    this->pending.pop_front();
+    return true;
+  }
+
+  if (this->binaryReader)
+  {
+    auto const &blocks = this->binaryReader->Blocks();
+    if (this->nextBlock >= blocks.size())
+      return false;
+    _chunk.encoding.clear();
+    _chunk.payload.clear();
+    _chunk.inputBytes = blocks[this->nextBlock].size;
+    _chunk.index = this->nextBlock++;
+  }
+  else
+  {
+    if (!this->textReader.Next(_chunk))
+      return false;
+    _chunk.index = this->chunkCount;
+  }
+
+  ++this->chunkCount;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogExtractPrivate::Decode(LogExtractChunk &_chunk,
+    LogBinaryReader *_reader, std::string &_data) const
+{
+  _data.clear();
+  if (_reader)
+    return _reader->Block(_chunk.index, _data);
+
+  if (_chunk.encoding == "txt")
+  {
+    _data.swap(_chunk.payload);
+    return true;
+  }
+
+  try
+  {
+    std::string compressed = Base64Decode(_chunk.payload);
+    boost::iostreams::filtering_istream in;
+    if (_chunk.encoding == "zlib")
+      in.push(boost::iostreams::zlib_decompressor());
+    else if (_chunk.encoding == "bz2")
+      in.push(boost::iostreams::bzip2_decompressor());
+    else
+    {
+      gzerr << "Invalid encoding[" << _chunk.encoding << "] in log file["
+            << this->filename << "]" << std::endl;
+      return false;
+    }
+    in.push(boost::make_iterator_range(compressed));
+    boost::iostreams::copy(in, boost::iostreams::back_inserter(_data));
+  }
+  catch(const std::exception &_e)
+  {
+    gzerr << "Unable to decompress log chunk: " << _e.what() << std::endl;
+    return false;
+  }
+
+  // Chunks decoded by LogPlay end with a null character.
+  while (!_data.empty() && _data.back() == '\0')
+    _data.pop_back();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogExtractPrivate::Work()
+{
+  // Binary logs are read by every thread, through a reader of its own.
+  std::unique_ptr<LogBinaryReader> reader;
+  if (this->binaryReader)
+  {
+    reader.reset(new LogBinaryReader);
+    if (!reader->Open(this->filename))
+      reader.reset();
+  }
+
+  LogExtractChunk chunk;
+  std::string data;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->resultMutex);
+      this->resultCondition.wait(lock, [this]
+          {return this->stop || this->inFlight < this->maxInFlight;});
+      if (this->stop)
+        break;
+      ++this->inFlight;
+    }
+
+    bool read;
+    {
+      std::lock_guard<std::mutex> lock(this->readMutex);
+      read = !this->endOfLog && this->Next(chunk);
+      if (!read)
+        this->endOfLog = true;
+    }
+
+    if (!read)
+    {
+      std::lock_guard<std::mutex> lock(this->resultMutex);
+      --this->inFlight;
+      break;
+    }
+
+    LogExtractResult result;
+    result.inputBytes = chunk.inputBytes;
+    result.ok = (!this->binaryReader || reader) &&
+      this->Decode(chunk, reader.get(), data);
+    if (result.ok)
+    {
+      result.decodedBytes = data.size();
+      this->Scan(data, result);
+    }
+
+    std::lock_guard<std::mutex> lock(this->resultMutex);
+    this->results[chunk.index] = std::move(result);
+    this->resultCondition.notify_all();
+  }
+
+  std::lock_guard<std::mutex> lock(this->resultMutex);
+  ++this->finished;
+  this->resultCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+bool LogExtractPrivate::Discover(const std::string &_data)
+{
+  size_t pos = 0;
+  LogExtractTag state;
+  if (!NextState(_data, pos, state))
+    return false;
+
+  this->columns.assign(1, "sim_time");
+  this->models.clear();
+
+  std::map<std::string, LogExtractTag> found;
+  ChildNames(_data, state, "model", "name=", this->modelRegex.get(), found);
+
+  for (auto const &model : found)
+  {
+    LogExtractModel columnsOfModel;
+
+    for (int element : this->modelPose)
+    {
+      columnsOfModel.pose[element] = this->columns.size();
+      this->columns.push_back(model.first + ".pose." + kPoseElements[element]);
+    }
+
+    if (this->extractLinks)
+    {
+      std::map<std::string, LogExtractTag> links;
+      ChildNames(_data, model.second, "link", "name=", this->linkRegex.get(),
+          links);
+      for (auto const &link : links)
+      {
+        std::array<int, 6> linkColumns{{-1, -1, -1, -1, -1, -1}};
+        for (int element : this->linkElements)
+        {
+          linkColumns[element] = this->columns.size();
+          this->columns.push_back(model.first + "::" + link.first + "." +
+              kLinkComponents[this->linkComponent] + "." +
+              kPoseElements[element]);
+        }
+        columnsOfModel.links[link.first] = linkColumns;
+      }
+    }
+
+    if (this->extractJoints)
+    {
+      std::map<std::string, LogExtractTag> joints;
+      ChildNames(_data, model.second, "joint", "name=",
+          this->jointRegex.get(), joints);
+      for (auto const &joint : joints)
+      {
+        std::vector<unsigned int> axes = this->jointAxes;
+        if (axes.empty())
+        {
+          std::map<std::string, LogExtractTag> angles;
+          ChildNames(_data, joint.second, "angle", "axis=", nullptr, angles);
+          for (auto const &angle : angles)
+          {
+            try
+            {
+              axes.push_back(boost::lexical_cast<unsigned int>(angle.first));
+            }
+            catch(const boost::bad_lexical_cast &)
+            {
+            }
+          }
+          std::sort(axes.begin(), axes.end());
+        }
+
+        std::vector<int> jointColumns;
+        for (unsigned int axis : axes)
+        {
+          if (jointColumns.size() <= axis)
+            jointColumns.resize(axis + 1, -1);
+          jointColumns[axis] = this->columns.size();
+          this->columns.push_back(model.first + "::" + joint.first +
+              ".angle." + std::to_string(axis));
+        }
+        columnsOfModel.joints[joint.first] = jointColumns;
+      }
+    }
+
+    this->models[model.first] = columnsOfModel;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogExtractPrivate::Scan(const std::string &_data,
+    LogExtractResult &_result) const
+{
+  const size_t columnCount = this->columns.size();
+  std::vector<double> values;
+  std::vector<common::Time> times;
+  std::string name;
+
+  size_t pos = 0;
+  LogExtractTag state;
+  while (NextState(_data, pos, state))
+  {
+    ++_result.frames;
+
+    const size_t row = times.size();
+    values.resize((row + 1) * columnCount,
+        std::numeric_limits<double>::quiet_NaN());
+    double *rowValues = &values[row * columnCount];
+
+    common::Time time;
+    LogExtractTag tag;
+    size_t p = state.end;
+    while (p != std::string::npos && NextTag(_data, p, tag))
+    {
+      if (tag.Is(_data, "sim_time"))
+      {
+        char *end;
+        time.sec = std::strtol(_data.c_str() + tag.end, &end, 10);
+        time.nsec = std::strtol(end, nullptr, 10);
+        p = ElementEnd(_data, tag);
+      }
+      else if (tag.Is(_data, "model") && !tag.empty &&
+               Attribute(_data, tag, "name=", name))
+      {
+        auto model = this->models.find(name);
+        if (model != this->models.end())
+          p = this->ScanModel(_data, tag, model->second, rowValues, name);
+        else
+          p = ElementEnd(_data, tag);
+      }
+      else
+      {
+        p = ElementEnd(_data, tag);
+      }
+    }
+
+    if (time < this->startTime)
+    {
+      values.resize(row * columnCount);
+      continue;
+    }
+
+    rowValues[0] = time.Double();
+    times.push_back(time);
+  }
+
+  _result.rows = times.size();
+  if (times.empty())
+    return;
+
+  std::string &out = _result.output;
+  if (this->format == LogExtract::CSV)
+  {
+    char number[32];
+    out.reserve(times.size() * columnCount * 10);
+    for (size_t row = 0; row < times.size(); ++row)
+    {
+      int length = std::snprintf(number, sizeof(number), "%d.%09d",
+          times[row].sec, times[row].nsec);
+      out.append(number, length);
+
+      const double *rowValues = &values[row * columnCount];
+      for (size_t column = 1; column < columnCount; ++column)
+      {
+        out.push_back(',');
+        if (!std::isnan(rowValues[column]))
+        {
+          length = std::snprintf(number, sizeof(number), "%.9g",
+              rowValues[column]);
+          out.append(number, length);
+        }
+      }
+      out.push_back('\n');
+    }
+  }
+  else
+  {
+    out.reserve(4 + times.size() * columnCount * 8);
+    AppendUint(out, times.size(), 4);
+    for (size_t column = 0; column < columnCount; ++column)
+    {
+      for (size_t row = 0; row < times.size(); ++row)
+        AppendDouble(out, values[row * columnCount + column]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+size_t LogExtractPrivate::ScanModel(const std::string &_data,
+    const LogExtractTag &_tag, const LogExtractModel &_model,
+    double *_row, std::string &_name) const
+{
+  const char *component = kLinkComponents[this->linkComponent];
+
+  LogExtractTag tag;
+  size_t pos = _tag.end;
+  while (NextTag(_data, pos, tag))
+  {
+    if (tag.Is(_data, "pose") && !tag.empty)
+    {
+      ReadValues(_data, tag.end, _model.pose, _row);
+    }
+    else if (tag.Is(_data, "link") && !tag.empty && !_model.links.empty() &&
+             Attribute(_data, tag, "name=", _name))
+    {
+      auto link = _model.links.find(_name);
+      if (link != _model.links.end())
+      {
+        LogExtractTag child;
+        size_t childPos = tag.end;
+        while (childPos != std::string::npos &&
+               NextTag(_data, childPos, child))
+        {
+          if (child.Is(_data, component) && !child.empty)
+            ReadValues(_data, child.end, link->second, _row);
+          childPos = ElementEnd(_data, child);
+        }
+      }
+    }
+    else if (tag.Is(_data, "joint") && !tag.empty && !_model.joints.empty() &&
+             Attribute(_data, tag, "name=", _name))
+    {
+      auto joint = _model.joints.find(_name);
+      if (joint != _model.joints.end())
+      {
+        LogExtractTag child;
+        size_t childPos = tag.end;
+        while (childPos != std::string::npos &&
+               NextTag(_data, childPos, child))
+        {
+          if (child.Is(_data, "angle") && !child.empty &&
+              Attribute(_data, child, "axis=", _name))
+          {
+            size_t axis = std::strtoul(_name.c_str(), nullptr, 10);
+            if (axis < joint->second.size() && joint->second[axis] >= 0)
+            {
+              _row[joint->second[axis]] =
+                std::strtod(_data.c_str() + child.end, nullptr);
+            }
+          }
+          childPos = ElementEnd(_data, child);
+        }
+      }
+    }
+
+    pos = ElementEnd(_data, tag);
+    if (pos == std::string::npos)
+      return pos;
+  }
+
+  return AfterEndTag(_data, tag);
+}
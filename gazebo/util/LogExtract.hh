@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGEXTRACT_HH_
+#define GAZEBO_UTIL_LOGEXTRACT_HH_
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class LogExtractPrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \brief Counters of a LogExtract::Extract call.
+    class GZ_UTIL_VISIBLE LogExtractStats
+    {
+      /// \brief Number of chunks decoded. The chunks of a binary log are
+      /// its blocks.
+      public: uint64_t chunks = 0;
+
+      /// \brief Number of state frames read.
+      public: uint64_t frames = 0;
+
+      /// \brief Number of rows written.
+      public: uint64_t rows = 0;
+
+      /// \brief Number of bytes read from the log.
+      public: uint64_t inputBytes = 0;
+
+      /// \brief Number of bytes of decoded state text.
+      public: uint64_t decodedBytes = 0;
+
+      /// \brief Number of bytes written.
+      public: uint64_t outputBytes = 0;
+
+      /// \brief Duration of the extraction, in seconds.
+      public: double seconds = 0;
+    };
+
+    /// \class LogExtract LogExtract.hh util/util.hh
+    /// \brief Extract values from the states of a log file into columns.
+    ///
+    /// The log is read sequentially without parsing it as a whole, and its
+    /// chunks are decoded and scanned by a pool of threads. Only the
+    /// elements selected by the filter are parsed, the other models, links
+    /// and joints are skipped. Rows are written in log order, one per state
+    /// frame, with the simulation time in the first column.
+    ///
+    /// The filter has the syntax of the `gz log --filter` option:
+    /// `model[.pose[.[x,y,z,r,p,a]]][/link[.component[.[x,y,z,r,p,a]]]]`
+    /// `[/joint[.[axes]]]`, where component is one of pose, velocity,
+    /// acceleration and wrench, and names may use `*` wildcards. Columns
+    /// are named after the values, such as `box.pose.x`,
+    /// `pr2::base_link.velocity.a` or `pr2::torso_joint.angle.0`.
+    ///
+    /// The columns are found in the first state frame of the log. Values
+    /// missing from a later frame are left empty in CSV output, and are NaN
+    /// in binary output. Entities that appear after the first state frame
+    /// are not extracted.
+    ///
+    /// The binary format starts with the magic number "GZLOGCOL", a 32 bit
+    /// version, a 32 bit column count and the names of the columns, each
+    /// prefixed by its 32 bit length. It is followed by blocks, each made
+    /// of a 32 bit row count and of the values of every column for these
+    /// rows, stored one column after the other as 64 bit doubles. The
+    /// simulation time is stored in seconds. All numbers are little endian.
+    class GZ_UTIL_VISIBLE LogExtract
+    {
+      /// \brief Output formats.
+      public: enum Format
+      {
+        /// \brief Comma separated values, with a header row.
+        CSV,
+
+        /// \brief Binary column blocks.
+        BINARY
+      };
+
+      /// \brief Constructor.
+      public: LogExtract();
+
+      /// \brief Destructor.
+      public: virtual ~LogExtract();
+
+      /// \brief Set the values to extract. An empty filter extracts the
+      /// poses of all the models.
+      /// \param[in] _filter Filter string.
+      /// \return False if the filter is invalid.
+      public: bool SetFilter(const std::string &_filter);
+
+      /// \brief Set the output format, CSV by default.
+      /// \param[in] _format Output format.
+      public: void SetFormat(const Format _format);
+
+      /// \brief Set the number of threads decoding chunks.
+      /// \param[in] _threads Number of threads, 0 to use one per core.
+      public: void SetThreads(const unsigned int _threads);
+
+      /// \brief Skip the frames before a simulation time.
+      /// \param[in] _time Simulation time of the first frame to extract.
+      public: void SetStartTime(const common::Time &_time);
+
+      /// \brief Extract the values of a log.
+      /// \param[in] _logFile Path to the log, using any encoding.
+      /// \param[out] _out Stream the columns are written to.
+      /// \return False if the log couldn't be read.
+      public: bool Extract(const std::string &_logFile, std::ostream &_out);
+
+      /// \brief Get the columns of the last extraction.
+      /// \return Names of the columns, the first one being "sim_time".
+      public: const std::vector<std::string> &Columns() const;
+
+      /// \brief Get the counters of the last extraction.
+      /// \return The counters.
+      public: const LogExtractStats &Stats() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogExtractPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "gazebo/common/Base64.hh"
+#include "gazebo/util/LogBinary.hh"
+#include "gazebo/util/LogExtract.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+/// \brief Number of state frames in the test logs.
+static const unsigned int kFrames = 40;
+
+/// \brief Number of state frames per chunk.
+static const unsigned int kFramesPerChunk = 10;
+
+class LogExtract_TEST : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a world state frame.
+  /// \param[in] _iteration Iteration of the frame.
+  /// \return The frame.
+  public: std::string Frame(const unsigned int _iteration) const
+  {
+    std::ostringstream stream;
+    stream << "<sdf version='1.6'><state world_name='default'>"
+           << "<sim_time>" << _iteration / 10 << " "
+           << (_iteration % 10) * 100000000 << "</sim_time>"
+           << "<wall_time>0 0</wall_time><real_time>0 0</real_time>"
+           << "<iterations>" << _iteration << "</iterations>"
+           << "<model name='robot'><pose>" << _iteration
+           << " 2 3 0 0 0.5</pose><scale>1 1 1</scale>"
+           << "<joint name='hinge'><angle axis='0'>" << _iteration * 0.1
+           << "</angle><angle axis='1'>-" << _iteration
+           << "</angle></joint>"
+           << "<link name='base'><pose>0 0 0 0 0 0</pose>"
+           << "<velocity>" << _iteration << " 0 0 0 0 -1</velocity>"
+           << "<acceleration>0 0 0 0 0 0</acceleration>"
+           << "<wrench>0 0 0 0 0 0</wrench></link>"
+           << "<model name='arm'><pose>0 0 1 0 0 0</pose>"
+           << "<scale>1 1 1</scale><link name='base'><pose>0 0 0 0 0 0</pose>"
+           << "<velocity>0 0 0 0 0 0</velocity>"
+           << "<acceleration>0 0 0 0 0 0</acceleration>"
+           << "<wrench>0 0 0 0 0 0</wrench></link></model>"
+           << "</model>";
+
+    // The box is deleted half way through the log
+    if (_iteration < kFrames / 2)
+    {
+      stream << "<model name='box'><pose>0 0 " << _iteration * 0.25
+             << " 0 0 0</pose><scale>1 1 1</scale></model>";
+    }
+
+    stream << "</state></sdf>";
+    return stream.str();
+  }
+
+  /// \brief Create a text log, with chunks of each encoding.
+  /// \return The log.
+  public: std::string TextLog() const
+  {
+    std::string log = "<?xml version='1.0'?>\n<gazebo_log>\n<header>\n"
+      "<log_version>1.0</log_version>\n</header>\n";
+    log += this->Chunk("txt", this->World());
+
+    for (unsigned int i = 0; i < kFrames; i += kFramesPerChunk)
+    {
+      std::string data;
+      for (unsigned int j = i; j < i + kFramesPerChunk; ++j)
+        data += this->Frame(j);
+      log += this->Chunk((i / kFramesPerChunk) % 2 ? "txt" : "zlib", data);
+    }
+
+    log += "</gazebo_log>\n";
+    return log;
+  }
+
+  /// \brief Create a binary log.
+  /// \return The log.
+  public: std::string BinaryLog() const
+  {
+    util::LogBinaryWriter writer;
+    writer.SetKeyframeInterval(kFramesPerChunk);
+
+    std::string log;
+    writer.Start("<header>\n<log_version>1.0</log_version>\n</header>\n",
+        log);
+    writer.AddFrames(this->World(), log);
+    for (unsigned int i = 0; i < kFrames; ++i)
+      writer.AddFrames(this->Frame(i), log);
+    writer.Finish(log);
+    return log;
+  }
+
+  /// \brief Create the world description frame.
+  /// \return The frame.
+  public: std::string World() const
+  {
+    return "<sdf version='1.6'><world name='default'>"
+      "<gravity>0 0 -9.8</gravity><model name='robot'><link name='base'/>"
+      "</model></world></sdf>";
+  }
+
+  /// \brief Create a chunk of a text log.
+  /// \param[in] _encoding Encoding of the chunk.
+  /// \param[in] _data Frames of the chunk.
+  /// \return The chunk.
+  public: std::string Chunk(const std::string &_encoding,
+              const std::string &_data) const
+  {
+    std::string chunk = "<chunk encoding='" + _encoding + "'>\n<![CDATA[";
+    if (_encoding == "zlib")
+    {
+      std::string str;
+      {
+        boost::iostreams::filtering_ostream out;
+        out.push(boost::iostreams::zlib_compressor());
+        out.push(std::back_inserter(str));
+        boost::iostreams::copy(boost::make_iterator_range(_data), out);
+      }
+      Base64Encode(str.c_str(), str.size(), chunk);
+    }
+    else
+    {
+      chunk += _data;
+    }
+    return chunk + "]]>\n</chunk>\n";
+  }
+
+  /// \brief Write a buffer to a temporary file.
+  /// \param[in] _buffer Data to write.
+  /// \return Name of the file.
+  public: std::string WriteFile(const std::string &_buffer) const
+  {
+    std::ostringstream stream;
+    stream << "/tmp/__gz_log_extract" << std::this_thread::get_id();
+    std::ofstream file(stream.str(), std::ios::binary);
+    file << _buffer;
+    return stream.str();
+  }
+
+  /// \brief Split CSV output into fields.
+  /// \param[in] _csv CSV output.
+  /// \return Fields of each line.
+  public: std::vector<std::vector<std::string>> Split(
+              const std::string &_csv) const
+  {
+    std::vector<std::string> lines;
+    boost::split(lines, _csv, boost::is_any_of("\n"));
+    EXPECT_TRUE(lines.back().empty());
+    lines.pop_back();
+
+    std::vector<std::vector<std::string>> result;
+    for (auto const &line : lines)
+    {
+      result.push_back(std::vector<std::string>());
+      boost::split(result.back(), line, boost::is_any_of(","));
+    }
+    return result;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Extract the model poses of a text log as CSV.
+TEST_F(LogExtract_TEST, Poses)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  std::string filename = this->WriteFile(this->TextLog());
+
+  util::LogExtract extract;
+  std::ostringstream out;
+  ASSERT_TRUE(extract.Extract(filename, out));
+
+  // Models sorted by name, nested models are not extracted
+  auto const &columns = extract.Columns();
+  ASSERT_EQ(columns.size(), 13u);
+  EXPECT_EQ(columns[0], "sim_time");
+  EXPECT_EQ(columns[1], "box.pose.x");
+  EXPECT_EQ(columns[6], "box.pose.a");
+  EXPECT_EQ(columns[7], "robot.pose.x");
+
+  auto lines = this->Split(out.str());
+  ASSERT_EQ(lines.size(), kFrames + 1);
+  EXPECT_EQ(boost::algorithm::join(lines[0], ","),
+      boost::algorithm::join(columns, ","));
+  for (auto const &line : lines)
+    ASSERT_EQ(line.size(), columns.size());
+
+  EXPECT_EQ(lines[1][0], "0.000000000");
+  EXPECT_EQ(lines[13][0], "1.200000000");
+  EXPECT_DOUBLE_EQ(std::stod(lines[13][3]), 3.0);
+  EXPECT_EQ(lines[13][7], "12");
+  EXPECT_EQ(lines[13][12], "0.5");
+
+  // Values of the deleted box are left empty
+  EXPECT_EQ(lines[kFrames][1], "");
+  EXPECT_EQ(lines[kFrames][7], std::to_string(kFrames - 1));
+
+  auto const &stats = extract.Stats();
+  EXPECT_EQ(stats.chunks, 5u);
+  EXPECT_EQ(stats.frames, kFrames);
+  EXPECT_EQ(stats.rows, kFrames);
+  EXPECT_EQ(stats.outputBytes, out.str().size());
+  EXPECT_GT(stats.decodedBytes, stats.inputBytes / 2);
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Extract links and joints selected by a filter.
+TEST_F(LogExtract_TEST, Filter)
+{
+#ifndef _WIN32
+  std::string filename = this->WriteFile(this->TextLog());
+
+  util::LogExtract extract;
+  ASSERT_TRUE(extract.SetFilter("rob*/base.velocity.[x,a]/hinge"));
+  std::ostringstream out;
+  ASSERT_TRUE(extract.Extract(filename, out));
+
+  EXPECT_EQ(boost::algorithm::join(extract.Columns(), ","),
+      "sim_time,robot::base.velocity.x,robot::base.velocity.a,"
+      "robot::hinge.angle.0,robot::hinge.angle.1");
+
+  auto lines = this->Split(out.str());
+  ASSERT_EQ(lines.size(), kFrames + 1);
+  EXPECT_EQ(lines[8][1], "7");
+  EXPECT_EQ(lines[8][2], "-1");
+  EXPECT_DOUBLE_EQ(std::stod(lines[8][3]), 0.7);
+  EXPECT_EQ(lines[8][4], "-7");
+
+  // Model pose with a single axis
+  ASSERT_TRUE(extract.SetFilter("robot.pose.[z,y]//hinge.[1]"));
+  out.str("");
+  ASSERT_TRUE(extract.Extract(filename, out));
+  EXPECT_EQ(boost::algorithm::join(extract.Columns(), ","),
+      "sim_time,robot.pose.z,robot.pose.y,robot::hinge.angle.1");
+  lines = this->Split(out.str());
+  ASSERT_EQ(lines.size(), kFrames + 1);
+  EXPECT_EQ(boost::algorithm::join(lines[3], ","), "0.200000000,3,2,-2");
+
+  // No matching model
+  ASSERT_TRUE(extract.SetFilter("nothing"));
+  out.str("");
+  ASSERT_TRUE(extract.Extract(filename, out));
+  EXPECT_EQ(extract.Columns().size(), 1u);
+  EXPECT_EQ(extract.Stats().rows, kFrames);
+
+  // Invalid filters
+  EXPECT_FALSE(extract.SetFilter("robot.velocity"));
+  EXPECT_FALSE(extract.SetFilter("robot/base.force"));
+  EXPECT_FALSE(extract.SetFilter("robot/base.pose.[q]"));
+  EXPECT_FALSE(extract.SetFilter("robot//hinge.[x]"));
+  EXPECT_FALSE(extract.SetFilter("a/b/c/d"));
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Extract a binary log into binary columns, skipping frames.
+TEST_F(LogExtract_TEST, Binary)
+{
+#ifndef _WIN32
+  std::string filename = this->WriteFile(this->BinaryLog());
+
+  util::LogExtract extract;
+  ASSERT_TRUE(extract.SetFilter("robot.pose.[x]"));
+  extract.SetFormat(util::LogExtract::BINARY);
+  extract.SetStartTime(common::Time(1, 500000000));
+  std::ostringstream stream;
+  ASSERT_TRUE(extract.Extract(filename, stream));
+  const std::string out = stream.str();
+
+  auto readUint = [&out](size_t &_pos)
+  {
+    uint32_t value = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+      value |= static_cast<uint32_t>(static_cast<uint8_t>(out[_pos++])) << 8*i;
+    return value;
+  };
+  auto readDouble = [&out](size_t &_pos)
+  {
+    uint64_t bits = 0;
+    for (unsigned int i = 0; i < 8; ++i)
+      bits |= static_cast<uint64_t>(static_cast<uint8_t>(out[_pos++])) << 8*i;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  };
+
+  ASSERT_GT(out.size(), 16u);
+  EXPECT_EQ(out.substr(0, 8), "GZLOGCOL");
+  size_t pos = 8;
+  EXPECT_EQ(readUint(pos), 1u);
+  ASSERT_EQ(readUint(pos), 2u);
+  for (auto const &name : {"sim_time", "robot.pose.x"})
+  {
+    uint32_t length = readUint(pos);
+    EXPECT_EQ(out.substr(pos, length), name);
+    pos += length;
+  }
+
+  // Frames before 1.5 seconds are skipped
+  std::vector<double> times;
+  std::vector<double> values;
+  while (pos < out.size())
+  {
+    uint32_t rows = readUint(pos);
+    ASSERT_LE(pos + rows * 16, out.size());
+    for (uint32_t i = 0; i < rows; ++i)
+      times.push_back(readDouble(pos));
+    for (uint32_t i = 0; i < rows; ++i)
+      values.push_back(readDouble(pos));
+  }
+  ASSERT_EQ(times.size(), kFrames - 15);
+  EXPECT_DOUBLE_EQ(times[0], 1.5);
+  EXPECT_DOUBLE_EQ(values[0], 15);
+  EXPECT_DOUBLE_EQ(times.back(), (kFrames - 1) * 0.1);
+  EXPECT_DOUBLE_EQ(values.back(), kFrames - 1);
+  EXPECT_EQ(extract.Stats().frames, kFrames);
+  EXPECT_EQ(extract.Stats().rows, kFrames - 15);
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the output doesn't depend on the number of threads.
+TEST_F(LogExtract_TEST, Threads)
+{
+#ifndef _WIN32
+  std::string filename = this->WriteFile(this->TextLog());
+
+  util::LogExtract extract;
+  ASSERT_TRUE(extract.SetFilter("*/*/*"));
+  extract.SetThreads(1);
+  std::ostringstream single;
+  ASSERT_TRUE(extract.Extract(filename, single));
+
+  for (unsigned int threads : {2u, 8u, 0u})
+  {
+    extract.SetThreads(threads);
+    std::ostringstream multiple;
+    ASSERT_TRUE(extract.Extract(filename, multiple));
+    EXPECT_EQ(single.str(), multiple.str()) << threads << " threads";
+  }
+
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Check invalid logs.
+TEST_F(LogExtract_TEST, Invalid)
+{
+  util::LogExtract extract;
+  std::ostringstream out;
+  EXPECT_FALSE(extract.Extract("/__no_such_file__", out));
+
+#ifndef _WIN32
+  // Corrupted compressed chunk
+  std::string filename = this->WriteFile("<gazebo_log>\n" +
+      this->Chunk("txt", this->World()) +
+      "<chunk encoding='zlib'>\n<![CDATA[AAAA]]>\n</chunk>\n</gazebo_log>\n");
+  EXPECT_FALSE(extract.Extract(filename, out));
+  std::remove(filename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
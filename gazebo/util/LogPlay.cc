@@ -23,6 +23,10 @@
 #endif
 
 #include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -37,6 +41,7 @@
 
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Base64.hh"
@@ -72,6 +77,13 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
+  if (LogBinaryReader::IsBinaryLog(_logFile))
+  {
+    this->OpenBinary(_logFile);
+    return;
+  }
+  this->dataPtr->binaryReader.reset();
+
   // Flag use to indicate if a parser failure has occurred
   bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
     tinyxml2::XML_SUCCESS;
@@ -150,6 +162,9 @@ void LogPlay::Open(const std::string &_logFile)
   this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
   this->dataPtr->encoding.clear();
 
+  // Get the time and iterations of each chunk.
+  this->dataPtr->LoadChunkIndex();
+
   // Extract the start/end log times from the log.
   this->ReadLogTimes();
 
@@ -172,6 +187,41 @@ void LogPlay::Open(const std::string &_logFile)
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 }
 
+/////////////////////////////////////////////////
+void LogPlay::OpenBinary(const std::string &_logFile)
+{
+  this->dataPtr->binaryReader.reset(new LogBinaryReader);
+  if (!this->dataPtr->binaryReader->Open(_logFile))
+  {
+    this->dataPtr->binaryReader.reset();
+    gzthrow("Error parsing log file");
+  }
+
+  // Only the header of a binary log is XML. Wrap it, so that the rest of
+  // the class finds it where it is in text logs.
+  std::string header = "<gazebo_log>" +
+    this->dataPtr->binaryReader->Header() + "</gazebo_log>";
+  if (this->dataPtr->xmlDoc.Parse(header.c_str()) != tinyxml2::XML_SUCCESS)
+    gzthrow("Unable to parse the header of log file[" + _logFile + "]");
+
+  this->dataPtr->logStartXml =
+    this->dataPtr->xmlDoc.FirstChildElement("gazebo_log");
+  this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
+  this->dataPtr->filename = _logFile;
+  this->dataPtr->encoding = "binary";
+
+  this->ReadHeader();
+  this->dataPtr->LoadChunkIndex();
+  this->ReadLogTimes();
+  this->dataPtr->iterationsFound = this->ReadIterations();
+
+  if (!this->Chunk(0, this->dataPtr->currentChunk))
+    gzthrow("Unable to decode log file");
+
+  this->dataPtr->start = 0;
+  this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Header() const
 {
@@ -258,115 +308,32 @@ void LogPlay::ReadHeader()
 /////////////////////////////////////////////////
 void LogPlay::ReadLogTimes()
 {
-  std::string chunk;
   bool found = false;
-
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  // Try to read the start time of the log.
-  auto numChunksToTry =
-    std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
-
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (auto const &info : this->dataPtr->chunkIndex)
   {
-    if (!chunkXml)
-    {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return;
-    }
-
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return;
+    if (!info.hasTime)
+      continue;
 
-    // Find the first <sim_time> of the log.
-    auto from = chunk.find(this->dataPtr->kStartTime);
-    auto to = chunk.find(this->dataPtr->kEndTime,
-        from + this->dataPtr->kStartTime.size());
-    if (from != std::string::npos && to != std::string::npos)
-    {
-      auto length = to - from - this->dataPtr->kStartTime.size();
-      auto startTime = chunk.substr(from + this->dataPtr->kStartTime.size(),
-          length);
-      std::stringstream ss(startTime);
-      ss >> this->dataPtr->logStartTime;
-      found = true;
-      break;
-    }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
+    if (!found)
+      this->dataPtr->logStartTime = info.startTime;
+    this->dataPtr->logEndTime = info.endTime;
+    found = true;
   }
 
   if (!found)
     gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
-
-  // Jump to the last chunk for finding the last <sim_time>.
-  auto lastChunk = this->dataPtr->logStartXml->LastChildElement("chunk");
-  if (!lastChunk)
-  {
-    gzerr << "Unable to jump to the last chunk of the log file\n";
-    return;
-  }
-
-  if (!this->dataPtr->ChunkData(lastChunk, chunk))
-    return;
-
-  // Update the last <sim_time> of the log.
-  auto to = chunk.rfind(this->dataPtr->kEndTime);
-  auto from = chunk.rfind(this->dataPtr->kStartTime, to - 1);
-
-  if (from != std::string::npos && to != std::string::npos)
-  {
-    auto length = to - from - this->dataPtr->kStartTime.size();
-    auto endTime = chunk.substr(
-        from + this->dataPtr->kStartTime.size(), length);
-    std::stringstream ss(endTime);
-    ss >> this->dataPtr->logEndTime;
-  }
-  else
-  {
-    gzwarn << "Unable to find <sim_time>...</sim_time> tags in the last chunk."
-           << std::endl;
-    return;
-  }
 }
 
 /////////////////////////////////////////////////
 bool LogPlay::ReadIterations()
 {
-  const std::string kStartDelim = "<iterations>";
-  const std::string kEndDelim = "</iterations>";
-
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  // Read the first "iterations" value of the log from the first chunk.
-  auto numChunksToTry =
-    std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
-
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (auto const &info : this->dataPtr->chunkIndex)
   {
-    if (!chunkXml)
-    {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return false;
-    }
-
-    std::string chunk;
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return false;
-
-    // Find the first <iterations> of the log.
-    auto from = chunk.find(kStartDelim);
-    auto to = chunk.find(kEndDelim, from + kStartDelim.size());
-    if (from != std::string::npos && to != std::string::npos)
+    if (info.hasIterations)
     {
-      auto length = to - from - kStartDelim.size();
-      auto iterations = chunk.substr(from + kStartDelim.size(), length);
-      std::stringstream ss(iterations);
-      ss >> this->dataPtr->initialIterations;
+      this->dataPtr->initialIterations = info.iterations;
       return true;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   gzwarn << "Unable to find <iterations>...</iterations> tags in the first "
@@ -536,19 +503,32 @@ bool LogPlay::Rewind()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
 
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binaryReader)
   {
-    gzerr << "Unable to jump to the beginning of the log file\n";
-    return false;
+    this->dataPtr->currentBlock = 0;
+    if (!this->dataPtr->binaryReader->Block(0, this->dataPtr->currentChunk))
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
   }
-
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  else
   {
-    return false;
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->FirstChildElement("chunk");
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   // Skip first <sdf> block (it doesn't have a world state).
@@ -576,19 +556,33 @@ bool LogPlay::Forward()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binaryReader)
   {
-    gzerr << "Unable to jump to the end of the log file\n";
-    return false;
+    auto count = this->dataPtr->binaryReader->Blocks().size();
+    this->dataPtr->currentBlock = count > 0 ? count - 1 : 0;
+    if (!this->dataPtr->binaryReader->Block(this->dataPtr->currentBlock,
+          this->dataPtr->currentChunk))
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
   }
-
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  else
   {
-    return false;
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->LastChildElement("chunk");
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
@@ -608,88 +602,77 @@ bool LogPlay::Seek(const common::Time &_time)
     return true;
   }
 
-  common::Time logTime = this->dataPtr->logStartTime;
-
-  // 1st step: Locate the chunk: We're looking for the first chunk that has
-  // a time greater than the target time.
-  int64_t imin = 0;
-  int64_t imax = this->ChunkCount() - 1;
-  while (imin <= imax)
+  // Use the index to find the last chunk that starts before the target
+  // time. It contains the frame we are looking for, so it is the only
+  // chunk that needs to be decoded.
+  unsigned int index = 0;
+  for (unsigned int i = 0; i < this->dataPtr->chunkIndex.size(); ++i)
   {
-    int64_t imid = imin + ((imax - imin) / 2);
-    this->Chunk(imid, this->dataPtr->currentChunk);
-
-    this->dataPtr->start = 0;
-    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
-
-    // We try a few times looking for <sim_time>.
-    for (unsigned int i = 0; i < 2; ++i)
+    const LogPlayChunkInfo &info = this->dataPtr->chunkIndex[i];
+    if (info.hasTime)
     {
-      std::string frame;
-      if (!this->Step(frame))
-        return false;
-
-      // Search the <sim_time> in the first frame of the current chunk.
-      auto from = frame.find(this->dataPtr->kStartTime);
-      auto to = frame.find(
-          this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
-      if (from != std::string::npos && to != std::string::npos)
-      {
-        auto length = to - from - this->dataPtr->kStartTime.size();
-        auto logTimeStr = frame.substr(
-            from + this->dataPtr->kStartTime.size(), length);
-        std::stringstream ss(logTimeStr);
-        ss >> logTime;
+      if (info.startTime >= _time)
         break;
-      }
+      index = i;
     }
-
-    // Chunk found.
-    if (logTime == _time)
-      break;
-    else if (logTime < _time)
-      imin = imid + 1;
-    else
-      imax = imid - 1;
   }
 
-  if (logTime < _time)
-  {
-    if (!this->NextChunk())
-      this->Forward();
-  }
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->Chunk(index, this->dataPtr->currentChunk))
+    return false;
 
-  // 2nd step: Locate the frame in the previous chunk.
+  // Find the last frame of the chunk with a time lower than the target.
+  // The first frame of the chunk is used when there is none, which only
+  // happens when seeking before the start of the log.
+  const std::string &chunk = this->dataPtr->currentChunk;
+  size_t start = std::string::npos;
+  size_t end = std::string::npos;
+  size_t pos = 0;
   while (true)
   {
-    std::string frame;
-    if (!this->StepBack(frame))
+    auto from = chunk.find(this->dataPtr->kStartFrame, pos);
+    auto to = chunk.find(this->dataPtr->kEndFrame, from);
+    if (from == std::string::npos || to == std::string::npos)
       break;
+    pos = to + this->dataPtr->kEndFrame.size();
 
-    // Search the <sim_time> in the frame of the current chunk.
-    auto from = frame.find(this->dataPtr->kStartTime);
-    auto to = frame.find(
-        this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
-    if (from != std::string::npos && to != std::string::npos)
+    // Frames without a <sim_time> are only used when there is no other.
+    common::Time frameTime;
+    bool hasTime = this->dataPtr->FrameTime(chunk, from, to, frameTime);
+    if (start == std::string::npos || (hasTime && frameTime < _time))
     {
-      auto length = to - from - this->dataPtr->kStartTime.size();
-      auto logTimeStr = frame.substr(
-          from + this->dataPtr->kStartTime.size(), length);
-      std::stringstream ss(logTimeStr);
-      ss >> logTime;
-
-      // frame found.
-      if (logTime < _time)
-        break;
+      start = from;
+      end = to;
     }
+
+    if (hasTime && frameTime >= _time)
+      break;
+  }
+
+  if (start == std::string::npos)
+  {
+    gzerr << "Unable to find an <sdf> frame in chunk " << index << std::endl;
+    return false;
   }
 
+  this->dataPtr->start = start;
+  this->dataPtr->end = end;
+
   return true;
 }
 
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
+  if (this->dataPtr->binaryReader)
+  {
+    if (!this->dataPtr->binaryReader->Block(_index, _data))
+      return false;
+    this->dataPtr->currentBlock = _index;
+    return true;
+  }
+
   unsigned int count = 0;
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
@@ -778,6 +761,241 @@ bool LogPlayPrivate::ChunkData(
   return true;
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the directory of the log index files. Indices are kept out
+/// of the directories of the logs, which may be read-only or under version
+/// control.
+/// \return Path to the directory, empty if indices are disabled.
+static std::string logIndexPath()
+{
+  const char *path = common::getEnv("GAZEBO_LOG_INDEX_PATH");
+  if (path)
+    return path;
+
+#ifndef _WIN32
+  const char *homePath = common::getEnv("HOME");
+#else
+  const char *homePath = common::getEnv("HOMEPATH");
+#endif
+  if (!homePath)
+    return "";
+  return (boost::filesystem::path(homePath) / ".gazebo" / "log_index")
+    .string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a fingerprint of a log file, used to detect a stale index.
+/// Modification times may only have a one second resolution, so the
+/// fingerprint also holds the size and a hash of both ends of the file.
+/// \param[in] _filename Path to the log file.
+/// \param[out] _fingerprint The fingerprint.
+/// \return False if the file can't be read.
+static bool logFingerprint(const std::string &_filename,
+    std::string &_fingerprint)
+{
+  boost::system::error_code ec;
+  auto size = boost::filesystem::file_size(_filename, ec);
+  auto writeTime = boost::filesystem::last_write_time(_filename, ec);
+  std::ifstream in(_filename, std::ios::binary);
+  if (ec || !in)
+    return false;
+
+  // Text logs grow at the end, and start with their header
+  const uintmax_t kSampleSize = 64 * 1024;
+  std::string sample(std::min(size, 2 * kSampleSize), '\0');
+  const size_t head = std::min<uintmax_t>(size, kSampleSize);
+  in.read(&sample[0], head);
+  in.seekg(size - (sample.size() - head));
+  in.read(&sample[head], sample.size() - head);
+  if (!in)
+    return false;
+
+  std::ostringstream stream;
+  stream << size << " " << writeTime << " " << std::hex
+         << std::hash<std::string>()(sample);
+  _fingerprint = stream.str();
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string LogPlayPrivate::IndexFilename() const
+{
+  std::string path = logIndexPath();
+  if (path.empty())
+    return "";
+
+  // The log path is stored in the index, in case of a hash collision.
+  std::ostringstream name;
+  name << std::hex << std::hash<std::string>()(
+      boost::filesystem::absolute(this->filename).string())
+       << this->kIndexExtension;
+  return (boost::filesystem::path(path) / name.str()).string();
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::LoadChunkIndex()
+{
+  this->chunkIndex.clear();
+
+  // Get the first <iterations> of a chunk.
+  auto readIterations = [](const std::string &_data, LogPlayChunkInfo &_info)
+  {
+    static const std::string kStartIterations = "<iterations>";
+    auto from = _data.find(kStartIterations);
+    if (from != std::string::npos)
+    {
+      std::stringstream ss(_data.substr(from + kStartIterations.size(), 32));
+      _info.hasIterations = static_cast<bool>(ss >> _info.iterations);
+    }
+    return _info.hasIterations;
+  };
+
+  std::string data;
+
+  // Binary logs end with the times of their blocks. Only the blocks up to
+  // the first one with <iterations> are decoded.
+  if (this->binaryReader)
+  {
+    for (auto const &block : this->binaryReader->Blocks())
+    {
+      LogPlayChunkInfo info;
+      info.hasTime = block.hasTime;
+      info.startTime = block.startTime;
+      info.endTime = block.endTime;
+      this->chunkIndex.push_back(info);
+    }
+
+    for (size_t i = 0; i < this->chunkIndex.size(); ++i)
+    {
+      if (this->binaryReader->Block(i, data) &&
+          readIterations(data, this->chunkIndex[i]))
+      {
+        break;
+      }
+    }
+    return;
+  }
+
+  const std::string indexFilename = this->IndexFilename();
+  std::string fingerprint;
+  const bool useIndex = !indexFilename.empty() &&
+    logFingerprint(this->filename, fingerprint);
+  if (useIndex && this->ReadChunkIndex(indexFilename, fingerprint))
+    return;
+
+  // Decode every chunk once. Chunks that can't be decoded still get an
+  // entry, so that the index matches the chunk numbering.
+  for (auto xml = this->logStartXml->FirstChildElement("chunk"); xml;
+       xml = xml->NextSiblingElement("chunk"))
+  {
+    if (!this->ChunkData(xml, data))
+      data.clear();
+
+    LogPlayChunkInfo info;
+
+    // Frames are in chronological order.
+    info.hasTime = this->FrameTime(data, 0, data.size(), info.startTime);
+    if (info.hasTime)
+    {
+      this->FrameTime(data, data.rfind(this->kStartTime), data.size(),
+          info.endTime);
+    }
+    readIterations(data, info);
+
+    this->chunkIndex.push_back(info);
+  }
+
+  if (useIndex)
+    this->WriteChunkIndex(indexFilename, fingerprint);
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadChunkIndex(const std::string &_indexFilename,
+    const std::string &_fingerprint)
+{
+  this->chunkIndex.clear();
+
+  std::ifstream in(_indexFilename);
+  if (!in)
+    return false;
+
+  // The index is only valid for the log it was created from, as it was
+  // when the index was created.
+  std::string version;
+  std::string logPath;
+  std::string fingerprint;
+  size_t count;
+  if (!std::getline(in, version) || version != this->kIndexVersion ||
+      !std::getline(in, logPath) ||
+      logPath != boost::filesystem::absolute(this->filename).string() ||
+      !std::getline(in, fingerprint) || fingerprint != _fingerprint ||
+      !(in >> count))
+  {
+    return false;
+  }
+
+  this->chunkIndex.resize(count);
+  for (auto &info : this->chunkIndex)
+  {
+    in >> info.hasTime >> info.startTime >> info.endTime
+       >> info.hasIterations >> info.iterations;
+  }
+
+  if (!in)
+  {
+    gzwarn << "Ignoring corrupted log index[" << _indexFilename << "]\n";
+    this->chunkIndex.clear();
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::WriteChunkIndex(const std::string &_indexFilename,
+    const std::string &_fingerprint) const
+{
+  // Without a writable index directory, the index is rebuilt every time
+  // the log is opened.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(
+      boost::filesystem::path(_indexFilename).parent_path(), ec);
+  std::ofstream out(_indexFilename);
+  if (ec || !out)
+  {
+    gzlog << "Unable to write log index[" << _indexFilename << "]\n";
+    return;
+  }
+
+  out << this->kIndexVersion << "\n"
+      << boost::filesystem::absolute(this->filename).string() << "\n"
+      << _fingerprint << "\n"
+      << this->chunkIndex.size() << "\n";
+  for (auto const &info : this->chunkIndex)
+  {
+    out << info.hasTime << " " << info.startTime << " " << info.endTime << " "
+        << info.hasIterations << " " << info.iterations << "\n";
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::FrameTime(const std::string &_data, const size_t _from,
+    const size_t _to, common::Time &_time) const
+{
+  auto from = _data.find(this->kStartTime, _from);
+  if (from == std::string::npos || from >= _to)
+    return false;
+
+  from += this->kStartTime.size();
+  auto to = _data.find(this->kEndTime, from);
+  if (to == std::string::npos || to > _to)
+    return false;
+
+  std::stringstream ss(_data.substr(from, to - from));
+  ss >> _time;
+  return true;
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Encoding() const
 {
@@ -787,6 +1005,9 @@ std::string LogPlay::Encoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::ChunkCount() const
 {
+  if (this->dataPtr->binaryReader)
+    return this->dataPtr->binaryReader->Blocks().size();
+
   unsigned int count = 0;
   auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
@@ -802,15 +1023,27 @@ unsigned int LogPlay::ChunkCount() const
 /////////////////////////////////////////////////
 bool LogPlay::NextChunk()
 {
-  auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
-  if (!next)
-    return false;
-
-  this->dataPtr->logCurrXml = next;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  if (this->dataPtr->binaryReader)
   {
-    return false;
+    if (this->dataPtr->currentBlock + 1 >= this->ChunkCount() ||
+        !this->Chunk(this->dataPtr->currentBlock + 1,
+                     this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
+    if (!next)
+      return false;
+
+    this->dataPtr->logCurrXml = next;
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   this->dataPtr->start = 0;
@@ -822,15 +1055,27 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
-  auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
-  if (!prev)
-    return false;
-
-  this->dataPtr->logCurrXml = prev;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  if (this->dataPtr->binaryReader)
   {
-    return false;
+    if (this->dataPtr->currentBlock == 0 ||
+        !this->Chunk(this->dataPtr->currentBlock - 1,
+                     this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
+    if (!prev)
+      return false;
+
+    this->dataPtr->logCurrXml = prev;
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
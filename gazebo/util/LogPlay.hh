@@ -57,7 +57,15 @@ namespace gazebo
 
       /// \brief Open a log file for reading
       ///
-      /// Open a log file that was previously recorded.
+      /// Open a log file that was previously recorded. Logs recorded with
+      /// the "binary" encoding are read one block at a time, using the
+      /// index stored in the log.
+      ///
+      /// The simulation time and iterations of every chunk of a text log are
+      /// indexed when the log is opened for the first time. The index is
+      /// saved in the GAZEBO_LOG_INDEX_PATH directory, ~/.gazebo/log_index
+      /// by default, and reused until the log changes. An empty
+      /// GAZEBO_LOG_INDEX_PATH disables the index files.
       /// \param[in] _logFile The file to load
       /// \throws Exception When the log file does not exist, is a directory
       /// instead of a regular file, or Gazebo was unable to parse it.
@@ -116,7 +124,8 @@ namespace gazebo
       public: bool Step(const int _step, std::string &_data);
 
       /// \brief Jump to the closest sample that has its simulation time lower
-      /// than the time specified as a parameter.
+      /// than the time specified as a parameter. Only the chunk holding that
+      /// sample is decoded.
       /// \param[in] _time Target simulation time.
       /// \return True if operation succeed or false otherwise.
       public: bool Seek(const common::Time &_time);
@@ -143,7 +152,8 @@ namespace gazebo
       /// \brief Get the type of encoding used for current chunck in the
       /// open log file.
       /// \return The type of encoding. An empty string will be returned if
-      /// LogPlay::Step has not been called at least once.
+      /// LogPlay::Step has not been called at least once. Always "binary"
+      /// for binary logs.
       public: std::string Encoding() const;
 
       /// \brief Get the header that was read from a log file. Should call
@@ -161,6 +171,11 @@ namespace gazebo
       /// false otherwise.
       public: bool HasIterations() const;
 
+      /// \brief Open a log file recorded with the "binary" encoding.
+      /// \param[in] _logFile The file to load
+      /// \throws Exception When Gazebo was unable to parse the file.
+      private: void OpenBinary(const std::string &_logFile);
+
       /// \brief Read the header from the log file.
       private: void ReadHeader();
 
@@ -25,16 +25,39 @@
 #include <tinyxml2.h>
 #endif
 
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinary.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
 {
   namespace util
   {
+    /// \internal
+    /// \brief Simulation time and iterations of the frames of a log chunk.
+    class LogPlayChunkInfo
+    {
+      /// \brief True if a frame of the chunk has a <sim_time>.
+      public: bool hasTime = false;
+
+      /// \brief First <sim_time> of the chunk.
+      public: common::Time startTime;
+
+      /// \brief Last <sim_time> of the chunk.
+      public: common::Time endTime;
+
+      /// \brief True if a frame of the chunk has <iterations>.
+      public: bool hasIterations = false;
+
+      /// \brief First <iterations> of the chunk.
+      public: uint64_t iterations = 0;
+    };
+
     /// \internal
     /// \brief Private data for log play
     class LogPlayPrivate
@@ -47,8 +70,46 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
-      /// \brief Max number of chunks to inspect when looking for XML elements.
-      public: const unsigned int kNumChunksToTry = 2u;
+      /// \brief Fill the chunk index of the open log. Binary logs store
+      /// the times of their blocks. For text logs, the index is read from
+      /// the index file of the log when it is up to date. Otherwise every
+      /// chunk is decoded once, and the index file is written for the next
+      /// time.
+      public: void LoadChunkIndex();
+
+      /// \brief Get the path to the index file of the open log, in the
+      /// GAZEBO_LOG_INDEX_PATH directory, or ~/.gazebo/log_index by
+      /// default.
+      /// \return The path, empty if GAZEBO_LOG_INDEX_PATH is empty.
+      public: std::string IndexFilename() const;
+
+      /// \brief Read an index file.
+      /// \param[in] _indexFilename Path to the index file.
+      /// \param[in] _fingerprint Fingerprint of the open log.
+      /// \return True if the file exists and matches the open log.
+      public: bool ReadChunkIndex(const std::string &_indexFilename,
+                  const std::string &_fingerprint);
+
+      /// \brief Write the chunk index to a file.
+      /// \param[in] _indexFilename Path to the index file.
+      /// \param[in] _fingerprint Fingerprint of the open log.
+      public: void WriteChunkIndex(const std::string &_indexFilename,
+                  const std::string &_fingerprint) const;
+
+      /// \brief Get the simulation time of a frame.
+      /// \param[in] _data Data holding the frame.
+      /// \param[in] _from Start of the frame in _data.
+      /// \param[in] _to End of the frame in _data.
+      /// \param[out] _time Simulation time of the frame.
+      /// \return False if the frame has no <sim_time>.
+      public: bool FrameTime(const std::string &_data, const size_t _from,
+                  const size_t _to, common::Time &_time) const;
+
+      /// \brief Version of the chunk index file format.
+      public: const std::string kIndexVersion = "2";
+
+      /// \brief Extension of the chunk index files.
+      public: const std::string kIndexExtension = ".idx";
 
       /// \brief XML tag delimiting the beginning of a frame.
       public: const std::string kStartFrame = "<sdf ";
@@ -90,6 +151,13 @@ namespace gazebo
       /// \brief Log end time (simulation time).
       public: common::Time logEndTime;
 
+      /// \brief Reader of the open log when it uses the "binary" encoding,
+      /// nullptr otherwise. The blocks of a binary log are its chunks.
+      public: std::unique_ptr<LogBinaryReader> binaryReader;
+
+      /// \brief Index of the current chunk of a binary log.
+      public: unsigned int currentBlock = 0;
+
       /// \brief The encoding for the current chunk in the log file.
       public: std::string encoding;
 
@@ -104,6 +172,9 @@ namespace gazebo
       /// This variable points to the end of the last frame dispatched.
       public: size_t end = 0;
 
+      /// \brief Time and iteration span of every chunk of the open log.
+      public: std::vector<LogPlayChunkInfo> chunkIndex;
+
       /// \brief Initial simulation iteration contained in the log file.
       public: uint64_t initialIterations = 0;
 
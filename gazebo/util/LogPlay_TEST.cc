@@ -17,10 +17,14 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogBinary.hh"
 #include "gazebo/util/LogPlay.hh"
 #include "test_config.h"
 #include "test/util.hh"
@@ -457,6 +461,195 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the chunk index saved for a log file.
+TEST_F(LogPlay_TEST, ChunkIndex)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  std::ifstream srcFile(std::string(TEST_PATH) + "/logs/state.log",
+      std::ios::binary);
+  ASSERT_TRUE(srcFile.good());
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_index_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::string indexPath = tmpFilename + "_index";
+  boost::filesystem::remove_all(indexPath);
+  ASSERT_EQ(0, setenv("GAZEBO_LOG_INDEX_PATH", indexPath.c_str(), 1));
+
+  std::ofstream destFile(tmpFilename, std::ios::binary);
+  ASSERT_TRUE(destFile.good());
+  destFile << srcFile.rdbuf();
+  destFile.close();
+
+  // The index is created in the index directory when the log is opened for
+  // the first time, not next to the log.
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  std::vector<boost::filesystem::path> indexFiles;
+  for (boost::filesystem::directory_iterator iter(indexPath);
+       iter != boost::filesystem::directory_iterator(); ++iter)
+  {
+    indexFiles.push_back(iter->path());
+  }
+  ASSERT_EQ(1u, indexFiles.size());
+  std::string indexFilename = indexFiles[0].string();
+  EXPECT_FALSE(boost::filesystem::exists(tmpFilename + ".idx"));
+
+  common::Time startTime = player->LogStartTime();
+  common::Time endTime = player->LogEndTime();
+  uint64_t iterations = player->InitialIterations();
+  EXPECT_LT(startTime, endTime);
+
+  std::string frame, expectedFrame;
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(expectedFrame));
+
+  // Then reused.
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_EQ(player->LogStartTime(), startTime);
+  EXPECT_EQ(player->LogEndTime(), endTime);
+  EXPECT_EQ(player->InitialIterations(), iterations);
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(frame, expectedFrame);
+
+  // Read the index, and give it a wrong start time.
+  std::string index;
+  {
+    std::ifstream indexFile(indexFilename);
+    index.assign(std::istreambuf_iterator<char>(indexFile),
+        std::istreambuf_iterator<char>());
+  }
+  {
+    // Keep the header, which holds the fingerprint of the log.
+    std::istringstream in(index);
+    std::string line;
+    std::ostringstream out;
+    for (int i = 0; i < 4 && std::getline(in, line); ++i)
+      out << line << "\n";
+
+    bool hasTime;
+    common::Time chunkStart, chunkEnd;
+    in >> hasTime >> chunkStart >> chunkEnd;
+    out << true << " " << common::Time(1, 0) << " " << chunkEnd;
+    out << in.rdbuf();
+    std::ofstream indexFile(indexFilename);
+    indexFile << out.str();
+  }
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_EQ(player->LogStartTime(), common::Time(1, 0));
+
+  // A change that keeps the size and the modification time of the log
+  // invalidates the index.
+  {
+    auto writeTime = boost::filesystem::last_write_time(tmpFilename);
+    std::fstream logFile(tmpFilename,
+        std::ios::in | std::ios::out | std::ios::binary);
+    std::string log((std::istreambuf_iterator<char>(logFile)),
+        std::istreambuf_iterator<char>());
+    auto seed = log.find("<rand_seed>");
+    ASSERT_NE(std::string::npos, seed);
+    seed += std::string("<rand_seed>").size();
+    logFile.seekp(seed);
+    logFile.put(log[seed] == '1' ? '2' : '1');
+    logFile.close();
+    boost::filesystem::last_write_time(tmpFilename, writeTime);
+  }
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_EQ(player->LogStartTime(), startTime);
+  EXPECT_EQ(player->LogEndTime(), endTime);
+
+  // A corrupted index is rebuilt.
+  {
+    std::ofstream indexFile(indexFilename);
+    indexFile << "garbage";
+  }
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_EQ(player->LogStartTime(), startTime);
+  EXPECT_EQ(player->LogEndTime(), endTime);
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(frame, expectedFrame);
+
+  unsetenv("GAZEBO_LOG_INDEX_PATH");
+  boost::filesystem::remove_all(indexPath);
+  std::remove(tmpFilename.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Test playing a log converted to the binary encoding.
+TEST_F(LogPlay_TEST, Binary)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Convert the text log.
+  std::vector<std::string> frames;
+  std::string frame;
+  while (player->Step(frame))
+    frames.push_back(frame);
+  ASSERT_GT(frames.size(), 1000u);
+
+  gazebo::util::LogBinaryWriter writer;
+  std::string buffer;
+  writer.Start("<header>\n<log_version>" + player->LogVersion() +
+      "</log_version>\n<gazebo_version>" + player->GazeboVersion() +
+      "</gazebo_version>\n<rand_seed>" + std::to_string(player->RandSeed()) +
+      "</rand_seed>\n</header>\n", buffer);
+  for (auto const &f : frames)
+    writer.AddFrames(f, buffer);
+  writer.Finish(buffer);
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_binary_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::ofstream destFile(tmpFilename, std::ios::binary);
+  ASSERT_TRUE(destFile.good());
+  destFile << buffer;
+  destFile.close();
+
+  // The binary log replays the same frames.
+  common::Time startTime = player->LogStartTime();
+  common::Time endTime = player->LogEndTime();
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  EXPECT_EQ(player->Encoding(), "binary");
+  EXPECT_EQ(player->ChunkCount(), writer.Blocks().size());
+  EXPECT_EQ(player->LogStartTime(), startTime);
+  EXPECT_EQ(player->LogEndTime(), endTime);
+
+  for (auto const &f : frames)
+  {
+    ASSERT_TRUE(player->Step(frame));
+    EXPECT_EQ(frame, f);
+  }
+  EXPECT_FALSE(player->Step(frame));
+
+  // Stepping back crosses block boundaries.
+  for (size_t i = frames.size() - 1; i-- > 0;)
+  {
+    ASSERT_TRUE(player->StepBack(frame));
+    EXPECT_EQ(frame, frames[i]);
+  }
+
+  // Rewind skips the world description.
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(frame, frames[1]);
+
+  std::remove(tmpFilename.c_str());
+#endif
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -32,6 +32,7 @@
 #include <boost/archive/iterators/transform_width.hpp>
 #include <boost/archive/iterators/ostream_iterator.hpp>
 
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/date_time.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -138,7 +139,7 @@ bool LogRecord::Init(const std::string &_subdir)
 bool LogRecord::Start(const LogRecordParams &_params)
 {
   this->dataPtr->period = _params.period;
-  this->dataPtr->filter = _params.filter;
+  this->SetFilter(_params.filter);
   this->dataPtr->recordResources = _params.recordResources;
   return this->Start(_params.encoding, _params.path);
 }
@@ -186,9 +187,12 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != "binary")
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, txt, binary]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
@@ -325,13 +329,44 @@ void LogRecord::SetPeriod(const double _period)
 //////////////////////////////////////////////////
 std::string LogRecord::Filter() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
   return this->dataPtr->filter;
 }
 
 //////////////////////////////////////////////////
 void LogRecord::SetFilter(const std::string &_filter)
 {
+  // Only the first element of the filter, the model name, selects what is
+  // recorded. For example "pr2*.link/joint" records the models named
+  // "pr2*".
+  std::string modelFilter = _filter.substr(0, _filter.find('/'));
+  modelFilter = modelFilter.substr(0, modelFilter.find('.'));
+
+  std::shared_ptr<const boost::regex> regex;
+  if (!modelFilter.empty() && modelFilter != "*")
+  {
+    boost::replace_all(modelFilter, "*", ".*");
+    try
+    {
+      regex.reset(new boost::regex(modelFilter));
+    }
+    catch(const boost::regex_error &_e)
+    {
+      gzerr << "Invalid log filter[" << _filter << "]: " << _e.what()
+            << ". Recording all models." << std::endl;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
   this->dataPtr->filter = _filter;
+  this->dataPtr->filterRegex = regex;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const boost::regex> LogRecord::FilterRegex() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
+  return this->dataPtr->filterRegex;
 }
 
 //////////////////////////////////////////////////
@@ -792,7 +827,12 @@ unsigned int LogRecordPrivate::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->binaryWriter)
+    {
+      // Binary logs are made of records instead of XML chunks.
+      this->binaryWriter->AddFrames(data, this->buffer);
+    }
+    else if (!data.empty())
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
@@ -875,10 +915,20 @@ void LogRecordPrivate::Log::Stop()
   if (this->logFile.is_open())
   {
     this->Update();
-    this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    // Binary logs end with the index of their blocks.
+    if (this->binaryWriter)
+    {
+      this->binaryWriter->Finish(this->buffer);
+      this->Write();
+    }
+    else
+    {
+      this->Write();
+
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
@@ -897,16 +947,24 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
     gzlog << "Filename [" + this->completePath.string() + "], already exists."
           << " The log file will be overwritten.\n";
 
-  std::ostringstream stream;
-  stream << "<?xml version='1.0'?>\n"
-         << "<gazebo_log>\n"
-         << "<header>\n"
+  std::ostringstream header;
+  header << "<header>\n"
          << "<log_version>" << GZ_LOG_VERSION << "</log_version>\n"
          << "<gazebo_version>" << GAZEBO_VERSION_FULL << "</gazebo_version>\n"
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
 
-  this->buffer.append(stream.str());
+  if (this->parent->Encoding() == "binary")
+  {
+    this->binaryWriter.reset(new LogBinaryWriter);
+    this->binaryWriter->Start(header.str(), this->buffer);
+  }
+  else
+  {
+    this->binaryWriter.reset();
+    this->buffer.append("<?xml version='1.0'?>\n<gazebo_log>\n");
+    this->buffer.append(header.str());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -18,8 +18,10 @@
 #define _GAZEBO_UTIL_LOGRECORD_HH_
 
 #include <fstream>
+#include <memory>
 #include <set>
 #include <string>
+#include <boost/regex.hpp>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
@@ -38,7 +40,7 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, or binary).
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -149,10 +151,18 @@ namespace gazebo
       /// \return Log recording filter string.
       public: std::string Filter() const;
 
-      /// \brief Set the log recording filter string.
+      /// \brief Set the log recording filter string. The filter is
+      /// compiled once here, see FilterRegex.
       /// \param[in] _filter New log record filter regex string
       public: void SetFilter(const std::string &_filter);
 
+      /// \brief Get the model name regular expression compiled from the
+      /// filter string. A new object is returned every time the filter
+      /// changes, so callers can cache the models that match it.
+      /// \return Regular expression that the names of the recorded models
+      /// must match, or nullptr if every model is recorded.
+      public: std::shared_ptr<const boost::regex> FilterRegex() const;
+
       /// \brief Get whether the model meshes and materials are saved when
       /// recording.
       /// \return True if model meshes and materials are saved when recording.
@@ -176,14 +186,17 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, or
+      /// binary).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, or binary], where txt is plain txt,
+      /// bz2 and zlib are compressed data with Base64 encoding, and binary
+      /// is an indexed sequence of keyframes and deltas (see
+      /// LogBinaryWriter).
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -19,12 +19,17 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
 #include <functional>
 #include <condition_variable>
 #include <boost/filesystem.hpp>
+#include <boost/regex.hpp>
+
+#include "gazebo/util/LogBinary.hh"
 
 namespace gazebo
 {
@@ -101,6 +106,10 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief Encoder of the log when using the "binary" encoding,
+        /// nullptr otherwise.
+        public: std::unique_ptr<LogBinaryWriter> binaryWriter;
       };
 
       /// \def Log_M
@@ -209,6 +218,13 @@ namespace gazebo
       /// \brief Record filter string.
       public: std::string filter = "";
 
+      /// \brief Model name regex compiled from the filter string, nullptr
+      /// when every model passes the filter.
+      public: std::shared_ptr<const boost::regex> filterRegex;
+
+      /// \brief Protects filter and filterRegex.
+      public: mutable std::mutex filterMutex;
+
       /// \brief Record with model resources.
       public: bool recordResources = false;
 
@@ -203,11 +203,29 @@ TEST_F(LogRecord_TEST, Filter)
 
 
   // filter by regex string
+  EXPECT_TRUE(recorder->FilterRegex() == nullptr);
   recorder->SetFilter("robot*");
   EXPECT_EQ(recorder->Filter(), "robot*");
 
+  // the filter is compiled once, and only the model part is used
+  auto regex = recorder->FilterRegex();
+  ASSERT_TRUE(regex != nullptr);
+  EXPECT_TRUE(boost::regex_match("robot_1", *regex));
+  EXPECT_FALSE(boost::regex_match("box", *regex));
+  EXPECT_EQ(regex, recorder->FilterRegex());
+
+  recorder->SetFilter("box.link/joint");
+  ASSERT_TRUE(recorder->FilterRegex() != nullptr);
+  EXPECT_NE(regex, recorder->FilterRegex());
+  EXPECT_TRUE(boost::regex_match("box", *recorder->FilterRegex()));
+  EXPECT_FALSE(boost::regex_match("box.link", *recorder->FilterRegex()));
+
+  recorder->SetFilter("*.link");
+  EXPECT_TRUE(recorder->FilterRegex() == nullptr);
+
   recorder->SetFilter("");
   EXPECT_EQ(recorder->Filter(), "");
+  EXPECT_TRUE(recorder->FilterRegex() == nullptr);
 }
 
 /////////////////////////////////////////////////
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
 
 #include <gazebo/common/Events.hh>
@@ -27,6 +28,7 @@
 
 #include <gazebo/physics/World.hh>
 #include <gazebo/physics/Model.hh>
+#include <gazebo/physics/SpatialIndex.hh>
 
 #include "plugins/events/OccupiedEventSource.hh"
 
@@ -103,19 +105,32 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void OccupiedEventSource::Update()
 {
-  // Get all the models.
-  physics::Model_V models = this->world->Models();
+  const RegionPtr &region = this->regions[this->regionName];
+
+  // Get the models whose bounds, which contain their origin, intersect the
+  // region.
+  physics::Model_V models;
+  for (auto const &box : region->boxes)
+  {
+    physics::Model_V inBox = this->world->SpatialIndex().ModelsInBox(box);
+    models.insert(models.end(), inBox.begin(), inBox.end());
+  }
+  std::sort(models.begin(), models.end());
+  models.erase(std::unique(models.begin(), models.end()), models.end());
 
   // Process each model.
   for (physics::Model_V::iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
-    // Skip models that are static
-    if ((*iter)->IsStatic())
+    // Skip models that are static, and nested models
+    if ((*iter)->IsStatic() || (*iter)->GetParent()->HasType(
+          physics::Base::MODEL))
+    {
       continue;
+    }
 
     // If inside, then transmit the desired message.
-    if (this->regions[this->regionName]->Contains((*iter)->WorldPose().Pos()))
+    if (region->Contains((*iter)->WorldPose().Pos()))
     {
       this->msgPub->Publish(this->msg);
     }
@@ -16,6 +16,9 @@
 */
 
 #include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include <ignition/math/Vector3.hh>
 
 // required for HAVE_DART_BULLET define
@@ -86,6 +89,13 @@ class HeightmapTest : public ServerFixture,
 /// \brief Test loading a heightmap and verify cache files are created
   public: void HeightmapCache();
 
+  /// \brief Test requesting the heights of a heightmap in tiles
+  public: void TiledHeights();
+
+  /// \brief Test that heights changed with SetHeight reach the collision
+  /// \param[in] _physicsEngine the physics engine to test
+  public: void SetHeightCollision(const std::string &_physicsEngine);
+
   public: void NotSquareImage();
   public: void InvalidSizeImage();
   // public: void Heights(const std::string &_physicsEngine);
@@ -990,6 +1000,118 @@ void HeightmapTest::TerrainCollisionAsymmetric(const std::string &_physics)
   EXPECT_LT(box2->WorldPose().Pos().Z(), 5.5);
 }
 
+/////////////////////////////////////////////////
+void HeightmapTest::TiledHeights()
+{
+  Load("worlds/heightmap_test.world", true);
+
+  physics::ModelPtr model = GetModel("heightmap");
+  ASSERT_NE(model, nullptr);
+  physics::HeightmapShapePtr shape =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+        model->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(shape, nullptr);
+
+  // Min and max are known without scanning, and match the heights
+  const unsigned int vertSize = shape->VertexCount().X();
+  ASSERT_GT(vertSize, 0u);
+  float minHeight = shape->GetHeight(0, 0);
+  float maxHeight = minHeight;
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    for (unsigned int x = 0; x < vertSize; ++x)
+    {
+      minHeight = std::min(minHeight, shape->GetHeight(x, y));
+      maxHeight = std::max(maxHeight, shape->GetHeight(x, y));
+    }
+  }
+  EXPECT_FLOAT_EQ(minHeight, shape->GetMinHeight());
+  EXPECT_FLOAT_EQ(maxHeight, shape->GetMaxHeight());
+
+  // Requests without data get all the heights
+  msgs::Geometry full;
+  boost::shared_ptr<msgs::Response> response =
+    transport::request("default", "heightmap_data");
+  ASSERT_EQ(full.GetTypeName(), response->type());
+  full.ParseFromString(response->serialized_data());
+  ASSERT_EQ(static_cast<int>(vertSize * vertSize),
+      full.heightmap().heights_size());
+
+  // Tiles of rows cover the same heights
+  const unsigned int tileRows = 7;
+  std::vector<float> tiled;
+  for (unsigned int row = 0; row < vertSize; row += tileRows)
+  {
+    msgs::Geometry tile;
+    response = transport::request("default", "heightmap_data",
+        std::to_string(row) + " " + std::to_string(tileRows));
+    ASSERT_EQ(tile.GetTypeName(), response->type());
+    tile.ParseFromString(response->serialized_data());
+    EXPECT_EQ(row, tile.heightmap().tile_row());
+    EXPECT_EQ(std::min(tileRows, vertSize - row),
+        tile.heightmap().tile_rows());
+    tiled.insert(tiled.end(), tile.heightmap().heights().begin(),
+        tile.heightmap().heights().end());
+  }
+  ASSERT_EQ(tiled.size(), vertSize * vertSize);
+  for (unsigned int i = 0; i < tiled.size(); ++i)
+    EXPECT_FLOAT_EQ(full.heightmap().heights(i), tiled[i]);
+
+  // The first change copies the heights shared with the other users of the
+  // same terrain
+  shape->SetHeight(0, 0, maxHeight + 1);
+  EXPECT_FLOAT_EQ(maxHeight + 1, shape->GetHeight(0, 0));
+  EXPECT_FLOAT_EQ(maxHeight + 1, shape->GetMaxHeight());
+}
+
+/////////////////////////////////////////////////
+void HeightmapTest::SetHeightCollision(const std::string &_physicsEngine)
+{
+  if (_physicsEngine == "bullet")
+  {
+    gzerr << "Skipping test for bullet. See issue #2506" << std::endl;
+    return;
+  }
+
+  if (_physicsEngine == "simbody" || _physicsEngine == "dart")
+  {
+    // SimbodyHeightmapShape unimplemented, DART copies the heights.
+    gzerr << "Aborting test for " << _physicsEngine << std::endl;
+    return;
+  }
+
+  Load("worlds/heightmap_test_with_sphere.world", true, _physicsEngine);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  physics::ModelPtr heightmap = GetModel("heightmap");
+  ASSERT_NE(heightmap, nullptr);
+  physics::HeightmapShapePtr shape =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+        heightmap->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(shape, nullptr);
+
+  physics::ModelPtr sphere = GetModel("test_sphere");
+  ASSERT_NE(sphere, nullptr);
+
+  // let the sphere roll into the valley
+  world->Step(5000);
+  const double restZ = sphere->WorldPose().Pos().Z();
+  EXPECT_GE(restZ, shape->GetMinHeight());
+
+  // lower the terrain, the sphere has to fall
+  const unsigned int vertSize = shape->VertexCount().X();
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    for (unsigned int x = 0; x < vertSize; ++x)
+      shape->SetHeight(x, y, shape->GetHeight(x, y) - 10);
+  }
+
+  world->Step(500);
+  EXPECT_LT(sphere->WorldPose().Pos().Z(), restZ - 0.5);
+}
+
 /////////////////////////////////////////////////
 TEST_F(HeightmapTest, NotSquareImage)
 {
@@ -1161,6 +1283,12 @@ TEST_F(HeightmapTest, TerrainCollisionDartBullet)
   TerrainCollision("dart", "bullet");
 }
 
+/////////////////////////////////////////////////
+TEST_P(HeightmapTest, SetHeightCollision)
+{
+  SetHeightCollision(GetParam());
+}
+
 /////////////////////////////////////////////////
 TEST_P(HeightmapTest, TerrainCollisionAsymmetric)
 {
@@ -1219,6 +1347,12 @@ TEST_F(HeightmapTest, HeightmapCache)
   HeightmapCache();
 }
 
+/////////////////////////////////////////////////
+TEST_F(HeightmapTest, TiledHeights)
+{
+  TiledHeights();
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, HeightmapTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 /////////////////////////////////////////////////
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/JointController.hh"
@@ -92,6 +96,61 @@ TEST_F(JointControllerTest, VelocityControl)
   EXPECT_NEAR(vel, 0.2, 0.05);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, QueuedCommands)
+{
+  Load("worlds/simple_arm_test.world", true);
+  gazebo::physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  gazebo::physics::ModelPtr model = world->ModelByName("simple_arm");
+  gazebo::physics::JointControllerPtr jointController =
+    model->GetJointController();
+
+  const std::string jointName = "simple_arm::arm_shoulder_pan_joint";
+  jointController->SetPositionPID(jointName, common::PID(10, 0.1, 4.5));
+  int handle = jointController->JointHandle(jointName);
+  ASSERT_GE(handle, 0);
+
+  world->Step(100);
+
+  // Queue position targets from another thread while the world steps
+  std::atomic<bool> stepping(true);
+  std::thread controller([&]()
+  {
+    unsigned int count = 0;
+    while (stepping)
+    {
+      if (jointController->QueuePositionTarget(handle, 0.5 + (count % 2)))
+        ++count;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  world->Step(1000);
+  stepping = false;
+  controller.join();
+
+  // Empty the queue, then queue more targets than it holds from this
+  // thread. The last one wins.
+  world->Step(1);
+  for (unsigned int i = 0; i < 2000; ++i)
+    EXPECT_TRUE(jointController->QueuePositionTarget(handle, 0.5 + (i % 2)));
+  EXPECT_TRUE(jointController->QueuePositionTarget(handle, 1.0));
+
+  // Commands for joints that don't exist are ignored
+  EXPECT_TRUE(jointController->QueueForce(100, 1.0));
+
+  world->Step(5000);
+
+  std::map<std::string, double> positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 1u);
+  EXPECT_DOUBLE_EQ(positions[jointName], 1.0);
+  EXPECT_TRUE(jointController->GetForces().empty());
+
+  auto angle = model->GetJoint("arm_shoulder_pan_joint")->Position(0);
+  EXPECT_NEAR(angle, 1.0, 0.1);
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, JointCmd)
 {
@@ -349,6 +349,65 @@ TEST_F(PhysicsCollisionTest, ModelSelfCollide)
   Unload();
 }
 
+/////////////////////////////////////////////////
+// Verify that the parallel ODE narrow-phase gives exactly the same result as
+// the serial narrow-phase.
+TEST_F(PhysicsCollisionTest, ParallelNarrowPhase)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // Drop a pile of boxes and spheres that touch each other and the ground.
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      std::ostringstream name;
+      name << "box_" << i << "_" << j;
+      SpawnBox(name.str(), ignition::math::Vector3d(0.5, 0.5, 0.5),
+          ignition::math::Vector3d(i * 0.45, j * 0.45, 0.5 + (i + j) * 0.1),
+          ignition::math::Vector3d(0.1 * i, 0.1 * j, 0));
+
+      name.str("");
+      name << "sphere_" << i << "_" << j;
+      SpawnSphere(name.str(),
+          ignition::math::Vector3d(i * 0.45, j * 0.45, 1.5 + (i + j) * 0.1),
+          ignition::math::Vector3d::Zero);
+    }
+  }
+
+  const unsigned int steps = 500;
+  const uint32_t seed = 1234;
+
+  // Serial narrow-phase
+  EXPECT_TRUE(physics->SetParam("collide_threads", 0));
+  physics->SetSeed(seed);
+  world->Step(steps);
+
+  std::map<std::string, ignition::math::Pose3d> serialPoses;
+  for (auto const &model : world->Models())
+    serialPoses[model->GetScopedName()] = model->WorldPose();
+
+  // Parallel narrow-phase from the same initial state
+  world->Reset();
+  EXPECT_TRUE(physics->SetParam("collide_threads", 4));
+  physics->SetSeed(seed);
+  world->Step(steps);
+
+  for (auto const &model : world->Models())
+  {
+    auto iter = serialPoses.find(model->GetScopedName());
+    ASSERT_TRUE(iter != serialPoses.end());
+    EXPECT_EQ(iter->second, model->WorldPose()) << model->GetScopedName();
+  }
+
+  Unload();
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsCollisionTest, GetBoundingBox)
 {
@@ -18,6 +18,9 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#include <atomic>
+#include <string>
+
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -40,6 +43,9 @@ int g_latchCreatedAfterPub = 0;
 int g_latchCreatedAfterPub2 = 0;
 int g_subBeforeClear = 0;
 int g_subAfterClear = 0;
+std::atomic<int> g_sharedImageCount(0);
+std::string g_sharedRawData;
+std::atomic<bool> g_sharedRawReceived(false);
 
 void ReceiveBeforeClear(ConstVector3dPtr &/*_msg*/)
 {
@@ -111,6 +117,18 @@ void ReceiveWorldStatsDebugMsg(ConstGzStringPtr &/*_data*/)
   g_worldStatsDebugMsg = true;
 }
 
+void ReceiveSharedImageMsg(ConstImageStampedPtr &_msg)
+{
+  EXPECT_EQ(1024u * 1024u, _msg->image().data().size());
+  g_sharedImageCount++;
+}
+
+void ReceiveSharedImageRaw(const std::string &_data)
+{
+  g_sharedRawData = _data;
+  g_sharedRawReceived = true;
+}
+
 /////////////////////////////////////////////////
 TEST_F(TransportTest, Load)
 {
@@ -186,6 +204,54 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+// Publish a shared message, which must not be copied by the publisher
+TEST_F(TransportTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::ImageStamped>("~/shared_image");
+
+  g_sharedImageCount = 0;
+  g_sharedRawData.clear();
+  g_sharedRawReceived = false;
+
+  transport::SubscriberPtr sub = node->Subscribe("~/shared_image",
+      &ReceiveSharedImageMsg);
+  transport::SubscriberPtr rawSub = node->Subscribe("~/shared_image",
+      &ReceiveSharedImageRaw);
+
+  boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+  msgs::Set(msg->mutable_time(), common::Time(1, 0));
+  msg->mutable_image()->set_width(1024);
+  msg->mutable_image()->set_height(1024);
+  msg->mutable_image()->set_pixel_format(common::Image::L_INT8);
+  msg->mutable_image()->set_step(1024);
+  msg->mutable_image()->set_data(std::string(1024 * 1024, 'a'));
+
+  pub->Publish(msg, true);
+
+  // The latched message is the published message, not a copy
+  EXPECT_EQ(msg.get(), pub->GetPrevMsgPtr().get());
+
+  for (int i = 0; i < 100 && (g_sharedImageCount == 0 ||
+        !g_sharedRawReceived); ++i)
+  {
+    common::Time::MSleep(10);
+  }
+
+  EXPECT_EQ(1, g_sharedImageCount);
+  EXPECT_EQ(msg->SerializeAsString(), g_sharedRawData);
+
+  // A pointer to a const message can be published as well
+  boost::shared_ptr<const msgs::ImageStamped> constMsg = msg;
+  pub->Publish(constMsg);
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/transport.hh"
+
+using namespace gazebo;
+
+/// \brief Size of a shared memory slot of the subscribers.
+static const size_t kSlotSize = 1024;
+
+/// \brief Messages received by the subscriber of a child process.
+static std::vector<std::string> g_received;
+
+/// \brief Protects g_received.
+static std::mutex g_receivedMutex;
+
+/////////////////////////////////////////////////
+void ReceiveString(ConstGzStringPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_receivedMutex);
+  g_received.push_back(_msg->data());
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the shared memory rings mapped by this process, whose name
+/// has been removed once the publisher opened them.
+/// \return Number of rings, -1 if the mappings can't be listed.
+static int MappedRings()
+{
+  std::ifstream maps("/proc/self/maps");
+  if (!maps.is_open())
+    return -1;
+
+  int count = 0;
+  std::string line;
+  while (std::getline(maps, line))
+  {
+    if (line.find("/dev/shm/gazebo_shm_") != std::string::npos &&
+        line.find("(deleted)") != std::string::npos)
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Subscribe to a topic in a child process, which exits with 0 once
+/// it received the expected messages. Must be called before the server is
+/// set up.
+/// \param[in] _topic Topic to subscribe to.
+/// \param[in] _sharedMemory True to receive the messages in shared memory.
+/// \param[in] _readyTopic Topic to wait for before subscribing with
+/// latching, empty to subscribe right away.
+/// \param[in] _expected Messages to receive.
+/// \return Pid of the child process, -1 on error.
+static pid_t ForkSubscriber(const std::string &_topic,
+    const bool _sharedMemory, const std::string &_readyTopic,
+    const std::vector<std::string> &_expected)
+{
+  pid_t pid = fork();
+  if (pid != 0)
+    return pid;
+
+  if (!transport::init())
+    _exit(1);
+  transport::run();
+
+  // Wait for the publisher to be ready
+  for (int i = 0; i < 100 && !_readyTopic.empty(); ++i)
+  {
+    auto topics = transport::getAdvertisedTopics("gazebo.msgs.GzString");
+    if (std::find(topics.begin(), topics.end(), _readyTopic) != topics.end())
+      break;
+    common::Time::MSleep(100);
+  }
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  node->SetSharedMemory(_topic, _sharedMemory, kSlotSize, 4);
+  transport::SubscriberPtr sub =
+    node->Subscribe(_topic, &ReceiveString, !_readyTopic.empty());
+
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_receivedMutex);
+      if (g_received.size() >= _expected.size())
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  int result = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_receivedMutex);
+    if (g_received != _expected)
+    {
+      std::cerr << "Subscriber of [" << _topic << "] received "
+                << g_received.size() << " of " << _expected.size()
+                << " messages" << std::endl;
+      result = 2;
+    }
+  }
+
+  // The ring is still mapped if the publisher accepted it
+  int rings = MappedRings();
+  if (rings >= 0 && (rings > 0) != _sharedMemory)
+  {
+    std::cerr << "Subscriber of [" << _topic << "] maps " << rings
+              << " rings" << std::endl;
+    result = 3;
+  }
+
+  _exit(result);
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for a child process to exit.
+/// \param[in] _pid Pid of the child process.
+/// \return Exit status of the child process, -1 if it did not exit in time.
+static int WaitForChild(const pid_t _pid)
+{
+  int status;
+  for (int i = 0; i < 300; ++i)
+  {
+    if (waitpid(_pid, &status, WNOHANG) == _pid)
+      return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    common::Time::MSleep(100);
+  }
+
+  kill(_pid, SIGKILL);
+  waitpid(_pid, &status, 0);
+  return -1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test class for gtest which forks subscribers in child processes,
+/// which read the messages of a publisher in shared memory.
+class TransportShmTest : public ::testing::Test
+{
+  /// \brief Set up the server of the publisher.
+  protected: void SetUpServer()
+             {
+               gazebo::setupServer(1, const_cast<char **>(&this->programName));
+             }
+
+  /// \brief Shut down the server.
+  protected: virtual void TearDown()
+             {
+               gazebo::shutdown();
+             }
+
+  /// \brief Fake program name as argv for gazebo::setupServer()
+  private: const char *programName = "TransportShmTest";
+};
+
+/////////////////////////////////////////////////
+TEST_F(TransportShmTest, NodePubSub)
+{
+  const std::string topic = "/gazebo/shm_test/pub_sub";
+
+  // Small messages go through the ring, the large one over the connection
+  std::vector<std::string> expected;
+  for (int i = 0; i < 10; ++i)
+    expected.push_back(std::to_string(i));
+  expected[5] = std::string(4 * kSlotSize, 'l');
+
+  pid_t child = ForkSubscriber(topic, true, "", expected);
+  ASSERT_GE(child, 0);
+
+  this->SetUpServer();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>(topic);
+  ASSERT_TRUE(pub->WaitForConnection(common::Time(10)));
+
+  msgs::GzString msg;
+  for (auto const &data : expected)
+  {
+    msg.set_data(data);
+    pub->Publish(msg, true);
+  }
+
+  EXPECT_EQ(0, WaitForChild(child));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportShmTest, LatchedMixed)
+{
+  const std::string topic = "/gazebo/shm_test/latched";
+  const std::string readyTopic = "/gazebo/shm_test/ready";
+
+  // The latched message is the first one each subscriber gets, whether it
+  // reads shared memory or the connection.
+  std::vector<std::string> expected = {"latched", "next"};
+
+  pid_t shmChild = ForkSubscriber(topic, true, readyTopic, expected);
+  ASSERT_GE(shmChild, 0);
+  pid_t tcpChild = ForkSubscriber(topic, false, readyTopic, expected);
+  ASSERT_GE(tcpChild, 0);
+
+  this->SetUpServer();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>(topic);
+
+  msgs::GzString msg;
+  msg.set_data("latched");
+  pub->Publish(msg, true);
+
+  // Let the subscribers connect after the latched message
+  transport::PublisherPtr readyPub =
+    node->Advertise<msgs::GzString>(readyTopic);
+
+  for (int i = 0; i < 100 && pub->GetRemoteSubscriptionCount() < 2; ++i)
+    common::Time::MSleep(100);
+  EXPECT_EQ(2u, pub->GetRemoteSubscriptionCount());
+
+  msg.set_data("next");
+  pub->Publish(msg, true);
+
+  EXPECT_EQ(0, WaitForChild(shmChild));
+  EXPECT_EQ(0, WaitForChild(tcpChild));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BulletThreadsTest : public ServerFixture,
+                          public ::testing::WithParamInterface<int>
+{
+  /// \brief Step a pile of boxes with a number of threads.
+  /// \param[in] _threads Number of threads to step the world with.
+  public: void PileOfBoxes(const int _threads);
+};
+
+/// \brief Number of boxes along each side of the pile.
+static const unsigned int g_side = 8;
+
+/// \brief Number of layers of boxes.
+static const unsigned int g_layers = 4;
+
+/////////////////////////////////////////////////
+/// \brief Write a world with a pile of boxes stepped by bullet.
+/// \param[in] _threads Number of threads to step the world with.
+/// \return Path to the world file.
+std::string writeWorld(const int _threads)
+{
+  boost::filesystem::path path =
+    common::SystemPaths::Instance()->TmpInstancePath();
+  path /= "bullet_threads";
+  boost::filesystem::create_directories(path);
+
+  std::ostringstream world;
+  world << "<?xml version='1.0'?>\n"
+    << "<sdf version='1.6'><world name='default'>\n"
+    << "<physics type='bullet'><bullet>"
+    << "<gz:threads>" << _threads << "</gz:threads>"
+    << "</bullet></physics>\n"
+    << "<include><uri>model://ground_plane</uri></include>\n";
+  for (unsigned int layer = 0; layer < g_layers; ++layer)
+  {
+    for (unsigned int i = 0; i < g_side * g_side; ++i)
+    {
+      world << "<model name='box_" << layer << "_" << i << "'>"
+        << "<pose>" << (i % g_side) * 0.55 << " " << (i / g_side) * 0.55
+        << " " << 0.25 + layer * 0.55 << " 0 0 0</pose>"
+        << "<link name='link'><collision name='collision'><geometry>"
+        << "<box><size>0.5 0.5 0.5</size></box>"
+        << "</geometry></collision></link></model>\n";
+    }
+  }
+  world << "</world></sdf>\n";
+
+  path /= "bullet_threads_" + std::to_string(_threads) + ".world";
+  std::ofstream out(path.string());
+  out << world.str();
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+void BulletThreadsTest::PileOfBoxes(const int _threads)
+{
+  this->Load(writeWorld(_threads), true, "bullet");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  ASSERT_EQ(g_side * g_side * g_layers + 1, world->ModelCount());
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ("bullet", physics->GetType());
+
+  // Bullet may have been built without multithreading support
+  const int threads = boost::any_cast<int>(physics->GetParam("threads"));
+  EXPECT_GE(threads, 1);
+  EXPECT_LE(threads, _threads);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  const unsigned int steps = 1000;
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+  gzmsg << "Time elapsed stepping " << steps << " iterations with "
+        << threads << " threads [" << elapsed << "]\n";
+
+  // The boxes settled on the ground and on each other, and the contacts
+  // of every layer are still reported
+  EXPECT_GE(manager->GetContactCount(), g_side * g_side * g_layers);
+  for (unsigned int i = 0; i < g_side * g_side; ++i)
+  {
+    physics::ModelPtr model = world->ModelByName("box_0_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.25, model->WorldPose().Pos().Z(), 0.05);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(BulletThreadsTest, PileOfBoxes)
+{
+  this->PileOfBoxes(this->GetParam());
+}
+
+#ifdef HAVE_BULLET
+INSTANTIATE_TEST_CASE_P(Threads, BulletThreadsTest,
+    ::testing::Values(1, 2, 4));
+#endif
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
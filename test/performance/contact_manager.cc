@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ContactManagerStressTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// Measure the memory used by the contacts of a crowded scene, and the time
+// needed to publish them.
+TEST_F(ContactManagerStressTest, PublishContacts)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int side = 10;
+  const unsigned int initialCount = world->ModelCount();
+  for (unsigned int i = 0; i < side; ++i)
+  {
+    for (unsigned int j = 0; j < side; ++j)
+    {
+      std::ostringstream name;
+      name << "box_" << i << "_" << j;
+      SpawnBox(name.str(), ignition::math::Vector3d(0.5, 0.5, 0.5),
+          ignition::math::Vector3d(i * 0.6, j * 0.6, 0.25));
+    }
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + side * side && sleep++ < 300)
+    common::Time::MSleep(100);
+  ASSERT_EQ(initialCount + side * side, world->ModelCount());
+
+  physics::ContactManager *manager = world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  world->Step(100);
+
+  unsigned int contactCount = manager->GetContactCount();
+  EXPECT_GE(contactCount, side * side);
+
+  size_t bytes = 0;
+  int points = 0;
+  for (unsigned int i = 0; i < contactCount; ++i)
+  {
+    physics::Contact *contact = manager->GetContact(i);
+    bytes += contact->AllocatedBytes();
+    points += contact->count;
+  }
+
+  // Size of the contact points when they were stored in fixed arrays
+  const size_t fixedBytes = contactCount * MAX_CONTACT_JOINTS *
+    (sizeof(physics::JointWrench) + 2 * sizeof(ignition::math::Vector3d) +
+     sizeof(double));
+
+  gzmsg << contactCount << " contacts with " << points << " points use ["
+        << bytes << "] bytes, fixed arrays would use ["
+        << fixedBytes << "] bytes" << std::endl;
+  EXPECT_LT(bytes, fixedBytes);
+
+  const unsigned int iterations = 1000;
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+    manager->PublishContacts();
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  gzmsg << "PublishContacts took [" << elapsed.Double() / iterations * 1e6
+        << "] us on average" << std::endl;
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class EntityLookupTest : public ServerFixture {};
+
+/// \brief Number of models in the world. Each model has a link, a
+/// collision and a shape, which makes 4 entities per model.
+static const unsigned int g_modelCount = 1250;
+
+/////////////////////////////////////////////////
+/// \brief Write a world with many box models.
+/// \return Path to the world file.
+std::string writeWorld()
+{
+  std::ostringstream world;
+  world << "<?xml version='1.0'?>\n"
+    << "<sdf version='1.6'><world name='default'>\n";
+  for (unsigned int i = 0; i < g_modelCount; ++i)
+  {
+    world << "<model name='box_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << (i % 50) << " " << (i / 50) << " 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<box><size>0.5 0.5 0.5</size></box>"
+      << "</geometry></collision></link></model>\n";
+  }
+  world << "</world></sdf>\n";
+
+  boost::filesystem::path path =
+    common::SystemPaths::Instance()->TmpInstancePath();
+  boost::filesystem::create_directories(path);
+  path /= "entity_lookup.world";
+
+  std::ofstream out(path.string());
+  out << world.str();
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityLookupTest, ManyEntities)
+{
+  Load(writeWorld(), true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  ASSERT_EQ(g_modelCount, world->ModelCount());
+
+  const unsigned int iterations = 100000;
+
+  // Models by name, including the last loaded ones which are found last
+  // when walking the entity tree.
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    std::string name = "box_" + std::to_string(
+        g_modelCount - 1 - i % g_modelCount);
+    ASSERT_TRUE(world->ModelByName(name) != nullptr) << name;
+  }
+  common::Time modelTime = common::Time::GetWallTime() - startTime;
+
+  // Entities by scoped name
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    std::string name = "box_" + std::to_string(i % g_modelCount) +
+      "::link::collision";
+    ASSERT_TRUE(world->EntityByName(name) != nullptr) << name;
+  }
+  common::Time entityTime = common::Time::GetWallTime() - startTime;
+
+  // Missing entities, as when looking for a unique name
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    std::string name = "missing_" + std::to_string(i);
+    ASSERT_TRUE(world->ModelByName(name) == nullptr) << name;
+  }
+  common::Time missingTime = common::Time::GetWallTime() - startTime;
+
+  gzdbg << "Time elapsed for " << iterations << " lookups among "
+        << g_modelCount * 4 << " entities: models [" << modelTime
+        << "] scoped entities [" << entityTime << "] missing ["
+        << missingTime << "]\n";
+
+  // Walking the tree takes several seconds for each of these
+  EXPECT_LT(modelTime, common::Time(1, 0));
+  EXPECT_LT(entityTime, common::Time(1, 0));
+  EXPECT_LT(missingTime, common::Time(1, 0));
+
+  // Renamed entities are found by their new name
+  physics::ModelPtr model = world->ModelByName("box_10");
+  ASSERT_TRUE(model != nullptr);
+  model->SetName("renamed_box");
+  EXPECT_TRUE(world->ModelByName("box_10") == nullptr);
+  EXPECT_EQ(model, world->ModelByName("renamed_box"));
+
+  // Entities with the same name are found in the scope of their parent
+  physics::BasePtr link = model->GetByName("link");
+  ASSERT_TRUE(link != nullptr);
+  EXPECT_EQ(model, link->GetParent());
+  EXPECT_TRUE(world->BaseByName("link") != nullptr);
+
+  // Removed entities are not found
+  world->RemoveModel("box_20");
+  EXPECT_TRUE(world->ModelByName("box_20") == nullptr);
+  EXPECT_TRUE(world->EntityByName("box_20::link") == nullptr);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ModelUpdateStressTest : public ServerFixture
+{
+  /// \brief Spawn a pendulum whose joint is driven by a position PID.
+  /// \param[in] _name Name of the model.
+  /// \param[in] _pos Position of the model.
+  public: void SpawnPendulum(const std::string &_name,
+              const ignition::math::Vector3d &_pos);
+};
+
+/////////////////////////////////////////////////
+void ModelUpdateStressTest::SpawnPendulum(const std::string &_name,
+    const ignition::math::Vector3d &_pos)
+{
+  std::ostringstream sdfStream;
+  sdfStream << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='" << _name << "'>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << "  <link name='base'>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>0.2 0.2 0.2</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "  <link name='arm'>"
+    << "    <pose>0 0 0.5 0 0 0</pose>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>0.05 0.05 0.8</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "  <joint name='fixed' type='fixed'>"
+    << "    <parent>world</parent>"
+    << "    <child>base</child>"
+    << "  </joint>"
+    << "  <joint name='hinge' type='revolute'>"
+    << "    <parent>base</parent>"
+    << "    <child>arm</child>"
+    << "    <pose>0 0 -0.4 0 0 0</pose>"
+    << "    <axis><xyz>1 0 0</xyz></axis>"
+    << "  </joint>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(sdfStream.str());
+}
+
+/////////////////////////////////////////////////
+// Compare the time spent stepping a world full of actuated models with the
+// serial and the parallel model update strategies.
+TEST_F(ModelUpdateStressTest, Strategies)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int side = 16;
+  const unsigned int modelCount = side * side;
+  const unsigned int initialCount = world->ModelCount();
+
+  for (unsigned int i = 0; i < side; ++i)
+  {
+    for (unsigned int j = 0; j < side; ++j)
+    {
+      std::ostringstream name;
+      name << "pendulum_" << i << "_" << j;
+      SpawnPendulum(name.str(), ignition::math::Vector3d(i, j, 0.1));
+    }
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < initialCount + modelCount && sleep++ < 600)
+    common::Time::MSleep(100);
+  ASSERT_EQ(initialCount + modelCount, world->ModelCount());
+
+  const unsigned int steps = 2000;
+  std::map<std::string, common::Time> elapsed;
+  for (auto const &strategy : {"serial", "parallel"})
+  {
+    world->Reset();
+    EXPECT_TRUE(world->SetModelUpdateStrategy(strategy));
+
+    // Drive every pendulum with a position controller, so that each
+    // Model::Update does joint controller work. Targets are cleared by
+    // World::Reset.
+    for (auto const &model : world->Models())
+    {
+      physics::JointPtr joint = model->GetJoint("hinge");
+      if (!joint)
+        continue;
+
+      physics::JointControllerPtr controller = model->GetJointController();
+      ASSERT_TRUE(controller != nullptr);
+      controller->SetPositionPID(joint->GetScopedName(),
+          common::PID(200, 0, 20));
+      EXPECT_TRUE(controller->SetPositionTarget(joint->GetScopedName(), 0.5));
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+    world->Step(steps);
+    elapsed[strategy] = common::Time::GetWallTime() - startTime;
+
+    gzmsg << "Stepping " << modelCount << " models " << steps << " times "
+          << "with the [" << strategy << "] model update took ["
+          << elapsed[strategy] << "] seconds" << std::endl;
+
+    // Every controller should have reached its target
+    for (auto const &model : world->Models())
+    {
+      physics::JointPtr joint = model->GetJoint("hinge");
+      if (joint)
+        EXPECT_NEAR(joint->Position(0), 0.5, 0.05) << model->GetName();
+    }
+  }
+
+  gzmsg << "Parallel model update speedup ["
+        << elapsed["serial"].Double() / elapsed["parallel"].Double()
+        << "]" << std::endl;
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
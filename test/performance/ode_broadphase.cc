@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Broadphase, and whether static models have their own space.
+typedef std::tuple<const char *, bool> Broadphase;
+
+class ODEBroadphaseTest : public ServerFixture,
+                          public ::testing::WithParamInterface<Broadphase>
+{
+  /// \brief Drop many small spheres on large static platforms.
+  /// \param[in] _broadphase Broadphase of the dynamic models.
+  /// \param[in] _staticSpace True to keep static models in their own space.
+  public: void SmallOnLarge(const std::string &_broadphase,
+                            const bool _staticSpace);
+};
+
+/// \brief Number of spheres along each side of the grid.
+static const unsigned int g_side = 30;
+
+/// \brief Number of static platforms.
+static const unsigned int g_platforms = 4;
+
+/// \brief Size of a static platform.
+static const double g_platformSize = 20;
+
+/////////////////////////////////////////////////
+/// \brief Write a world with small spheres above large static platforms.
+/// \param[in] _broadphase Broadphase of the dynamic models.
+/// \param[in] _staticSpace True to keep static models in their own space.
+/// \return Path to the world file.
+std::string writeWorld(const std::string &_broadphase, const bool _staticSpace)
+{
+  boost::filesystem::path path =
+    common::SystemPaths::Instance()->TmpInstancePath();
+  path /= "ode_broadphase";
+  boost::filesystem::create_directories(path);
+
+  std::ostringstream world;
+  world << "<?xml version='1.0'?>\n"
+    << "<sdf version='1.6'><world name='default'>\n"
+    << "<physics type='ode'><ode>"
+    << "<gz:broadphase>" << _broadphase << "</gz:broadphase>"
+    << "<gz:static_space>" << (_staticSpace ? "true" : "false")
+    << "</gz:static_space>"
+    << "<gz:quadtree_extents>100 100 20</gz:quadtree_extents>"
+    << "</ode></physics>\n"
+    << "<include><uri>model://ground_plane</uri></include>\n";
+
+  // Platforms side by side, covering the grid of spheres
+  for (unsigned int i = 0; i < g_platforms; ++i)
+  {
+    world << "<model name='platform_" << i << "'><static>true</static>"
+      << "<pose>" << (i % 2) * g_platformSize << " "
+      << (i / 2) * g_platformSize << " 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<box><size>" << g_platformSize << " " << g_platformSize
+      << " 1</size></box></geometry></collision></link></model>\n";
+  }
+
+  const double spacing = 2 * g_platformSize / g_side;
+  for (unsigned int i = 0; i < g_side * g_side; ++i)
+  {
+    world << "<model name='sphere_" << i << "'>"
+      << "<pose>" << (i % g_side) * spacing - g_platformSize / 2 + 0.5
+      << " " << (i / g_side) * spacing - g_platformSize / 2 + 0.5
+      << " 1.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<sphere><radius>0.1</radius></sphere>"
+      << "</geometry></collision></link></model>\n";
+  }
+  world << "</world></sdf>\n";
+
+  path /= "ode_broadphase_" + _broadphase +
+    (_staticSpace ? "_static" : "") + ".world";
+  std::ofstream out(path.string());
+  out << world.str();
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+void ODEBroadphaseTest::SmallOnLarge(const std::string &_broadphase,
+    const bool _staticSpace)
+{
+  this->Load(writeWorld(_broadphase, _staticSpace), true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  ASSERT_EQ(g_side * g_side + g_platforms + 1, world->ModelCount());
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  EXPECT_EQ(_broadphase,
+      boost::any_cast<std::string>(physics->GetParam("broadphase")));
+  EXPECT_EQ(_staticSpace,
+      boost::any_cast<bool>(physics->GetParam("static_space")));
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  const unsigned int steps = 1000;
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+  gzmsg << "Time elapsed stepping " << steps << " iterations with broadphase ["
+        << _broadphase << "]" << (_staticSpace ? " and a static space" : "")
+        << " [" << elapsed << "]\n";
+
+  // Every sphere landed on a platform, whatever the broadphase
+  EXPECT_GE(manager->GetContactCount(), g_side * g_side);
+  for (unsigned int i = 0; i < g_side * g_side; ++i)
+  {
+    physics::ModelPtr model = world->ModelByName("sphere_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(1.1, model->WorldPose().Pos().Z(), 0.02);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(ODEBroadphaseTest, SmallOnLarge)
+{
+  this->SmallOnLarge(std::get<0>(this->GetParam()),
+      std::get<1>(this->GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(Broadphases, ODEBroadphaseTest,
+    ::testing::Combine(
+      ::testing::Values("hash", "hash_auto", "sap", "quadtree"),
+      ::testing::Bool()));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
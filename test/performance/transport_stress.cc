@@ -15,6 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 #include <boost/thread.hpp>
 #include "gazebo/test/ServerFixture.hh"
 #include "RAMLibrary.hh"
@@ -236,6 +242,86 @@ TEST_F(TransportStressTest, ManyNodes)
   delete [] fakeData;
 }
 
+std::mutex g_pongMutex;
+std::condition_variable g_pongCondition;
+unsigned int g_pongCount = 0;
+transport::PublisherPtr g_pongPub;
+
+void PingCB(ConstGzStringPtr &_msg)
+{
+  g_pongPub->Publish(*_msg, true);
+}
+
+void PongCB(ConstGzStringPtr & /*_msg*/)
+{
+  {
+    std::lock_guard<std::mutex> lock(g_pongMutex);
+    g_pongCount++;
+  }
+  g_pongCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+// Measure the round trip latency of small messages: a message published on
+// a ping topic is published back on a pong topic by the subscriber. Reports
+// the median and 99th percentile round trip times.
+TEST_F(TransportStressTest, RoundTripLatency)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+
+  transport::PublisherPtr pingPub =
+    node->Advertise<msgs::GzString>("~/test/ping__");
+  g_pongPub = node->Advertise<msgs::GzString>("~/test/pong__");
+
+  transport::SubscriberPtr pingSub =
+    node->Subscribe("~/test/ping__", &PingCB);
+  transport::SubscriberPtr pongSub =
+    node->Subscribe("~/test/pong__", &PongCB);
+
+  msgs::GzString msg;
+  msg.set_data("ping");
+
+  const unsigned int roundTrips = 2000;
+  std::vector<double> latencies;
+  latencies.reserve(roundTrips);
+
+  g_pongCount = 0;
+  for (unsigned int i = 0; i < roundTrips; ++i)
+  {
+    common::Time startTime = common::Time::GetWallTime();
+    pingPub->Publish(msg, true);
+
+    std::unique_lock<std::mutex> lock(g_pongMutex);
+    if (!g_pongCondition.wait_for(lock, std::chrono::seconds(1),
+          [i] { return g_pongCount > i; }))
+    {
+      break;
+    }
+
+    latencies.push_back(
+        (common::Time::GetWallTime() - startTime).Double() * 1e3);
+  }
+
+  g_pongPub.reset();
+
+  ASSERT_EQ(roundTrips, latencies.size());
+
+  std::sort(latencies.begin(), latencies.end());
+  double p50 = latencies[latencies.size() / 2];
+  double p99 = latencies[latencies.size() * 99 / 100];
+
+  gzmsg << "Round trip latency over " << roundTrips << " messages: p50 ["
+        << p50 << "] ms, p99 [" << p99 << "] ms, max ["
+        << latencies.back() << "] ms" << std::endl;
+
+  // A round trip must not wait for the 100 ms update period of the
+  // connection manager.
+  EXPECT_LT(p50, 10.0);
+}
+
 /////////////////////////////////////////////////
 // Main function
 int main(int argc, char **argv)
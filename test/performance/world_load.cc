@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldLoadTest : public ServerFixture {};
+
+/// \brief Number of models in the world, each with its own mesh file.
+static const unsigned int g_modelCount = 200;
+
+/////////////////////////////////////////////////
+/// \brief Write a world with many mesh models, and their mesh files.
+/// \param[out] _meshFiles Paths to the mesh files.
+/// \return Path to the world file.
+std::string writeWorld(std::vector<std::string> &_meshFiles)
+{
+  boost::filesystem::path path =
+    common::SystemPaths::Instance()->TmpInstancePath();
+  path /= "world_load";
+  boost::filesystem::create_directories(path);
+
+  std::ostringstream world;
+  world << "<?xml version='1.0'?>\n"
+    << "<sdf version='1.6'><world name='default'>\n";
+  for (unsigned int i = 0; i < g_modelCount; ++i)
+  {
+    // Alternate between mesh formats
+    boost::filesystem::path source = boost::filesystem::path(TEST_PATH) /
+      "data" / (i % 2 ? "box.dae" : "twoFaces.stl");
+    boost::filesystem::path meshFile = path /
+      ("mesh_" + std::to_string(i) + source.extension().string());
+    boost::filesystem::remove(meshFile);
+    boost::filesystem::copy_file(source, meshFile);
+    _meshFiles.push_back(meshFile.string());
+
+    world << "<model name='mesh_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << (i % 20) << " " << (i / 20) << " 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<mesh><uri>" << meshFile.string() << "</uri></mesh>"
+      << "</geometry></collision></link></model>\n";
+  }
+  world << "</world></sdf>\n";
+
+  path /= "world_load.world";
+  std::ofstream out(path.string());
+  out << world.str();
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldLoadTest, ManyMeshes)
+{
+  std::vector<std::string> meshFiles;
+  std::string worldFile = writeWorld(meshFiles);
+
+  common::Time startTime = common::Time::GetWallTime();
+  Load(worldFile, true);
+  common::Time loadTime = common::Time::GetWallTime() - startTime;
+  gzdbg << "Time elapsed loading " << g_modelCount << " mesh models ["
+        << loadTime << "]\n";
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  ASSERT_EQ(g_modelCount, world->ModelCount());
+
+  // Every mesh was loaded once, and is used by its collision
+  for (unsigned int i = 0; i < g_modelCount; ++i)
+  {
+    EXPECT_TRUE(common::MeshManager::Instance()->HasMesh(meshFiles[i]))
+      << meshFiles[i];
+
+    physics::ModelPtr model = world->ModelByName("mesh_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    physics::CollisionPtr collision =
+      model->GetLink("link")->GetCollision("collision");
+    ASSERT_TRUE(collision != nullptr);
+    physics::MeshShapePtr shape =
+      boost::dynamic_pointer_cast<physics::MeshShape>(collision->GetShape());
+    ASSERT_TRUE(shape != nullptr);
+    EXPECT_EQ(meshFiles[i], shape->GetMeshURI());
+  }
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -240,6 +240,19 @@ namespace gazebo
     private: void Step(const std::string &_filter, bool _raw,
                  const std::string &_stamp, double _hz);
 
+    /// \brief Extract the values selected by a filter into columns,
+    /// without loading the whole log, see util::LogExtract.
+    /// \param[in] _filename Name of the log file.
+    /// \param[in] _filter Filter string
+    /// \return True on success.
+    private: bool Extract(const std::string &_filename,
+                 const std::string &_filter);
+
+    /// \brief Skip to the simulation time given with --start, using the
+    /// time index of the log. Called once the world description has been
+    /// read, since it is always output.
+    private: void SeekStart();
+
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
     private: void Record(bool _start);
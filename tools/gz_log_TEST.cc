@@ -373,6 +373,42 @@ TEST(gz_log, Step)
     FAIL() << "Please add support for sdf version: " << SDF_VERSION;
 }
 
+/////////////////////////////////////////////////
+TEST(gz_log, Extract)
+{
+  std::string csv = custom_exec(
+      std::string(GZ_LOG_PATH + "-x --filter pr2.pose.[x]//*torso* -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  EXPECT_EQ(csv,
+      "sim_time,pr2.pose.x,pr2::torso_lift_joint.angle.0,"
+      "pr2::torso_lift_motor_screw_joint.angle.0,"
+      "pr2::torso_lift_screw_torso_lift_joint.angle.0\n"
+      "0.021343973,0,1.41007e-06,7.9351e-05,-1.98549e-06\n"
+      "0.028958235,0,1.61697e-06,0.000183324,-2.25856e-06\n");
+
+  // Same output with a single thread, skipping the first state
+  csv = custom_exec(
+      std::string(GZ_LOG_PATH + "-x --threads 1 --start 0.025 "
+        "--filter pr2.pose.[x]//*torso* -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  EXPECT_EQ(csv,
+      "sim_time,pr2.pose.x,pr2::torso_lift_joint.angle.0,"
+      "pr2::torso_lift_motor_screw_joint.angle.0,"
+      "pr2::torso_lift_screw_torso_lift_joint.angle.0\n"
+      "0.028958235,0,1.61697e-06,0.000183324,-2.25856e-06\n");
+
+  // Binary columns
+  std::string binary = custom_exec(
+      std::string(GZ_LOG_PATH + "-x --format binary --filter pr2.pose.[x] "
+        "-f ") + PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  EXPECT_EQ(binary.substr(0, 8), "GZLOGCOL");
+
+  // Invalid format
+  EXPECT_TRUE(custom_exec(
+      std::string(GZ_LOG_PATH + "-x --format xml -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log").empty());
+}
+
 /////////////////////////////////////////////////
 TEST(gz_log, HangCheck)
 {